@@ -10,8 +10,37 @@ namespace EntitySpawner
 	static std::shared_ptr<ECSManager> entitySpawnerEcsManager = ECSManager::Instance();
 
 	/// <summary>
-	///
+	/// Creates the prefab lasers are pooled from, the values of each shot are set when the laser is acquired from the pool
+	/// </summary>
+	/// <returns>Laser prefab</returns>
+	static Prefab LaserPrefab()
+	{
+		Prefab prefab;
+
+		//Geometry component
+		prefab.Add(Geometry{ L"sphere.obj" });
+
+		//Shader component
+		prefab.Add(Shader{ L"defaultShader.fx", BlendState::NOBLEND, CullState::BACK, DepthState::LESSEQUAL, std::vector<int>(), true });
+
+		//Texture component
+		prefab.Add(Texture{ L"stones.dds", L"stones_NM_height.dds", L"" });
+
+		//Components set by SpawnLaser
+		prefab.Add(PointLight{});
+		prefab.Add(Transform{});
+		prefab.Add(Audio{});
+		prefab.Add(Velocity{});
+		prefab.Add(Colour{});
+		prefab.Add(SphereCollider{});
+
+		return prefab;
+	}
+
+	/// <summary>
+	/// Acquires a laser from the given pool and sets it up for a new shot
 	/// </summary>
+	/// <param name="pLaserPool">Index of the pool created from LaserPrefab</param>
 	/// <param name="pPosition"></param>
 	/// <param name="pScale"></param>
 	/// <param name="pRotation"></param>
@@ -22,58 +51,35 @@ namespace EntitySpawner
 	/// <param name="pBoxMax"></param>
 	/// <param name="pIgnoreCollisionMask"></param>
 	/// <returns></returns>
-	static int SpawnLaser(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const KodeboldsMath::Vector4& pColour,
-		const KodeboldsMath::Vector4& pAcceleration, const float& pMaxSpeed, const float& pRadius, const int pCollisionMask, const int pIgnoreCollisionMask, const float& pLightRange,
-    const std::wstring& pSound)
+	static EntityHandle SpawnLaser(const int pLaserPool, const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation,
+		const KodeboldsMath::Vector4& pColour, const KodeboldsMath::Vector4& pAcceleration, const float& pMaxSpeed, const float& pRadius, const int pCollisionMask,
+		const int pIgnoreCollisionMask, const float& pLightRange, const std::wstring& pSound)
 	{
-		int ID = entitySpawnerEcsManager->CreateEntity();
-
-		//Geometry component
-		Geometry geo{ L"sphere.obj" };
-		entitySpawnerEcsManager->AddGeometryComp(geo, ID);
-
-		//Shader component
-		Shader shader{ L"defaultShader.fx", BlendState::NOBLEND, CullState::BACK, DepthState::LESSEQUAL, std::vector<int>(), true };
-		entitySpawnerEcsManager->AddShaderComp(shader, ID);
+		EntityHandle ID = entitySpawnerEcsManager->AcquireEntity(pLaserPool);
 
 		//Light component
-		PointLight light{ pColour, pLightRange };
-		entitySpawnerEcsManager->AddPointLightComp(light, ID);
+		*entitySpawnerEcsManager->PointLightComp(ID) = PointLight{ pColour, pLightRange };
 
-		//Transform component
-		Transform trans{};
-		trans.scale = pScale;
-		trans.rotation = pRotation;
-		trans.translation = pPosition;
-		entitySpawnerEcsManager->AddTransformComp(trans, ID);
+		//Transform component, the matrix is rebuilt here as the transform system only calculates it when the laser first enters the pool
+		Transform* const trans = entitySpawnerEcsManager->TransformComp(ID);
+		trans->scale = pScale;
+		trans->rotation = pRotation;
+		trans->translation = pPosition;
+		trans->transform = KodeboldsMath::TranslationMatrix(pPosition)
+			* KodeboldsMath::RotationMatrixX(pRotation.X) * KodeboldsMath::RotationMatrixY(pRotation.Y) * KodeboldsMath::RotationMatrixZ(pRotation.Z)
+			* KodeboldsMath::ScaleMatrix(pScale);
 
 		// Audio Component
-		Audio audio{};
-		audio.filename = pSound;
-		audio.active = true;
-		audio.loop = false;
-		audio.volume = 0.5f;
-		audio.pitch = 1.0f;
-		audio.pan = 0.0f;
-		entitySpawnerEcsManager->AddAudioComp(audio, ID);
-
-		//Texture component
-		Texture tex{};
-		tex.diffuse = L"stones.dds";
-		tex.normal = L"stones_NM_height.dds";
-		entitySpawnerEcsManager->AddTextureComp(tex, ID);
+		*entitySpawnerEcsManager->AudioComp(ID) = Audio{ pSound, true, false, 0.5f, 1.0f, 0.0f };
 
 		//Velocity component
-		Velocity vel{ pAcceleration, KodeboldsMath::Vector4(), pMaxSpeed };
-		entitySpawnerEcsManager->AddVelocityComp(vel, ID);
+		*entitySpawnerEcsManager->VelocityComp(ID) = Velocity{ pAcceleration, KodeboldsMath::Vector4(), pMaxSpeed };
 
 		//Colour component
-		Colour colour{ pColour };
-		entitySpawnerEcsManager->AddColourComp(colour, ID);
+		*entitySpawnerEcsManager->ColourComp(ID) = Colour{ pColour };
 
 		//SphereCollider component
-		SphereCollider sphere{ pRadius, pCollisionMask, pIgnoreCollisionMask };
-		entitySpawnerEcsManager->AddSphereColliderComp(sphere, ID);
+		*entitySpawnerEcsManager->SphereColliderComp(ID) = SphereCollider{ pRadius, pCollisionMask, pIgnoreCollisionMask };
 
 		return ID;
 	}
@@ -92,11 +98,11 @@ namespace EntitySpawner
 	/// <param name="pDiffuse"></param>
 	/// <param name="pNormal"></param>
 	/// <returns></returns>
-	static int SpawnShip(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const float& pMaxSpeed,
+	static EntityHandle SpawnShip(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const float& pMaxSpeed,
 		const float& pRadius, const int pCollisionMask, const int pIgnoreCollisionMask, const std::wstring& pDiffuse,
 		const std::wstring& pNormal)
 	{
-		int ID = entitySpawnerEcsManager->CreateEntity();
+		EntityHandle ID = entitySpawnerEcsManager->CreateEntity();
 
 		//Geometry component
 		Geometry geo{ L"ship.obj" };
@@ -130,56 +136,69 @@ namespace EntitySpawner
 	}
 
 	/// <summary>
-	///
+	/// Builds the prefab shared by asteroids with the given collider and textures
+	/// A transform still needs to be added before the prefab is instantiated
 	/// </summary>
-	/// <param name="pPosition"></param>
-	/// <param name="pScale"></param>
-	/// <param name="pRotation"></param>
 	/// <param name="pRadius"></param>
 	/// <param name="pIgnoreCollisionMask"></param>
+	/// <param name="pCollisionMask"></param>
 	/// <param name="pDiffuse"></param>
 	/// <param name="pNormal"></param>
 	/// <returns></returns>
-	static int SpawnAsteroid(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const float& pRadius,
-		const int pIgnoreCollisionMask, const int pCollisionMask, const std::wstring& pDiffuse, const std::wstring& pNormal)
+	static Prefab AsteroidPrefab(const float& pRadius, const int pIgnoreCollisionMask, const int pCollisionMask, const std::wstring& pDiffuse, const std::wstring& pNormal)
 	{
-		int ID = entitySpawnerEcsManager->CreateEntity();
+		Prefab prefab;
 
 		//Geometry component
-		Geometry geo{ L"asteroid.obj" };
-		entitySpawnerEcsManager->AddGeometryComp(geo, ID);
+		prefab.Add(Geometry{ L"asteroid.obj" });
 
 		//Shader component
-		Shader shader{ L"defaultShader.fx", BlendState::NOBLEND, CullState::BACK, DepthState::LESSEQUAL, std::vector<int>{0}, true };
-		entitySpawnerEcsManager->AddShaderComp(shader, ID);
+		prefab.Add(Shader{ L"defaultShader.fx", BlendState::NOBLEND, CullState::BACK, DepthState::LESSEQUAL, std::vector<int>{0}, true });
 
 		//Texture component
-		Texture texture{ pDiffuse, pNormal, L"" };
-		entitySpawnerEcsManager->AddTextureComp(texture, ID);
-
-		//Transform component
-		Transform trans{};
-		trans.scale = pScale;
-		trans.rotation = pRotation;
-		trans.translation = pPosition;
-		entitySpawnerEcsManager->AddTransformComp(trans, ID);
+		prefab.Add(Texture{ pDiffuse, pNormal, L"" });
 
 		//SphereCollider component
-		SphereCollider sphere{ pRadius, pCollisionMask, pIgnoreCollisionMask };
-		entitySpawnerEcsManager->AddSphereColliderComp(sphere, ID);
+		prefab.Add(SphereCollider{ pRadius, pCollisionMask, pIgnoreCollisionMask });
 
 		//Velocity component
 		Velocity velocity{};
 		velocity.maxSpeed = 50;
-		entitySpawnerEcsManager->AddVelocityComp(velocity, ID);
+		prefab.Add(velocity);
 
-		return ID;
+		return prefab;
+	}
+
+	/// <summary>
+	///
+	/// </summary>
+	/// <param name="pPosition"></param>
+	/// <param name="pScale"></param>
+	/// <param name="pRotation"></param>
+	/// <param name="pRadius"></param>
+	/// <param name="pIgnoreCollisionMask"></param>
+	/// <param name="pDiffuse"></param>
+	/// <param name="pNormal"></param>
+	/// <returns></returns>
+	static EntityHandle SpawnAsteroid(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const float& pRadius,
+		const int pIgnoreCollisionMask, const int pCollisionMask, const std::wstring& pDiffuse, const std::wstring& pNormal)
+	{
+		Prefab prefab = AsteroidPrefab(pRadius, pIgnoreCollisionMask, pCollisionMask, pDiffuse, pNormal);
+
+		//Transform component
+		Transform trans{};
+		trans.scale = pScale;
+		trans.rotation = pRotation;
+		trans.translation = pPosition;
+		prefab.Add(trans);
+
+		return entitySpawnerEcsManager->Instantiate(prefab, 1).front();
 	}
 
-	static int SpawnLaserGun(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const std::wstring& pDiffuse,
+	static EntityHandle SpawnLaserGun(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const std::wstring& pDiffuse,
 		const std::wstring& pNormal, const float& pMaxSpeed)
 	{
-		int ID = entitySpawnerEcsManager->CreateEntity();
+		EntityHandle ID = entitySpawnerEcsManager->CreateEntity();
 
 		//Geometry component
 		Geometry geo{ L"laser_gun.obj" };
@@ -212,10 +231,10 @@ namespace EntitySpawner
 		return ID;
 	}
 
-	static int SpawnCamera(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const int pFOV,
+	static EntityHandle SpawnCamera(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const int pFOV,
 		const int pNear, const int pFar, const float& pMaxSpeed)
 	{
-		int ID = entitySpawnerEcsManager->CreateEntity();
+		EntityHandle ID = entitySpawnerEcsManager->CreateEntity();
 
 		//Camera component
 		Camera cam{ pFOV, pNear, pFar, std::vector<int>(), false };
@@ -236,10 +255,10 @@ namespace EntitySpawner
 		return ID;
 	}
 
-	static int SpawnPlayer(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const int pFOV,
+	static EntityHandle SpawnPlayer(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const int pFOV,
 		const int pNear, const int pFar, const float& pMaxSpeed, const KodeboldsMath::Vector3& pBoxMin, const KodeboldsMath::Vector3& pBoxMax, const int pCollisionMask, const int pIgnoreCollisionMask)
 	{
-		int ID = entitySpawnerEcsManager->CreateEntity();
+		EntityHandle ID = entitySpawnerEcsManager->CreateEntity();
 
 		//Camera component
 		Camera cam{ pFOV, pNear, pFar, std::vector<int>(0), false };
@@ -268,10 +287,29 @@ namespace EntitySpawner
 		return ID;
 	}
 
-	static int SpawnEngine(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const float& pMaxSpeed,
+	/// <summary>
+	/// Attaches the given entity to a parent, the transform system then keeps it at the given offset and rotation relative to the parent
+	/// The child is moved by its parent, so any velocity or gravity it was spawned with is removed
+	/// </summary>
+	/// <param name="pChild">Entity to attach</param>
+	/// <param name="pParent">Entity the child is attached to</param>
+	/// <param name="pPosition">Position of the child relative to the parent</param>
+	/// <param name="pRotation">Rotation of the child relative to the parent</param>
+	static void AttachToParent(const EntityHandle pChild, const EntityHandle pParent, const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pRotation)
+	{
+		entitySpawnerEcsManager->RemoveVelocityComp(pChild);
+		entitySpawnerEcsManager->RemoveGravityComp(pChild);
+
+		//Parent component
+		const KodeboldsMath::Matrix4 localTransform = KodeboldsMath::TranslationMatrix(pPosition)
+			* KodeboldsMath::RotationMatrixX(pRotation.X) * KodeboldsMath::RotationMatrixY(pRotation.Y) * KodeboldsMath::RotationMatrixZ(pRotation.Z);
+		entitySpawnerEcsManager->AddParentComp(Parent{ pParent, localTransform }, pChild);
+	}
+
+	static EntityHandle SpawnEngine(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const float& pMaxSpeed,
 		const std::wstring& pDiffuse, const std::wstring& pNormal)
 	{
-		int ID = entitySpawnerEcsManager->CreateEntity();
+		EntityHandle ID = entitySpawnerEcsManager->CreateEntity();
 
 		//Geometry component
 		Geometry geo{ L"quad100.obj" };
@@ -300,10 +338,10 @@ namespace EntitySpawner
 		return ID;
 	}
 
-	static int SpawnPlanetSurface(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const std::wstring& pDiffuse, 
+	static EntityHandle SpawnPlanetSurface(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation, const std::wstring& pDiffuse, 
 		const std::wstring& pNormal)
 	{
-		int ID = entitySpawnerEcsManager->CreateEntity();
+		EntityHandle ID = entitySpawnerEcsManager->CreateEntity();
 
 		//Geometry component
 		Geometry geo{ L"planet.obj" };
@@ -331,9 +369,9 @@ namespace EntitySpawner
 		return ID;
 	}
 
-	static int SpawnSun(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation)
+	static EntityHandle SpawnSun(const KodeboldsMath::Vector4& pPosition, const KodeboldsMath::Vector4& pScale, const KodeboldsMath::Vector4& pRotation)
 	{
-		int ID = entitySpawnerEcsManager->CreateEntity();
+		EntityHandle ID = entitySpawnerEcsManager->CreateEntity();
 
 		//Geometry component
 		Geometry geo{ L"sun.obj" };
@@ -356,9 +394,9 @@ namespace EntitySpawner
 		return ID;
 	}
 
-	static int SpawnSkyBox()
+	static EntityHandle SpawnSkyBox()
 	{
-		int ID = entitySpawnerEcsManager->CreateEntity();
+		EntityHandle ID = entitySpawnerEcsManager->CreateEntity();
 
 		//Geometry component
 		Geometry geom{ L"cube.obj" };
@@ -15,15 +15,13 @@ private:
 
 	int mPlayerCount;
 	int mPlayerNumber;
-	std::queue<int> mNewBullets;
-
-	void RotateAroundPoint(const int pEntity, const KodeboldsMath::Vector4& pAxis, const KodeboldsMath::Vector4& pPoint, const float& pAngle);
+	std::queue<EntityHandle> mNewBullets;
 
 public:
 	GameNetworking();
 	~GameNetworking();
 
-	void ProcessMessages();
+	void ProcessMessages(const int pLaserPool);
 	const int PlayerNumber();
-	std::queue<int>& NewBullets();
+	std::queue<EntityHandle>& NewBullets();
 };
\ No newline at end of file
@@ -35,26 +35,26 @@ private:
 	GAME_STATE mGameState = GAME_STATE::LOADING;
 	int mPlayerNumber;
 
-	int mActivePlayer;
-	int mActivePlayerGun;
-	int mActivePlayerShip;
-	int mActivePlayerShipCam;
-	int mActivePlayerShipEngine;
-	int mActiveCamera;
-
-	int mPlayer;
-	int mPlayerGun;
-	int mPlayerShip;
-	int mPlayerShipCam;
-	int mPlayerShipEngine;
-	int mCamera;
-
-	int mPlayer2;
-	int mPlayerGun2;
-	int mPlayerShip2;
-	int mPlayerShipCam2;
-	int mPlayerShipEngine2;
-	int mCamera2;
+	EntityHandle mActivePlayer;
+	EntityHandle mActivePlayerGun;
+	EntityHandle mActivePlayerShip;
+	EntityHandle mActivePlayerShipCam;
+	EntityHandle mActivePlayerShipEngine;
+	EntityHandle mActiveCamera;
+
+	EntityHandle mPlayer;
+	EntityHandle mPlayerGun;
+	EntityHandle mPlayerShip;
+	EntityHandle mPlayerShipCam;
+	EntityHandle mPlayerShipEngine;
+	EntityHandle mCamera;
+
+	EntityHandle mPlayer2;
+	EntityHandle mPlayerGun2;
+	EntityHandle mPlayerShip2;
+	EntityHandle mPlayerShipCam2;
+	EntityHandle mPlayerShipEngine2;
+	EntityHandle mCamera2;
 
 	float mPlayerSpeed;
 	float mPlayerJumpSpeed;
@@ -62,20 +62,21 @@ private:
 	float mCameraSpeed;
 	float mRotationSpeed;
 
-	int mGravityAsteroid1;
-	int mGravityAsteroid2;
+	EntityHandle mGravityAsteroid1;
+	EntityHandle mGravityAsteroid2;
 
-	int mSunLight;
-	int mSun;
+	EntityHandle mSunLight;
+	EntityHandle mSun;
 
-	int mActiveCam;
+	EntityHandle mActiveCam;
 
 	KodeboldsMath::Vector4 mPlayerShipStartPos;
 	KodeboldsMath::Vector4 mPlayerStartPos;
 	KodeboldsMath::Vector4 mPlayerShipStartPos2;
 	KodeboldsMath::Vector4 mPlayerStartPos2;
 
-	std::vector<std::pair<int, float>> mBulletLifeTimers;
+	std::vector<std::pair<EntityHandle, float>> mBulletLifeTimers;
+	int mLaserPool = -1;
 	float mRateOfFire;
 	float mTimeSinceLastFire;
 
@@ -85,7 +86,7 @@ private:
 	void Movement();
 	void Rotation();
 	void Shooting();
-	void RotateAroundPoint(const int pEntity, const KodeboldsMath::Vector4& pAxis, const KodeboldsMath::Vector4& pPoint, const float& pAngle);
+	void TrackBullet(const EntityHandle pLaser);
 
 	// Game Assets
 	Sprite* mCrosshair;
@@ -25,7 +25,7 @@ private:
 	std::shared_ptr<ResourceManager> resourceManager = ResourceManager::Instance();
 
 
-	int mMenuMusic;
+	EntityHandle mMenuMusic;
 	Quad* mBackgroundOverlay = nullptr;
 
 	Quad* mOverlay = nullptr;
@@ -4,17 +4,24 @@
 #include "CustomCollisionMask.h"
 #include "KodeboldsMath.h"
 #include "EntitySpawner.h"
+#include "CollisionCheckSystem.h"
+#include <unordered_set>
 
 class CollisionResponseSystem : public ISystem
 {
 private:
 	std::shared_ptr<ECSManager> mEcsManager = ECSManager::Instance();
+	std::shared_ptr<const CollisionCheckSystem> mCollisionCheckSystem;
+	unsigned long long mEventCursor;
+	std::unordered_set<EntityHandle> mDestroyedEntities;
+
+	bool Respond(const EntityHandle pEntity, const int pEntityMask, const EntityHandle pCollidedEntity, const int pCollidedEntityMask);
 
 public:
-	CollisionResponseSystem();
+	explicit CollisionResponseSystem(std::shared_ptr<const CollisionCheckSystem> pCollisionCheckSystem);
 	virtual ~CollisionResponseSystem();
 
-	void AssignEntity(const Entity& pEntity) override;
-	void ReAssignEntity(const Entity& pEntity) override;
+	void OnEnter(const Entity& pEntity, const int pMaskIndex) override;
+	void OnExit(const Entity& pEntity, const int pMaskIndex) override;
 	void Process() override;
 };
\ No newline at end of file
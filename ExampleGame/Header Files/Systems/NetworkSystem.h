@@ -41,7 +41,7 @@ public:
 	explicit NetworkSystem();
 	virtual ~NetworkSystem();
 
-	void AssignEntity(const Entity& pEntity) override;
-	void ReAssignEntity(const Entity& pEntity) override;
+	void OnEnter(const Entity& pEntity, const int pMaskIndex) override;
+	void OnExit(const Entity& pEntity, const int pMaskIndex) override;
 	void Process() override;
 };
\ No newline at end of file
@@ -1,20 +1,22 @@
 #pragma once
-#include "ISystem.h"
+#include "IParallelSystem.h"
 #include <algorithm>
 #include "Managers.h"
 
-class RayAABBIntersectionSystem : public ISystem
+class RayAABBIntersectionSystem : public IParallelSystem
 {
 private:
 	std::shared_ptr<ECSManager> mEcsManager = ECSManager::Instance();
 
 	std::vector<Entity> mRays;
 
+	bool Intersect(const BoxCollider& pBox, const Ray& pRay, const KodeboldsMath::Vector3& pInverseRayDir, float& pDistance) const;
+
 public:
 	explicit RayAABBIntersectionSystem();
 	virtual ~RayAABBIntersectionSystem();
 
-	void AssignEntity(const Entity& pEntity) override;
-	void ReAssignEntity(const Entity& pEntity) override;
+	void OnEnter(const Entity& pEntity, const int pMaskIndex) override;
+	void OnExit(const Entity& pEntity, const int pMaskIndex) override;
 	void Process() override;
 };
\ No newline at end of file
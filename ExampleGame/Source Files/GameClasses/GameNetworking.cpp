@@ -2,17 +2,6 @@
 
 using namespace KodeboldsMath;
 
-void GameNetworking::RotateAroundPoint(const int pEntity, const KodeboldsMath::Vector4 & pAxis, const KodeboldsMath::Vector4 & pPoint, const float & pAngle)
-{
-	const float angleInRadians = DegreesToRadians(pAngle);
-
-	auto translateTo = TranslationMatrix(pPoint);
-	auto rotation = RotationMatrixAxis(angleInRadians * mSceneManager->DeltaTime(), pAxis);
-	auto translateBack = TranslationMatrix(pPoint * -1);
-
-	mEcsManager->TransformComp(pEntity)->transform *= translateTo * rotation * translateBack;
-}
-
 /// <summary>
 /// 
 /// </summary>
@@ -31,7 +20,8 @@ GameNetworking::~GameNetworking()
 /// <summary>
 /// 
 /// </summary>
-void GameNetworking::ProcessMessages()
+/// <param name="pLaserPool">Index of the pool lasers fired by the other player are taken from</param>
+void GameNetworking::ProcessMessages(const int pLaserPool)
 {
 	std::queue<std::string> messages = mNetworkManager->ReadMessages();
 	int messageCount = messages.size();
@@ -57,86 +47,85 @@ void GameNetworking::ProcessMessages()
 		//Accelerate player up
 		if (message[0] == 'U' && message[1] != 'R')
 		{
-			int ID = static_cast<int>(message[1]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[1]) - 48);
 			mEcsManager->VelocityComp(ID)->acceleration += Vector4(0, 1, 0, 0) * 20.0f;
 		}
 		//Remove up acceleration
 		if (message[0] == 'U' && message[1] == 'R')
 		{
-			int ID = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 			mEcsManager->VelocityComp(ID)->acceleration -= Vector4(0, 1, 0, 0) * 20.0f;
 		}
 
 		//Accelerate player down
 		if (message[0] == 'D' && message[1] != 'R')
 		{
-			int ID = static_cast<int>(message[1]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[1]) - 48);
 			mEcsManager->VelocityComp(ID)->acceleration += Vector4(0, -1, 0, 0) * 20.0f;
 		}
 		//Remove down acceleration
 		if (message[0] == 'D' && message[1] == 'R')
 		{
-			int ID = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 			mEcsManager->VelocityComp(ID)->acceleration -= Vector4(0, -1, 0, 0) * 20.0f;
 		}
 
 		//Accelerate player right
 		if (message[0] == 'R' && message[1] != 'R')
 		{
-			int ID = static_cast<int>(message[1]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[1]) - 48);
 			mEcsManager->VelocityComp(ID)->acceleration += Vector4(1, 0, 0, 0) * 20.0f;
 		}
 		//Remove right acceleration
 		if (message[0] == 'R' && message[1] == 'R')
 		{
-			int ID = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 			mEcsManager->VelocityComp(ID)->acceleration -= Vector4(1, 0, 0, 0) * 20.0f;
 		}
 
 		//Accelerate player left
 		if (message[0] == 'L' && message[1] != 'R')
 		{
-			int ID = static_cast<int>(message[1]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[1]) - 48);
 			mEcsManager->VelocityComp(ID)->acceleration += Vector4(-1, 0, 0, 0) * 20.0f;
 		}
 		//Remove left acceleration
 		if (message[0] == 'L' && message[1] == 'R')
 		{
-			int ID = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 			mEcsManager->VelocityComp(ID)->acceleration -= Vector4(-1, 0, 0, 0) * 20.0f;
 		}
 
 		//Accelerate player forward
 		if (message[0] == 'F' && message[1] != 'R')
 		{
-			int ID = static_cast<int>(message[1]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[1]) - 48);
 			mEcsManager->VelocityComp(ID)->acceleration += Vector4(0, 0, 1, 0) * 20.0f;
 		}
 		//Remove forward acceleration
 		if (message[0] == 'F' && message[1] == 'R')
 		{
-			int ID = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 			mEcsManager->VelocityComp(ID)->acceleration -= Vector4(0, 0, 1, 0) * 20.0f;
 		}
 
 		//Accelerate player back
 		if (message[0] == 'B' && message[1] != 'R')
 		{
-			int ID = static_cast<int>(message[1]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[1]) - 48);
 			mEcsManager->VelocityComp(ID)->acceleration += Vector4(0, 0, -1, 0) * 20.0f;
 		}
 		//Remove back acceleration
 		if (message[0] == 'B' && message[1] == 'R')
 		{
-			int ID = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 			mEcsManager->VelocityComp(ID)->acceleration -= Vector4(0, 0, -1, 0) * 20.0f;
 		}
 
 		//Rotate ship
 		if (message[0] == 'S' && message[1] == 'R')
 		{
-			int ID = static_cast<int>(message[2]) - 48;
-			int ID2 = static_cast<int>(message[3]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 
 			//Split the message up on the delimiter
 			std::vector<std::string> splitString;
@@ -152,18 +141,15 @@ void GameNetworking::ProcessMessages()
 
 			//Y rotation
 			mEcsManager->TransformComp(ID)->transform *= RotationMatrixAxis(DegreesToRadians(std::stof(splitString[1]) * 10.0f) * mSceneManager->DeltaTime(), Vector4(0, 1, 0, 1));
-			RotateAroundPoint(ID2, Vector4(0, 1, 0, 0), Vector4(0, -40, 75, 0), std::stof(splitString[1]) * 10.0f);
 
 			//X rotation
 			mEcsManager->TransformComp(ID)->transform *= RotationMatrixAxis(DegreesToRadians(std::stof(splitString[2]) * 10.0f) * mSceneManager->DeltaTime(), Vector4(1, 0, 0, 1));
-			RotateAroundPoint(ID2, Vector4(1, 0, 0, 0), Vector4(0, -40, 75, 0), std::stof(splitString[2]) * 10.0f);
 		}
 
 		//Rotate player
 		if (message[0] == 'P' && message[1] == 'R')
 		{
-			int ID = static_cast<int>(message[2]) - 48;
-			int ID2 = static_cast<int>(message[3]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 
 			//Split the message up on the delimiter
 			std::vector<std::string> splitString;
@@ -179,13 +165,12 @@ void GameNetworking::ProcessMessages()
 
 			//Y rotation
 			mEcsManager->TransformComp(ID)->transform *= RotationMatrixAxis(DegreesToRadians(std::stof(splitString[1]) * 10.0f) * mSceneManager->DeltaTime(), Vector4(0, 1, 0, 1));
-			RotateAroundPoint(ID2, Vector4(0, 1, 0, 0), Vector4(0, -40, 75, 0), std::stof(splitString[1]) * 10.0f);
 		}
 
 		//Rotate camera
 		if (message[0] == 'N')
 		{
-			int ID = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 
 			//Split the message up on the delimiter
 			std::vector<std::string> splitString;
@@ -209,17 +194,15 @@ void GameNetworking::ProcessMessages()
 		//Roll left
 		if (message[0] == 'E' && message[1] != 'C')
 		{
-			int ID = static_cast<int>(message[1]) - 48;
-			int ID2 = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[1]) - 48);
 
 			mEcsManager->TransformComp(ID)->transform *= RotationMatrixAxis(DegreesToRadians(2 * -10.0f) * mSceneManager->DeltaTime(), Vector4(0, 0, 1, 1));
-			RotateAroundPoint(ID2, Vector4(0, 0, 1, 0), Vector4(0, -40, 75, 0), 2 * -10.0f);
 		}
 
 		//Roll cam left
 		if (message[0] == 'E' && message[1] == 'C')
 		{
-			int ID = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 
 			mEcsManager->TransformComp(ID)->transform *= RotationMatrixAxis(DegreesToRadians(2 * -10.0f) * mSceneManager->DeltaTime(), Vector4(0, 0, 1, 1));
 		}
@@ -227,17 +210,15 @@ void GameNetworking::ProcessMessages()
 		//Roll right
 		if (message[0] == 'Q' && message[1] != 'C')
 		{
-			int ID = static_cast<int>(message[1]) - 48;
-			int ID2 = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[1]) - 48);
 
 			mEcsManager->TransformComp(ID)->transform *= RotationMatrixAxis(DegreesToRadians(2 * 10.0f) * mSceneManager->DeltaTime(), Vector4(0, 0, 1, 1));
-			RotateAroundPoint(ID2, Vector4(0, 0, 1, 0), Vector4(0, -40, 75, 0), 2 * 10.0f);
 		}
 
 		//Roll cam right
 		if (message[0] == 'Q' && message[1] == 'C')
 		{
-			int ID = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 
 			mEcsManager->TransformComp(ID)->transform *= RotationMatrixAxis(DegreesToRadians(2 * 10.0f) * mSceneManager->DeltaTime(), Vector4(0, 0, 1, 1));
 		}
@@ -245,24 +226,22 @@ void GameNetworking::ProcessMessages()
 		//Player jump message
 		if (message[0] == 'J')
 		{
-			int ID = static_cast<int>(message[1]) - 48;
-			int ID2 = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[1]) - 48);
 
 			mEcsManager->VelocityComp(ID)->velocity += Vector4(0, 1, 0, 0) * 20.0f;
-			mEcsManager->VelocityComp(ID2)->velocity += Vector4(0, 1, 0, 0) * 20.0f;
 		}
 
 		//Ship fire message
 		if (message[0] == 'Z')
 		{
-			int ID = static_cast<int>(message[1]) - 48;
-			int ID2 = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[1]) - 48);
+			const EntityHandle ID2 = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 
 			//Set spawn location and calculate firing direction
 			Vector4 leftLaser = mEcsManager->TransformComp(ID)->translation + ((mEcsManager->TransformComp(ID)->right * -23) + (mEcsManager->TransformComp(ID)->up * 5));
 			Vector4 directionLeft = leftLaser - Vector4(mEcsManager->TransformComp(ID2)->translation + mEcsManager->TransformComp(ID2)->forward * 300);
 
-			int laser = EntitySpawner::SpawnLaser(leftLaser, Vector4(1, 1, 1, 1), Vector4(0, 0, 0, 1), Vector4(1, 0, 0, 1), directionLeft * -40, 120,
+			EntityHandle laser = EntitySpawner::SpawnLaser(pLaserPool, leftLaser, Vector4(1, 1, 1, 1), Vector4(0, 0, 0, 1), Vector4(1, 0, 0, 1), directionLeft * -40, 120,
 				2, CustomCollisionMask::SHIP_LASER, CustomCollisionMask::SHIP_LASER | CustomCollisionMask::SHIP, 50, L"laser.wav");
 
 			mNewBullets.push(laser);
@@ -271,7 +250,7 @@ void GameNetworking::ProcessMessages()
 			Vector4 rightLaser = mEcsManager->TransformComp(ID)->translation + ((mEcsManager->TransformComp(ID)->right * 23) + (mEcsManager->TransformComp(ID)->up * 5));
 			Vector4 directionRight = rightLaser - Vector4(mEcsManager->TransformComp(ID2)->translation + mEcsManager->TransformComp(ID2)->forward * 300);
 
-			laser = EntitySpawner::SpawnLaser(rightLaser, Vector4(1, 1, 1, 1), Vector4(0, 0, 0, 1), Vector4(1, 0, 0, 1), directionRight * -40, 120,
+			laser = EntitySpawner::SpawnLaser(pLaserPool, rightLaser, Vector4(1, 1, 1, 1), Vector4(0, 0, 0, 1), Vector4(1, 0, 0, 1), directionRight * -40, 120,
 				2, CustomCollisionMask::SHIP_LASER, CustomCollisionMask::SHIP_LASER | CustomCollisionMask::SHIP, 50, L"laser.wav");
 
 			mNewBullets.push(laser);
@@ -280,14 +259,15 @@ void GameNetworking::ProcessMessages()
 		//Player fire message
 		if (message[0] == 'X')
 		{
-			int ID = static_cast<int>(message[1]) - 48;
-			int ID2 = static_cast<int>(message[2]) - 48;
+			//The gun is attached to the player that fired it
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[1]) - 48);
+			const EntityHandle ID2 = mEcsManager->Read<Parent>(ID)->parent;
 
 			//Set spawn location and calculate firing direction
 			Vector4 gunBarrel = mEcsManager->TransformComp(ID)->translation + (mEcsManager->TransformComp(ID)->forward * -2);
 			Vector4 direction = gunBarrel - Vector4(mEcsManager->TransformComp(ID2)->translation + mEcsManager->TransformComp(ID2)->forward * 25);
 
-			int laser = EntitySpawner::SpawnLaser(gunBarrel, Vector4(0.1f, 0.1f, 0.1f, 1), Vector4(0, 0, 0, 1), Vector4(1, 0, 0, 1), direction * -40, 120,
+			EntityHandle laser = EntitySpawner::SpawnLaser(pLaserPool, gunBarrel, Vector4(0.1f, 0.1f, 0.1f, 1), Vector4(0, 0, 0, 1), Vector4(1, 0, 0, 1), direction * -40, 120,
 				2, CustomCollisionMask::GUN_LASER, CustomCollisionMask::GUN_LASER | CustomCollisionMask::PLAYER, 50, L"laser.wav");
 
 			mNewBullets.push(laser);
@@ -308,14 +288,14 @@ void GameNetworking::ProcessMessages()
 				splitString.push_back(message.substr(start, end - start));
 			}
 
-			mEcsManager->AddGravityComp(Gravity{}, std::stoi(splitString[1]));
-			mEcsManager->AddGravityComp(Gravity{}, std::stoi(splitString[2]));
+			mEcsManager->AddGravityComp(Gravity{}, mEcsManager->Handle(std::stoi(splitString[1])));
+			mEcsManager->AddGravityComp(Gravity{}, mEcsManager->Handle(std::stoi(splitString[2])));
 		}
 
 		//Freeze player message
 		if (message[0] == 'F' && message[1] == 'Z')
 		{
-			int ID = static_cast<int>(message[2]) - 48;
+			const EntityHandle ID = mEcsManager->Handle(static_cast<int>(message[2]) - 48);
 
 			mEcsManager->VelocityComp(ID)->velocity = Vector4(0, 0, 0, 1);
 			mEcsManager->VelocityComp(ID)->acceleration = Vector4(0, 0, 0, 1);
@@ -330,7 +310,7 @@ const int GameNetworking::PlayerNumber()
 	return mPlayerNumber;
 }
 
-std::queue<int>& GameNetworking::NewBullets()
+std::queue<EntityHandle>& GameNetworking::NewBullets()
 {
 	return mNewBullets;
 }
@@ -15,26 +15,22 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration += Vector4(0, 0, 1, 0) * mShipSpeed;
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration += Vector4(0, 0, 1, 0) * mShipSpeed;
 
-			mNetworkManager->AddMessage("F" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("F" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("F" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If player cam is active, move player cam
 		if (mEcsManager->CameraComp(mActivePlayer)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayer)->acceleration += Vector4(0, 0, 1, 0) * mPlayerSpeed;
-			mEcsManager->VelocityComp(mActivePlayerGun)->acceleration += Vector4(0, 0, -1, 0) * mPlayerSpeed;
 
-			mNetworkManager->AddMessage("F" + std::to_string(mActivePlayer));
-			mNetworkManager->AddMessage("B" + std::to_string(mActivePlayerGun));
+			mNetworkManager->AddMessage("F" + std::to_string(mActivePlayer.Index()));
 		}
 		//If free cam is active, move free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
 		{
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration += Vector4(0, 0, 1, 0) * mCameraSpeed;
 
-			mNetworkManager->AddMessage("F" + std::to_string(mActiveCamera));
+			mNetworkManager->AddMessage("F" + std::to_string(mActiveCamera.Index()));
 		}
 	}
 	else if (mInputManager->KeyUp(KEYS::KEY_W))
@@ -43,26 +39,22 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration -= Vector4(0, 0, 1, 0) * mShipSpeed;
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration -= Vector4(0, 0, 1, 0) * mShipSpeed;
 
-			mNetworkManager->AddMessage("FR" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("FR" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("FR" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If player cam is active, move player cam
 		if (mEcsManager->CameraComp(mActivePlayer)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayer)->acceleration -= Vector4(0, 0, 1, 0) * mPlayerSpeed;
-			mEcsManager->VelocityComp(mActivePlayerGun)->acceleration -= Vector4(0, 0, -1, 0) * mPlayerSpeed;
 
-			mNetworkManager->AddMessage("FR" + std::to_string(mActivePlayer));
-			mNetworkManager->AddMessage("BR" + std::to_string(mActivePlayerGun));
+			mNetworkManager->AddMessage("FR" + std::to_string(mActivePlayer.Index()));
 		}
 		//If free cam is active, move free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
 		{
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration -= Vector4(0, 0, 1, 0) * mCameraSpeed;
 
-			mNetworkManager->AddMessage("FR" + std::to_string(mActiveCamera));
+			mNetworkManager->AddMessage("FR" + std::to_string(mActiveCamera.Index()));
 		}
 	}
 
@@ -73,26 +65,22 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration += Vector4(0, 0, 1, 0) * -mShipSpeed;
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration += Vector4(0, 0, 1, 0) * -mShipSpeed;
 
-			mNetworkManager->AddMessage("B" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("B" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("B" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If player cam is active, move player cam
 		if (mEcsManager->CameraComp(mActivePlayer)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayer)->acceleration += Vector4(0, 0, 1, 0) * -mPlayerSpeed;
-			mEcsManager->VelocityComp(mActivePlayerGun)->acceleration += Vector4(0, 0, -1, 0) * -mPlayerSpeed;
 
-			mNetworkManager->AddMessage("B" + std::to_string(mActivePlayer));
-			mNetworkManager->AddMessage("F" + std::to_string(mActivePlayerGun));
+			mNetworkManager->AddMessage("B" + std::to_string(mActivePlayer.Index()));
 		}
 		//If free cam is active, move free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
 		{
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration += Vector4(0, 0, 1, 0) * -mCameraSpeed;
 
-			mNetworkManager->AddMessage("B" + std::to_string(mActiveCamera));
+			mNetworkManager->AddMessage("B" + std::to_string(mActiveCamera.Index()));
 		}
 	}
 	else if (mInputManager->KeyUp(KEYS::KEY_S))
@@ -101,26 +89,22 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration -= Vector4(0, 0, 1, 0) * -mShipSpeed;
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration -= Vector4(0, 0, 1, 0) * -mShipSpeed;
 
-			mNetworkManager->AddMessage("BR" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("BR" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("BR" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If player cam is active, move player cam
 		if (mEcsManager->CameraComp(mActivePlayer)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayer)->acceleration -= Vector4(0, 0, 1, 0) * -mPlayerSpeed;
-			mEcsManager->VelocityComp(mActivePlayerGun)->acceleration -= Vector4(0, 0, -1, 0) * -mPlayerSpeed;
 
-			mNetworkManager->AddMessage("BR" + std::to_string(mActivePlayer));
-			mNetworkManager->AddMessage("FR" + std::to_string(mActivePlayerGun));
+			mNetworkManager->AddMessage("BR" + std::to_string(mActivePlayer.Index()));
 		}
 		//If free cam is active, move free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
 		{
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration -= Vector4(0, 0, 1, 0) * -mCameraSpeed;
 
-			mNetworkManager->AddMessage("BR" + std::to_string(mActiveCamera));
+			mNetworkManager->AddMessage("BR" + std::to_string(mActiveCamera.Index()));
 		}
 	}
 
@@ -131,26 +115,22 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration += Vector4(1, 0, 0, 0) * -mShipSpeed;
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration += Vector4(1, 0, 0, 0) * -mShipSpeed;
 
-			mNetworkManager->AddMessage("L" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("L" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("L" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If player cam is active, move player cam
 		if (mEcsManager->CameraComp(mActivePlayer)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayer)->acceleration += Vector4(1, 0, 0, 0) * -mPlayerSpeed;
-			mEcsManager->VelocityComp(mActivePlayerGun)->acceleration += Vector4(-1, 0, 0, 0) * -mPlayerSpeed;
 
-			mNetworkManager->AddMessage("L" + std::to_string(mActivePlayer));
-			mNetworkManager->AddMessage("R" + std::to_string(mActivePlayerGun));
+			mNetworkManager->AddMessage("L" + std::to_string(mActivePlayer.Index()));
 		}
 		//If free cam is active, move free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
 		{
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration += Vector4(1, 0, 0, 0) * -mCameraSpeed;
 
-			mNetworkManager->AddMessage("L" + std::to_string(mActiveCamera));
+			mNetworkManager->AddMessage("L" + std::to_string(mActiveCamera.Index()));
 		}
 	}
 	else if (mInputManager->KeyUp(KEYS::KEY_A))
@@ -159,26 +139,22 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration -= Vector4(1, 0, 0, 0) * -mShipSpeed;
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration -= Vector4(1, 0, 0, 0) * -mShipSpeed;
 
-			mNetworkManager->AddMessage("LR" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("LR" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("LR" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If player cam is active, move player cam
 		if (mEcsManager->CameraComp(mActivePlayer)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayer)->acceleration -= Vector4(1, 0, 0, 0) * -mPlayerSpeed;
-			mEcsManager->VelocityComp(mActivePlayerGun)->acceleration -= Vector4(-1, 0, 0, 0) * -mPlayerSpeed;
 
-			mNetworkManager->AddMessage("LR" + std::to_string(mActivePlayer));
-			mNetworkManager->AddMessage("RR" + std::to_string(mActivePlayerGun));
+			mNetworkManager->AddMessage("LR" + std::to_string(mActivePlayer.Index()));
 		}
 		//If free cam is active, move free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
 		{
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration -= Vector4(1, 0, 0, 0) * -mCameraSpeed;
 
-			mNetworkManager->AddMessage("LR" + std::to_string(mActiveCamera));
+			mNetworkManager->AddMessage("LR" + std::to_string(mActiveCamera.Index()));
 		}
 	}
 
@@ -189,26 +165,22 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration += Vector4(1, 0, 0, 0) * mShipSpeed;
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration += Vector4(1, 0, 0, 0) * mShipSpeed;
 
-			mNetworkManager->AddMessage("R" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("R" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("R" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If player cam is active, move player cam
 		if (mEcsManager->CameraComp(mActivePlayer)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayer)->acceleration += Vector4(1, 0, 0, 0) * mPlayerSpeed;
-			mEcsManager->VelocityComp(mActivePlayerGun)->acceleration += Vector4(-1, 0, 0, 0) * mPlayerSpeed;
 
-			mNetworkManager->AddMessage("R" + std::to_string(mActivePlayer));
-			mNetworkManager->AddMessage("L" + std::to_string(mActivePlayerGun));
+			mNetworkManager->AddMessage("R" + std::to_string(mActivePlayer.Index()));
 		}
 		//If free cam is active, move free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
 		{
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration += Vector4(1, 0, 0, 0) * mCameraSpeed;
 
-			mNetworkManager->AddMessage("R" + std::to_string(mActiveCamera));
+			mNetworkManager->AddMessage("R" + std::to_string(mActiveCamera.Index()));
 		}
 	}
 	else if (mInputManager->KeyUp(KEYS::KEY_D))
@@ -217,26 +189,22 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration -= Vector4(1, 0, 0, 0) * mShipSpeed;
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration -= Vector4(1, 0, 0, 0) * mShipSpeed;
 
-			mNetworkManager->AddMessage("RR" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("RR" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("RR" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If player cam is active, move player cam
 		if (mEcsManager->CameraComp(mActivePlayer)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayer)->acceleration -= Vector4(1, 0, 0, 0) * mPlayerSpeed;
-			mEcsManager->VelocityComp(mActivePlayerGun)->acceleration -= Vector4(-1, 0, 0, 0) * mPlayerSpeed;
 
-			mNetworkManager->AddMessage("RR" + std::to_string(mActivePlayer));
-			mNetworkManager->AddMessage("LR" + std::to_string(mActivePlayerGun));
+			mNetworkManager->AddMessage("RR" + std::to_string(mActivePlayer.Index()));
 		}
 		//If free cam is active, move free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
 		{
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration -= Vector4(1, 0, 0, 0) * mCameraSpeed;
 
-			mNetworkManager->AddMessage("RR" + std::to_string(mActiveCamera));
+			mNetworkManager->AddMessage("RR" + std::to_string(mActiveCamera.Index()));
 		}
 	}
 
@@ -247,26 +215,22 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration += Vector4(0, 1, 0, 0) * mShipSpeed;
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration += Vector4(0, 1, 0, 0) * mShipSpeed;
 
-			mNetworkManager->AddMessage("U" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("U" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("U" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If player cam is active, move player cam
 		if (mEcsManager->CameraComp(mActivePlayer)->active && mPlayerIsGrounded)
 		{
 			mEcsManager->VelocityComp(mActivePlayer)->velocity += Vector4(0, 1, 0, 0) * mPlayerJumpSpeed;
-			mEcsManager->VelocityComp(mActivePlayerGun)->velocity += Vector4(0, 1, 0, 0) * mPlayerJumpSpeed;
 
-			mNetworkManager->AddMessage("J" + std::to_string(mActivePlayer) + std::to_string(mActivePlayerGun));
+			mNetworkManager->AddMessage("J" + std::to_string(mActivePlayer.Index()));
 		}
 		//If free cam is active, move free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
 		{
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration += Vector4(0, 1, 0, 0) * mCameraSpeed;
 
-			mNetworkManager->AddMessage("U" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("U" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("U" + std::to_string(mActivePlayerShip.Index()));
 		}
 	}
 	else if (mInputManager->KeyUp(KEYS::KEY_SPACE))
@@ -275,17 +239,15 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration -= Vector4(0, 1, 0, 0) * mShipSpeed;
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration -= Vector4(0, 1, 0, 0) * mShipSpeed;
 
-			mNetworkManager->AddMessage("UR" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("UR" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("UR" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If free cam is active, move free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
 		{
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration -= Vector4(0, 1, 0, 0) * mCameraSpeed;
 
-			mNetworkManager->AddMessage("UR" + std::to_string(mActiveCamera));
+			mNetworkManager->AddMessage("UR" + std::to_string(mActiveCamera.Index()));
 		}
 	}
 
@@ -296,17 +258,15 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration += Vector4(0, 1, 0, 0) * -mShipSpeed;
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration += Vector4(0, 1, 0, 0) * -mShipSpeed;
 
-			mNetworkManager->AddMessage("D" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("D" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("D" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If free cam is active, move free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
 		{
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration += Vector4(0, 1, 0, 0) * -mCameraSpeed;
 
-			mNetworkManager->AddMessage("D" + std::to_string(mActiveCamera));
+			mNetworkManager->AddMessage("D" + std::to_string(mActiveCamera.Index()));
 		}
 	}
 	else if (mInputManager->KeyUp(KEYS::KEY_LEFT_CTRL))
@@ -315,17 +275,15 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration -= Vector4(0, 1, 0, 0) * -mShipSpeed;
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration -= Vector4(0, 1, 0, 0) * -mShipSpeed;
 
-			mNetworkManager->AddMessage("DR" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("DR" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("DR" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If free cam is active, move free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
 		{
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration -= Vector4(0, 1, 0, 0) * -mCameraSpeed;
 
-			mNetworkManager->AddMessage("DR" + std::to_string(mActiveCamera));
+			mNetworkManager->AddMessage("DR" + std::to_string(mActiveCamera.Index()));
 		}
 	}
 
@@ -336,23 +294,17 @@ void GameScene::Movement()
 		if (mEcsManager->CameraComp(mActivePlayerShipCam)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayerShip)->velocity = Vector4(0, 0, 0, 1);
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->velocity = Vector4(0, 0, 0, 1);
 			mEcsManager->VelocityComp(mActivePlayerShip)->acceleration = Vector4(0, 0, 0, 1);
-			mEcsManager->VelocityComp(mActivePlayerShipCam)->acceleration = Vector4(0, 0, 0, 1);
 
-			mNetworkManager->AddMessage("FZ" + std::to_string(mActivePlayerShip));
-			mNetworkManager->AddMessage("FZ" + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("FZ" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//If player cam is active, freeze player cam
 		if (mEcsManager->CameraComp(mActivePlayer)->active)
 		{
 			mEcsManager->VelocityComp(mActivePlayer)->velocity = Vector4(0, 0, 0, 1);
-			mEcsManager->VelocityComp(mActivePlayerGun)->velocity = Vector4(0, 0, 0, 1);
 			mEcsManager->VelocityComp(mActivePlayer)->acceleration = Vector4(0, 0, 0, 1);
-			mEcsManager->VelocityComp(mActivePlayerGun)->acceleration = Vector4(0, 0, 0, 1);
 
-			mNetworkManager->AddMessage("FZ" + std::to_string(mActivePlayer));
-			mNetworkManager->AddMessage("FZ" + std::to_string(mActivePlayerGun));
+			mNetworkManager->AddMessage("FZ" + std::to_string(mActivePlayer.Index()));
 		}
 		//If free cam is active, freeze free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
@@ -360,7 +312,7 @@ void GameScene::Movement()
 			mEcsManager->VelocityComp(mActiveCamera)->velocity = Vector4(0, 0, 0, 1);
 			mEcsManager->VelocityComp(mActiveCamera)->acceleration = Vector4(0, 0, 0, 1);
 
-			mNetworkManager->AddMessage("FZ" + std::to_string(mActiveCamera));
+			mNetworkManager->AddMessage("FZ" + std::to_string(mActiveCamera.Index()));
 		}
 	}
 }
@@ -382,22 +334,19 @@ void GameScene::Rotation()
 		{
 			//Y rotation
 			mEcsManager->TransformComp(mActivePlayerShip)->transform *= RotationMatrixAxis(DegreesToRadians(deltaX * mRotationSpeed) * mSceneManager->DeltaTime(), Vector4(0, 1, 0, 1));
-			RotateAroundPoint(mActivePlayerShipCam, Vector4(0, 1, 0, 0), Vector4(0, -40, 75, 0), deltaX * mRotationSpeed);
 
 			//X rotation
 			mEcsManager->TransformComp(mActivePlayerShip)->transform *= RotationMatrixAxis(DegreesToRadians(deltaY * mRotationSpeed) * mSceneManager->DeltaTime(), Vector4(1, 0, 0, 1));
-			RotateAroundPoint(mActivePlayerShipCam, Vector4(1, 0, 0, 0), Vector4(0, -40, 75, 0), deltaY * mRotationSpeed);
 
-			mNetworkManager->AddMessage("SR" + std::to_string(mActivePlayerShip) + std::to_string(mActivePlayerShipCam) + ":" + std::to_string(deltaX) + ":" + std::to_string(deltaY));
+			mNetworkManager->AddMessage("SR" + std::to_string(mActivePlayerShip.Index()) + ":" + std::to_string(deltaX) + ":" + std::to_string(deltaY));
 		}
 		//If player cam is active, rotate player
 		if (mEcsManager->CameraComp(mPlayer)->active)
 		{
 			//Y rotation
 			mEcsManager->TransformComp(mActivePlayer)->transform *= RotationMatrixAxis(DegreesToRadians(deltaX * mRotationSpeed) * mSceneManager->DeltaTime(), Vector4(0, 1, 0, 1));
-			RotateAroundPoint(mActivePlayerGun, Vector4(0, 1, 0, 0), Vector4(1, -1, 2.0f, 0), deltaX * mRotationSpeed);
 
-			mNetworkManager->AddMessage("PR" + std::to_string(mActivePlayer) + std::to_string(mActivePlayerGun) + ":" + std::to_string(deltaX));
+			mNetworkManager->AddMessage("PR" + std::to_string(mActivePlayer.Index()) + ":" + std::to_string(deltaX));
 		}
 		//If free cam is active, rotate free cam
 		if (mEcsManager->CameraComp(mActiveCamera)->active)
@@ -408,7 +357,7 @@ void GameScene::Rotation()
 			//X rotation
 			mEcsManager->TransformComp(mActiveCamera)->transform *= RotationMatrixAxis(DegreesToRadians(deltaY * mRotationSpeed) * mSceneManager->DeltaTime(), Vector4(1, 0, 0, 1));
 
-			mNetworkManager->AddMessage("N" + std::to_string(mActiveCamera) + ":" + std::to_string(deltaX) + ":" + std::to_string(deltaY));
+			mNetworkManager->AddMessage("N" + std::to_string(mActiveCamera.Index()) + ":" + std::to_string(deltaX) + ":" + std::to_string(deltaY));
 		}
 	}
 
@@ -420,17 +369,15 @@ void GameScene::Rotation()
 		if (mInputManager->KeyHeld(KEYS::KEY_Q))
 		{
 			mEcsManager->TransformComp(mActivePlayerShip)->transform *= RotationMatrixAxis(DegreesToRadians(2 * mRotationSpeed) * mSceneManager->DeltaTime(), Vector4(0, 0, 1, 1));
-			RotateAroundPoint(mActivePlayerShipCam, Vector4(0, 0, 1, 0), Vector4(0, -40, 75, 0), 2 * mRotationSpeed);
 
-			mNetworkManager->AddMessage("Q" + std::to_string(mActivePlayerShip) + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("Q" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//Left roll
 		if (mInputManager->KeyHeld(KEYS::KEY_E))
 		{
 			mEcsManager->TransformComp(mActivePlayerShip)->transform *= RotationMatrixAxis(DegreesToRadians(2 * -mRotationSpeed) * mSceneManager->DeltaTime(), Vector4(0, 0, 1, 1));
-			RotateAroundPoint(mActivePlayerShipCam, Vector4(0, 0, 1, 0), Vector4(0, -40, 75, 0), 2 * -mRotationSpeed);
 
-			mNetworkManager->AddMessage("E" + std::to_string(mActivePlayerShip) + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("E" + std::to_string(mActivePlayerShip.Index()));
 		}
 	}
 	//If free cam is active, rotate free cam
@@ -441,14 +388,14 @@ void GameScene::Rotation()
 		{
 			mEcsManager->TransformComp(mActiveCamera)->transform *= RotationMatrixAxis(DegreesToRadians(2 * mRotationSpeed) * mSceneManager->DeltaTime(), Vector4(0, 0, 1, 1));
 
-			mNetworkManager->AddMessage("QC" + std::to_string(mActivePlayerShip));
+			mNetworkManager->AddMessage("QC" + std::to_string(mActivePlayerShip.Index()));
 		}
 		//Left roll
 		if (mInputManager->KeyHeld(KEYS::KEY_E))
 		{
 			mEcsManager->TransformComp(mActiveCamera)->transform *= RotationMatrixAxis(DegreesToRadians(2 * -mRotationSpeed) * mSceneManager->DeltaTime(), Vector4(0, 0, 1, 1));
 
-			mNetworkManager->AddMessage("EC" + std::to_string(mActivePlayerShip));
+			mNetworkManager->AddMessage("EC" + std::to_string(mActivePlayerShip.Index()));
 		}
 	}
 }
@@ -470,24 +417,24 @@ void GameScene::Shooting()
 			Vector4 leftLaser = mEcsManager->TransformComp(mActivePlayerShip)->translation + ((mEcsManager->TransformComp(mActivePlayerShip)->right * -23) + (mEcsManager->TransformComp(mActivePlayerShip)->up * 5));
 			Vector4 directionLeft = leftLaser - Vector4(mEcsManager->TransformComp(mActivePlayerShipCam)->translation + mEcsManager->TransformComp(mActivePlayerShipCam)->forward * 300);
 
-			int laser = SpawnLaser(leftLaser, Vector4(1, 1, 1, 1), Vector4(0, 0, 0, 1), Vector4(1, 0, 0, 1), directionLeft * -40, 120,
+			EntityHandle laser = SpawnLaser(mLaserPool, leftLaser, Vector4(1, 1, 1, 1), Vector4(0, 0, 0, 1), Vector4(1, 0, 0, 1), directionLeft * -40, 120,
 				2, CustomCollisionMask::SHIP_LASER, CustomCollisionMask::SHIP_LASER | CustomCollisionMask::SHIP, 50, L"laser.wav");
 
 			//Add laser to life timer list
-			mBulletLifeTimers.push_back(std::make_pair(laser, 0.0f));
+			TrackBullet(laser);
 
 			//Set spawn location and calculate firing direction
 			Vector4 rightLaser = mEcsManager->TransformComp(mActivePlayerShip)->translation + ((mEcsManager->TransformComp(mActivePlayerShip)->right * 23) + (mEcsManager->TransformComp(mActivePlayerShip)->up * 5));
 			Vector4 directionRight = rightLaser - Vector4(mEcsManager->TransformComp(mActivePlayerShipCam)->translation + mEcsManager->TransformComp(mActivePlayerShipCam)->forward * 300);
 
-			laser = SpawnLaser(rightLaser, Vector4(1, 1, 1, 1), Vector4(0, 0, 0, 1), Vector4(1, 0, 0, 1), directionRight * -40, 120,
+			laser = SpawnLaser(mLaserPool, rightLaser, Vector4(1, 1, 1, 1), Vector4(0, 0, 0, 1), Vector4(1, 0, 0, 1), directionRight * -40, 120,
 				2, CustomCollisionMask::SHIP_LASER, CustomCollisionMask::SHIP_LASER | CustomCollisionMask::SHIP, 50, L"laser.wav");
 
 			//Add laser to life timer list
-			mBulletLifeTimers.push_back(std::make_pair(laser, 0.0f));
+			TrackBullet(laser);
 			mTimeSinceLastFire = 0;
 
-			mNetworkManager->AddMessage("Z" + std::to_string(mActivePlayerShip) + std::to_string(mActivePlayerShipCam));
+			mNetworkManager->AddMessage("Z" + std::to_string(mActivePlayerShip.Index()) + std::to_string(mActivePlayerShipCam.Index()));
 		}
 
 		//If player cam is active, fire gun
@@ -497,14 +444,14 @@ void GameScene::Shooting()
 			Vector4 gunBarrel = mEcsManager->TransformComp(mActivePlayerGun)->translation + (mEcsManager->TransformComp(mActivePlayerGun)->forward * -2);
 			Vector4 direction = gunBarrel - Vector4(mEcsManager->TransformComp(mActivePlayer)->translation + mEcsManager->TransformComp(mActivePlayer)->forward * 25);
 
-			int laser = SpawnLaser(gunBarrel, Vector4(0.1f, 0.1f, 0.1f, 1), Vector4(0, 0, 0, 1), Vector4(1, 0, 0, 1), direction * -40, 120,
+			EntityHandle laser = SpawnLaser(mLaserPool, gunBarrel, Vector4(0.1f, 0.1f, 0.1f, 1), Vector4(0, 0, 0, 1), Vector4(1, 0, 0, 1), direction * -40, 120,
 				2, CustomCollisionMask::GUN_LASER, CustomCollisionMask::GUN_LASER | CustomCollisionMask::PLAYER, 50, L"laser.wav");
 
 			//Add laser to life timer list
-			mBulletLifeTimers.push_back(std::make_pair(laser, 0.0f));
+			TrackBullet(laser);
 			mTimeSinceLastFire = 0;
 
-			mNetworkManager->AddMessage("X" + std::to_string(mActivePlayerGun) + std::to_string(mActivePlayer));
+			mNetworkManager->AddMessage("X" + std::to_string(mActivePlayerGun.Index()));
 		}
 	}
 
@@ -513,30 +460,24 @@ void GameScene::Shooting()
 	{
 		bullet.second += mSceneManager->DeltaTime();
 
-		//Destroy bullet if it's lifetime is greater than the limit
+		//Return bullet to the laser pool if it's lifetime is greater than the limit
 		if (bullet.second >= 2)
 		{
-			mEcsManager->DestroyEntity(bullet.first);
-			mBulletLifeTimers.erase(std::remove_if(mBulletLifeTimers.begin(), mBulletLifeTimers.end(), [&](const auto& pBullet) {return pBullet.first == bullet.first; }), mBulletLifeTimers.end());
+			mEcsManager->ReleaseEntity(bullet.first);
 		}
 	}
+	mBulletLifeTimers.erase(std::remove_if(mBulletLifeTimers.begin(), mBulletLifeTimers.end(), [](const auto& pBullet) {return pBullet.second >= 2; }), mBulletLifeTimers.end());
 }
 
 /// <summary>
-/// Rotates an object around a point in space
+/// Adds a laser to the life timer list
+/// Pooled lasers keep their handle when they are reused, so any timer left over from the laser's previous shot is removed first
 /// </summary>
-/// <param name="pAxis">Axis of rotation</param>
-/// <param name="pPoint">Point to rotate around</param>
-/// <param name="pAngle">Angle of rotation</param>
-void GameScene::RotateAroundPoint(const int pEntity, const KodeboldsMath::Vector4 & pAxis, const KodeboldsMath::Vector4 & pPoint, const float& pAngle)
+/// <param name="pLaser">Laser acquired from the laser pool</param>
+void GameScene::TrackBullet(const EntityHandle pLaser)
 {
-	const float angleInRadians = DegreesToRadians(pAngle);
-
-	auto translateTo = TranslationMatrix(pPoint);
-	auto rotation = RotationMatrixAxis(angleInRadians * mSceneManager->DeltaTime(), pAxis);
-	auto translateBack = TranslationMatrix(pPoint * -1);
-
-	mEcsManager->TransformComp(pEntity)->transform *= translateTo * rotation * translateBack;
+	mBulletLifeTimers.erase(std::remove_if(mBulletLifeTimers.begin(), mBulletLifeTimers.end(), [&](const auto& pBullet) {return pBullet.first == pLaser; }), mBulletLifeTimers.end());
+	mBulletLifeTimers.push_back(std::make_pair(pLaser, 0.0f));
 }
 
 /// <summary>
@@ -576,7 +517,7 @@ void GameScene::Update()
 {
 	if (mGameState == GAME_STATE::PLAYING)
 	{
-		mGameNetworking.ProcessMessages();
+		mGameNetworking.ProcessMessages(mLaserPool);
 		mPlayerNumber = mGameNetworking.PlayerNumber();
 
 		if (mPlayerNumber == 2)
@@ -597,7 +538,7 @@ void GameScene::Update()
 
 		for (int i = 0; i < newBulletCount; i++)
 		{
-			mBulletLifeTimers.push_back(std::make_pair(mGameNetworking.NewBullets().front(), 0.0f));
+			TrackBullet(mGameNetworking.NewBullets().front());
 			mGameNetworking.NewBullets().pop();
 		}
 
@@ -647,7 +588,6 @@ void GameScene::Update()
 				if (!(mEcsManager->CollisionComp(mPlayer)->collidedEntityCollisionMask == CustomCollisionMask::FLOOR))
 				{
 					mEcsManager->AddGravityComp(Gravity{}, mPlayer);
-					mEcsManager->AddGravityComp(Gravity{}, mPlayerGun);
 					mPlayerIsGrounded = false;
 				}
 				else
@@ -658,7 +598,6 @@ void GameScene::Update()
 			else
 			{
 				mEcsManager->AddGravityComp(Gravity{}, mPlayer);
-				mEcsManager->AddGravityComp(Gravity{}, mPlayerGun);
 				mPlayerIsGrounded = false;
 			}
 		}
@@ -673,7 +612,6 @@ void GameScene::Update()
 				if (!(mEcsManager->CollisionComp(mPlayer2)->collidedEntityCollisionMask == CustomCollisionMask::FLOOR))
 				{
 					mEcsManager->AddGravityComp(Gravity{}, mPlayer2);
-					mEcsManager->AddGravityComp(Gravity{}, mPlayerGun2);
 					mPlayerIsGrounded2 = false;
 				}
 				else
@@ -684,7 +622,6 @@ void GameScene::Update()
 			else
 			{
 				mEcsManager->AddGravityComp(Gravity{}, mPlayer2);
-				mEcsManager->AddGravityComp(Gravity{}, mPlayerGun2);
 				mPlayerIsGrounded2 = false;
 			}
 		}
@@ -695,7 +632,7 @@ void GameScene::Update()
 			mEcsManager->AddGravityComp(Gravity{}, mGravityAsteroid1);
 			mEcsManager->AddGravityComp(Gravity{}, mGravityAsteroid2);
 
-			mNetworkManager->AddMessage("G:" + std::to_string(mGravityAsteroid1) + ":" + std::to_string(mGravityAsteroid2));
+			mNetworkManager->AddMessage("G:" + std::to_string(mGravityAsteroid1.Index()) + ":" + std::to_string(mGravityAsteroid2.Index()));
 		}
 
 		// Turn On Pause Menu
@@ -729,6 +666,12 @@ void GameScene::OnLoad()
 	//Allows the user to use the mouse again as normal
 	mInputManager->CenterCursor(true);
 
+	//Create the pool lasers are taken from, the pool outlives the scene and regrows if its lasers are destroyed on unload
+	if (mLaserPool < 0)
+	{
+		mLaserPool = mEcsManager->CreateEntityPool(LaserPrefab(), 64);
+	}
+
 	//Spawn ship engine
 	//Vector4 engineStartPos = mPlayerShipStartPos - Vector4(0, -10, 15, 1);
 	//mPlayerShipEngine = SpawnEngine(engineStartPos, Vector4(10, 10, 10, 1), Vector4(0, 0, 0, 1), 4, L"", L"");
@@ -752,6 +695,10 @@ void GameScene::OnLoad()
 	mActivePlayerGun = mPlayerGun = SpawnLaserGun(mPlayerStartPos + Vector4(1, -1, 2.0f, 0), Vector4(1, 1, 1, 1), Vector4(0, 3.14f, 0, 1), L"laser_gun_diffuse.dds", L"laser_gun_normal.dds", 10);
 	mRateOfFire = 0.5f;
 
+	//Attach the ship cam to the ship and the gun to the player so they move and rotate with them
+	AttachToParent(mPlayerShipCam, mPlayerShip, Vector4(0, 40, -75, 1), Vector4(0, 0, 0, 0));
+	AttachToParent(mPlayerGun, mPlayer, Vector4(1, -1, 2.0f, 1), Vector4(0, 3.14f, 0, 1));
+
 	//Spawn free cam
 	mActiveCamera = mCamera = SpawnCamera(Vector4(5, 2, -100, 1), Vector4(1, 1, 1, 1), Vector4(0, 0, 0, 0), 60, 1, 10000, 50);
 
@@ -773,6 +720,10 @@ void GameScene::OnLoad()
 	mPlayerGun2 = SpawnLaserGun(mPlayerStartPos2 + Vector4(1, -1, 2.0f, 0), Vector4(1, 1, 1, 1), Vector4(0, 3.14f, 0, 1), L"laser_gun_diffuse.dds", L"laser_gun_normal.dds", 10);
 	mRateOfFire = 0.5f;
 
+	//Attach the ship cam and gun of player 2
+	AttachToParent(mPlayerShipCam2, mPlayerShip2, Vector4(0, 40, -75, 1), Vector4(0, 0, 0, 0));
+	AttachToParent(mPlayerGun2, mPlayer2, Vector4(1, -1, 2.0f, 1), Vector4(0, 3.14f, 0, 1));
+
 	//Spawn free cam 2
 	mCamera2 = SpawnCamera(Vector4(5, 2, -100, 1), Vector4(1, 1, 1, 1), Vector4(0, 0, 0, 0), 60, 1, 10000, 50);
 
@@ -805,23 +756,26 @@ void GameScene::OnLoad()
 	entitySpawnerEcsManager->AddCameraComp(cam, mSunLight);
 
 	//Spawn shadow demo asteroid
-	int asteroid = SpawnAsteroid(Vector4(0, -100, 100, 1), Vector4(3, 3, 3, 1), Vector4(0, 0, 0, 1), 10, 0,
+	EntityHandle asteroid = SpawnAsteroid(Vector4(0, -100, 100, 1), Vector4(3, 3, 3, 1), Vector4(0, 0, 0, 1), 10, 0,
 		CustomCollisionMask::ASTEROID, L"asteroid_diffuse.dds", L"asteroid_normal.dds");
 
 	//Spawn skybox
 	SpawnSkyBox();
 
-	//Spawn testing asteroid field
-	for (int i = -200; i < 200; i += 40)
+	//Spawn testing asteroid field in a single batch
+	Prefab asteroidPrefab = AsteroidPrefab(10, 0, CustomCollisionMask::ASTEROID, L"asteroid_diffuse.dds", L"asteroid_normal.dds");
+	Transform asteroidTrans{};
+	asteroidTrans.scale = Vector4(1, 1, 1, 1);
+	asteroidTrans.rotation = Vector4(0, 0, 0, 1);
+	asteroidPrefab.Add(asteroidTrans);
+	mEcsManager->Instantiate(asteroidPrefab, 1000, [&](const EntityHandle pAsteroid, const int pIndex)
 	{
-		for (int j = -5; j < 5; j++)
-		{
-			for (int k = -400; k > -800; k -= 40)
-			{
-				SpawnAsteroid(Vector4(i, 40 * j, k, 1), Vector4(1, 1, 1, 1), Vector4(0, 0, 0, 1), 10, 0, CustomCollisionMask::ASTEROID, L"asteroid_diffuse.dds", L"asteroid_normal.dds");
-			}
-		}
-	}
+		//10x10x10 grid, with the index running through the z axis fastest
+		const int i = -200 + 40 * (pIndex / 100);
+		const int j = -5 + (pIndex / 10) % 10;
+		const int k = -400 - 40 * (pIndex % 10);
+		mEcsManager->TransformComp(pAsteroid)->translation = Vector4(i, 40 * j, k, 1);
+	});
 
 	//Spawn gravity asteroids
 	mGravityAsteroid1 = SpawnAsteroid(Vector4(100, 350, -600, 1), Vector4(5, 5, 5, 1), Vector4(0, 0, 0, 1), 50, 0, CustomCollisionMask::SHIP, L"asteroid_diffuse.dds", L"asteroid_normal.dds");
@@ -834,7 +788,7 @@ void GameScene::OnLoad()
 		{
 			int randScale = rand() % 6 + 2;
 			int randRotation = rand() % 2 - 2;
-			int asteroid = SpawnAsteroid(Vector4(0, 100 * j, -100, 1), Vector4(1, 1, 1, 1) * randScale, Vector4(0, DegreesToRadians(i + randRotation), 0, 1), 10 * randScale, 0,
+			EntityHandle asteroid = SpawnAsteroid(Vector4(0, 100 * j, -100, 1), Vector4(1, 1, 1, 1) * randScale, Vector4(0, DegreesToRadians(i + randRotation), 0, 1), 10 * randScale, 0,
 				CustomCollisionMask::ASTEROID, L"asteroid_diffuse.dds", L"asteroid_normal.dds");
 
 			//Translate outwards, then reverse rotation
@@ -851,7 +805,7 @@ void GameScene::OnLoad()
 
 	/*
 	{
-		int screenspaceQuad = mEcsManager->CreateEntity();
+		EntityHandle screenspaceQuad = mEcsManager->CreateEntity();
 		Geometry geom{ L"cube.obj" };
 		mEcsManager->AddGeometryComp(geom, screenspaceQuad);
 		Shader shaderm{ L"distortionShader.fx" , BlendState::ALPHABLEND, CullState::NONE, DepthState::NONE, std::vector<int>(), false };
@@ -1,12 +1,14 @@
 #include "CollisionResponseSystem.h"
 
 /// <summary>
-/// 
+/// Constructor
+/// The system has no component masks as it consumes the collision event stream of the given collision check system instead of entities
+/// Responses create entities immediately, so the system doesn't declare the components it accesses and always runs on its own
 /// </summary>
-CollisionResponseSystem::CollisionResponseSystem()
-	: ISystem(std::vector<int>{ComponentType::COMPONENT_COLLISION})
+/// <param name="pCollisionCheckSystem">Collision check system that produces the collision events</param>
+CollisionResponseSystem::CollisionResponseSystem(std::shared_ptr<const CollisionCheckSystem> pCollisionCheckSystem)
+	: ISystem(std::vector<ComponentMask>{}), mCollisionCheckSystem(pCollisionCheckSystem), mEventCursor(0)
 {
-	mEntities = std::vector<Entity>(mEcsManager->MaxEntities(), Entity{ -1, ComponentType::COMPONENT_NONE });
 }
 
 /// <summary>
@@ -17,151 +19,138 @@ CollisionResponseSystem::~CollisionResponseSystem()
 }
 
 /// <summary>
-/// 
+/// Not used as the system has no component masks
 /// </summary>
-/// <param name="pEntity"></param>
-void CollisionResponseSystem::AssignEntity(const Entity & pEntity)
+/// <param name="pEntity">Entity that entered the system</param>
+/// <param name="pMaskIndex">Index of the mask the entity now matches</param>
+void CollisionResponseSystem::OnEnter(const Entity & pEntity, const int pMaskIndex)
 {
-	//Checks if entity mask matches the collision mask
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0])
-	{
-		//Update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
-	}
 }
 
 /// <summary>
-/// 
+/// Not used as the system has no component masks
 /// </summary>
-/// <param name="pEntity"></param>
-void CollisionResponseSystem::ReAssignEntity(const Entity & pEntity)
+/// <param name="pEntity">Entity that exited the system</param>
+/// <param name="pMaskIndex">Index of the mask the entity no longer matches</param>
+void CollisionResponseSystem::OnExit(const Entity & pEntity, const int pMaskIndex)
 {
-	//Checks if entity mask matches the collision mask
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0])
+}
+
+/// <summary>
+/// Responds to a collision between the two given entities if their collision masks form a pair this game reacts to
+/// </summary>
+/// <param name="pEntity">Given entity</param>
+/// <param name="pEntityMask">Collision mask of the given entity</param>
+/// <param name="pCollidedEntity">Entity the given entity collided with</param>
+/// <param name="pCollidedEntityMask">Collision mask of the collided entity</param>
+/// <returns>Bool representing whether the collision was handled</returns>
+bool CollisionResponseSystem::Respond(const EntityHandle pEntity, const int pEntityMask, const EntityHandle pCollidedEntity, const int pCollidedEntityMask)
+{
+	//If the player collides with the floor, remove gravity and set Y velocity to 0
+	if (pEntityMask == CustomCollisionMask::PLAYER && pCollidedEntityMask == CustomCollisionMask::FLOOR)
 	{
-		//If the entity matches collision mask then update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
+		//The players gun is attached to the player, so it stops with the player
+		if (mEcsManager->Read<Gravity>(pEntity))
+		{
+			mEcsManager->CommandBuffer().RemoveGravityComp(pEntity);
+			mEcsManager->VelocityComp(pEntity)->velocity.Y = 0;
+		}
+		return true;
+	}
+
+	//If asteroid collides with the player, move the asteroid
+	if (pEntityMask == CustomCollisionMask::ASTEROID && pCollidedEntityMask == CustomCollisionMask::SHIP)
+	{
+		//Get direction vector between the ship and asteroid
+		KodeboldsMath::Vector4 direction = mEcsManager->Read<Transform>(pEntity)->translation - mEcsManager->Read<Transform>(pCollidedEntity)->translation;
+		direction.Normalise();
+
+		//Set the velocity of the asteroid to the velocity of the ship in the direction of the direction vector
+		mEcsManager->VelocityComp(pEntity)->velocity = (direction * mEcsManager->Read<Velocity>(pCollidedEntity)->velocity.Magnitude()) * 0.9f;
+		return true;
+	}
+
+	//If asteroid collides with another asteroid, move the asteroids
+	if (pEntityMask == CustomCollisionMask::ASTEROID && pCollidedEntityMask == CustomCollisionMask::ASTEROID)
+	{
+		if (mEcsManager->Read<Velocity>(pEntity)->velocity.Magnitude() != 0 && mEcsManager->Read<Transform>(pCollidedEntity))
+		{
+			//Get direction vector between the asteroids
+			KodeboldsMath::Vector4 direction = mEcsManager->Read<Transform>(pEntity)->translation - mEcsManager->Read<Transform>(pCollidedEntity)->translation;
+			direction.Normalise();
+
+			//Set the velocity of the asteroids
+			mEcsManager->VelocityComp(pCollidedEntity)->velocity = (direction * mEcsManager->Read<Velocity>(pEntity)->velocity.Magnitude()) * -0.9f;
+			mEcsManager->VelocityComp(pEntity)->velocity = (direction * mEcsManager->Read<Velocity>(pCollidedEntity)->velocity.Magnitude()) * 0.9f;
+			return true;
+		}
+		return false;
 	}
-	else
+
+	//If laser collides with asteroid, destroy the asteroid and release the laser
+	if (pEntityMask == CustomCollisionMask::SHIP_LASER && pCollidedEntityMask == CustomCollisionMask::ASTEROID)
 	{
-		//If the mask doesn't match then set ID to -1
-		mEntities[pEntity.ID].ID = -1;
+		//Skip lasers and asteroids that have already been destroyed by another contact this frame
+		if (!mDestroyedEntities.count(pEntity) && mDestroyedEntities.insert(pCollidedEntity).second)
+		{
+			mDestroyedEntities.insert(pEntity);
+
+			const KodeboldsMath::Vector4 pos = mEcsManager->Read<Transform>(pCollidedEntity)->translation;
+			const float radius = mEcsManager->Read<SphereCollider>(pCollidedEntity)->radius / 4;
+			const KodeboldsMath::Vector4 scale = mEcsManager->Read<Transform>(pCollidedEntity)->scale / 4;
+
+			//Split asteroid into 4 smaller asteroids with an acceleration outwards of the translation of the destroyed asteroid
+			const KodeboldsMath::Vector4 offsets[] = { KodeboldsMath::Vector4(0, 0, 20, 0), KodeboldsMath::Vector4(0, 0, -20, 0), KodeboldsMath::Vector4(0, 20, 0, 0), KodeboldsMath::Vector4(0, -20, 0, 0) };
+			const KodeboldsMath::Vector4 velocities[] = { KodeboldsMath::Vector4(15, 0, 15, 1), KodeboldsMath::Vector4(0, 15, -15, 1), KodeboldsMath::Vector4(-15, 0, 15, 1), KodeboldsMath::Vector4(15, -15, 0, 1) };
+
+			Prefab asteroidPrefab = EntitySpawner::AsteroidPrefab(radius, 0, CustomCollisionMask::ASTEROID, L"asteroid_diffuse.dds", L"asteroid_normal.dds");
+			Transform trans{};
+			trans.scale = scale;
+			trans.rotation = KodeboldsMath::Vector4(0, 0, 0, 1);
+			asteroidPrefab.Add(trans);
+
+			mEcsManager->Instantiate(asteroidPrefab, 4, [&](const EntityHandle pAsteroid, const int pIndex)
+			{
+				mEcsManager->TransformComp(pAsteroid)->translation = pos + offsets[pIndex];
+				mEcsManager->VelocityComp(pAsteroid)->velocity = velocities[pIndex];
+			});
+
+			//Destroy asteroid and return laser to its pool, releasing only clears the enabled bit so it can be done immediately
+			mEcsManager->CommandBuffer().DestroyEntity(pCollidedEntity);
+			if (!mEcsManager->ReleaseEntity(pEntity))
+			{
+				mEcsManager->CommandBuffer().DestroyEntity(pEntity);
+			}
+		}
+
+		// TODO: INCREASE SCORE
+		return true;
 	}
+
+	return false;
 }
 
 /// <summary>
-/// 
+/// Systems process function, core logic of system
+/// Responds to every contact recorded by the collision check system since the last run, each pair of entities is handled once per contact
 /// </summary>
 void CollisionResponseSystem::Process()
 {
-	for (const Entity& entity : mEntities)
+	//Entities destroyed this frame, as destruction is deferred until the command buffer is played back
+	mDestroyedEntities.clear();
+
+	mEventCursor = mCollisionCheckSystem->Events().Read(mEventCursor, [this](const CollisionEvent& pEvent)
 	{
-		if (entity.ID != -1)
+		//Separating entities need no response and either entity may have been destroyed or released by an earlier response
+		if (pEvent.phase == CollisionEvent::END || !mEcsManager->IsEnabled(pEvent.entityA) || !mEcsManager->IsEnabled(pEvent.entityB))
 		{
-			int entityMask = 0;
-			Collision* collision = mEcsManager->CollisionComp(entity.ID);
-			if (collision)
-			{
-				if (!collision->handled)
-				{
-					//Retrieve the entity mask from the box collider if it has one
-					if (BoxCollider* b = mEcsManager->BoxColliderComp(entity.ID))
-						entityMask = b->collisionMask;
-
-					//Retrieve the entity mask from the sphere collider if it has one
-					if (SphereCollider* s = mEcsManager->SphereColliderComp(entity.ID))
-						entityMask = s->collisionMask;
-
-					//If the player collides with the floor, remove gravity and set Y velocity to 0
-					if (entityMask == CustomCollisionMask::PLAYER && collision->collidedEntityCollisionMask == CustomCollisionMask::FLOOR)
-					{
-						if (mEcsManager->GravityComp(entity.ID))
-						{
-							mEcsManager->RemoveGravityComp(entity.ID);
-							mEcsManager->VelocityComp(entity.ID)->velocity.Y = 0;
-							mEcsManager->RemoveGravityComp(entity.ID + 1);
-							mEcsManager->VelocityComp(entity.ID + 1)->velocity.Y = 0;
-							mEcsManager->RemoveGravityComp(entity.ID + 2);
-							mEcsManager->VelocityComp(entity.ID + 2)->velocity.Y = 0;
-						}
-						mEcsManager->CollisionComp(entity.ID)->handled = true;
-						mEcsManager->CollisionComp(mEcsManager->CollisionComp(entity.ID)->collidedEntity)->handled = true;
-					}
-
-					//If asteroid collides with the player, move the asteroid
-					if (entityMask == CustomCollisionMask::ASTEROID && collision->collidedEntityCollisionMask == CustomCollisionMask::SHIP)
-					{
-						int player = mEcsManager->CollisionComp(entity.ID)->collidedEntity;
-
-						//Get direction vector between the ship and asteroid
-						KodeboldsMath::Vector4 direction = mEcsManager->TransformComp(entity.ID)->translation - mEcsManager->TransformComp(player)->translation;
-						direction.Normalise();
-
-						//Set the velocity of the asteroid to the velocity of the ship in the direction of the direction vector
-						mEcsManager->VelocityComp(entity.ID)->velocity = (direction * mEcsManager->VelocityComp(player)->velocity.Magnitude()) * 0.9f;
-
-						mEcsManager->CollisionComp(entity.ID)->handled = true;
-						mEcsManager->CollisionComp(player)->handled = true;
-					}
-
-					//If asteroid collides with another asteroid, move the asteroids
-					if (entityMask == CustomCollisionMask::ASTEROID && collision->collidedEntityCollisionMask == CustomCollisionMask::ASTEROID)
-					{
-						int collidedAsteroid = mEcsManager->CollisionComp(entity.ID)->collidedEntity;
-
-						if (mEcsManager->VelocityComp(entity.ID)->velocity.Magnitude() != 0 && mEcsManager->TransformComp(collidedAsteroid))
-						{
-							//Get direction vector between the asteroids
-							KodeboldsMath::Vector4 direction = mEcsManager->TransformComp(entity.ID)->translation - mEcsManager->TransformComp(collidedAsteroid)->translation;
-							direction.Normalise();
-
-							//Set the velocity of the asteroids
-							mEcsManager->VelocityComp(collidedAsteroid)->velocity = (direction * mEcsManager->VelocityComp(entity.ID)->velocity.Magnitude()) * -0.9f;
-							mEcsManager->VelocityComp(entity.ID)->velocity = (direction * mEcsManager->VelocityComp(collidedAsteroid)->velocity.Magnitude()) * 0.9f;
-
-							mEcsManager->CollisionComp(entity.ID)->handled = true;
-							mEcsManager->CollisionComp(collidedAsteroid)->handled = true;
-						}
-					}
-
-					//If laser collides with asteroid, destroy both
-					if (entityMask == CustomCollisionMask::SHIP_LASER && collision->collidedEntityCollisionMask == CustomCollisionMask::ASTEROID)
-					{
-						if (mEcsManager->CollisionComp(entity.ID) && mEcsManager->CollisionComp(mEcsManager->CollisionComp(entity.ID)->collidedEntity))
-						{
-							const KodeboldsMath::Vector4 pos = mEcsManager->TransformComp(mEcsManager->CollisionComp(entity.ID)->collidedEntity)->translation;
-							const float radius = mEcsManager->SphereColliderComp(mEcsManager->CollisionComp(entity.ID)->collidedEntity)->radius / 4;
-							const KodeboldsMath::Vector4 scale = mEcsManager->TransformComp(mEcsManager->CollisionComp(entity.ID)->collidedEntity)->scale / 4;
-
-							//Split asteroid into 4 smaller asteroids with an acceleration outwards of the translation of the destroyed asteroid
-							int asteroid = EntitySpawner::SpawnAsteroid(pos + KodeboldsMath::Vector4(0, 0, 20, 0), scale, KodeboldsMath::Vector4(0, 0, 0, 1), radius, 0,
-								CustomCollisionMask::ASTEROID, L"asteroid_diffuse.dds", L"asteroid_normal.dds");
-							mEcsManager->VelocityComp(asteroid)->velocity = KodeboldsMath::Vector4(15, 0, 15, 1);
-
-							asteroid = EntitySpawner::SpawnAsteroid(pos + KodeboldsMath::Vector4(0, 0, -20, 0), scale, KodeboldsMath::Vector4(0, 0, 0, 1), radius, 0,
-								CustomCollisionMask::ASTEROID, L"asteroid_diffuse.dds", L"asteroid_normal.dds");
-							mEcsManager->VelocityComp(asteroid)->velocity = KodeboldsMath::Vector4(0, 15, -15, 1);
-
-							asteroid = EntitySpawner::SpawnAsteroid(pos + KodeboldsMath::Vector4(0, 20, 0, 0), scale, KodeboldsMath::Vector4(0, 0, 0, 1), radius, 0,
-								CustomCollisionMask::ASTEROID, L"asteroid_diffuse.dds", L"asteroid_normal.dds");
-							mEcsManager->VelocityComp(asteroid)->velocity = KodeboldsMath::Vector4(-15, 0, 15, 1);
-
-							asteroid = EntitySpawner::SpawnAsteroid(pos + KodeboldsMath::Vector4(0, -20, 0, 0), scale, KodeboldsMath::Vector4(0, 0, 0, 1), radius, 0,
-								CustomCollisionMask::ASTEROID, L"asteroid_diffuse.dds", L"asteroid_normal.dds");
-							mEcsManager->VelocityComp(asteroid)->velocity = KodeboldsMath::Vector4(15, -15, 0, 1);
-
-							//Destroy laser and asteroid
-							if (mEcsManager->CollisionComp(entity.ID))
-							{
-								mEcsManager->DestroyEntity(mEcsManager->CollisionComp(entity.ID)->collidedEntity);
-							}
-							mEcsManager->DestroyEntity(entity.ID);
-						}
-
-						// TODO: INCREASE SCORE
-					}
-				}
-			}
+			return;
 		}
-	}
+
+		//Try both orders as each response is written from the point of view of one of the entities
+		if (!Respond(pEvent.entityA, pEvent.collisionMaskA, pEvent.entityB, pEvent.collisionMaskB))
+		{
+			Respond(pEvent.entityB, pEvent.collisionMaskB, pEvent.entityA, pEvent.collisionMaskA);
+		}
+	});
 }
@@ -6,7 +6,7 @@
 /// <param name="pSplitString">Command args</param>
 void NetworkSystem::ClickedCommand(std::vector<std::string>& pSplitString)
 {
-	int cubeID = std::stoi(pSplitString[1]);
+	EntityHandle cubeID = mEcsManager->Handle(std::stoi(pSplitString[1]));
 	std::string colourToSteal = " ";
 
 	//Checks if this cube has weight to steal
@@ -49,7 +49,7 @@ void NetworkSystem::ClickedCommand(std::vector<std::string>& pSplitString)
 		}
 
 		//Send a response back to the stealing player with the stolen colour
-		mNetworkManager->AddMessage("CLICKEDRESPONSE:" + std::to_string(cubeID) + ":" + colourToSteal + ":" + pSplitString[3]);
+		mNetworkManager->AddMessage("CLICKEDRESPONSE:" + std::to_string(cubeID.Index()) + ":" + colourToSteal + ":" + pSplitString[3]);
 	}
 
 	//If no weight available, steal nothing or find another player with weight to steal?
@@ -61,7 +61,7 @@ void NetworkSystem::ClickedCommand(std::vector<std::string>& pSplitString)
 /// <param name="pSplitString">Command args</param>
 void NetworkSystem::ClickedResponseCommand(std::vector<std::string>& pSplitString)
 {
-	int cubeID = std::stoi(pSplitString[1]);
+	EntityHandle cubeID = mEcsManager->Handle(std::stoi(pSplitString[1]));
 	KodeboldsMath::Vector4 stolenColour;
 
 	//If stolen colour is red
@@ -412,7 +412,8 @@ NetworkSystem::~NetworkSystem()
 /// NOT IMPLEMENTED FOR THIS SYSTEM
 /// </summary>
 /// <param name="pEntity"></param>
-void NetworkSystem::AssignEntity(const Entity & pEntity)
+/// <param name="pMaskIndex"></param>
+void NetworkSystem::OnEnter(const Entity & pEntity, const int pMaskIndex)
 {
 }
 
@@ -420,7 +421,8 @@ void NetworkSystem::AssignEntity(const Entity & pEntity)
 /// NOT IMPLEMENTED FOR THIS SYSTEM
 /// </summary>
 /// <param name="pEntity"></param>
-void NetworkSystem::ReAssignEntity(const Entity & pEntity)
+/// <param name="pMaskIndex"></param>
+void NetworkSystem::OnExit(const Entity & pEntity, const int pMaskIndex)
 {
 }
 
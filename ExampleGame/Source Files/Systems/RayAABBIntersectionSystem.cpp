@@ -2,12 +2,13 @@
 
 /// <summary>
 /// Constructor
-/// Sets component mask to contain both a transform component and box collider component
-/// Resizes entity vector to 200000 entities
+/// Sets component masks to contain both a transform component and box collider component, and a ray component
+/// Reads box colliders and rays and writes the intersection results of rays
 /// </summary>
-RayAABBIntersectionSystem::RayAABBIntersectionSystem() : ISystem(ComponentType::COMPONENT_TRANSFORM | ComponentType::COMPONENT_BOXCOLLIDER)
+RayAABBIntersectionSystem::RayAABBIntersectionSystem()
+	: IParallelSystem(std::vector<ComponentMask>{ComponentType::COMPONENT_TRANSFORM | ComponentType::COMPONENT_BOXCOLLIDER, ComponentType::COMPONENT_RAY},
+		ComponentType::COMPONENT_BOXCOLLIDER | ComponentType::COMPONENT_RAY, ComponentType::COMPONENT_RAY)
 {
-	mEntities = std::vector<Entity>(200000, Entity{ -1, ComponentType::COMPONENT_NONE });
 }
 
 /// <summary>
@@ -18,182 +19,177 @@ RayAABBIntersectionSystem::~RayAABBIntersectionSystem()
 }
 
 /// <summary>
-/// Assigns entity to system if the entities mask matches the system mask
+/// Adds the entity to the box collider or ray list when it starts matching the corresponding mask
 /// </summary>
-/// <param name="pEntity">Entity to be assigned</param>
-void RayAABBIntersectionSystem::AssignEntity(const Entity & pEntity)
+/// <param name="pEntity">Entity that entered the system</param>
+/// <param name="pMaskIndex">Index of the mask the entity now matches</param>
+void RayAABBIntersectionSystem::OnEnter(const Entity & pEntity, const int pMaskIndex)
 {
-	//Checks if entity mask matches the box collider mask
-	if ((pEntity.componentMask & mMask) == mMask)
+	if (pMaskIndex == 0)
 	{
-		//If the entity matches box collider mask then update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
+		mEntities.Add(pEntity);
 	}
+	else
+	{
+		mRays.push_back(pEntity);
+	}
+}
 
-	//Checks if entity mask matches the ray mask
-	if ((pEntity.componentMask & ComponentType::COMPONENT_RAY) == ComponentType::COMPONENT_RAY)
+/// <summary>
+/// Removes the entity from the box collider or ray list when it stops matching the corresponding mask
+/// </summary>
+/// <param name="pEntity">Entity that exited the system</param>
+/// <param name="pMaskIndex">Index of the mask the entity no longer matches</param>
+void RayAABBIntersectionSystem::OnExit(const Entity & pEntity, const int pMaskIndex)
+{
+	if (pMaskIndex == 0)
 	{
-		//If the entity has a ray component then find it in the rays
-		const auto entity = std::find_if(mRays.begin(), mRays.end(), [&](const Entity& entity) {return entity.ID == pEntity.ID; });
-		if (entity == mRays.end())
-		{
-			//If not found then add it
-			mRays.push_back(pEntity);
-		}
-		else
-		{
-			//If already in the list, then update mask
-			entity->componentMask = pEntity.componentMask;
-		}
+		mEntities.Remove(pEntity.ID);
+	}
+	else
+	{
+		mRays.erase(std::remove_if(mRays.begin(), mRays.end(), [&](const Entity& entity) {return entity.ID == pEntity.ID; }), mRays.end());
 	}
 }
 
+
 /// <summary>
-/// Re-assigns entity to system when component is removed from entity
+/// Calculates the intersection between the given ray and AABB
 /// </summary>
-/// <param name="pEntity">Entity to re-assign</param>
-void RayAABBIntersectionSystem::ReAssignEntity(const Entity & pEntity)
+/// <param name="pBox">Box collider of the AABB</param>
+/// <param name="pRay">Ray component of the ray</param>
+/// <param name="pInverseRayDir">Inverse of the rays direction</param>
+/// <param name="pDistance">Distance along the ray to the point of intersection, set when the ray intersects</param>
+/// <returns>Bool representing whether the ray intersects the AABB</returns>
+bool RayAABBIntersectionSystem::Intersect(const BoxCollider& pBox, const Ray& pRay, const KodeboldsMath::Vector3& pInverseRayDir, float& pDistance) const
 {
-	//Checks if entity mask matches the box collider mask
-	if ((pEntity.componentMask & mMask) == mMask)
+	float minX = 0, maxX = 0, minY = 0, maxY = 0, minZ = 0, maxZ = 0, highestMin = 0, lowestMax = 0;
+
+	//Swap min and max of X around depending on if the ray is travelling positive or negative direction
+	if (pInverseRayDir.X >= 0)
 	{
-		//If the entity matches box collider mask then update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
+		minX = (pBox.minBounds.X - pRay.origin.X) * pInverseRayDir.X;
+		maxX = (pBox.maxBounds.X - pRay.origin.X) * pInverseRayDir.X;
 	}
 	else
 	{
-		//If the mask doesn't match then set ID to -1
-		mEntities[pEntity.ID].ID = -1;
+		minX = (pBox.maxBounds.X - pRay.origin.X) * pInverseRayDir.X;
+		maxX = (pBox.minBounds.X - pRay.origin.X) * pInverseRayDir.X;
 	}
 
-	//Checks if entity mask matches the ray mask
-	if ((pEntity.componentMask & ComponentType::COMPONENT_RAY) == ComponentType::COMPONENT_RAY)
+	//Swap min and max of Y around depending on if the ray is travelling positive or negative direction
+	if (pInverseRayDir.Y >= 0)
 	{
-		//If the entity has a ray component then find it in the rays
-		const auto entity = std::find_if(mRays.begin(), mRays.end(), [&](const Entity& entity) {return entity.ID == pEntity.ID; });
-		if (entity == mRays.end())
-		{
-			//If not found then add it
-			mRays.push_back(pEntity);
-		}
-		else
-		{
-			//If already in the list, then update mask
-			entity->componentMask = pEntity.componentMask;
-		}
+		minY = (pBox.minBounds.Y - pRay.origin.Y) * pInverseRayDir.Y;
+		maxY = (pBox.maxBounds.Y - pRay.origin.Y) * pInverseRayDir.Y;
 	}
 	else
 	{
-		//If the mask doesn't match then remove it (if it wasn't in the list then the remove acts as a search to confirm it is not there)
-		mRays.erase(std::remove_if(mRays.begin(), mRays.end(), [&](const Entity& entity) {return entity.ID == pEntity.ID; }), mRays.end());
+		minY = (pBox.maxBounds.Y - pRay.origin.Y) * pInverseRayDir.Y;
+		maxY = (pBox.minBounds.Y - pRay.origin.Y) * pInverseRayDir.Y;
+	}
+
+	//If min is greater than max, ray did not intersect
+	if ((minX > maxY) || (minY > maxX))
+	{
+		return false;
+	}
+
+	//Find lowest max and highest min
+	if (minY > minX)
+	{
+		highestMin = minY;
+	}
+	else
+	{
+		highestMin = minX;
+	}
+	if (maxY < maxX)
+	{
+		lowestMax = maxY;
+	}
+	else
+	{
+		lowestMax = maxX;
+	}
+
+	//Swap min and max of Z around depending on if the ray is travelling positive or negative direction
+	if (pInverseRayDir.Z >= 0)
+	{
+		minZ = (pBox.minBounds.Z - pRay.origin.Z) * pInverseRayDir.Z;
+		maxZ = (pBox.maxBounds.Z - pRay.origin.Z) * pInverseRayDir.Z;
+	}
+	else
+	{
+		minZ = (pBox.maxBounds.Z - pRay.origin.Z) * pInverseRayDir.Z;
+		maxZ = (pBox.minBounds.Z - pRay.origin.Z) * pInverseRayDir.Z;
+	}
+
+	//If min is greater than max, ray did not intersect
+	if ((highestMin > maxZ) || (minZ > lowestMax))
+	{
+		return false;
+	}
+
+	//Find highest min
+	if (minZ > highestMin)
+	{
+		highestMin = minZ;
 	}
+
+	pDistance = highestMin;
+	return true;
 }
 
 /// <summary>
 /// Systems process function, core logic of system
-/// Calculates the ray AABB intersection between every ray and AABB
+/// Calculates the ray AABB intersection between every enabled ray and AABB
+/// The AABBs are split across the workers for each ray, and the first AABB in the list that the ray intersects is kept
 /// </summary>
 void RayAABBIntersectionSystem::Process()
 {
 	for (const auto& ray : mRays)
 	{
+		if (!mEcsManager->IsEnabled(ray.ID))
+		{
+			continue;
+		}
+
 		//Retrieve ray component and calculate inverse ray direction
-		Ray rayComp = *mEcsManager->RayComp(ray.ID);
-		KodeboldsMath::Vector3 inverseRayDir(1 / rayComp.direction.X, 1 / rayComp.direction.Y, 1 / rayComp.direction.Z);
+		const Ray rayComp = *mEcsManager->Read<Ray>(ray.ID);
+		const KodeboldsMath::Vector3 inverseRayDir(1 / rayComp.direction.X, 1 / rayComp.direction.Y, 1 / rayComp.direction.Z);
 
-		//Check to see if ray intersects with any AABBs
-		for (const auto& box : mEntities)
+		//Check to see if ray intersects with any AABBs, ranges stop at the earliest intersection found so far
+		std::atomic<int> firstIntersection(mEntities.Size());
+		mThreadManager->ParallelFor(0, mEntities.Size(), mGrainSize, [&](const int pBegin, const int pEnd)
 		{
-			if (box.ID != -1)
+			for (int i = pBegin; i < pEnd && i < firstIntersection; i++)
 			{
-				float minX = 0, maxX = 0, minY = 0, maxY = 0, minZ = 0, maxZ = 0, highestMin = 0, lowestMax = 0;
-				BoxCollider boxComp = *mEcsManager->BoxColliderComp(box.ID);
-
-				//Swap min and max of X around depending on if the ray is travelling positive or negative direction
-				if (inverseRayDir.X >= 0)
-				{
-					minX = (boxComp.minBounds.X - rayComp.origin.X) * inverseRayDir.X;
-					maxX = (boxComp.maxBounds.X - rayComp.origin.X) * inverseRayDir.X;
-				}
-				else
-				{
-					minX = (boxComp.maxBounds.X - rayComp.origin.X) * inverseRayDir.X;
-					maxX = (boxComp.minBounds.X - rayComp.origin.X) * inverseRayDir.X;
-				}
-
-				//Swap min and max of Y around depending on if the ray is travelling positive or negative direction
-				if (inverseRayDir.Y >= 0)
-				{
-					minY = (boxComp.minBounds.Y - rayComp.origin.Y) * inverseRayDir.Y;
-					maxY = (boxComp.maxBounds.Y - rayComp.origin.Y) * inverseRayDir.Y;
-				}
-				else
-				{
-					minY = (boxComp.maxBounds.Y - rayComp.origin.Y) * inverseRayDir.Y;
-					maxY = (boxComp.minBounds.Y - rayComp.origin.Y) * inverseRayDir.Y;
-				}
-
-				//If min is greater than max, ray did not intersect then continue
-				if ((minX > maxY) || (minY > maxX))
-				{
-					continue;
-				}
-
-				//Find lowest max and highest min
-				if (minY > minX)
-				{
-					highestMin = minY;
-				}
-				else
-				{
-					highestMin = minX;
-				}
-				if (maxY < maxX)
-				{
-					lowestMax = maxY;
-				}
-				else
-				{
-					lowestMax = maxX;
-				}
-
-
-				//Swap min and max of Z around depending on if the ray is travelling positive or negative direction
-				if (inverseRayDir.Z >= 0)
-				{
-					minZ = (boxComp.minBounds.Z - rayComp.origin.Z) * inverseRayDir.Z;
-					maxZ = (boxComp.maxBounds.Z - rayComp.origin.Z) * inverseRayDir.Z;
-				}
-				else
-				{
-					minZ = (boxComp.maxBounds.Z - rayComp.origin.Z) * inverseRayDir.Z;
-					maxZ = (boxComp.minBounds.Z - rayComp.origin.Z) * inverseRayDir.Z;
-				}
-
-				//If min is greater than max, ray did not intersect then continue
-				if ((highestMin > maxZ) || (minZ > lowestMax))
+				const EntityHandle box = mEntities[i].ID;
+				float distance = 0;
+				if (!mEcsManager->IsEnabled(box) || !Intersect(*mEcsManager->Read<BoxCollider>(box), rayComp, inverseRayDir, distance))
 				{
 					continue;
 				}
 
-				//Set rays intersected with property to the id of this box
-				mEcsManager->RayComp(ray.ID)->intersectedWith = box.ID;
-
-				//Find lowest max and highest min
-				if (minZ > highestMin)
+				int current = firstIntersection;
+				while (i < current && !firstIntersection.compare_exchange_weak(current, i))
 				{
-					highestMin = minZ;
 				}
-				if (maxZ < lowestMax)
-				{
-					lowestMax = maxZ;
-				}
-
-				//Set rays intersection point property to the point of intersection
-				KodeboldsMath::Vector3 intersection(rayComp.origin + rayComp.direction * highestMin);
-				mEcsManager->RayComp(ray.ID)->intersectionPoint = intersection;
-				break;
+				return;
 			}
+		});
+
+		if (firstIntersection < mEntities.Size())
+		{
+			const EntityHandle box = mEntities[firstIntersection].ID;
+			float distance = 0;
+			Intersect(*mEcsManager->Read<BoxCollider>(box), rayComp, inverseRayDir, distance);
+
+			//Set rays intersected with property to the id of this box and intersection point property to the point of intersection
+			Ray* const rayToUpdate = mEcsManager->RayComp(ray.ID);
+			rayToUpdate->intersectedWith = box;
+			rayToUpdate->intersectionPoint = KodeboldsMath::Vector3(rayComp.origin + rayComp.direction * distance);
 		}
 	}
 }
@@ -57,11 +57,8 @@ int WINAPI wWinMain(_In_ const HINSTANCE pHInstance, _In_opt_ const HINSTANCE pH
 	ecsManager->AddRenderSystem(std::make_shared<RenderSystem_GL>(hWnd, 20, 2));
 #endif
 
-	//Update systems
+	//Update systems, systems that don't conflict with any system added before them run alongside the earliest one
 	ecsManager->AddUpdateSystem(std::make_shared<TransformSystem>());
-	ecsManager->AddUpdateSystem(std::make_shared<MovementSystem>());
-	ecsManager->AddUpdateSystem(std::make_shared<CollisionCheckSystem>(1000, 50));
-	ecsManager->AddUpdateSystem(std::make_shared<CollisionResponseSystem>());
 
 	// Audio system
 #ifdef DIRECTX
@@ -70,6 +67,11 @@ int WINAPI wWinMain(_In_ const HINSTANCE pHInstance, _In_opt_ const HINSTANCE pH
 	ecsManager->AddUpdateSystem(std::make_shared<AudioSystem_GL>());
 #endif
 
+	ecsManager->AddUpdateSystem(std::make_shared<MovementSystem>());
+	const auto collisionCheckSystem = std::make_shared<CollisionCheckSystem>(1000, 50);
+	ecsManager->AddUpdateSystem(collisionCheckSystem);
+	ecsManager->AddUpdateSystem(std::make_shared<CollisionResponseSystem>(collisionCheckSystem));
+
 	//Scenes
 	sceneManager->LoadScene<MenuScene>();
 
@@ -1,9 +1,9 @@
 #include "Sound.h"
-#include <string>
+#include "ResourceHandle.h"
 
 struct Audio
 {
-	std::wstring filename;
+	AudioHandle filename;
 	bool active = false;
 	bool loop = false;
 	float volume;
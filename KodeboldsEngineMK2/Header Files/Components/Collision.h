@@ -1,6 +1,9 @@
+#pragma once
+#include "EntityHandle.h"
+
 struct Collision
 {
-	int collidedEntity;
+	EntityHandle collidedEntity;
 	int collidedEntityCollisionMask;
 	bool handled = false;
 };
\ No newline at end of file
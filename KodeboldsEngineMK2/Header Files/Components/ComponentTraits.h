@@ -0,0 +1,38 @@
+#pragma once
+#include <initializer_list>
+#include "Components.h"
+
+//Maps each built in component type to its component mask so templated queries can be written in terms of types
+//Custom components have no built in mask as their masks are assigned at runtime and they are never stored in archetypes
+template <class T>
+struct ComponentTraits { enum : int { MASK = ComponentType::COMPONENT_NONE }; };
+
+template <> struct ComponentTraits<AI> { enum : int { MASK = ComponentType::COMPONENT_AI }; };
+template <> struct ComponentTraits<Audio> { enum : int { MASK = ComponentType::COMPONENT_AUDIO }; };
+template <> struct ComponentTraits<BoxCollider> { enum : int { MASK = ComponentType::COMPONENT_BOXCOLLIDER }; };
+template <> struct ComponentTraits<Camera> { enum : int { MASK = ComponentType::COMPONENT_CAMERA }; };
+template <> struct ComponentTraits<Collision> { enum : int { MASK = ComponentType::COMPONENT_COLLISION }; };
+template <> struct ComponentTraits<Colour> { enum : int { MASK = ComponentType::COMPONENT_COLOUR }; };
+template <> struct ComponentTraits<Geometry> { enum : int { MASK = ComponentType::COMPONENT_GEOMETRY }; };
+template <> struct ComponentTraits<Gravity> { enum : int { MASK = ComponentType::COMPONENT_GRAVITY }; };
+template <> struct ComponentTraits<PointLight> { enum : int { MASK = ComponentType::COMPONENT_POINTLIGHT }; };
+template <> struct ComponentTraits<DirectionalLight> { enum : int { MASK = ComponentType::COMPONENT_DIRECTIONALLIGHT }; };
+template <> struct ComponentTraits<Ray> { enum : int { MASK = ComponentType::COMPONENT_RAY }; };
+template <> struct ComponentTraits<Shader> { enum : int { MASK = ComponentType::COMPONENT_SHADER }; };
+template <> struct ComponentTraits<SphereCollider> { enum : int { MASK = ComponentType::COMPONENT_SPHERECOLLIDER }; };
+template <> struct ComponentTraits<Texture> { enum : int { MASK = ComponentType::COMPONENT_TEXTURE }; };
+template <> struct ComponentTraits<Transform> { enum : int { MASK = ComponentType::COMPONENT_TRANSFORM }; };
+template <> struct ComponentTraits<Velocity> { enum : int { MASK = ComponentType::COMPONENT_VELOCITY }; };
+template <> struct ComponentTraits<Parent> { enum : int { MASK = ComponentType::COMPONENT_PARENT }; };
+
+template <class... Ts>
+/// <summary>
+/// Combines the component masks of every given component type
+/// </summary>
+/// <returns>Component mask containing every given type</returns>
+int ComponentMaskOf()
+{
+	int mask = ComponentType::COMPONENT_NONE;
+	(void)std::initializer_list<int>{ (mask |= ComponentTraits<Ts>::MASK)... };
+	return mask;
+}
@@ -19,6 +19,7 @@ typedef struct {
 		COMPONENT_TRANSFORM = 1 << 14,
 		COMPONENT_VELOCITY = 1 << 15,
 		COMPONENT_COLLISION = 1 << 16,
-		CUSTOM_COMPONENT = 1 << 17,
+		COMPONENT_PARENT = 1 << 17,
+		CUSTOM_COMPONENT = 1 << 18,
 	};
 }ComponentType;
\ No newline at end of file
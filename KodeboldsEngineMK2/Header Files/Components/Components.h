@@ -16,4 +16,5 @@
 #include "Colour.h"
 #include "Ray.h"
 #include "Collision.h"
+#include "Parent.h"
 #include "CustomComponent.h"
\ No newline at end of file
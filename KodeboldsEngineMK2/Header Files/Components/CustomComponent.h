@@ -1,6 +1,30 @@
 #pragma once
+#include <atomic>
 
+//Base type of every game specific component
+//Custom component types are identified by a static type index rather than RTTI, so they carry no virtual functions
 struct CustomComponent
 {
-	virtual ~CustomComponent() = default;
-};
\ No newline at end of file
+};
+
+/// <summary>
+/// Hands out the next unused custom component type index
+/// </summary>
+/// <returns>Unused type index</returns>
+inline int NextCustomComponentTypeIndex()
+{
+	static std::atomic<int> typeIndex(0);
+	return typeIndex++;
+}
+
+template <class T>
+/// <summary>
+/// Returns the type index of custom component type T
+/// The index is assigned the first time the type is used and is stable for the lifetime of the program
+/// </summary>
+/// <returns>Type index of T</returns>
+int CustomComponentTypeIndex()
+{
+	static const int typeIndex = NextCustomComponentTypeIndex();
+	return typeIndex;
+}
\ No newline at end of file
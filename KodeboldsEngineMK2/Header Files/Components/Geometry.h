@@ -1,7 +1,7 @@
 #pragma once
-#include <string>
+#include "ResourceHandle.h"
 
 struct Geometry
 {
-	std::wstring filename;
+	GeometryHandle filename;
 };
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+#include "EntityHandle.h"
+#include "Matrix4.h"
+
+//Attaches an entity to a parent entity, the transform system sets the entities transform matrix to the parents transform matrix multiplied by the local transform
+struct Parent
+{
+	EntityHandle parent;
+	KodeboldsMath::Matrix4 localTransform;
+};
\ No newline at end of file
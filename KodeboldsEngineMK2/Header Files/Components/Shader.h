@@ -2,10 +2,11 @@
 #include "BlendState.h"
 #include "CullState.h"
 #include "DepthState.h"
+#include "ResourceHandle.h"
 
 struct Shader
 {
-	std::wstring filename;
+	ShaderHandle filename;
 	BlendState blendState;
 	CullState cullState;
 	DepthState  depthState;
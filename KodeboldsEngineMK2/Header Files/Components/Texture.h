@@ -1,8 +1,9 @@
 #pragma once
+#include "ResourceHandle.h"
 
 struct Texture
 {
-	std::wstring diffuse;
-	std::wstring normal;
-	std::wstring height;
+	TextureHandle diffuse;
+	TextureHandle normal;
+	TextureHandle height;
 };
\ No newline at end of file
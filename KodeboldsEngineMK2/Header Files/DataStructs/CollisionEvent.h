@@ -0,0 +1,20 @@
+#pragma once
+#include "EntityHandle.h"
+
+//Single contact between two entities found by the collision check system
+//Begin is reported on the first frame a pair touches, stay on every following frame and end on the first frame they are apart again
+struct CollisionEvent
+{
+	enum Phase : int
+	{
+		BEGIN,
+		STAY,
+		END
+	};
+
+	EntityHandle entityA;
+	EntityHandle entityB;
+	int collisionMaskA;
+	int collisionMaskB;
+	Phase phase;
+};
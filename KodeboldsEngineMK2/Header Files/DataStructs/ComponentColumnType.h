@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <utility>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+struct ComponentColumnType
+{
+	int componentMask;
+	size_t size;
+	size_t alignment;
+	void(*copyConstruct)(void* pDestination, const void* pSource);
+	void(*moveConstruct)(void* pDestination, void* pSource);
+	void(*destruct)(void* pComponent);
+};
+
+/// <summary>
+/// Builds the type information required to construct, move and destroy a component of type T inside raw chunk memory
+/// </summary>
+/// <param name="pComponentMask">Component mask of the given type</param>
+/// <returns>Column type for components of type T</returns>
+template <class T>
+ComponentColumnType ColumnType(const int pComponentMask)
+{
+	return ComponentColumnType
+	{
+		pComponentMask,
+		sizeof(T),
+		alignof(T),
+		[](void* pDestination, const void* pSource) { new (pDestination) T(*static_cast<const T*>(pSource)); },
+		[](void* pDestination, void* pSource) { new (pDestination) T(std::move(*static_cast<T*>(pSource))); },
+		[](void* pComponent) { static_cast<T*>(pComponent)->~T(); }
+	};
+}
+
+/// <summary>
+/// Calculates the index of the lowest set bit of the given component mask
+/// </summary>
+/// <param name="pComponentMask">Given component mask, must be non zero</param>
+/// <returns>Bit index of the component</returns>
+inline int MaskIndex(const int pComponentMask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, static_cast<unsigned long>(pComponentMask));
+	return static_cast<int>(index);
+#else
+	return __builtin_ctz(static_cast<unsigned int>(pComponentMask));
+#endif
+}
@@ -0,0 +1,231 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "ComponentType.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#include <emmintrin.h>
+#define COMPONENT_MASK_SSE2
+#endif
+
+//128 bit component signature, built in components occupy the low bits given by ComponentType and custom components the bits above them
+//Integer component masks convert implicitly so built in masks can still be combined with | before being compared
+//Membership tests are done on the whole signature at once with SSE2 where it is available
+struct ComponentMask
+{
+	//Size of the mask, the bit index of the first custom component and the number of custom component types that fit in a mask
+	enum : int
+	{
+		WORDS = 2,
+		BITS = WORDS * 64,
+		CUSTOM_BIT = 18,
+		MAX_CUSTOM_COMPONENTS = BITS - CUSTOM_BIT
+	};
+
+	uint64_t words[WORDS];
+
+	ComponentMask() : words{ 0, 0 } {};
+	ComponentMask(const int pComponentMask) : words{ static_cast<unsigned int>(pComponentMask), 0 } {};
+
+	/// <summary>
+	/// Creates a mask containing only the given bit
+	/// </summary>
+	/// <param name="pBitIndex">Index of the bit, must be less than BITS</param>
+	/// <returns>Mask with the single bit set</returns>
+	static ComponentMask Bit(const int pBitIndex)
+	{
+		ComponentMask mask;
+		mask.words[pBitIndex >> 6] = uint64_t(1) << (pBitIndex & 63);
+		return mask;
+	};
+
+	/// <summary>
+	/// Creates the mask of the custom component type at the given index, custom types are numbered from zero upwards
+	/// </summary>
+	/// <param name="pCustomIndex">Index of the custom component type</param>
+	/// <returns>Mask of the custom component type</returns>
+	static ComponentMask Custom(const int pCustomIndex)
+	{
+		return Bit(CUSTOM_BIT + pCustomIndex);
+	};
+
+	/// <summary>
+	/// Get method for the built in components of the mask as an integer mask, used for archetype and column lookups
+	/// </summary>
+	/// <returns>Integer mask of the built in components</returns>
+	int BuiltIn() const
+	{
+		return static_cast<int>(words[0] & static_cast<uint64_t>(ComponentType::CUSTOM_COMPONENT - 1));
+	};
+
+#ifdef COMPONENT_MASK_SSE2
+	__m128i Load() const { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(words)); };
+	void Store(const __m128i pBits) { _mm_storeu_si128(reinterpret_cast<__m128i*>(words), pBits); };
+#endif
+
+	/// <summary>
+	/// Checks if every bit of the given mask is set in this mask
+	/// </summary>
+	/// <param name="pComponentMask">Given mask</param>
+	/// <returns>Bool representing whether this mask contains the given mask</returns>
+	bool Contains(const ComponentMask& pComponentMask) const
+	{
+#ifdef COMPONENT_MASK_SSE2
+		const __m128i mask = pComponentMask.Load();
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(Load(), mask), mask)) == 0xFFFF;
+#else
+		return (words[0] & pComponentMask.words[0]) == pComponentMask.words[0] && (words[1] & pComponentMask.words[1]) == pComponentMask.words[1];
+#endif
+	};
+
+	/// <summary>
+	/// Checks if any bit of the given mask is set in this mask
+	/// </summary>
+	/// <param name="pComponentMask">Given mask</param>
+	/// <returns>Bool representing whether the masks share a component</returns>
+	bool Intersects(const ComponentMask& pComponentMask) const
+	{
+#ifdef COMPONENT_MASK_SSE2
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(Load(), pComponentMask.Load()), _mm_setzero_si128())) != 0xFFFF;
+#else
+		return ((words[0] & pComponentMask.words[0]) | (words[1] & pComponentMask.words[1])) != 0;
+#endif
+	};
+
+	bool IsEmpty() const { return (words[0] | words[1]) == 0; };
+
+	/// <summary>
+	/// Calculates the index of the lowest set bit of the mask
+	/// </summary>
+	/// <returns>Bit index of the lowest component, BITS if the mask is empty</returns>
+	int LowestBit() const
+	{
+		for (int i = 0; i < WORDS; i++)
+		{
+			if (words[i] != 0)
+			{
+				const unsigned int low = static_cast<unsigned int>(words[i]);
+				const unsigned int bits = low != 0 ? low : static_cast<unsigned int>(words[i] >> 32);
+#ifdef _MSC_VER
+				unsigned long index;
+				_BitScanForward(&index, static_cast<unsigned long>(bits));
+#else
+				const int index = __builtin_ctz(bits);
+#endif
+				return i * 64 + (low != 0 ? 0 : 32) + static_cast<int>(index);
+			}
+		}
+		return BITS;
+	};
+
+	template <class F>
+	/// <summary>
+	/// Calls the given function with the bit index of every set bit in ascending order
+	/// </summary>
+	/// <param name="pFunction">Function taking (const int)</param>
+	void ForEachBit(F pFunction) const
+	{
+		ComponentMask remaining(*this);
+		while (!remaining.IsEmpty())
+		{
+			const int bit = remaining.LowestBit();
+			pFunction(bit);
+			remaining.words[bit >> 6] &= remaining.words[bit >> 6] - 1;
+		}
+	};
+
+	ComponentMask& operator|=(const ComponentMask& pComponentMask)
+	{
+#ifdef COMPONENT_MASK_SSE2
+		Store(_mm_or_si128(Load(), pComponentMask.Load()));
+#else
+		words[0] |= pComponentMask.words[0];
+		words[1] |= pComponentMask.words[1];
+#endif
+		return *this;
+	};
+
+	ComponentMask& operator&=(const ComponentMask& pComponentMask)
+	{
+#ifdef COMPONENT_MASK_SSE2
+		Store(_mm_and_si128(Load(), pComponentMask.Load()));
+#else
+		words[0] &= pComponentMask.words[0];
+		words[1] &= pComponentMask.words[1];
+#endif
+		return *this;
+	};
+
+	ComponentMask& operator^=(const ComponentMask& pComponentMask)
+	{
+#ifdef COMPONENT_MASK_SSE2
+		Store(_mm_xor_si128(Load(), pComponentMask.Load()));
+#else
+		words[0] ^= pComponentMask.words[0];
+		words[1] ^= pComponentMask.words[1];
+#endif
+		return *this;
+	};
+
+	ComponentMask operator~() const
+	{
+		ComponentMask mask;
+#ifdef COMPONENT_MASK_SSE2
+		mask.Store(_mm_xor_si128(Load(), _mm_set1_epi32(-1)));
+#else
+		mask.words[0] = ~words[0];
+		mask.words[1] = ~words[1];
+#endif
+		return mask;
+	};
+
+	/// <summary>
+	/// Removes every bit of the given mask from this mask
+	/// </summary>
+	/// <param name="pComponentMask">Given mask</param>
+	/// <returns>Copy of this mask without the given components</returns>
+	ComponentMask Without(const ComponentMask& pComponentMask) const
+	{
+		ComponentMask mask;
+#ifdef COMPONENT_MASK_SSE2
+		mask.Store(_mm_andnot_si128(pComponentMask.Load(), Load()));
+#else
+		mask.words[0] = words[0] & ~pComponentMask.words[0];
+		mask.words[1] = words[1] & ~pComponentMask.words[1];
+#endif
+		return mask;
+	};
+
+	bool operator==(const ComponentMask& pComponentMask) const
+	{
+#ifdef COMPONENT_MASK_SSE2
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(Load(), pComponentMask.Load())) == 0xFFFF;
+#else
+		return words[0] == pComponentMask.words[0] && words[1] == pComponentMask.words[1];
+#endif
+	};
+
+	bool operator!=(const ComponentMask& pComponentMask) const { return !(*this == pComponentMask); };
+};
+
+static_assert(ComponentType::CUSTOM_COMPONENT == 1 << ComponentMask::CUSTOM_BIT, "Custom components must start at the first bit after the built in components");
+
+//Free operators so integer masks convert on either side
+inline ComponentMask operator|(ComponentMask pLeft, const ComponentMask& pRight) { return pLeft |= pRight; }
+inline ComponentMask operator&(ComponentMask pLeft, const ComponentMask& pRight) { return pLeft &= pRight; }
+inline ComponentMask operator^(ComponentMask pLeft, const ComponentMask& pRight) { return pLeft ^= pRight; }
+
+namespace std
+{
+	template <>
+	struct hash<ComponentMask>
+	{
+		size_t operator()(const ComponentMask& pComponentMask) const
+		{
+			return hash<uint64_t>()(pComponentMask.words[0] ^ (pComponentMask.words[1] * 0x9E3779B97F4A7C15ull));
+		}
+	};
+}
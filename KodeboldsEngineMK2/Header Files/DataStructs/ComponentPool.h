@@ -0,0 +1,191 @@
+#pragma once
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "Entity.h"
+
+//Sparse storage of a component type, entityMap maps entity indices to slots and owners maps slots back to the entity index that last took them
+//Removed components leave holes that later components reuse, so Defragment incrementally moves live components into a dense prefix ordered by entity index
+template <class T>
+struct ComponentPool
+{
+	std::vector<T> components;
+	std::vector<int> entityMap;
+	std::vector<int> owners;
+	std::vector<int> freeList;
+
+	//Slots freed since the last defragmentation pass started, and the entity and slot the current pass has reached, -1 when no pass is running
+	int freedSlots = 0;
+	int defragmentEntity = -1;
+	int defragmentSlot = 0;
+
+	/// <summary>
+	/// Stores the given component for the given entity, reusing a free slot if there is one
+	/// </summary>
+	/// <param name="pEntityIndex">Index of the entity that owns the component</param>
+	/// <param name="pComponent">Component to store</param>
+	void Place(const int pEntityIndex, const T& pComponent)
+	{
+		if (freeList.empty())
+		{
+			//Push onto back if no free slots and map to back
+			components.push_back(pComponent);
+			owners.push_back(pEntityIndex);
+			entityMap[pEntityIndex] = static_cast<int>(components.size() - 1);
+		}
+		else
+		{
+			//Insert into free slot and map to free slot
+			const int slot = freeList.back();
+			freeList.pop_back();
+			components[slot] = pComponent;
+			owners[slot] = pEntityIndex;
+			entityMap[pEntityIndex] = slot;
+		}
+	};
+
+	/// <summary>
+	/// Returns the slot of the given entities component to the free list
+	/// </summary>
+	/// <param name="pEntityIndex">Index of the entity that owns the component</param>
+	void Free(const int pEntityIndex)
+	{
+		freeList.push_back(entityMap[pEntityIndex]);
+		freedSlots++;
+	};
+
+	/// <summary>
+	/// Maps the components of every entity owning the given mask to consecutive slots in entity index order, used after components are loaded in that order
+	/// </summary>
+	/// <param name="pEntities">Entity list of the ECS</param>
+	/// <param name="pComponentMask">Component mask of type T</param>
+	void MapInOrder(const std::vector<Entity>& pEntities, const ComponentMask& pComponentMask)
+	{
+		owners.clear();
+		for (const Entity& entity : pEntities)
+		{
+			if (entity.componentMask.Contains(pComponentMask))
+			{
+				entityMap[entity.ID.Index()] = static_cast<int>(owners.size());
+				owners.push_back(entity.ID.Index());
+			}
+		}
+	};
+
+	/// <summary>
+	/// Removes every component and free slot and stops any defragmentation pass
+	/// </summary>
+	void Clear()
+	{
+		components.clear();
+		owners.clear();
+		freeList.clear();
+		freedSlots = 0;
+		defragmentEntity = -1;
+	};
+
+	/// <summary>
+	/// Checks if the given slot holds the component of a live entity
+	/// </summary>
+	/// <param name="pSlot">Given slot</param>
+	/// <param name="pEntities">Entity list of the ECS</param>
+	/// <param name="pComponentMask">Component mask of type T</param>
+	/// <returns>Bool representing whether the slot is in use</returns>
+	bool Occupied(const int pSlot, const std::vector<Entity>& pEntities, const ComponentMask& pComponentMask) const
+	{
+		const int owner = owners[pSlot];
+		return owner < static_cast<int>(pEntities.size()) && pEntities[owner].componentMask.Contains(pComponentMask) && entityMap[owner] == pSlot;
+	};
+
+	/// <summary>
+	/// Continues the current defragmentation pass over the given number of entities, starting a new pass if slots have been freed since the last one
+	/// Each component found is swapped into the next slot of the dense prefix, so the pass can be spread over many frames while components are added and removed in between
+	/// Slots freed before the pass started are held back from the free list until the pass ends, when every hole is reclaimed and the unused tail is trimmed
+	/// Components must not be accessed from other threads during a step, and pointers to components are invalidated by it
+	/// </summary>
+	/// <param name="pEntities">Entity list of the ECS</param>
+	/// <param name="pComponentMask">Component mask of type T</param>
+	/// <param name="pEntityCount">Number of entities to visit</param>
+	/// <returns>Bool representing whether the pool still needs defragmenting</returns>
+	bool Defragment(const std::vector<Entity>& pEntities, const ComponentMask& pComponentMask, const int pEntityCount)
+	{
+		if (defragmentEntity < 0)
+		{
+			if (freedSlots == 0)
+			{
+				return false;
+			}
+			freedSlots = 0;
+			freeList.clear();
+			defragmentEntity = 0;
+			defragmentSlot = 0;
+		}
+
+		const int entityCount = static_cast<int>(pEntities.size());
+		const int lastEntity = entityCount - defragmentEntity > pEntityCount ? defragmentEntity + pEntityCount : entityCount;
+		for (; defragmentEntity < lastEntity; defragmentEntity++)
+		{
+			if (!pEntities[defragmentEntity].componentMask.Contains(pComponentMask))
+			{
+				continue;
+			}
+
+			//Components removed after they were counted leave the prefix short, so targets can run past the end of the pool until the next pass
+			const int slot = entityMap[defragmentEntity];
+			const int target = defragmentSlot++;
+			if (slot == target || target >= static_cast<int>(components.size()))
+			{
+				continue;
+			}
+
+			if (Occupied(target, pEntities, pComponentMask))
+			{
+				//Swap places with the entity in the target slot
+				const int displaced = owners[target];
+				entityMap[displaced] = slot;
+				owners[slot] = displaced;
+			}
+			else
+			{
+				//The slot being vacated takes over the target slots place in the free list, if it was freed during this pass
+				const auto freeSlot = std::find(freeList.begin(), freeList.end(), target);
+				if (freeSlot != freeList.end())
+				{
+					*freeSlot = slot;
+				}
+			}
+
+			std::swap(components[slot], components[target]);
+			entityMap[defragmentEntity] = target;
+			owners[target] = defragmentEntity;
+		}
+
+		if (defragmentEntity < entityCount)
+		{
+			return true;
+		}
+
+		//Trim unused slots from the end, then rebuild the free list from the remaining holes so the lowest slots are reused first
+		int size = static_cast<int>(components.size());
+		while (size > 0 && !Occupied(size - 1, pEntities, pComponentMask))
+		{
+			size--;
+		}
+		components.erase(components.begin() + size, components.end());
+		owners.resize(size);
+
+		freeList.clear();
+		for (int i = size - 1; i >= 0; i--)
+		{
+			if (!Occupied(i, pEntities, pComponentMask))
+			{
+				freeList.push_back(i);
+			}
+		}
+
+		//Holes left by components added or removed during the pass are picked up by the next pass
+		freedSlots += static_cast<int>(freeList.size());
+		defragmentEntity = -1;
+		return freedSlots > 0;
+	};
+};
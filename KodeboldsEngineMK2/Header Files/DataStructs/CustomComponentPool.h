@@ -0,0 +1,80 @@
+#pragma once
+#include <type_traits>
+#include <vector>
+#include "ComponentPool.h"
+#include "Entity.h"
+#include "Snapshot.h"
+
+//Type erased interface to a pool of custom components so pools can be released, resized and defragmented without knowing their component type
+struct ICustomComponentPool
+{
+	ComponentMask componentMask;
+
+	ICustomComponentPool(const ComponentMask& pComponentMask) : componentMask(pComponentMask) {};
+	virtual ~ICustomComponentPool() {};
+	virtual void Release(const int pEntityIndex) = 0;
+	virtual void Resize(const int pEntityCount) = 0;
+	virtual void Clear() = 0;
+	virtual bool Defragment(const std::vector<Entity>& pEntities, const int pEntityCount) = 0;
+
+	//Snapshots, only pools of trivially copyable components can be saved and loaded
+	virtual bool CanSnapshot() const = 0;
+	virtual size_t ComponentSize() const = 0;
+	virtual void Save(SnapshotWriter& pWriter, const std::vector<Entity>& pEntities) = 0;
+	virtual void Load(SnapshotReader& pReader, const std::vector<Entity>& pEntities, const int pCount) = 0;
+};
+
+template <class T>
+struct CustomComponentPool : ICustomComponentPool
+{
+	ComponentPool<T> pool;
+
+	CustomComponentPool(const ComponentMask& pComponentMask, const int pEntityCount) : ICustomComponentPool(pComponentMask) { pool.entityMap.resize(pEntityCount); };
+
+	void Release(const int pEntityIndex) override { pool.Free(pEntityIndex); };
+	void Resize(const int pEntityCount) override { pool.entityMap.resize(pEntityCount); };
+	void Clear() override { pool.Clear(); };
+	bool Defragment(const std::vector<Entity>& pEntities, const int pEntityCount) override { return pool.Defragment(pEntities, componentMask, pEntityCount); };
+
+	bool CanSnapshot() const override { return std::is_trivially_copyable<T>::value; };
+	size_t ComponentSize() const override { return sizeof(T); };
+
+	/// <summary>
+	/// Writes a section holding the component of every entity that owns one in entity index order
+	/// </summary>
+	/// <param name="pWriter">Given writer</param>
+	/// <param name="pEntities">Entity list of the ECS</param>
+	void Save(SnapshotWriter& pWriter, const std::vector<Entity>& pEntities) override
+	{
+		SnapshotSection section{ componentMask.LowestBit(), sizeof(T), 0, 0 };
+		const size_t sectionOffset = pWriter.Size();
+		pWriter.WriteBytes(&section, sizeof(section));
+
+		for (const Entity& entity : pEntities)
+		{
+			if (entity.componentMask.Contains(componentMask))
+			{
+				pWriter.WriteBytes(&pool.components[pool.entityMap[entity.ID.Index()]], sizeof(T));
+				section.componentCount++;
+			}
+		}
+
+		section.byteCount = section.componentCount * sizeof(T);
+		pWriter.Overwrite(sectionOffset, &section, sizeof(section));
+	};
+
+	/// <summary>
+	/// Reads the given number of components with a single copy and maps them to the entities that own them in entity index order
+	/// The pool must have been cleared first
+	/// </summary>
+	/// <param name="pReader">Reader over the section data</param>
+	/// <param name="pEntities">Entity list of the ECS, already loaded from the snapshot</param>
+	/// <param name="pCount">Number of components in the section</param>
+	void Load(SnapshotReader& pReader, const std::vector<Entity>& pEntities, const int pCount) override
+	{
+		pool.components.resize(pCount);
+		pReader.ReadBytes(static_cast<void*>(pool.components.data()), pCount * sizeof(T));
+
+		pool.MapInOrder(pEntities, componentMask);
+	};
+};
\ No newline at end of file
@@ -1,9 +1,10 @@
 #pragma once
-#include "ComponentType.h"
+#include "ComponentMask.h"
+#include "EntityHandle.h"
 #include <string>
 
 struct Entity
 {
-	int ID;
-	int componentMask;
+	EntityHandle ID;
+	ComponentMask componentMask;
 };
\ No newline at end of file
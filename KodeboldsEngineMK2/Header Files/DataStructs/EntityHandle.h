@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+//32 bit entity handle made up of an index into the entity list and a generation counter
+//The generation is incremented every time an index is reused so handles to destroyed entities can be detected
+struct EntityHandle
+{
+	enum : unsigned int
+	{
+		INDEX_BITS = 20,
+		INDEX_MASK = (1u << INDEX_BITS) - 1,
+		GENERATION_MASK = 0xFFFFFFFFu >> INDEX_BITS,
+		NULL_HANDLE = 0xFFFFFFFFu
+	};
+
+	unsigned int value;
+
+	EntityHandle() : value(NULL_HANDLE) {};
+	EntityHandle(const unsigned int pIndex, const unsigned int pGeneration) : value(((pGeneration & GENERATION_MASK) << INDEX_BITS) | (pIndex & INDEX_MASK)) {};
+
+	unsigned int Index() const { return value & INDEX_MASK; };
+	unsigned int Generation() const { return value >> INDEX_BITS; };
+	bool IsNull() const { return value == NULL_HANDLE; };
+
+	bool operator==(const EntityHandle& pHandle) const { return value == pHandle.value; };
+	bool operator!=(const EntityHandle& pHandle) const { return value != pHandle.value; };
+	bool operator<(const EntityHandle& pHandle) const { return value < pHandle.value; };
+};
+
+namespace std
+{
+	template <>
+	struct hash<EntityHandle>
+	{
+		size_t operator()(const EntityHandle& pHandle) const
+		{
+			return hash<unsigned int>()(pHandle.value);
+		}
+	};
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "FrameAllocator.h"
+#include "RenderFrame.h"
+
+//Everything owned by a single frame in flight
+//The ECS manager keeps a ring of contexts, so a context is only reused once the renderer has finished the frame that last used it
+struct FrameContext
+{
+	//Snapshot the render system extracts at the end of the frame and draws from
+	RenderFrame renderFrame;
+	//Scratch memory for the frame, reset when the context is reused so it can be referenced by the render frame
+	FrameAllocator allocator;
+	//Number of the frame using the context
+	unsigned long long frameIndex;
+	//Number of simulation steps run in the frame, zero when the frame only renders
+	int steps;
+};
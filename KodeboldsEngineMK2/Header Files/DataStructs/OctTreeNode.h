@@ -1,12 +1,13 @@
 #pragma once
 #include <vector>
 #include "Vector3.h"
+#include "EntityHandle.h"
 
 struct OctTreeNode
 {
 	OctTreeNode* parent;
 	OctTreeNode* children[8];
-	std::vector<unsigned short> entities;
+	std::vector<EntityHandle> entities;
 	KodeboldsMath::Vector3 minBounds;
 	KodeboldsMath::Vector3 maxBounds;
 	KodeboldsMath::Vector3 dimensions;
@@ -0,0 +1,78 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Matrix4.h"
+#include "Vector4.h"
+#include "Camera.h"
+#include "DirectionalLight.h"
+#include "Geometry.h"
+#include "PointLight.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "FrameAllocator.h"
+
+//Geometry, shader and textures shared by every render item with the same material key
+struct RenderMaterial
+{
+	Geometry geometry;
+	Shader shader;
+	Texture texture;
+	bool hasTexture;
+};
+
+//World matrix and colour of a single renderable entity, material is an index into the frames material list
+//The previous world matrix is the entities world matrix one simulation step earlier, for interpolating between steps
+struct RenderItem
+{
+	KodeboldsMath::Matrix4 world;
+	KodeboldsMath::Matrix4 previousWorld;
+	KodeboldsMath::Vector4 colour;
+	int material;
+};
+
+//Cameras and lights also keep where they were one simulation step earlier, so they are interpolated with the items they look at
+struct RenderCamera
+{
+	KodeboldsMath::Vector4 translation;
+	KodeboldsMath::Vector4 forward;
+	KodeboldsMath::Vector4 up;
+	KodeboldsMath::Vector4 previousTranslation;
+	KodeboldsMath::Vector4 previousForward;
+	KodeboldsMath::Vector4 previousUp;
+	Camera camera;
+};
+
+struct RenderPointLight
+{
+	KodeboldsMath::Vector4 translation;
+	KodeboldsMath::Vector4 previousTranslation;
+	PointLight light;
+};
+
+//Directional lights render shadow maps from their own camera
+struct RenderDirectionalLight
+{
+	KodeboldsMath::Vector4 translation;
+	KodeboldsMath::Vector4 forward;
+	KodeboldsMath::Vector4 up;
+	KodeboldsMath::Vector4 previousTranslation;
+	KodeboldsMath::Vector4 previousForward;
+	KodeboldsMath::Vector4 previousUp;
+	DirectionalLight light;
+	Camera camera;
+};
+
+//Everything the renderer draws in a single frame, copied out of the ECS at the end of ECSManager::ProcessSystems
+//The render thread only reads the packet, so the update systems can keep writing components while it draws
+//Items are allocated from the frame allocator of the context that owns the frame, so they are only valid until the context is reused
+struct RenderFrame
+{
+	FrameArray<RenderItem> items;
+	std::vector<RenderMaterial> materials;
+	std::vector<RenderCamera> cameras;
+	std::vector<RenderPointLight> pointLights;
+	std::vector<RenderDirectionalLight> directionalLights;
+	double time;
+	//How far between the previous and current simulation steps the frame is drawn, one outside of fixed step mode
+	float interpolationAlpha;
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include "StringTable.h"
+
+//32 bit handle to an interned resource file name, typed by the kind of resource it names so handles of different kinds can't be mixed up
+//Handles of equal file names are equal, so components can be copied and compared without touching strings
+//A default constructed handle, or one made from an empty file name, refers to no resource
+template <class Tag>
+struct ResourceHandle
+{
+	unsigned int id;
+
+	ResourceHandle() : id(0) {};
+	ResourceHandle(const wchar_t* const pFilename) : id(StringTable::Intern(pFilename)) {};
+	ResourceHandle(const std::wstring& pFilename) : id(StringTable::Intern(pFilename)) {};
+
+	const std::wstring& Filename() const { return StringTable::String(id); };
+	bool IsNull() const { return id == 0; };
+
+	bool operator==(const ResourceHandle& pHandle) const { return id == pHandle.id; };
+	bool operator!=(const ResourceHandle& pHandle) const { return id != pHandle.id; };
+};
+
+struct GeometryResource;
+struct ShaderResource;
+struct TextureResource;
+struct AudioResource;
+
+typedef ResourceHandle<GeometryResource> GeometryHandle;
+typedef ResourceHandle<ShaderResource> ShaderHandle;
+typedef ResourceHandle<TextureResource> TextureHandle;
+typedef ResourceHandle<AudioResource> AudioHandle;
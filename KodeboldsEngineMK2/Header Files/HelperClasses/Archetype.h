@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include "ComponentColumnType.h"
+
+class Archetype;
+
+struct ArchetypeLocation
+{
+	Archetype* archetype;
+	int row;
+};
+
+class Archetype
+{
+private:
+	struct Column
+	{
+		const ComponentColumnType* type;
+		size_t offset;
+	};
+
+	const int mComponentMask;
+	int mChunkCapacity;
+	int mEntityCount;
+	std::vector<Column> mColumns;
+	std::vector<const ComponentColumnType*> mColumnTypes;
+	std::vector<int> mColumnLookup;
+	std::vector<unsigned char*> mChunks;
+
+	void* const Element(const int pRow, const Column& pColumn) const;
+
+public:
+	//Size of a single chunk in bytes
+	static const size_t CHUNK_SIZE = 16 * 1024;
+
+	//Structors
+	Archetype(const int pComponentMask, const std::vector<const ComponentColumnType*>& pColumnTypes);
+	~Archetype();
+
+	//Deleted copy constructor and assignment operator as chunks are owned by the archetype
+	Archetype(const Archetype& pArchetype) = delete;
+	Archetype& operator=(const Archetype& pArchetype) = delete;
+
+	//Accessors
+	int ComponentMask() const;
+	bool Matches(const int pComponentMask) const;
+	const std::vector<const ComponentColumnType*>& ColumnTypes() const;
+	int EntityCount() const;
+	int ChunkCount() const;
+	int ChunkCapacity() const;
+	int ChunkEntityCount(const int pChunk) const;
+	const int* const ChunkEntities(const int pChunk) const;
+	void* const ChunkColumn(const int pChunk, const int pComponentMask) const;
+	void* const Component(const int pRow, const int pComponentMask) const;
+
+	template <class T>
+	/// <summary>
+	/// Returns the contiguous column of components of type T stored in the given chunk
+	/// </summary>
+	/// <param name="pChunk">Index of the given chunk</param>
+	/// <param name="pComponentMask">Component mask of type T</param>
+	/// <returns>Pointer to the first component in the column, nullptr if the archetype has no such column</returns>
+	T* const ChunkColumn(const int pChunk, const int pComponentMask) const
+	{
+		return static_cast<T*>(ChunkColumn(pChunk, pComponentMask));
+	}
+
+	//Entity management
+	int AddEntity(const int pEntityIndex);
+	int RemoveEntity(const int pRow);
+};
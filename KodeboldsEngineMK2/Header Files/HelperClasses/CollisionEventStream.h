@@ -0,0 +1,48 @@
+#pragma once
+#include <vector>
+#include "CollisionEvent.h"
+
+//Ring buffer of collision events addressed by an ever increasing sequence number
+//Readers keep their own cursor and read every event pushed since, so any number of systems can consume the stream without it being cleared
+//Events from earlier frames are overwritten once the buffer wraps, but the buffer grows rather than overwrite events from the current frame
+class CollisionEventStream
+{
+private:
+	std::vector<CollisionEvent> mEvents;
+	unsigned long long mHead;
+	unsigned long long mTail;
+	unsigned long long mFrameStart;
+
+	void Grow();
+
+public:
+	//Structors
+	explicit CollisionEventStream(const int pCapacity = 1024);
+	~CollisionEventStream();
+
+	//Event management
+	void BeginFrame();
+	void Push(const CollisionEvent& pEvent);
+
+	//Accessors
+	unsigned long long Head() const;
+	unsigned long long Tail() const;
+	unsigned long long FrameStart() const;
+	const CollisionEvent& operator[](const unsigned long long pSequence) const;
+
+	template <class F>
+	/// <summary>
+	/// Calls the given function for every event pushed since the given cursor that hasn't been overwritten
+	/// </summary>
+	/// <param name="pCursor">Sequence number of the first unread event</param>
+	/// <param name="pFunction">Function taking (const CollisionEvent&)</param>
+	/// <returns>Cursor to pass to the next read</returns>
+	unsigned long long Read(const unsigned long long pCursor, F pFunction) const
+	{
+		for (unsigned long long sequence = pCursor > mTail ? pCursor : mTail; sequence < mHead; sequence++)
+		{
+			pFunction((*this)[sequence]);
+		}
+		return mHead;
+	}
+};
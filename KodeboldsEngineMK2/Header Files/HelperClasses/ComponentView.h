@@ -0,0 +1,237 @@
+#pragma once
+#include <tuple>
+#include <vector>
+#include "ComponentTraits.h"
+#include "ComponentPool.h"
+#include "StorageMode.h"
+#include "Archetype.h"
+#include "EntityList.h"
+
+//Query over every enabled entity that owns all of the given component types
+//Views are created through ECSManager::View and iterate a packed list of matching entities rather than every entity slot
+//Entities and components must not be created, destroyed, added or removed while a view is being iterated
+//Writes made through a view aren't recorded as changes, systems that modify components through a view mark them with ECSManager::MarkChanged
+template <class... Ts>
+class ComponentView
+{
+private:
+	StorageMode mStorageMode;
+	int mComponentMask;
+	const EntityList* mEntities;
+	const std::vector<Archetype*>* mArchetypes;
+	const std::vector<Entity>* mAllEntities;
+	const std::vector<unsigned char>* mEnabledEntities;
+	const std::vector<std::vector<unsigned int>>* mComponentVersions;
+	const std::vector<unsigned int>* mChangedVersions;
+	unsigned int mChangedSince;
+	std::tuple<ComponentPool<Ts>*...> mPools;
+
+	/// <summary>
+	/// Checks whether the given entity is enabled and passes the change filter of the view
+	/// </summary>
+	/// <param name="pEntityIndex">Index of the given entity</param>
+	/// <returns>Bool representing whether the entity should be visited</returns>
+	bool Visit(const int pEntityIndex) const
+	{
+		return (*mEnabledEntities)[pEntityIndex] && (!mChangedVersions || (*mChangedVersions)[pEntityIndex] > mChangedSince);
+	}
+
+	template <class F>
+	/// <summary>
+	/// Calls the given function for every entity in a single archetype chunk
+	/// </summary>
+	/// <param name="pFunction">Function to call for each entity</param>
+	/// <param name="pEntityIndices">Entity index column of the chunk</param>
+	/// <param name="pEntityCount">Number of entities in the chunk</param>
+	/// <param name="pColumns">Component columns of the chunk, one per component type</param>
+	void ForEachInChunk(F& pFunction, const int* const pEntityIndices, const int pEntityCount, Ts* const... pColumns) const
+	{
+		for (int i = 0; i < pEntityCount; i++)
+		{
+			if (Visit(pEntityIndices[i]))
+			{
+				pFunction((*mAllEntities)[pEntityIndices[i]].ID, pColumns[i]...);
+			}
+		}
+	}
+
+public:
+	/// <summary>
+	/// Constructs a view over the given entity list and component storage
+	/// </summary>
+	/// <param name="pStorageMode">Storage mode used for built in components</param>
+	/// <param name="pComponentMask">Combined built in component mask of the view, used to match archetypes</param>
+	/// <param name="pEntities">Packed list of entities matching the component mask</param>
+	/// <param name="pArchetypes">Archetypes created by the archetype storage mode</param>
+	/// <param name="pAllEntities">Every entity slot, used to map archetype entity indices back to handles</param>
+	/// <param name="pEnabledEntities">Enabled bit of every entity slot, disabled entities aren't visited</param>
+	/// <param name="pComponentVersions">Change versions of each built in component, indexed by bit index then entity index</param>
+	/// <param name="pPools">Pools that store each component type</param>
+	ComponentView(const StorageMode pStorageMode, const int pComponentMask, const EntityList& pEntities, const std::vector<Archetype*>& pArchetypes, const std::vector<Entity>& pAllEntities,
+		const std::vector<unsigned char>& pEnabledEntities, const std::vector<std::vector<unsigned int>>& pComponentVersions, ComponentPool<Ts>* const... pPools)
+		: mStorageMode(pStorageMode), mComponentMask(pComponentMask), mEntities(&pEntities), mArchetypes(&pArchetypes), mAllEntities(&pAllEntities),
+		mEnabledEntities(&pEnabledEntities), mComponentVersions(&pComponentVersions), mChangedVersions(nullptr), mChangedSince(0), mPools(pPools...)
+	{
+	}
+
+	template <class T>
+	/// <summary>
+	/// Returns a copy of the view that only visits entities whose built in component of type T has changed after the given version
+	/// </summary>
+	/// <param name="pSinceVersion">Version the caller last processed at, usually the value of ECSManager::Version after its previous run</param>
+	/// <returns>Filtered view</returns>
+	ComponentView Changed(const unsigned int pSinceVersion) const
+	{
+		static_assert(static_cast<int>(ComponentTraits<T>::MASK) != ComponentType::COMPONENT_NONE, "Only built in components track changes");
+
+		ComponentView view(*this);
+		view.mChangedVersions = &(*mComponentVersions)[MaskIndex(ComponentTraits<T>::MASK)];
+		view.mChangedSince = pSinceVersion;
+		return view;
+	}
+
+	template <class F>
+	/// <summary>
+	/// Calls the given function with the handle and a modifiable reference to each component of every matching entity
+	/// Archetype storage walks the component columns of each matching chunk, sparse storage walks the packed entity list
+	/// </summary>
+	/// <param name="pFunction">Function taking (const EntityHandle, Ts&...)</param>
+	void ForEach(F pFunction) const
+	{
+		if (mStorageMode == StorageMode::ARCHETYPE)
+		{
+			for (const auto& archetype : *mArchetypes)
+			{
+				if (!archetype->Matches(mComponentMask))
+				{
+					continue;
+				}
+
+				for (int chunk = 0; chunk < archetype->ChunkCount(); chunk++)
+				{
+					ForEachInChunk(pFunction, archetype->ChunkEntities(chunk), archetype->ChunkEntityCount(chunk), archetype->template ChunkColumn<Ts>(chunk, ComponentTraits<Ts>::MASK)...);
+				}
+			}
+			return;
+		}
+
+		for (const Entity& entity : *mEntities)
+		{
+			const int index = entity.ID.Index();
+			if (!Visit(index))
+			{
+				continue;
+			}
+			pFunction(entity.ID, std::get<ComponentPool<Ts>*>(mPools)->components[std::get<ComponentPool<Ts>*>(mPools)->entityMap[index]]...);
+		}
+	}
+
+	/// <summary>
+	/// Get method for the number of parts the view can be split into to process on several threads at once
+	/// Archetype storage is split into the chunks of the matching archetypes, sparse storage into the entities of the packed entity list
+	/// </summary>
+	/// <returns>Number of parts</returns>
+	int Partitions() const
+	{
+		if (mStorageMode != StorageMode::ARCHETYPE)
+		{
+			return mEntities->Size();
+		}
+
+		int chunkCount = 0;
+		for (const auto& archetype : *mArchetypes)
+		{
+			if (archetype->Matches(mComponentMask))
+			{
+				chunkCount += archetype->ChunkCount();
+			}
+		}
+		return chunkCount;
+	}
+
+	template <class F>
+	/// <summary>
+	/// Calls the given function with the handle and a modifiable reference to each component of every matching entity in the given parts of the view
+	/// Different parts can be processed on different threads at the same time, as long as the function only writes to the entity it is given
+	/// </summary>
+	/// <param name="pBegin">First part to process</param>
+	/// <param name="pEnd">Part past the last part to process</param>
+	/// <param name="pFunction">Function taking (const EntityHandle, Ts&...)</param>
+	void ForEach(const int pBegin, const int pEnd, F pFunction) const
+	{
+		if (mStorageMode == StorageMode::ARCHETYPE)
+		{
+			int firstChunk = 0;
+			for (const auto& archetype : *mArchetypes)
+			{
+				if (!(firstChunk < pEnd))
+				{
+					break;
+				}
+				if (!archetype->Matches(mComponentMask))
+				{
+					continue;
+				}
+
+				//Only the chunks of this archetype that fall inside the given parts are visited
+				const int begin = pBegin > firstChunk ? pBegin - firstChunk : 0;
+				const int end = pEnd - firstChunk < archetype->ChunkCount() ? pEnd - firstChunk : archetype->ChunkCount();
+				for (int chunk = begin; chunk < end; chunk++)
+				{
+					ForEachInChunk(pFunction, archetype->ChunkEntities(chunk), archetype->ChunkEntityCount(chunk), archetype->template ChunkColumn<Ts>(chunk, ComponentTraits<Ts>::MASK)...);
+				}
+				firstChunk += archetype->ChunkCount();
+			}
+			return;
+		}
+
+		for (int i = pBegin; i < pEnd; i++)
+		{
+			const Entity& entity = (*mEntities)[i];
+			const int index = entity.ID.Index();
+			if (!Visit(index))
+			{
+				continue;
+			}
+			pFunction(entity.ID, std::get<ComponentPool<Ts>*>(mPools)->components[std::get<ComponentPool<Ts>*>(mPools)->entityMap[index]]...);
+		}
+	}
+
+	/// <summary>
+	/// Get method for the storage mode of the view, which decides what the parts of the view are
+	/// </summary>
+	/// <returns>Storage mode of the view</returns>
+	StorageMode Storage() const
+	{
+		return mStorageMode;
+	}
+
+	/// <summary>
+	/// Get method for the number of entities matching the view
+	/// Change filters and disabled entities aren't accounted for, so this is an upper bound for filtered views and pooled entities
+	/// </summary>
+	/// <returns>Number of matching entities</returns>
+	int Size() const
+	{
+		return mEntities->Size();
+	}
+
+	/// <summary>
+	/// Returns an iterator to the first matching entity
+	/// Iterators walk the whole packed entity list and ignore change filters and disabled entities
+	/// </summary>
+	/// <returns>Iterator to the first entity</returns>
+	std::vector<Entity>::const_iterator begin() const
+	{
+		return mEntities->begin();
+	}
+
+	/// <summary>
+	/// Returns an iterator past the last matching entity
+	/// </summary>
+	/// <returns>Iterator past the last entity</returns>
+	std::vector<Entity>::const_iterator end() const
+	{
+		return mEntities->end();
+	}
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+//Set of logical cores a thread may run on, stored inline as a fixed width bitmask so tasks can carry an affinity without touching the heap
+//An empty mask lets the thread run on every core
+class CoreMask
+{
+public:
+	//Cores past the last one that fits in the mask are ignored
+	static const int MAX_CORES = 256;
+
+private:
+	static const int BITS_PER_WORD = 64;
+	static const int WORD_COUNT = MAX_CORES / BITS_PER_WORD;
+
+	std::uint64_t mWords[WORD_COUNT];
+
+public:
+	//Structors
+	CoreMask();
+	CoreMask(std::initializer_list<int> pCores);
+	CoreMask(const std::vector<int>& pCores);
+
+	void Set(const int pCore);
+	bool IsSet(const int pCore) const;
+	bool Empty() const;
+
+	bool operator==(const CoreMask& pCoreMask) const;
+	bool operator!=(const CoreMask& pCoreMask) const;
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+//Logical cores of the machine grouped by the physical core they belong to
+//Logical cores sharing a physical core are SMT siblings, threads that need a core to themselves should be given one logical core per physical core
+class CpuTopology
+{
+private:
+	//Physical core of each logical core, indexed by logical core, negative for logical cores the process can't run on
+	std::vector<int> mPhysicalCores;
+	int mLogicalCoreCount;
+	int mPhysicalCoreCount;
+
+	//Private constructor for singleton pattern
+	CpuTopology();
+
+public:
+	~CpuTopology();
+
+	//Singleton pattern
+	//Deleted copy constructor and assignment operator so no copies of the singleton instance can be made
+	CpuTopology(const CpuTopology& CpuTopology) = delete;
+	CpuTopology& operator=(CpuTopology const&) = delete;
+
+	int LogicalCoreCount() const;
+	int PhysicalCoreCount() const;
+	int PhysicalCore(const int pLogicalCore) const;
+	bool IsSMTSibling(const int pLogicalCore) const;
+
+	//Affinity lists
+	std::vector<int> LogicalCores() const;
+	std::vector<int> LogicalCores(const int pPhysicalCore) const;
+	std::vector<int> PrimaryCores() const;
+
+	static std::shared_ptr< CpuTopology > Instance();
+};
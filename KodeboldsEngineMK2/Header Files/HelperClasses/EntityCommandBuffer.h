@@ -0,0 +1,111 @@
+#pragma once
+#include <mutex>
+#include <new>
+#include <vector>
+#include "Components.h"
+#include "EntityHandle.h"
+
+class ECSManager;
+
+//Records structural changes (entity creation and destruction, component addition and removal) so they can be applied later in a single batch
+//Commands can be recorded from any thread and are played back by the ECS manager at a sync point once the update systems have finished
+class EntityCommandBuffer
+{
+private:
+	typedef void(*ApplyCommand)(ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent);
+
+	struct Command
+	{
+		ApplyCommand apply;
+		void(*destruct)(void* pComponent);
+		EntityHandle entityID;
+		void* component;
+	};
+
+	//Size of a single block of recorded component data in bytes
+	static const size_t BLOCK_SIZE = 16 * 1024;
+
+	ECSManager& mEcsManager;
+	std::mutex mMutex;
+	std::vector<Command> mCommands;
+	std::vector<unsigned char*> mBlocks;
+	std::vector<unsigned char*> mFreeBlocks;
+	size_t mBlockOffset;
+
+	void* const Allocate(const size_t pSize, const size_t pAlignment);
+	void Record(const ApplyCommand pApply, const EntityHandle pEntityID);
+
+	template <class T>
+	/// <summary>
+	/// Records a command that carries a copy of the given component
+	/// Components are copied into fixed size blocks that never move, so components with non trivial copy semantics are safe to store
+	/// </summary>
+	/// <param name="pApply">Function that applies the command to the ECS manager</param>
+	/// <param name="pComponent">Component to copy into the buffer</param>
+	/// <param name="pEntityID">ID of the entity the command applies to</param>
+	void Record(const ApplyCommand pApply, const T& pComponent, const EntityHandle pEntityID)
+	{
+		static_assert(sizeof(T) <= BLOCK_SIZE, "Component is too large to be recorded in a command buffer");
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		void* const component = Allocate(sizeof(T), alignof(T));
+		new (component) T(pComponent);
+		mCommands.push_back(Command{ pApply, [](void* pComponent) { static_cast<T*>(pComponent)->~T(); }, pEntityID, component });
+	}
+
+public:
+	//Structors
+	EntityCommandBuffer(ECSManager& pEcsManager);
+	~EntityCommandBuffer();
+
+	//Deleted copy constructor and assignment operator as recorded components are owned by the buffer
+	EntityCommandBuffer(const EntityCommandBuffer& pCommandBuffer) = delete;
+	EntityCommandBuffer& operator=(const EntityCommandBuffer& pCommandBuffer) = delete;
+
+	//Entity commands
+	EntityHandle CreateEntity();
+	void DestroyEntity(const EntityHandle pEntityID);
+
+	//Add commands for components
+	void AddAIComp(const AI& pAI, const EntityHandle pEntityID);
+	void AddAudioComp(const Audio& pAudio, const EntityHandle pEntityID);
+	void AddBoxColliderComp(const BoxCollider& pBoxCollider, const EntityHandle pEntityID);
+	void AddCameraComp(const Camera& pCamera, const EntityHandle pEntityID);
+	void AddCollisionComp(const Collision& pCollision, const EntityHandle pEntityID);
+	void AddColourComp(const Colour& pColour, const EntityHandle pEntityID);
+	void AddGeometryComp(const Geometry& pGeometry, const EntityHandle pEntityID);
+	void AddGravityComp(const Gravity& pGravity, const EntityHandle pEntityID);
+	void AddPointLightComp(const PointLight& pLight, const EntityHandle pEntityID);
+	void AddDirectionalLightComp(const DirectionalLight& pLight, const EntityHandle pEntityID);
+	void AddRayComp(const Ray& pRay, const EntityHandle pEntityID);
+	void AddShaderComp(const Shader& pShader, const EntityHandle pEntityID);
+	void AddSphereColliderComp(const SphereCollider& pSphereCollider, const EntityHandle pEntityID);
+	void AddTextureComp(const Texture& pTexture, const EntityHandle pEntityID);
+	void AddTransformComp(const Transform& pTransform, const EntityHandle pEntityID);
+	void AddVelocityComp(const Velocity& pVelocity, const EntityHandle pEntityID);
+	void AddParentComp(const Parent& pParent, const EntityHandle pEntityID);
+	template <class T> void AddCustomComponent(const T& pComponent, const EntityHandle pEntityID);
+
+	//Remove commands for components
+	void RemoveAIComp(const EntityHandle pEntityID);
+	void RemoveAudioComp(const EntityHandle pEntityID);
+	void RemoveBoxColliderComp(const EntityHandle pEntityID);
+	void RemoveCameraComp(const EntityHandle pEntityID);
+	void RemoveCollisionComp(const EntityHandle pEntityID);
+	void RemoveColourComp(const EntityHandle pEntityID);
+	void RemoveGeometryComp(const EntityHandle pEntityID);
+	void RemoveGravityComp(const EntityHandle pEntityID);
+	void RemovePointLightComp(const EntityHandle pEntityID);
+	void RemoveDirectionalLightComp(const EntityHandle pEntityID);
+	void RemoveRayComp(const EntityHandle pEntityID);
+	void RemoveShaderComp(const EntityHandle pEntityID);
+	void RemoveSphereColliderComp(const EntityHandle pEntityID);
+	void RemoveTextureComp(const EntityHandle pEntityID);
+	void RemoveTransformComp(const EntityHandle pEntityID);
+	void RemoveVelocityComp(const EntityHandle pEntityID);
+	void RemoveParentComp(const EntityHandle pEntityID);
+	template <class T> void RemoveCustomComponent(const EntityHandle pEntityID);
+
+	//Playback
+	void Playback();
+};
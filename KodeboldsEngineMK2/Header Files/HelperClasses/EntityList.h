@@ -0,0 +1,28 @@
+#pragma once
+#include <vector>
+#include "Entity.h"
+
+class EntityList
+{
+private:
+	std::vector<Entity> mEntities;
+	std::vector<int> mPositions;
+
+public:
+	//Structors
+	EntityList();
+	~EntityList();
+
+	//Entity management
+	bool Add(const Entity& pEntity);
+	bool Remove(const EntityHandle pEntity);
+	void Clear();
+
+	//Accessors
+	bool Contains(const EntityHandle pEntity) const;
+	int Size() const;
+	bool Empty() const;
+	const Entity& operator[](const int pPosition) const;
+	std::vector<Entity>::const_iterator begin() const;
+	std::vector<Entity>::const_iterator end() const;
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+//Bump allocator for memory that only lives for a single frame
+//Allocating moves an offset through a list of blocks, and resetting rewinds the offset without freeing the blocks, so after the first few frames allocating never touches the heap
+//Nothing allocated is destructed, so only trivially destructible types can be allocated
+class FrameAllocator
+{
+private:
+	std::vector<std::vector<unsigned char>> mBlocks;
+	size_t mBlockSize;
+	int mBlock;
+	size_t mOffset;
+	size_t mUsed;
+
+public:
+	//Structors
+	explicit FrameAllocator(const size_t pBlockSize = 65536);
+	~FrameAllocator();
+
+	FrameAllocator(const FrameAllocator&) = delete;
+	FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+	void* Allocate(const size_t pSize, const size_t pAlignment = alignof(std::max_align_t));
+	void Reset();
+	size_t Used() const;
+
+	template <class T>
+	/// <summary>
+	/// Allocates uninitialised memory for the given number of objects of type T, valid until the allocator is next reset
+	/// </summary>
+	/// <param name="pCount">Number of objects</param>
+	/// <returns>Pointer to the first object</returns>
+	T* Allocate(const int pCount)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "Frame allocations are never destructed");
+		return static_cast<T*>(Allocate(sizeof(T) * pCount, alignof(T)));
+	};
+};
+
+template <class T>
+//Array of a fixed number of objects allocated from a frame allocator, only valid until the allocator is next reset
+struct FrameArray
+{
+	T* data = nullptr;
+	int count = 0;
+
+	T* begin() const { return data; };
+	T* end() const { return data + count; };
+	int size() const { return count; };
+	T& operator[](const int pIndex) const { return data[pIndex]; };
+};
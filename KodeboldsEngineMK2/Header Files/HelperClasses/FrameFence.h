@@ -0,0 +1,26 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+//Synchronisation point between two stages of the frame pipeline
+//The producing stage signals an ever increasing value as it finishes each frame, and the consuming stage waits until the value reaches the frame it needs
+class FrameFence
+{
+private:
+	std::atomic<unsigned long long> mValue;
+	std::mutex mMutex;
+	std::condition_variable mSignalled;
+
+public:
+	//Structors
+	FrameFence();
+	~FrameFence();
+
+	FrameFence(const FrameFence&) = delete;
+	FrameFence& operator=(const FrameFence&) = delete;
+
+	unsigned long long Value() const;
+	void Signal(const unsigned long long pValue);
+	void Wait(const unsigned long long pValue);
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include "Task.h"
+
+class ThreadManager;
+
+//Handle to a task added to the thread manager, used to check whether the task has finished, wait on it, or make other tasks depend on it
+//Each handle holds a reference to the task, so the task is cleaned up once it has run and every handle to it is gone
+class JobHandle
+{
+private:
+	Task* mTask;
+
+	friend class ThreadManager;
+	explicit JobHandle(Task* const pTask);
+
+public:
+	//Structors
+	JobHandle();
+	JobHandle(const JobHandle& pJobHandle);
+	JobHandle(JobHandle&& pJobHandle) noexcept;
+	~JobHandle();
+
+	JobHandle& operator=(const JobHandle& pJobHandle);
+	JobHandle& operator=(JobHandle&& pJobHandle) noexcept;
+
+	bool Valid() const;
+	bool IsDone() const;
+	void Reset();
+};
@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+
+//Read only view of a whole file mapped into memory, so large files can be read without copying them into a buffer first
+//Pages are loaded by the operating system as they are touched and released when the file is closed
+class MappedFile
+{
+private:
+	const unsigned char* mData;
+	size_t mSize;
+
+public:
+	//Structors
+	MappedFile();
+	~MappedFile();
+
+	//Deleted copy constructor and assignment operator as the mapping is owned by the file
+	MappedFile(const MappedFile& pMappedFile) = delete;
+	MappedFile& operator=(const MappedFile& pMappedFile) = delete;
+
+	//Mapping
+	bool Open(const std::wstring& pFilename);
+	void Close();
+
+	//Accessors
+	const unsigned char* const Data() const;
+	size_t Size() const;
+
+	static bool Write(const std::wstring& pFilename, const void* const pData, const size_t pSize);
+};
\ No newline at end of file
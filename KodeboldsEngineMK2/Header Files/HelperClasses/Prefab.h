@@ -0,0 +1,37 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "ComponentTraits.h"
+#include "ComponentColumnType.h"
+
+//Template of built in components that can be instantiated onto many entities at once
+class Prefab
+{
+private:
+	int mComponentMask;
+	std::vector<std::shared_ptr<const void>> mComponents;
+
+public:
+	//Structors
+	Prefab();
+	~Prefab();
+
+	template <class T>
+	/// <summary>
+	/// Adds the given built in component to the template, replacing any component of the same type
+	/// </summary>
+	/// <param name="pComponent">Component to copy onto every instantiated entity</param>
+	/// <returns>Modifiable handle to the prefab so components can be chained</returns>
+	Prefab& Add(const T& pComponent)
+	{
+		static_assert(static_cast<int>(ComponentTraits<T>::MASK) != ComponentType::COMPONENT_NONE, "Prefabs only store built in components");
+
+		mComponents[MaskIndex(ComponentTraits<T>::MASK)] = std::make_shared<const T>(pComponent);
+		mComponentMask |= ComponentTraits<T>::MASK;
+		return *this;
+	}
+
+	//Accessors
+	int ComponentMask() const;
+	const void* const Component(const int pComponentMask) const;
+};
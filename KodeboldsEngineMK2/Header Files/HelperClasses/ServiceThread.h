@@ -0,0 +1,22 @@
+#pragma once
+#include <thread>
+#include "Thread.h"
+#include "Task.h"
+
+class ThreadManager;
+
+//Thread dedicated to a single task that blocks or runs for the life of the program, such as a network loop
+//Service threads sit outside of the workers, so the workers stay free for the jobs of each frame
+class ServiceThread
+{
+private:
+	std::thread mThread;
+	Task* mTask;
+
+public:
+	//Structors
+	ServiceThread(ThreadManager* const pThreadManager, Task* const pTask, const THREAD_PRIORITY pPriority);
+	~ServiceThread();
+
+	bool IsDone() const;
+};
@@ -0,0 +1,287 @@
+#pragma once
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Components.h"
+
+//Identifies snapshot files, snapshots written with a different version are rejected rather than converted
+const char SNAPSHOT_MAGIC[4] = { 'K', 'B', 'S', 'S' };
+const unsigned int SNAPSHOT_VERSION = 4;
+
+//Fixed size header at the start of every snapshot, followed by the entity table, the free entity IDs, the enabled bit and pool index of each entity and then one section per component type
+struct SnapshotHeader
+{
+	char magic[4];
+	unsigned int version;
+	unsigned int entityCount;
+	unsigned int freeEntityCount;
+	unsigned int sectionCount;
+	int nextEntityID;
+};
+
+//Header of a single component section, followed by the component of every entity that owns one in entity index order
+//Components are identified by their bit index in the component mask
+struct SnapshotSection
+{
+	int componentIndex;
+	unsigned int componentSize;
+	unsigned int componentCount;
+	unsigned int byteCount;
+};
+
+//Appends snapshot data to a growing byte buffer so the whole snapshot can be written to disk in one call
+class SnapshotWriter
+{
+private:
+	std::vector<unsigned char> mBuffer;
+
+public:
+	//Structors
+	SnapshotWriter();
+	~SnapshotWriter();
+
+	//Accessors
+	const unsigned char* const Data() const;
+	size_t Size() const;
+
+	//Writing
+	void WriteBytes(const void* const pData, const size_t pSize);
+	void Overwrite(const size_t pOffset, const void* const pData, const size_t pSize);
+	void Transfer(std::wstring& pString);
+
+	template <class T>
+	/// <summary>
+	/// Writes the element count of the given vector followed by its elements
+	/// </summary>
+	/// <param name="pVector">Given vector</param>
+	void Transfer(std::vector<T>& pVector)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only vectors of trivially copyable types can be written directly");
+
+		const unsigned int count = static_cast<unsigned int>(pVector.size());
+		WriteBytes(&count, sizeof(count));
+		WriteBytes(pVector.data(), count * sizeof(T));
+	}
+
+	template <class T>
+	/// <summary>
+	/// Writes the bytes of the given value
+	/// </summary>
+	/// <param name="pValue">Given value</param>
+	void Transfer(T& pValue)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly");
+
+		WriteBytes(&pValue, sizeof(T));
+	}
+
+	template <class Tag>
+	/// <summary>
+	/// Writes the file name of the given resource handle, as handle IDs are only meaningful within the process that interned them
+	/// </summary>
+	/// <param name="pHandle">Given handle</param>
+	void Transfer(ResourceHandle<Tag>& pHandle)
+	{
+		std::wstring filename = pHandle.Filename();
+		Transfer(filename);
+	}
+};
+
+//Reads snapshot data from a block of memory, such as a mapped file
+//Every read is bounds checked, reading past the end of the data marks the reader as failed and leaves the destination untouched
+class SnapshotReader
+{
+private:
+	const unsigned char* mData;
+	size_t mSize;
+	size_t mOffset;
+	bool mFailed;
+
+public:
+	//Structors
+	SnapshotReader(const void* const pData, const size_t pSize);
+	~SnapshotReader();
+
+	//Accessors
+	bool Failed() const;
+	size_t Remaining() const;
+
+	//Reading
+	const void* const Skip(const size_t pSize);
+	bool ReadBytes(void* const pDestination, const size_t pSize);
+	SnapshotReader Section(const size_t pSize);
+	void Transfer(std::wstring& pString);
+
+	template <class T>
+	/// <summary>
+	/// Reads an element count followed by that many elements into the given vector
+	/// </summary>
+	/// <param name="pVector">Vector to read into</param>
+	void Transfer(std::vector<T>& pVector)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only vectors of trivially copyable types can be read directly");
+
+		unsigned int count = 0;
+		if (ReadBytes(&count, sizeof(count)) && count <= Remaining() / sizeof(T))
+		{
+			pVector.resize(count);
+			ReadBytes(pVector.data(), count * sizeof(T));
+		}
+		else
+		{
+			mFailed = true;
+		}
+	}
+
+	template <class T>
+	/// <summary>
+	/// Reads the bytes of a value into the given value
+	/// </summary>
+	/// <param name="pValue">Value to read into</param>
+	void Transfer(T& pValue)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly");
+
+		ReadBytes(&pValue, sizeof(T));
+	}
+
+	template <class Tag>
+	/// <summary>
+	/// Reads a file name and interns it into the given resource handle
+	/// </summary>
+	/// <param name="pHandle">Handle to read into</param>
+	void Transfer(ResourceHandle<Tag>& pHandle)
+	{
+		std::wstring filename;
+		Transfer(filename);
+		pHandle = ResourceHandle<Tag>(filename);
+	}
+};
+
+//Components are read with a single copy when they are trivially copyable, apart from components holding resource handles as they are written by file name
+template <class T> struct BlockCopyable : std::is_trivially_copyable<T> {};
+template <> struct BlockCopyable<Audio> : std::false_type {};
+template <> struct BlockCopyable<Geometry> : std::false_type {};
+template <> struct BlockCopyable<Texture> : std::false_type {};
+
+template <class Archive, class T>
+/// <summary>
+/// Writes or reads a component that doesn't own any memory as a single block of bytes
+/// </summary>
+/// <param name="pArchive">Snapshot writer or reader</param>
+/// <param name="pComponent">Given component</param>
+void TransferComponent(Archive& pArchive, T& pComponent)
+{
+	pArchive.Transfer(pComponent);
+}
+
+template <class Archive>
+/// <summary>
+/// Writes or reads an audio component field by field so its resource handle is written by file name
+/// </summary>
+/// <param name="pArchive">Snapshot writer or reader</param>
+/// <param name="pAudio">Given component</param>
+void TransferComponent(Archive& pArchive, Audio& pAudio)
+{
+	pArchive.Transfer(pAudio.filename);
+	pArchive.Transfer(pAudio.active);
+	pArchive.Transfer(pAudio.loop);
+	pArchive.Transfer(pAudio.volume);
+	pArchive.Transfer(pAudio.pitch);
+	pArchive.Transfer(pAudio.pan);
+}
+
+template <class Archive>
+/// <summary>
+/// Writes or reads a camera component field by field as it owns memory
+/// </summary>
+/// <param name="pArchive">Snapshot writer or reader</param>
+/// <param name="pCamera">Given component</param>
+void TransferComponent(Archive& pArchive, Camera& pCamera)
+{
+	pArchive.Transfer(pCamera.FOV);
+	pArchive.Transfer(pCamera.nearPlane);
+	pArchive.Transfer(pCamera.farPlane);
+	pArchive.Transfer(pCamera.activeTargets);
+	pArchive.Transfer(pCamera.active);
+}
+
+template <class Archive>
+/// <summary>
+/// Writes or reads a geometry component by the file name of its resource handle
+/// </summary>
+/// <param name="pArchive">Snapshot writer or reader</param>
+/// <param name="pGeometry">Given component</param>
+void TransferComponent(Archive& pArchive, Geometry& pGeometry)
+{
+	pArchive.Transfer(pGeometry.filename);
+}
+
+template <class Archive>
+/// <summary>
+/// Writes or reads a shader component field by field as it owns memory
+/// </summary>
+/// <param name="pArchive">Snapshot writer or reader</param>
+/// <param name="pShader">Given component</param>
+void TransferComponent(Archive& pArchive, Shader& pShader)
+{
+	pArchive.Transfer(pShader.filename);
+	pArchive.Transfer(pShader.blendState);
+	pArchive.Transfer(pShader.cullState);
+	pArchive.Transfer(pShader.depthState);
+	pArchive.Transfer(pShader.renderTargets);
+	pArchive.Transfer(pShader.renderToScreen);
+}
+
+template <class Archive>
+/// <summary>
+/// Writes or reads a texture component by the file names of its resource handles
+/// </summary>
+/// <param name="pArchive">Snapshot writer or reader</param>
+/// <param name="pTexture">Given component</param>
+void TransferComponent(Archive& pArchive, Texture& pTexture)
+{
+	pArchive.Transfer(pTexture.diffuse);
+	pArchive.Transfer(pTexture.normal);
+	pArchive.Transfer(pTexture.height);
+}
+
+template <class T>
+/// <summary>
+/// Reads the given number of trivially copyable components with a single copy
+/// </summary>
+/// <param name="pReader">Given reader</param>
+/// <param name="pComponents">Components to read into</param>
+/// <param name="pCount">Number of components</param>
+void ReadComponents(SnapshotReader& pReader, T* const pComponents, const int pCount, std::true_type)
+{
+	pReader.ReadBytes(pComponents, pCount * sizeof(T));
+}
+
+template <class T>
+/// <summary>
+/// Reads the given number of components that own memory or hold resource handles one at a time
+/// </summary>
+/// <param name="pReader">Given reader</param>
+/// <param name="pComponents">Components to read into</param>
+/// <param name="pCount">Number of components</param>
+void ReadComponents(SnapshotReader& pReader, T* const pComponents, const int pCount, std::false_type)
+{
+	for (int i = 0; i < pCount; i++)
+	{
+		TransferComponent(pReader, pComponents[i]);
+	}
+}
+
+template <class T>
+/// <summary>
+/// Reads the given number of consecutive components, copying the whole block at once when the component type allows it
+/// </summary>
+/// <param name="pReader">Given reader</param>
+/// <param name="pComponents">Components to read into</param>
+/// <param name="pCount">Number of components</param>
+void ReadComponents(SnapshotReader& pReader, T* const pComponents, const int pCount)
+{
+	ReadComponents(pReader, pComponents, pCount, std::integral_constant<bool, BlockCopyable<T>::value>());
+}
\ No newline at end of file
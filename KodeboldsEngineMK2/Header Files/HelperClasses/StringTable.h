@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+
+//Process wide table of interned strings, each unique string is stored once and identified by a 32 bit ID
+//IDs are handed out in the order strings are first interned, so they are only meaningful within the process that interned them
+//The empty string is always ID 0
+class StringTable
+{
+public:
+	static unsigned int Intern(const std::wstring& pString);
+	static unsigned int Intern(const wchar_t* const pString);
+	static const std::wstring& String(const unsigned int pID);
+	static unsigned int Count();
+};
@@ -1,23 +1,86 @@
 #pragma once
-#include <functional>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include "CoreMask.h"
 
+//Unit of work run by the thread manager
+//Tasks are reference counted, the thread manager holds a reference until the task has run and each JobHandle to the task holds another
+//A task only becomes ready to run once every task it depends on has finished, finished tasks ready the tasks that depend on them
+//The function of a task is stored inside the task and task memory is recycled, so adding a task doesn't touch the heap once the pools have warmed up
 class Task
 {
+public:
+	//Largest function that can be stored inside a task, functions that need more should capture by reference or pointer instead
+	static const int STORAGE_SIZE = 64;
+
+	//Continuations stored inside the task before the rest spill into a vector
+	static const int INLINE_CONTINUATIONS = 4;
+
 private:
-	std::function<void(void* param1, void* param2)> mFunction = nullptr;
+	typename std::aligned_storage<STORAGE_SIZE, alignof(std::max_align_t)>::type mStorage;
+	void(*mInvoke)(void* pStorage, void* pParam1, void* pParam2);
+	void(*mDestroy)(void* pStorage);
 	void* mParam1;
 	void* mParam2;
-	std::vector<int> mAffinity;
-	bool mIsDone;
+	CoreMask mAffinity;
+	std::atomic<bool> mIsDone;
 
-public:
-	//Structors
-	Task(std::function<void(void* param1, void* param2)> pFunction, void* pParam1, void* pParam2, const std::vector<int>& pThreadAffinity);
+	std::atomic<int> mReferences;
+	std::atomic<int> mDependencies;
+	Task* mContinuations[INLINE_CONTINUATIONS];
+	int mContinuationCount;
+	std::vector<Task*> mMoreContinuations;
+	std::mutex mContinuationsMutex;
+
+	//Tasks delete themselves when the last reference is released
 	~Task();
 
+public:
+	template <class F>
+	/// <summary>
+	/// Constructs a Task class that stores a copy of the given function inside the task, along with its parameters and the thread affinity for the task
+	/// The task starts with a single reference, held by the thread manager, and a single dependency that is finished once the task has been added
+	/// </summary>
+	/// <param name="pFunction">Function taking (void*, void*), such as a lambda or the result of std::bind</param>
+	/// <param name="pParam1">The first parameter of the function</param>
+	/// <param name="pParam2">The second parameter of the function</param>
+	/// <param name="pThreadAffinity">Cores the task may run on, empty for any core</param>
+	Task(F&& pFunction, void* pParam1, void* pParam2, const CoreMask& pThreadAffinity)
+		:mParam1(pParam1), mParam2(pParam2), mAffinity(pThreadAffinity), mIsDone(false), mReferences(1), mDependencies(1), mContinuationCount(0)
+	{
+		typedef typename std::decay<F>::type Function;
+		static_assert(sizeof(Function) <= STORAGE_SIZE, "Task functions must fit in Task::STORAGE_SIZE, capture large state by reference or pointer");
+		static_assert(alignof(Function) <= alignof(std::max_align_t), "Task functions can't be over aligned");
+
+		new (&mStorage) Function(std::forward<F>(pFunction));
+		mInvoke = [](void* pStorage, void* pFirst, void* pSecond) { (*static_cast<Function*>(pStorage))(pFirst, pSecond); };
+		mDestroy = [](void* pStorage) { static_cast<Function*>(pStorage)->~Function(); };
+	}
+
+	Task(const Task&) = delete;
+	Task& operator=(const Task&) = delete;
+
+	//Task memory comes from per thread pools
+	static void* operator new(const std::size_t pSize);
+	static void operator delete(void* const pMemory);
+
 	void Run();
-	const std::vector<int>& ThreadAffinity();
+	const CoreMask& ThreadAffinity();
 	bool IsDone();
-	void CleanUpTask();
-};
\ No newline at end of file
+
+	//Lifetime
+	void AddReference();
+	void Release();
+
+	//Dependencies
+	void AddDependency();
+	bool DependencyFinished();
+	bool AddContinuation(Task* const pTask);
+	int ContinuationCount() const;
+	Task* Continuation(const int pIndex) const;
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "Task.h"
+
+//Lock free work stealing deque of tasks (Chase-Lev), owned by a single worker thread
+//The owner pushes and pops tasks at the bottom while any other thread steals from the top, so the owner works newest first and thieves take the oldest tasks
+//The buffer doubles when full, replaced buffers are kept until the deque is destroyed as a thief may still be reading one
+class TaskDeque
+{
+private:
+	struct Buffer
+	{
+		std::unique_ptr<std::atomic<Task*>[]> slots;
+		long long capacity;
+
+		explicit Buffer(const long long pCapacity) : slots(new std::atomic<Task*>[pCapacity]), capacity(pCapacity) {};
+		Task* Get(const long long pIndex) const { return slots[pIndex & (capacity - 1)].load(std::memory_order_relaxed); };
+		void Put(const long long pIndex, Task* const pTask) { slots[pIndex & (capacity - 1)].store(pTask, std::memory_order_relaxed); };
+	};
+
+	std::atomic<long long> mTop;
+	std::atomic<long long> mBottom;
+	std::atomic<Buffer*> mBuffer;
+	std::vector<std::unique_ptr<Buffer>> mBuffers;
+
+	Buffer* Grow(Buffer* const pBuffer, const long long pBottom, const long long pTop);
+
+public:
+	//Structors
+	explicit TaskDeque(const int pCapacity = 256);
+	~TaskDeque();
+
+	TaskDeque(const TaskDeque&) = delete;
+	TaskDeque& operator=(const TaskDeque&) = delete;
+
+	//Owner thread only
+	void Push(Task* const pTask);
+	Task* Pop();
+
+	//Any thread
+	Task* Steal();
+	bool Empty() const;
+};
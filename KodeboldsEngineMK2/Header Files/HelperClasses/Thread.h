@@ -1,24 +1,60 @@
 #pragma once
 #include <thread>
-#include "windows.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
 #include <iostream>
 #include "Task.h"
+#include "TaskDeque.h"
 
+class ThreadManager;
+
+//Priority of a thread relative to the other threads of the process
+enum class THREAD_PRIORITY
+{
+	LOWEST, BELOW_NORMAL, NORMAL, ABOVE_NORMAL, HIGHEST
+};
+
+//Worker thread of the thread manager, each worker runs the tasks in its own deque and steals from the other workers once it runs out
 class Thread
 {
 private:
 	std::thread mThread;
-	Task* mTask;
-	bool mNeedsTask;
+	ThreadManager* mThreadManager;
+	int mIndex;
+	TaskDeque mTasks;
+
+	//Cores the worker runs on when its task doesn't ask for any, set from other threads and picked up by the worker before its next task
+	CoreMask mHomeAffinity;
+	CoreMask mNewHomeAffinity;
+	std::atomic<bool> mHomeAffinityChanged;
+	std::mutex mAffinityMutex;
 
-	void SetThreadAffinity(const std::vector<int>& pCores);
+	//Cores the worker is currently allowed to run on, empty for every core
+	CoreMask mAffinity;
+
+	void UpdateAffinity(const CoreMask& pCores);
 public:
 	//Structors
-	Thread();
+	Thread(ThreadManager* const pThreadManager, const int pIndex);
 	~Thread();
 
 	void Start();
-	void SetTask(Task* pTask);
 	void Run();
-	bool NeedsTask();
+
+	//Task deque
+	void PushTask(Task* const pTask);
+	Task* PopTask();
+	Task* StealTask();
+	bool HasTasks() const;
+
+	int Index() const;
+	void SetHomeAffinity(const CoreMask& pCores);
+	static Thread* Current();
+
+	//Scheduling of the calling thread, shared with the service threads
+	static bool SetThreadAffinity(const CoreMask& pCores);
+	static bool SetThreadPriority(const THREAD_PRIORITY pPriority);
+	static bool SetThreadName(const std::string& pName);
 };
@@ -27,7 +27,6 @@ namespace KodeboldsMath
 			const float& p21, const float& p22, const float& p23, const float& p24,
 			const float& p31, const float& p32, const float& p33, const float& p34,
 			const float& p41, const float& p42, const float& p43, const float& p44);
-		~Matrix4();
 
 		//Operator overloads
 		Matrix4& operator*=(const Matrix4& rhs);
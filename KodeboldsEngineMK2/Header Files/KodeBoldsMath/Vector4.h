@@ -14,13 +14,12 @@ namespace KodeboldsMath
 		//Structors
 		Vector4();
 		Vector4(const float x, const float y, const float z, const float w);
-		~Vector4();
 
 		//Accessors
-		Vector3 XYZ() { return Vector3(X, Y, Z); };
-		Vector2 XY() { return Vector2(X, Y); };
-		Vector2 XZ() { return Vector2(X, Z); };
-		Vector2 YZ() { return Vector2(Y, Z); };
+		Vector3 XYZ() const { return Vector3(X, Y, Z); };
+		Vector2 XY() const { return Vector2(X, Y); };
+		Vector2 XZ() const { return Vector2(X, Z); };
+		Vector2 YZ() const { return Vector2(Y, Z); };
 
 		//Maths methods
 		float Magnitude() const;
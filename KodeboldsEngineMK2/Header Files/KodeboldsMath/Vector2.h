@@ -11,7 +11,6 @@ namespace KodeboldsMath
 		//Structors
 		Vector2();
 		Vector2(const float x, const float y);
-		~Vector2();
 
 		//Maths methods
 		float Magnitude() const;
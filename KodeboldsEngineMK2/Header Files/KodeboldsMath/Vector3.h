@@ -13,7 +13,6 @@ namespace KodeboldsMath
 		//Structors
 		Vector3();
 		Vector3(const float x, const float y, const float z);
-		~Vector3();
 
 		//Accessors
 		Vector2 XY() { return Vector2(X, Y); };
@@ -7,96 +7,241 @@
 #include <algorithm>
 #include "ThreadManager.h"
 #include <chrono>
+#include <unordered_map>
+#include <type_traits>
+#include "ComponentPool.h"
+#include "CustomComponentPool.h"
+#include "StorageMode.h"
+#include "Archetype.h"
+#include "EntityList.h"
+#include "ComponentView.h"
+#include "EntityCommandBuffer.h"
+#include "Prefab.h"
+#include "Snapshot.h"
+#include <mutex>
+#include <functional>
+#include <atomic>
+#include "FrameContext.h"
+#include "FrameFence.h"
 
 class RenderSystem_DX;
 
 class ECSManager
 {
+	//The command buffer reserves and places entities on playback
+	friend class EntityCommandBuffer;
+
 private:
+	//A single mask of a registered system, systems are notified per mask when an entity starts or stops matching it
+	struct SystemSignature
+	{
+		ISystem* system;
+		ComponentMask componentMask;
+		int maskIndex;
+	};
+
+	//Entities instantiated from a prefab that are disabled and reused instead of being destroyed, inactive holds the disabled entities ready to be acquired
+	struct EntityPool
+	{
+		Prefab prefab;
+		std::vector<EntityHandle> inactive;
+		int size;
+	};
+
 	std::shared_ptr<ThreadManager> mThreadManager = ThreadManager::Instance();
 
 	//Entities and free ID list
 	std::vector<Entity> mEntities;
-	std::vector<int> mFreeEntityIDs;
+	std::vector<EntityHandle> mFreeEntityIDs;
 	int mEntityID;
+	std::mutex mEntityIDMutex;
 	int MAX_ENTITIES;
 
+	//Enabled bit of each entity indexed by entity index, disabled entities keep their components and system membership but are skipped by views and systems
+	std::vector<unsigned char> mEnabledEntities;
+
+	//Entity pools and the index of the pool each entity belongs to, -1 for entities that aren't pooled
+	std::vector<EntityPool> mEntityPools;
+	std::vector<int> mEntityPoolIndices;
+
+	//Component storage mode
+	StorageMode mStorageMode;
+
 	//Components
-	std::vector<AI> mAIs;
-	std::vector<Audio> mAudios;
-	std::vector<BoxCollider> mBoxColliders;
-	std::vector<Camera> mCameras;
-	std::vector<Collision> mCollisions;
-	std::vector<Colour> mColours;
-	std::vector<Geometry> mGeometries;
-	std::vector<Gravity> mGravities;
-	std::vector<PointLight> mPointLights;
-	std::vector<DirectionalLight> mDirectionalLights;
-	std::vector<Ray> mRays;
-	std::vector<Shader> mShaders;
-	std::vector<SphereCollider> mSphereColliders;
-	std::vector<Texture> mTextures;
-	std::vector<Transform> mTransforms;
-	std::vector<Velocity> mVelocities;
-
-	//Custom components
-	std::vector<CustomComponent*> mCustomComponentTypes;
-	std::vector<int> mCustomComponentMasks;
-	std::vector<void*> mCustomComponentVectors;
-	std::vector<std::vector<unsigned short>*> mCustomComponentEntityMaps;
-	std::vector<std::vector<unsigned short>*> mCustomComponentFreeLists;
-
-	//Entity-Component maps
-	std::vector<unsigned short> mAIEntityMap;
-	std::vector<unsigned short> mAudioEntityMap;
-	std::vector<unsigned short> mBoxColliderEntityMap;
-	std::vector<unsigned short> mCameraEntityMap;
-	std::vector<unsigned short> mCollisionEntityMap;
-	std::vector<unsigned short> mColourEntityMap;
-	std::vector<unsigned short> mGeometryEntityMap;
-	std::vector<unsigned short> mGravityEntityMap;
-	std::vector<unsigned short> mPointLightEntityMap;
-	std::vector<unsigned short> mDirectionalLightEntityMap;
-	std::vector<unsigned short> mRayEntityMap;
-	std::vector<unsigned short> mShaderEntityMap;
-	std::vector<unsigned short> mSphereColliderEntityMap;
-	std::vector<unsigned short> mTextureEntityMap;
-	std::vector<unsigned short> mTransformEntityMap;
-	std::vector<unsigned short> mVelocityEntityMap;
-
-	//Component free lists
-	std::vector<unsigned short> mAIFreeList;
-	std::vector<unsigned short> mAudioFreeList;
-	std::vector<unsigned short> mBoxColliderFreeList;
-	std::vector<unsigned short> mCameraFreeList;
-	std::vector<unsigned short> mCollisionFreeList;
-	std::vector<unsigned short> mColourFreeList;
-	std::vector<unsigned short> mGeometryFreeList;
-	std::vector<unsigned short> mGravityFreeList;
-	std::vector<unsigned short> mPointLightFreeList;
-	std::vector<unsigned short> mDirectionalLightFreeList;
-	std::vector<unsigned short> mRayFreeList;
-	std::vector<unsigned short> mShaderFreeList;
-	std::vector<unsigned short> mSphereColliderFreeList;
-	std::vector<unsigned short> mTextureFreeList;
-	std::vector<unsigned short> mTransformFreeList;
-	std::vector<unsigned short> mVelocityFreeList;
+	ComponentPool<AI> mAIs;
+	ComponentPool<Audio> mAudios;
+	ComponentPool<BoxCollider> mBoxColliders;
+	ComponentPool<Camera> mCameras;
+	ComponentPool<Collision> mCollisions;
+	ComponentPool<Colour> mColours;
+	ComponentPool<Geometry> mGeometries;
+	ComponentPool<Gravity> mGravities;
+	ComponentPool<PointLight> mPointLights;
+	ComponentPool<DirectionalLight> mDirectionalLights;
+	ComponentPool<Ray> mRays;
+	ComponentPool<Shader> mShaders;
+	ComponentPool<SphereCollider> mSphereColliders;
+	ComponentPool<Texture> mTextures;
+	ComponentPool<Transform> mTransforms;
+	ComponentPool<Velocity> mVelocities;
+	ComponentPool<Parent> mParents;
+
+	//Custom components, indexed by custom component type index
+	std::vector<std::unique_ptr<ICustomComponentPool>> mCustomComponentPools;
+
+	//Archetype storage
+	std::vector<ComponentColumnType> mColumnTypes;
+	std::vector<Archetype*> mArchetypes;
+	std::unordered_map<int, Archetype*> mArchetypeLookup;
+	std::vector<ArchetypeLocation> mArchetypeLocations;
+
+	//Packed entity lists for each queried component mask, views can be created by systems running on different threads
+	std::unordered_map<ComponentMask, EntityList> mViews;
+	std::mutex mViewsMutex;
+
+	//Entity list of views over custom component types that haven't been created, always empty
+	const EntityList mNoEntities;
+
+	//Deferred structural changes and the system notifications batched while they are played back
+	EntityCommandBuffer mCommandBuffer;
+	bool mDeferNotifications;
+	std::vector<std::pair<EntityHandle, ComponentMask>> mPendingNotifications;
+	std::vector<int> mPendingNotificationPositions;
+
+	//System signatures indexed by the bit index of each component they contain
+	std::vector<SystemSignature> mSystemSignatures;
+	std::vector<std::vector<int>> mSignaturesByComponent;
+	std::vector<unsigned int> mSignatureStamps;
+	unsigned int mNotificationStamp;
+
+	//Version each built in component was last changed at, indexed by the bit index of the component then the entity index
+	std::vector<std::vector<unsigned int>> mComponentVersions;
+	unsigned int mVersion;
 
 	//Systems
 	std::shared_ptr<ISystem> mRenderSystem;
 	std::vector<std::shared_ptr<ISystem>> mUpdateSystems;
+	std::vector<std::unique_ptr<EntityCommandBuffer>> mSystemCommandBuffers;
+	std::vector<std::vector<int>> mSystemWaves;
+	std::vector<JobHandle> mWaveJobs;
 	std::vector<std::shared_ptr<ISystem>> mNetworkSystems;
 
-	//Render and network threads
-	Task* mRenderTask = nullptr;
-	int mRenderingFrequency;
-	std::chrono::high_resolution_clock::time_point mRenderStart;
-	std::chrono::high_resolution_clock::time_point mRenderFinish;
-	std::chrono::nanoseconds mRenderTime;
+	//Frame pipeline, each frame is simulated and extracted into the next context of the ring while the render thread draws the frames before it
+	static const int MAX_FRAMES_IN_FLIGHT = 3;
+	FrameContext mFrameContexts[MAX_FRAMES_IN_FLIGHT];
+	int mFramesInFlight;
+	//Signalled with the number of frames the render thread has drawn
+	FrameFence mRenderFence;
+	//Number of frames extracted and whether the render task is running, written under the render mutex
+	std::mutex mRenderMutex;
+	unsigned long long mFramesExtracted;
+	bool mRendering;
+	JobHandle mRenderTask;
+	std::atomic<int> mRenderingFrequency;
+
+	//Time spent compacting component pools each frame and the pool the last compaction stopped on
+	float mDefragmentBudget;
+	int mDefragmentPool;
 
 	//Entity management
-	void AssignEntity(const Entity& pEntity);
-	void ReAssignEntity(const Entity& pEntity);
+	Entity* const LiveEntity(const EntityHandle pEntityID);
+	EntityHandle ReserveEntity();
+	void PlaceEntity(const EntityHandle pEntityID);
+	void GrowEntityPool(const int pPoolIndex, const int pCount);
+	void RefillEntityPools();
+	void DeferNotification(const EntityHandle pEntityID, const ComponentMask& pOldMask);
+	void PlaybackCommands();
+	void RegisterSignatures(ISystem* const pSystem);
+	void ScheduleSystem(const int pSystemIndex);
+	void RunSystem(const int pSystemIndex);
+	void StepSystems();
+	void BeginFrame();
+	void SubmitFrame();
+	void RenderFrames();
+	void NotifySystems(const EntityHandle pEntityID, const ComponentMask& pOldMask, const ComponentMask& pNewMask);
+	void NotifySystems(const EntityHandle* const pEntityIDs, const int pCount, const ComponentMask& pOldMask, const ComponentMask& pNewMask);
+	void UpdateViews(const Entity& pEntity, const ComponentMask& pOldMask);
+	EntityList& ViewEntities(const ComponentMask& pComponentMask);
+
+	//Component storage
+	void ResizeEntityMaps();
+	Archetype* const FindArchetype(const int pComponentMask);
+	void MoveToArchetype(const int pEntityIndex, const int pComponentMask, const void* const pAddedComponent, const int pAddedMask);
+	template <class T> void AddComponent(ComponentPool<T>& pPool, const T& pComponent, const int pComponentMask, const EntityHandle pEntityID);
+	template <class T> void RemoveComponent(ComponentPool<T>& pPool, const int pComponentMask, const EntityHandle pEntityID);
+	template <class T> void ReleaseComponent(ComponentPool<T>& pPool, const int pComponentMask, const EntityHandle pEntityID);
+	template <class T> void InstantiateComponents(ComponentPool<T>& pPool, const int pComponentMask, const Prefab& pPrefab, const std::vector<EntityHandle>& pEntityIDs);
+	template <class T> T* const ModifiableComponent(ComponentPool<T>& pPool, const int pComponentMask, const EntityHandle pEntityID);
+	bool DefragmentPool(const int pPoolIndex, const int pEntityCount);
+
+	//Change tracking
+	void StampVersions(const int pEntityIndex, const int pComponentMask);
+
+	//Snapshots
+	template <class T> void SaveComponents(SnapshotWriter& pWriter, ComponentPool<T>& pPool, const int pComponentMask);
+	template <class T> void LoadComponents(SnapshotReader& pReader, ComponentPool<T>& pPool, const int pComponentMask, const int pCount);
+	bool ValidateSnapshot(const unsigned char* const pData, const size_t pSize) const;
+	void ClearComponents();
+	void LoadSection(SnapshotReader& pReader, const SnapshotSection& pSection);
+
+	//Pool lookup by component type, used to build views
+	ComponentPool<AI>* Pool(const AI*) { return &mAIs; };
+	ComponentPool<Audio>* Pool(const Audio*) { return &mAudios; };
+	ComponentPool<BoxCollider>* Pool(const BoxCollider*) { return &mBoxColliders; };
+	ComponentPool<Camera>* Pool(const Camera*) { return &mCameras; };
+	ComponentPool<Collision>* Pool(const Collision*) { return &mCollisions; };
+	ComponentPool<Colour>* Pool(const Colour*) { return &mColours; };
+	ComponentPool<Geometry>* Pool(const Geometry*) { return &mGeometries; };
+	ComponentPool<Gravity>* Pool(const Gravity*) { return &mGravities; };
+	ComponentPool<PointLight>* Pool(const PointLight*) { return &mPointLights; };
+	ComponentPool<DirectionalLight>* Pool(const DirectionalLight*) { return &mDirectionalLights; };
+	ComponentPool<Ray>* Pool(const Ray*) { return &mRays; };
+	ComponentPool<Shader>* Pool(const Shader*) { return &mShaders; };
+	ComponentPool<SphereCollider>* Pool(const SphereCollider*) { return &mSphereColliders; };
+	ComponentPool<Texture>* Pool(const Texture*) { return &mTextures; };
+	ComponentPool<Transform>* Pool(const Transform*) { return &mTransforms; };
+	ComponentPool<Velocity>* Pool(const Velocity*) { return &mVelocities; };
+	ComponentPool<Parent>* Pool(const Parent*) { return &mParents; };
+
+	template <class T>
+	/// <summary>
+	/// Looks up the pool of custom component type T by its type index
+	/// </summary>
+	/// <returns>Pointer to the pool, nullptr if the type hasn't been created</returns>
+	CustomComponentPool<T>* const CustomPool()
+	{
+		const int typeIndex = CustomComponentTypeIndex<T>();
+		if (typeIndex < static_cast<int>(mCustomComponentPools.size()))
+		{
+			return static_cast<CustomComponentPool<T>*>(mCustomComponentPools[typeIndex].get());
+		}
+		return nullptr;
+	}
+
+	template <class T>
+	/// <summary>
+	/// Returns the component of type T associated with the given entity without recording a change
+	/// </summary>
+	/// <param name="pPool">Pool that stores components of type T</param>
+	/// <param name="pComponentMask">Component mask of type T</param>
+	/// <param name="pEntityID">Given ID of the entity</param>
+	/// <returns>Handle to the component, nullptr if the entity doesn't own one or the handle is stale</returns>
+	T* const Component(ComponentPool<T>& pPool, const int pComponentMask, const EntityHandle pEntityID)
+	{
+		const Entity* const entity = LiveEntity(pEntityID);
+
+		//Checks if entity is alive and actually owns a component of this type
+		if (entity && entity->componentMask.Contains(pComponentMask))
+		{
+			if (mStorageMode == StorageMode::ARCHETYPE)
+			{
+				const ArchetypeLocation& location = mArchetypeLocations[pEntityID.Index()];
+				return static_cast<T*>(location.archetype->Component(location.row, pComponentMask));
+			}
+			return &pPool.components[pPool.entityMap[pEntityID.Index()]];
+		}
+		return nullptr;
+	}
 
 	//Private constructor for singleton pattern
 	ECSManager();
@@ -113,62 +258,139 @@ public:
 	//Frequencies get/sets
 	int RenderingFrequency() const;
 
+	//Frame pipeline
+	void SetFramesInFlight(const int pFramesInFlight);
+	int FramesInFlight() const;
+	void FlushFrames();
+	FrameAllocator& CurrentFrameAllocator();
+
+	//Storage mode
+	void SetStorageMode(const StorageMode pStorageMode);
+	StorageMode Storage() const;
+	const std::vector<Archetype*>& Archetypes() const;
+
 	//Entity creation
 	void SetMaxEntities(const int pEntityCount);
 	int MaxEntities() const;
-	int CreateEntity();
-	void DestroyEntity(const int pEntityID);
+	EntityHandle CreateEntity();
+	std::vector<EntityHandle> Instantiate(const Prefab& pPrefab, const int pCount, const std::function<void(const EntityHandle, const int)>& pInitialise = nullptr);
+	void DestroyEntity(const EntityHandle pEntityID);
 	void DestroyEntities();
+	bool IsAlive(const EntityHandle pEntityID) const;
+	EntityHandle Handle(const int pEntityIndex) const;
+	EntityCommandBuffer& CommandBuffer();
+
+	//Enabling and pooling
+	void SetEnabled(const EntityHandle pEntityID, const bool pEnabled);
+	bool IsEnabled(const EntityHandle pEntityID) const;
+	int CreateEntityPool(const Prefab& pPrefab, const int pCapacity);
+	EntityHandle AcquireEntity(const int pPoolIndex);
+	bool ReleaseEntity(const EntityHandle pEntityID);
+
+	template <class... Ts>
+	/// <summary>
+	/// Creates a view over every enabled entity that owns all of the given built in component types
+	/// The first view of a component mask builds its packed entity list, after which the list is kept up to date as components are added and removed
+	/// </summary>
+	/// <returns>View that iterates the matching entities and their components</returns>
+	ComponentView<Ts...> View()
+	{
+		const int componentMask = ComponentMaskOf<Ts...>();
+		return ComponentView<Ts...>(mStorageMode, componentMask, ViewEntities(componentMask), mArchetypes, mEntities, mEnabledEntities, mComponentVersions, Pool(static_cast<const Ts*>(nullptr))...);
+	}
 
 	//System management
 	void AddUpdateSystem(std::shared_ptr<ISystem> pSystem);
 	void AddRenderSystem(std::shared_ptr<ISystem> pSystem);
-	void ProcessSystems();
+	void ProcessSystems(const int pSteps = 1);
+
+	//Defragmentation
+	void SetDefragmentBudget(const float pMilliseconds);
+	void Defragment(const float pMilliseconds);
+
+	//Change tracking
+	unsigned int Version() const;
+
+	//Snapshots
+	bool SaveSnapshot(const std::wstring& pFilename);
+	bool LoadSnapshot(const std::wstring& pFilename);
+
+	template <class T>
+	/// <summary>
+	/// Records a change to the built in component of type T owned by the given entity at the current version
+	/// Used by systems that write to components through views or chunk columns, which don't record changes themselves
+	/// </summary>
+	/// <param name="pEntityID">ID of the given entity</param>
+	void MarkChanged(const EntityHandle pEntityID)
+	{
+		static_assert(static_cast<int>(ComponentTraits<T>::MASK) != ComponentType::COMPONENT_NONE, "Only built in components track changes");
+		if (IsAlive(pEntityID))
+		{
+			StampVersions(pEntityID.Index(), ComponentTraits<T>::MASK);
+		}
+	}
 
 	template<class T>
 	/// <summary>
 	/// Creates a new custom component of type T
 	/// </summary>
-	/// <param name="pMask">Bitmask for the new custom component type</param>
-	void CreateCustomComponent(const int pMask)
+	/// <param name="pMask">Bitmask for the new custom component type, ComponentMask::Custom gives the mask of each custom component index</param>
+	void CreateCustomComponent(const ComponentMask& pMask)
 	{
-		//Add new type to types list
-		mCustomComponentTypes.push_back(new T());
-
-		//Add new mask to masks list
-		mCustomComponentMasks.push_back(pMask);
+		static_assert(std::is_base_of<CustomComponent, T>::value, "Custom components must derive from CustomComponent");
 
-		//Create vector for new component type
-		std::vector<T>* newVector = new std::vector<T>();
-		mCustomComponentVectors.push_back(static_cast<void*>(newVector));
+		//Pools are indexed by the type index of the component so lookups don't need to search the registered types
+		const int typeIndex = CustomComponentTypeIndex<T>();
+		if (typeIndex >= static_cast<int>(mCustomComponentPools.size()))
+		{
+			mCustomComponentPools.resize(typeIndex + 1);
+		}
+		mCustomComponentPools[typeIndex] = std::make_unique<CustomComponentPool<T>>(pMask, MAX_ENTITIES);
+	}
 
-		//Create vector for new component types entity component map
-		std::vector<unsigned short>* newMapVector = new std::vector<unsigned short>();
-		newMapVector->resize(MAX_ENTITIES);
-		mCustomComponentEntityMaps.push_back(newMapVector);
+	template<class T>
+	/// <summary>
+	/// Creates a new custom component of type T, masked by the bit of its custom component type index
+	/// </summary>
+	void CreateCustomComponent()
+	{
+		CreateCustomComponent<T>(ComponentMask::Custom(CustomComponentTypeIndex<T>()));
+	}
 
-		//Create vector for new component types free list
-		std::vector<unsigned short>* newFreeListVector = new std::vector<unsigned short>();
-		mCustomComponentFreeLists.push_back(newFreeListVector);
+	template <class T>
+	/// <summary>
+	/// Creates a view over every enabled entity that owns a custom component of type T
+	/// Custom components are always stored in pools, so the view walks the packed entity list in both storage modes
+	/// </summary>
+	/// <returns>View that iterates the matching entities and their components, an empty view if the type hasn't been created</returns>
+	ComponentView<T> CustomView()
+	{
+		CustomComponentPool<T>* const customPool = CustomPool<T>();
+		if (!customPool)
+		{
+			return ComponentView<T>(StorageMode::SPARSE, ComponentType::COMPONENT_NONE, mNoEntities, mArchetypes, mEntities, mEnabledEntities, mComponentVersions, nullptr);
+		}
+		return ComponentView<T>(StorageMode::SPARSE, ComponentType::COMPONENT_NONE, ViewEntities(customPool->componentMask), mArchetypes, mEntities, mEnabledEntities, mComponentVersions, &customPool->pool);
 	}
 
 	//Add methods for components
-	void AddAIComp(const AI& pAI, const int pEntityID);
-	void AddAudioComp(const Audio& pAudio, const int pEntityID);
-	void AddBoxColliderComp(const BoxCollider& pBoxCollider, const int pEntityID);
-	void AddCameraComp(const Camera& pCamera, const int pEntityID);
-	void AddCollisionComp(const Collision& pCollision, const int pEntityID);
-	void AddColourComp(const Colour& pColour, const int pEntityID);
-	void AddGeometryComp(const Geometry& pGeometry, const int pEntityID);
-	void AddGravityComp(const Gravity& pGravity, const int pEntityID);
-	void AddPointLightComp(const PointLight& pLight, const int pEntityID);
-	void AddDirectionalLightComp(const DirectionalLight& pLight, const int pEntityID);
-	void AddRayComp(const Ray& pRay, const int pEntityID);
-	void AddShaderComp(const Shader& pShader, const int pEntityID);
-	void AddSphereColliderComp(const SphereCollider& pSphereCollider, const int pEntityID);
-	void AddTextureComp(const Texture& pTexture, const int pEntityID);
-	void AddTransformComp(const Transform& pTransform, const int pEntityID);
-	void AddVelocityComp(const Velocity& pVelocity, const int pEntityID);
+	void AddAIComp(const AI& pAI, const EntityHandle pEntityID);
+	void AddAudioComp(const Audio& pAudio, const EntityHandle pEntityID);
+	void AddBoxColliderComp(const BoxCollider& pBoxCollider, const EntityHandle pEntityID);
+	void AddCameraComp(const Camera& pCamera, const EntityHandle pEntityID);
+	void AddCollisionComp(const Collision& pCollision, const EntityHandle pEntityID);
+	void AddColourComp(const Colour& pColour, const EntityHandle pEntityID);
+	void AddGeometryComp(const Geometry& pGeometry, const EntityHandle pEntityID);
+	void AddGravityComp(const Gravity& pGravity, const EntityHandle pEntityID);
+	void AddPointLightComp(const PointLight& pLight, const EntityHandle pEntityID);
+	void AddDirectionalLightComp(const DirectionalLight& pLight, const EntityHandle pEntityID);
+	void AddRayComp(const Ray& pRay, const EntityHandle pEntityID);
+	void AddShaderComp(const Shader& pShader, const EntityHandle pEntityID);
+	void AddSphereColliderComp(const SphereCollider& pSphereCollider, const EntityHandle pEntityID);
+	void AddTextureComp(const Texture& pTexture, const EntityHandle pEntityID);
+	void AddTransformComp(const Transform& pTransform, const EntityHandle pEntityID);
+	void AddVelocityComp(const Velocity& pVelocity, const EntityHandle pEntityID);
+	void AddParentComp(const Parent& pParent, const EntityHandle pEntityID);
 
 
 	template <class T>
@@ -178,61 +400,56 @@ public:
 	/// <param name="pComponent">Component to add</param>
 	/// <param name="pEntityID">ID of given entity</param>
 	/// <returns>Bool representing whether the addition of this custom component was successful or not</returns>
-	bool AddCustomComponent(const T& pComponent, const int pEntityID)
+	bool AddCustomComponent(const T& pComponent, const EntityHandle pEntityID)
 	{
-		//Loop through custom types to find matching type
-		for (int i = 0; i < mCustomComponentTypes.size(); i++)
+		//Ignore stale handles to destroyed entities and types that haven't been created
+		Entity* const entity = LiveEntity(pEntityID);
+		CustomComponentPool<T>* const customPool = CustomPool<T>();
+		if (!entity || !customPool)
 		{
-			//Check if type matches
-			if (dynamic_cast<T*>(mCustomComponentTypes[i]))
-			{
-				//Retrieve vector that contains this component type and vector that contains this componenet types entity component map and vector that contains this components free list
-				std::vector<unsigned short>* componentEntityMapVector = mCustomComponentEntityMaps[i];
-				std::vector<unsigned short>* componentFreeList = mCustomComponentFreeLists[i];
-				std::vector<T>* componentVector = static_cast<std::vector<T>*>(mCustomComponentVectors[i]);
-
-				if (componentFreeList->empty())
-				{
-					//Push onto back if no free slots and map to back
-					componentVector->push_back(pComponent);
-					(*componentEntityMapVector)[pEntityID] = static_cast<unsigned short>(componentVector->size() - 1);
-				}
-				else
-				{
-					//Insert into free slot and map to free slot
-					(*componentVector)[componentFreeList->back()] = pComponent;
-					(*componentEntityMapVector)[pEntityID] = static_cast<unsigned short>(componentFreeList->back());
-					componentFreeList->pop_back();
-				}
-
-				//Adjust entities mask to contain mask of new component
-				Entity* entity = &mEntities[pEntityID];
-				entity->componentMask |= mCustomComponentMasks[i];
-				AssignEntity(*entity);
-
-				return true;
-			}
+			return false;
+		}
+
+		ComponentPool<T>& pool = customPool->pool;
+		const int index = pEntityID.Index();
+		const ComponentMask oldMask = entity->componentMask;
+
+		if (entity->componentMask.Contains(customPool->componentMask))
+		{
+			//Overwrite existing component
+			pool.components[pool.entityMap[index]] = pComponent;
 		}
-		return false;
+		else
+		{
+			//Store in a free slot or at the back of the pool
+			pool.Place(index, pComponent);
+		}
+
+		//Adjust entities mask to contain mask of new component
+		entity->componentMask |= customPool->componentMask;
+		NotifySystems(pEntityID, oldMask, entity->componentMask);
+
+		return true;
 	};
 
 	//Remove methods for components
-	void RemoveAIComp(const int pEntityID);
-	void RemoveAudioComp(const int pEntityID);
-	void RemoveBoxColliderComp(const int pEntityID);
-	void RemoveCameraComp(const int pEntityID);
-	void RemoveCollisionComp(const int pEntityID);
-	void RemoveColourComp(const int pEntityID);
-	void RemoveGeometryComp(const int pEntityID);
-	void RemoveGravityComp(const int pEntityID);
-	void RemovePointLightComp(const int pEntityID);
-	void RemoveDirectionalLightComp(const int pEntityID);
-	void RemoveRayComp(const int pEntityID);
-	void RemoveShaderComp(const int pEntityID);
-	void RemoveSphereColliderComp(const int pEntityID);
-	void RemoveTextureComp(const int pEntityID);
-	void RemoveTransformComp(const int pEntityID);
-	void RemoveVelocityComp(const int pEntityID);
+	void RemoveAIComp(const EntityHandle pEntityID);
+	void RemoveAudioComp(const EntityHandle pEntityID);
+	void RemoveBoxColliderComp(const EntityHandle pEntityID);
+	void RemoveCameraComp(const EntityHandle pEntityID);
+	void RemoveCollisionComp(const EntityHandle pEntityID);
+	void RemoveColourComp(const EntityHandle pEntityID);
+	void RemoveGeometryComp(const EntityHandle pEntityID);
+	void RemoveGravityComp(const EntityHandle pEntityID);
+	void RemovePointLightComp(const EntityHandle pEntityID);
+	void RemoveDirectionalLightComp(const EntityHandle pEntityID);
+	void RemoveRayComp(const EntityHandle pEntityID);
+	void RemoveShaderComp(const EntityHandle pEntityID);
+	void RemoveSphereColliderComp(const EntityHandle pEntityID);
+	void RemoveTextureComp(const EntityHandle pEntityID);
+	void RemoveTransformComp(const EntityHandle pEntityID);
+	void RemoveVelocityComp(const EntityHandle pEntityID);
+	void RemoveParentComp(const EntityHandle pEntityID);
 
 	template <class T>
 	/// <summary>
@@ -240,53 +457,59 @@ public:
 	/// </summary>
 	/// <param name="pEntityID">ID of the given entity</param>
 	/// <returns>Bool representing whether the removal of this custom component was successful or not</returns>
-	bool RemoveCustomComponent(const int pEntityID)
+	bool RemoveCustomComponent(const EntityHandle pEntityID)
 	{
-		//Loop through custom types to find matching type
-		for (int i = 0; i < mCustomComponentTypes.size(); i++)
+		Entity* const entity = LiveEntity(pEntityID);
+		CustomComponentPool<T>* const customPool = CustomPool<T>();
+
+		//Checks if entity is alive and actually owns a component of this type
+		if (!entity || !customPool || !entity->componentMask.Contains(customPool->componentMask))
 		{
-			//Checks if entity actually owns a component of this type
-			if ((mEntities[pEntityID].componentMask & mCustomComponentMasks[i]) == mCustomComponentMasks[i])
-			{
-				//Check if type matches
-				if (dynamic_cast<T*>(mCustomComponentTypes[i]))
-				{
-					//Retrieve vector that contains this component type and vector that contains this componenet types entity component map
-					std::vector<unsigned short>* componentEntityMapVector = mCustomComponentEntityMaps[i];
-					std::vector<unsigned short>* componentFreeList = mCustomComponentFreeLists[i];
-
-					//Add slot in array to free list
-					componentFreeList->push_back((*componentEntityMapVector)[pEntityID]);
-
-					//Adjust entities mask to no longer contain mask of removed component
-					Entity* entity = &mEntities[pEntityID];
-					entity->componentMask = entity->componentMask &= ~mCustomComponentMasks[i]; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-					ReAssignEntity(*entity);
-
-					return true;
-				}
-			}
+			return false;
 		}
-		return false;
+
+		//Add slot in array to free list
+		customPool->Release(pEntityID.Index());
+		const ComponentMask oldMask = entity->componentMask;
+
+		//Adjust entities mask to no longer contain mask of removed component
+		entity->componentMask &= ~customPool->componentMask; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
+		NotifySystems(pEntityID, oldMask, entity->componentMask);
+
+		return true;
 	}
 
 	//Accessors
-	AI* const AIComp(const int pEntityID);
-	Audio* const AudioComp(const int pEntityID);
-	BoxCollider* const BoxColliderComp(const int pEntityID);
-	Camera* const CameraComp(const int pEntityID);
-	Collision* const CollisionComp(const int pEntityID);
-	Colour* const ColourComp(const int pEntityID);
-	Geometry* const GeometryComp(const int pEntityID);
-	Gravity* const GravityComp(const int pEntityID);
-	PointLight* const PointLightComp(const int pEntityID);
-	DirectionalLight* const DirectionalLightComp(const int pEntityID);
-	Ray* const RayComp(const int pEntityID);
-	Shader* const ShaderComp(const int pEntityID);
-	SphereCollider* const SphereColliderComp(const int pEntityID);
-	Texture* const TextureComp(const int pEntityID);
-	Transform* const TransformComp(const int pEntityID);
-	Velocity* const VelocityComp(const int pEntityID);
+	AI* const AIComp(const EntityHandle pEntityID);
+	Audio* const AudioComp(const EntityHandle pEntityID);
+	BoxCollider* const BoxColliderComp(const EntityHandle pEntityID);
+	Camera* const CameraComp(const EntityHandle pEntityID);
+	Collision* const CollisionComp(const EntityHandle pEntityID);
+	Colour* const ColourComp(const EntityHandle pEntityID);
+	Geometry* const GeometryComp(const EntityHandle pEntityID);
+	Gravity* const GravityComp(const EntityHandle pEntityID);
+	PointLight* const PointLightComp(const EntityHandle pEntityID);
+	DirectionalLight* const DirectionalLightComp(const EntityHandle pEntityID);
+	Ray* const RayComp(const EntityHandle pEntityID);
+	Shader* const ShaderComp(const EntityHandle pEntityID);
+	SphereCollider* const SphereColliderComp(const EntityHandle pEntityID);
+	Texture* const TextureComp(const EntityHandle pEntityID);
+	Transform* const TransformComp(const EntityHandle pEntityID);
+	Velocity* const VelocityComp(const EntityHandle pEntityID);
+	Parent* const ParentComp(const EntityHandle pEntityID);
+
+	template <class T>
+	/// <summary>
+	/// Get built in component of type T for the given entity without recording a change
+	/// The modifiable accessors mark the component as changed, so read only access should go through this method to keep change filters accurate
+	/// </summary>
+	/// <param name="pEntityID">ID of given entity</param>
+	/// <returns>Read only handle to the component of type T, nullptr if the entity doesn't own one</returns>
+	const T* const Read(const EntityHandle pEntityID)
+	{
+		static_assert(static_cast<int>(ComponentTraits<T>::MASK) != ComponentType::COMPONENT_NONE, "Only built in components can be read by type");
+		return Component(*Pool(static_cast<const T*>(nullptr)), ComponentTraits<T>::MASK, pEntityID);
+	}
 
 	template <class T>
 	/// <summary>
@@ -294,26 +517,40 @@ public:
 	/// </summary>
 	/// <param name="pEntityID">ID of given entity</param>
 	/// <returns>Modifiable handle to the component of type T</returns>
-	T* const GetCustomComponent(const int pEntityID)
+	T* const GetCustomComponent(const EntityHandle pEntityID)
 	{
-		//Loop through custom types to find matching type
-		for (int i = 0; i < mCustomComponentTypes.size(); i++)
+		const Entity* const entity = LiveEntity(pEntityID);
+		CustomComponentPool<T>* const customPool = CustomPool<T>();
+
+		//Checks if entity is alive and actually owns a component of this type
+		if (!entity || !customPool || !entity->componentMask.Contains(customPool->componentMask))
 		{
-			//Checks if entity actually owns a component of this type
-			if ((mEntities[pEntityID].componentMask & mCustomComponentMasks[i]) == mCustomComponentMasks[i])
-			{
-				//Check if type matches
-				if (dynamic_cast<T*>(mCustomComponentTypes[i]))
-				{
-					//Retrieve vector that contains this component type and vector that contains this componenet types entity component map
-					std::vector<unsigned short>* componentEntityMapVector = mCustomComponentEntityMaps[i];
-					std::vector<T>* componentVector = static_cast<std::vector<T>*>(mCustomComponentVectors[i]);
-
-					//Gets the index of the component from the map, then retrieves the component from the component vector
-					return static_cast<T*>(&((*componentVector)[(*componentEntityMapVector)[pEntityID]]));
-				}
-			}
+			return nullptr;
 		}
-		return nullptr;
+
+		//Gets the index of the component from the map, then retrieves the component from the component vector
+		return &customPool->pool.components[customPool->pool.entityMap[pEntityID.Index()]];
 	};
-};
\ No newline at end of file
+};
+
+//Custom component commands are defined here as applying them requires the complete ECS manager type
+template <class T>
+/// <summary>
+/// Records the addition of a custom component of type T to the given entity
+/// </summary>
+/// <param name="pComponent">Component to add</param>
+/// <param name="pEntityID">ID of given entity</param>
+void EntityCommandBuffer::AddCustomComponent(const T& pComponent, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddCustomComponent(*static_cast<const T*>(pComponent), pEntityID); }, pComponent, pEntityID);
+}
+
+template <class T>
+/// <summary>
+/// Records the removal of the custom component of type T from the given entity
+/// </summary>
+/// <param name="pEntityID">ID of the given entity</param>
+void EntityCommandBuffer::RemoveCustomComponent(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveCustomComponent<T>(pEntityID); }, pEntityID);
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 #include "ObjLoader.h"
+#include "ResourceHandle.h"
 #include <wrl/client.h>
 #include "VBO_DX.h"
 #include "ShaderObject_DX.h"
@@ -19,11 +20,28 @@ class RenderSystem;
 
 class ResourceManager
 {
-	std::vector< std::pair< std::wstring, TextureObject*>> mTextures{};
-	std::vector< std::pair< std::wstring, VBO*>> mGeometries{};
-	std::vector< std::pair< std::wstring, ShaderObject*>> mShaders{};
+	//Loaded resources indexed by the ID of their resource handle, nullptr if the resource hasn't been loaded
+	std::vector<TextureObject*> mTextures{};
+	std::vector<VBO*> mGeometries{};
+	std::vector<ShaderObject*> mShaders{};
 	//std::vector< std::pair< std::wstring, Microsoft::WRL::ComPtr< ID3D11Buffer >>> mInstances{};
-	std::vector<std::pair<std::wstring, Sound*>> mSounds;
+	std::vector<Sound*> mSounds;
+
+	template <class T>
+	/// <summary>
+	/// Returns the slot of the resource with the given handle ID, growing the given resources so the slot exists
+	/// </summary>
+	/// <param name="pResources">Resources of a single type indexed by handle ID</param>
+	/// <param name="pID">ID of the resource handle</param>
+	/// <returns>Modifiable reference to the slot</returns>
+	static T*& Slot(std::vector<T*>& pResources, const unsigned int pID)
+	{
+		if (pID >= pResources.size())
+		{
+			pResources.resize(pID + 1, nullptr);
+		}
+		return pResources[pID];
+	}
 
 	//Private constructor for singleton pattern
 	ResourceManager();
@@ -39,10 +57,10 @@ public:
 	ResourceManager(const ResourceManager& pResourceManager) = delete;
 	ResourceManager& operator=(ResourceManager const&) = delete;
 
-	const TextureObject* const LoadTexture(const RenderSystem* const pRenderer, const std::wstring& pFilename);
-	VBO* const LoadGeometry(const RenderSystem* const pRenderer, const std::wstring& pFilename);
-	const Sound* const LoadAudio(const AudioSystem* const pAudioSystem, std::wstring& pFileName);
-	const ShaderObject* const LoadShader(const RenderSystem* const pRenderer, const std::wstring& pFilename);
+	const TextureObject* const LoadTexture(const RenderSystem* const pRenderer, const TextureHandle pTexture);
+	VBO* const LoadGeometry(const RenderSystem* const pRenderer, const GeometryHandle pGeometry);
+	const Sound* const LoadAudio(const AudioSystem* const pAudioSystem, const AudioHandle pAudio);
+	const ShaderObject* const LoadShader(const RenderSystem* const pRenderer, const ShaderHandle pShader);
 
 
 	static std::shared_ptr< ResourceManager > Instance();
@@ -34,6 +34,14 @@ private:
 	std::array<double, 50> mLast50Frames;
 	bool mDeltaTimeSet = false;
 
+	//Fixed step simulation, elapsed time is collected in the accumulator and the systems are stepped once for every whole tick it holds
+	bool mFixedStep = false;
+	std::chrono::nanoseconds mTickLength = std::chrono::nanoseconds(1000000000 / 60);
+	std::chrono::nanoseconds mAccumulator = std::chrono::nanoseconds(0);
+	int mMaxCatchUpSteps = 5;
+	double mInterpolationAlpha = 1;
+	bool mStepping = false;
+
 	//Active scene
 	std::shared_ptr<Scene> mScene;
 
@@ -53,6 +61,14 @@ public:
 	const double Time() const;
 	const int& Fps() const;
 
+	//Fixed step functions
+	void SetFixedStep(const bool pFixedStep);
+	void SetTickRate(const int pTicksPerSecond);
+	void SetMaxCatchUpSteps(const int pMaxCatchUpSteps);
+	const bool FixedStep() const;
+	const int TickRate() const;
+	const double InterpolationAlpha() const;
+
 	//Window width/height functions
 	void SetWindowWidthHeight(const float& pWidth, const float& pHeight);
 	const float& WindowWidth() const;
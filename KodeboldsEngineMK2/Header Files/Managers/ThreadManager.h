@@ -1,19 +1,55 @@
 #pragma once
 #include "Thread.h"
+#include "JobHandle.h"
+#include "ServiceThread.h"
 #include <vector>
 #include <memory>
-#include <queue>
+#include <deque>
 #include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <type_traits>
+#include <utility>
 
 class ThreadManager
 {
 private:
 	std::vector<Thread*> mThreads;
-	std::queue<Task*> mTasks;
+
+	//Jobs added by threads that aren't workers, taken by whichever worker gets to them first
+	//Tasks may block, so they are kept apart from jobs and are only ever run by a worker looking for work, never by a thread waiting on a job
+	std::deque<Task*> mSharedJobs;
+	std::deque<Task*> mSharedTasks;
+	std::mutex mSharedMutex;
+	std::atomic<int> mSharedJobCount;
+	std::atomic<int> mSharedTaskCount;
+
+	//Idle workers spin briefly then sleep until a task is added
+	std::mutex mSleepMutex;
+	std::condition_variable mTaskAvailable;
+	std::atomic<int> mSleepingThreads;
+	int mWakeSignals;
+
+	//Threads running blocking or long running tasks outside of the workers
+	std::vector<ServiceThread*> mServiceThreads;
+	std::mutex mServiceMutex;
 
 	//Private constructor for singleton pattern
 	ThreadManager();
 
+	Thread* CurrentWorker() const;
+	void Schedule(Task* const pTask);
+	Task* TakeShared(std::deque<Task*>& pQueue, std::atomic<int>& pCount);
+	Task* StealJob(Thread* const pThief);
+	Task* FindJob(Thread* const pWorker);
+	Task* FindTask(const int pThreadIndex);
+	void WakeThread();
+
+	JobHandle QueueTask(Task* const pTask);
+	JobHandle QueueJob(Task* const pJob, const std::vector<JobHandle>& pDependencies);
+	JobHandle QueueService(Task* const pTask, const THREAD_PRIORITY pPriority);
+	void ParallelRanges(const int pBegin, const int pEnd, const int pGrainSize, void(*pFunction)(void* pContext, const int pRangeBegin, const int pRangeEnd), void* const pContext);
+
 public:
 	~ThreadManager();
 
@@ -22,8 +58,77 @@ public:
 	ThreadManager(const ThreadManager& ThreadManager) = delete;
 	ThreadManager& operator=(ThreadManager const&) = delete;
 
-	Task* const AddTask(std::function<void(void* param1, void* param2)> pFunction, void* pParam1, void* pParam2, const std::vector<int>& pThreadAffinity);
-	void ProcessTasks();
+	//Tasks may block for a short time, jobs are short pieces of work that can depend on other jobs
+	//Tasks that block or loop for the life of the program belong on a service thread, so they don't take a worker away from the jobs of each frame
+	//Functions are stored inside the task, so they must fit in Task::STORAGE_SIZE
+	template <class F>
+	/// <summary>
+	/// Adds a new task, tasks can be added from any thread
+	/// Tasks may block, so they are only taken by workers looking for work and never by threads waiting on a job
+	/// </summary>
+	/// <param name="pFunction">Function taking (void*, void*) that holds the task</param>
+	/// <param name="pParam1">First parameter of the function</param>
+	/// <param name="pParam2">Second parameter of the function</param>
+	/// <param name="pThreadAffinity">Thread affinity to set the task to</param>
+	/// <returns>A handle to the created task so that the tasks completion can be monitored, the task is cleaned up once it has run and every handle to it is gone</returns>
+	JobHandle AddTask(F&& pFunction, void* pParam1, void* pParam2, const CoreMask& pThreadAffinity)
+	{
+		return QueueTask(new Task(std::forward<F>(pFunction), pParam1, pParam2, pThreadAffinity));
+	};
+
+	template <class F>
+	/// <summary>
+	/// Adds a new job that runs once every job it depends on has finished, jobs can be added from any thread
+	/// </summary>
+	/// <param name="pFunction">Function taking (void*, void*) that holds the job</param>
+	/// <param name="pParam1">First parameter of the function</param>
+	/// <param name="pParam2">Second parameter of the function</param>
+	/// <param name="pDependencies">Jobs that must finish before this job runs, empty handles are ignored</param>
+	/// <returns>A handle to the created job so that it can be waited on or depended on, the job is cleaned up once it has run and every handle to it is gone</returns>
+	JobHandle AddJob(F&& pFunction, void* pParam1, void* pParam2, const std::vector<JobHandle>& pDependencies = std::vector<JobHandle>{})
+	{
+		return QueueJob(new Task(std::forward<F>(pFunction), pParam1, pParam2, CoreMask()), pDependencies);
+	};
+
+	template <class F>
+	/// <summary>
+	/// Starts a service thread that runs the given function, for work that blocks or runs for the life of the program such as network loops
+	/// The thread exits once the function returns
+	/// </summary>
+	/// <param name="pFunction">Function taking (void*, void*) that holds the work</param>
+	/// <param name="pParam1">First parameter of the function</param>
+	/// <param name="pParam2">Second parameter of the function</param>
+	/// <param name="pThreadAffinity">Cores the service thread may run on, empty to let the OS place the thread</param>
+	/// <param name="pPriority">Priority of the service thread</param>
+	/// <returns>A handle to the work so that its completion can be monitored</returns>
+	JobHandle StartService(F&& pFunction, void* pParam1, void* pParam2, const CoreMask& pThreadAffinity, const THREAD_PRIORITY pPriority = THREAD_PRIORITY::NORMAL)
+	{
+		return QueueService(new Task(std::forward<F>(pFunction), pParam1, pParam2, pThreadAffinity), pPriority);
+	};
+
+	void Wait(const JobHandle& pJob);
+
+	template <class F>
+	/// <summary>
+	/// Splits the given range into ranges of the grain size and calls the given function on each of them across the workers, returning once every range has been processed
+	/// </summary>
+	/// <param name="pBegin">First index of the range</param>
+	/// <param name="pEnd">Index past the last index of the range</param>
+	/// <param name="pGrainSize">Number of indices processed together by a single call of the function</param>
+	/// <param name="pFunction">Function taking the first index and the index past the last index of a range, called from several threads at once</param>
+	void ParallelFor(const int pBegin, const int pEnd, const int pGrainSize, F&& pFunction)
+	{
+		typedef typename std::remove_reference<F>::type Function;
+		ParallelRanges(pBegin, pEnd, pGrainSize, [](void* pContext, const int pRangeBegin, const int pRangeEnd) { (*static_cast<Function*>(pContext))(pRangeBegin, pRangeEnd); },
+			const_cast<void*>(static_cast<const void*>(&pFunction)));
+	};
+
+	//Workers
+	Task* WaitForTask(const int pThreadIndex);
+	void RunTask(Task* const pTask);
+	int ThreadCount() const;
+	void PinWorkers(const std::vector<int>& pCores);
+	int ServiceThreadCount();
 
 	static std::shared_ptr< ThreadManager > Instance();
-};
\ No newline at end of file
+};
@@ -9,7 +9,7 @@
 class AudioSystem : public ISystem
 {
 protected:
-	AudioSystem(const std::vector<int>& pMasks);
+	AudioSystem(const std::vector<ComponentMask>& pMasks, const ComponentMask& pReadMask, const ComponentMask& pWriteMask);
 
 	std::shared_ptr<ECSManager> mEcsManager = ECSManager::Instance();
 	std::shared_ptr<ResourceManager>  mResourceManager = ResourceManager::Instance();
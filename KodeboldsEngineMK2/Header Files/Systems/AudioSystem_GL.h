@@ -10,8 +10,8 @@ public:
 	explicit AudioSystem_GL();
 	virtual ~AudioSystem_GL();
 
-	void AssignEntity(const Entity& pEntity) override;
-	void ReAssignEntity(const Entity& pEntity) override;
+	void OnEnter(const Entity& pEntity, const int pMaskIndex) override;
+	void OnExit(const Entity& pEntity, const int pMaskIndex) override;
 	void Process() override;
 
 	const Sound* LoadAudio(const Entity& pEntity) override;
@@ -3,6 +3,8 @@
 #include "OctTreeNode.h"
 #include "ISystem.h"
 #include <queue>
+#include <unordered_map>
+#include "CollisionEventStream.h"
 
 class CollisionCheckSystem : public ISystem
 {
@@ -12,29 +14,39 @@ private:
 	const int MAX_OCTANT_SIZE;
 	const int MIN_OCTANT_SIZE;
 	OctTreeNode* mOctTree;
-	std::queue<unsigned short> mEntitiesToInsert;
-	std::queue<unsigned short> mEntitiesToRemove;
+	std::queue<EntityHandle> mEntitiesToInsert;
+	std::queue<EntityHandle> mEntitiesToRemove;
 	std::vector<OctTreeNode*> mEntityNodeMap;
+	CollisionEventStream mEvents;
+	std::unordered_map<unsigned long long, CollisionEvent> mContacts;
+	std::unordered_map<unsigned long long, CollisionEvent> mPreviousContacts;
+	unsigned int mLastVersion;
 
 	void ConstructTree();
 	void SplitRegion(OctTreeNode* const pRegion) const;
 	void UpdateTree();
-	void Insert(OctTreeNode* const pNode, const unsigned short pEntity);
-	void HandleCollisions(OctTreeNode* const pNode, std::vector<unsigned short> pParentEntities);
-	void CollisionBetweenEntities(const unsigned short pEntityA, const unsigned short pEntityB);
+	void Insert(OctTreeNode* const pNode, const EntityHandle pEntity);
+	void HandleCollisions(OctTreeNode* const pNode, std::vector<EntityHandle> pParentEntities);
+	void CollisionBetweenEntities(const EntityHandle pEntityA, const EntityHandle pEntityB);
+	void AddContact(const EntityHandle pEntityA, const int pCollisionMaskA, const EntityHandle pEntityB, const int pCollisionMaskB);
+	void EndContacts();
 	bool RaySphere();
 	bool SphereSphere(const KodeboldsMath::Vector3& pSpherePosA, const SphereCollider* const pSphereColliderA, const KodeboldsMath::Vector3& pSpherePosB, const SphereCollider* const pSphereColliderB);
 	bool BoxSphere(const BoxCollider* const pBox, const KodeboldsMath::Vector3& pSpherePos, const SphereCollider* const pSphere);
 	bool BoxBox(const BoxCollider* const pBoxA, const BoxCollider* const pBoxB);
 	bool RayBox();
-	bool BoxInsideRegion(OctTreeNode* const pNode, const unsigned short pEntity) const;
-	bool SphereInsideRegion(OctTreeNode* const pNode, const unsigned short pEntity) const;
+	bool BoxInsideRegion(OctTreeNode* const pNode, const BoxCollider* const pBox) const;
+	bool SphereInsideRegion(OctTreeNode* const pNode, const KodeboldsMath::Vector4& pSpherePos, const SphereCollider* const pSphere) const;
+	void RequeueMovedEntity(const EntityHandle pEntity, const Transform& pTransform, const BoxCollider* const pBox, const SphereCollider* const pSphere);
 
 public:
 	CollisionCheckSystem(const int pMaxOctantSize, const int pMinOctantSize);
 	virtual ~CollisionCheckSystem();
 
-	void AssignEntity(const Entity& pEntity) override;
-	void ReAssignEntity(const Entity& pEntity) override;
+	void OnEnter(const Entity& pEntity, const int pMaskIndex) override;
+	void OnExit(const Entity& pEntity, const int pMaskIndex) override;
 	void Process() override;
+
+	//Accessors
+	const CollisionEventStream& Events() const;
 };
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include "ISystem.h"
+#include "ComponentView.h"
+#include "ThreadManager.h"
+
+//System whose work on each entity is independent of every other entity, so its entities can be split across the worker threads
+//Process doesn't return until every part has been processed, so systems that depend on this one still see all of its writes
+class IParallelSystem : public ISystem
+{
+protected:
+	std::shared_ptr<ThreadManager> mThreadManager = ThreadManager::Instance();
+
+	//Number of entities of sparse storage, or chunks of archetype storage, handed to a worker at a time
+	int mGrainSize;
+	int mChunkGrainSize;
+
+	IParallelSystem(const std::vector<ComponentMask>& pMasks, const ComponentMask& pReadMask, const ComponentMask& pWriteMask, const int pGrainSize = 256, const int pChunkGrainSize = 2)
+		: ISystem(pMasks, pReadMask, pWriteMask), mGrainSize(pGrainSize), mChunkGrainSize(pChunkGrainSize) {};
+
+	template <class F, class... Ts>
+	/// <summary>
+	/// Splits the given view across the worker threads and calls the given function for every matching entity, returning once every entity has been processed
+	/// The function is called from several threads at once, so it must only write to the entity it is given
+	/// </summary>
+	/// <param name="pView">View to process</param>
+	/// <param name="pFunction">Function taking (const EntityHandle, Ts&...)</param>
+	void ParallelForEach(const ComponentView<Ts...>& pView, const F& pFunction) const
+	{
+		const int grainSize = pView.Storage() == StorageMode::ARCHETYPE ? mChunkGrainSize : mGrainSize;
+		mThreadManager->ParallelFor(0, pView.Partitions(), grainSize, [&pView, &pFunction](const int pBegin, const int pEnd)
+		{
+			pView.ForEach(pBegin, pEnd, pFunction);
+		});
+	};
+
+public:
+	virtual ~IParallelSystem() {};
+
+	//Grain sizes trade the cost of handing out work against how evenly it is shared between the workers
+	void SetGrainSize(const int pGrainSize, const int pChunkGrainSize) { mGrainSize = pGrainSize; mChunkGrainSize = pChunkGrainSize; };
+};
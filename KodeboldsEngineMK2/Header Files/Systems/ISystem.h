@@ -2,17 +2,41 @@
 #include <vector>
 #include "Components.h"
 #include "Entity.h"
+#include "EntityList.h"
+#include "FrameContext.h"
 
 class ISystem
 {
 protected:
-	std::vector<Entity> mEntities;
-	std::vector<int> mMasks;
-	ISystem(const std::vector<int>& pMasks) : mMasks(pMasks) {};
+	EntityList mEntities;
+	std::vector<ComponentMask> mMasks;
+	ComponentMask mReadMask;
+	ComponentMask mWriteMask;
+
+	//Systems that don't declare the components they read and write are assumed to access every component and always run on their own
+	ISystem(const std::vector<ComponentMask>& pMasks) : mMasks(pMasks), mReadMask(AllComponents()), mWriteMask(AllComponents()) {};
+	ISystem(const std::vector<ComponentMask>& pMasks, const ComponentMask& pReadMask, const ComponentMask& pWriteMask) : mMasks(pMasks), mReadMask(pReadMask), mWriteMask(pWriteMask) {};
 
 public:
+	//Read or write mask covering every built in and custom component
+	static ComponentMask AllComponents() { return ~ComponentMask(); };
+
 	virtual ~ISystem() {};
 	virtual void Process() = 0;
-	virtual void AssignEntity(const Entity& pEntity) = 0;
-	virtual void ReAssignEntity(const Entity& pEntity) = 0;
+	const std::vector<ComponentMask>& Masks() const { return mMasks; };
+
+	//Components the system reads and writes during Process, used by the ECS manager to run systems that don't conflict at the same time
+	const ComponentMask& ReadMask() const { return mReadMask; };
+	const ComponentMask& WriteMask() const { return mWriteMask; };
+
+	//Called by the ECS manager on the main thread before the last simulation step of each frame, the render system records the state it interpolates from here
+	virtual void BeforeFinalStep() {};
+	//Called by the ECS manager on the main thread at the end of each frame, the render system copies the state it draws into the frames context here
+	virtual void Extract(FrameContext& pFrame) {};
+	//Called by the ECS manager on the render thread for each extracted frame in order, while the main thread simulates the frames after it
+	virtual void ProcessFrame(const FrameContext& pFrame) { Process(); };
+
+	//Called by the ECS manager only when an entity starts or stops matching the mask at the given index of the systems masks
+	virtual void OnEnter(const Entity& pEntity, const int pMaskIndex) = 0;
+	virtual void OnExit(const Entity& pEntity, const int pMaskIndex) = 0;
 };
\ No newline at end of file
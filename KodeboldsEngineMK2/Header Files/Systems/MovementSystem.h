@@ -1,10 +1,10 @@
 #pragma once
 #include "ECSManager.h"
 #include "SceneManager.h"
-#include "ISystem.h"
+#include "IParallelSystem.h"
 #include "Vector4.h"
 
-class MovementSystem : public ISystem
+class MovementSystem : public IParallelSystem
 {
 private:
 	const float mGravityAccel = -9.81f;
@@ -12,11 +12,19 @@ private:
 	std::shared_ptr<ECSManager> mEcsManager = ECSManager::Instance();
 	std::shared_ptr<SceneManager> mSceneManager = SceneManager::Instance();
 
+	//Chunks of the archetypes matching the movement mask, gathered each frame so they can be split across the workers
+	std::vector<std::pair<Archetype*, int>> mChunks;
+
+	KodeboldsMath::Vector3 Move(Transform& pTransform, Velocity& pVelocity, const bool pGravity, const float pDeltaTime) const;
+	void MoveBounds(BoxCollider& pBoxCollider, const KodeboldsMath::Vector3& pDisplacement) const;
+	void ProcessChunk(const Archetype& pArchetype, const int pChunk, const float pDeltaTime) const;
+	void ProcessChunks(const float pDeltaTime);
+
 public:
 	MovementSystem();
 	virtual ~MovementSystem();
 
-	void AssignEntity(const Entity& pEntity) override;
-	void ReAssignEntity(const Entity& pEntity) override;
+	void OnEnter(const Entity& pEntity, const int pMaskIndex) override;
+	void OnExit(const Entity& pEntity, const int pMaskIndex) override;
 	void Process() override;
 };
\ No newline at end of file
@@ -8,11 +8,12 @@
 #include "Vector4.h"
 #include "Components.h"
 #include "SceneManager.h"
+#include "RenderFrame.h"
 
 class RenderSystem : public ISystem
 {
 protected:
-	RenderSystem(const std::vector<int>& pMasks, const int pMaxPointLight, const int pMaxDirLights);
+	RenderSystem(const std::vector<ComponentMask>& pMasks, const int pMaxPointLight, const int pMaxDirLights);
 
 	std::shared_ptr<GUIManager> mGUIManager = GUIManager::Instance();
 	std::shared_ptr<ECSManager> mEcsManager = ECSManager::Instance();
@@ -22,6 +23,31 @@ protected:
 	int mMaxPointLights;
 	int mMaxDirLights;
 
+	std::vector<Entity> mPointLights;
+	std::vector<Entity> mDirectionalLights;
+	std::vector<Entity> mCameras;
+
+	//Frame the render thread is drawing, owned by a frame context of the ECS manager while the main thread extracts later frames into the other contexts
+	const RenderFrame* mFrame;
+
+	//Every material extracted so far, materials are never removed so material keys stay valid between frames
+	std::vector<RenderMaterial> mMaterials;
+	//Material key of each renderable entity indexed by entity index, -1 if it needs finding again
+	std::vector<int> mEntityMaterials;
+	unsigned int mLastVersion;
+
+	//Transform of each renderable entity, camera and light before the last simulation step indexed by entity index, and whether it has been recorded since the entity entered the system
+	std::vector<Transform> mPreviousTransforms;
+	std::vector<bool> mHasPreviousTransforms;
+
+	int MaterialKey(const EntityHandle pEntityID);
+	void InvalidateMaterials();
+	void RecordPreviousTransform(const EntityHandle pEntityID);
+	const Transform& PreviousTransform(const EntityHandle pEntityID, const Transform& pTransform) const;
+	const RenderFrame& Frame() const;
+	KodeboldsMath::Matrix4 InterpolatedWorld(const RenderItem& pItem) const;
+	KodeboldsMath::Vector4 Interpolate(const KodeboldsMath::Vector4& pPrevious, const KodeboldsMath::Vector4& pCurrent) const;
+
 public:
 	virtual ~RenderSystem() {};
 
@@ -38,10 +64,16 @@ public:
 
 	virtual void ClearView() const = 0;
 	virtual void SwapBuffers() const = 0;
-	virtual void LoadGeometry(const Entity& pEntity) = 0;
-	virtual bool LoadShaders(const Entity& pEntity) = 0;
-	virtual void LoadTexture(const Entity& pEntity) = 0;
+	virtual void LoadGeometry(const RenderMaterial& pMaterial) = 0;
+	virtual bool LoadShaders(const RenderMaterial& pMaterial) = 0;
+	virtual void LoadTexture(const RenderMaterial& pMaterial) = 0;
 	virtual void SetViewProj() = 0;
 	virtual void SetLights() = 0;
 	virtual void SetCamera() = 0;
+
+	void OnEnter(const Entity& pEntity, const int pMaskIndex) override;
+	void OnExit(const Entity& pEntity, const int pMaskIndex) override;
+	void BeforeFinalStep() override;
+	void Extract(FrameContext& pFrame) override;
+	void ProcessFrame(const FrameContext& pFrame) override;
 };
@@ -11,19 +11,17 @@
 class RenderSystem_DX : public RenderSystem
 {
 private:
-	std::vector<Entity> mPointLights;
-	std::vector<Entity> mDirectionalLights;
-	std::vector<Entity> mCameras;
 	HWND mWindow;
 	UINT mWidth{};
 	UINT mHeight{};
-	const Entity* mActiveCamera;
+	const RenderCamera* mActiveCamera;
 	VBO* mGeometry{};
 	ConstantBuffer mCB{};
 	LightingBuffer mLightCB{};
 
-	std::wstring mActiveGeometry;
-	std::wstring mActiveShader;
+	GeometryHandle mActiveGeometry;
+	ShaderHandle mActiveShader;
+	ShaderHandle mDepthShader;
 	BlendState mActiveBlend;
 	CullState mActiveCull;
 	DepthState mActiveDepth;
@@ -82,24 +80,21 @@ private:
 
 	void ClearView() const override;
 	void SwapBuffers() const override;
-	void LoadGeometry(const Entity& pEntity) override;
-	bool LoadShaders(const Entity& pEntity) override;
-	void LoadTexture(const Entity& pEntity) override;
+	void LoadGeometry(const RenderMaterial& pMaterial) override;
+	bool LoadShaders(const RenderMaterial& pMaterial) override;
+	void LoadTexture(const RenderMaterial& pMaterial) override;
 
 	void SetViewProj() override;
 	void SetLights() override;
 	void SetCamera() override;
 
-	void Render();
+	void Render(const RenderFrame& pFrame);
 	void RenderGUI() const;
 
 public:
 	explicit RenderSystem_DX(const HWND& pWindow, const int pMaxPointLights, const int pMaxDirLights, const int pRenderTextures);
 	virtual ~RenderSystem_DX();
 
-
-	void AssignEntity(const Entity& pEntity) override;
-	void ReAssignEntity(const Entity& pEntity) override;
 	void Process() override;
 	Microsoft::WRL::ComPtr<ID3D11Device> Device() const { return mDevice; }
 	Microsoft::WRL::ComPtr<ID3D11DeviceContext> Context() const { return mContext; }
@@ -6,15 +6,16 @@
 class RenderSystem_GL : public RenderSystem
 {
 private:
-	std::vector<Entity> mLights;
 	HWND mWindow;
 	UINT mWidth{};
 	UINT height{};
-	const Entity* mActiveCamera;
+	const RenderCamera* mActiveCamera;
 	VBO* mGeometry;
+	//World matrix of the item being drawn, blended between the last two simulation steps
+	KodeboldsMath::Matrix4 mWorld;
 
-	std::wstring mActiveGeometry;
-	std::wstring mActiveShader;
+	GeometryHandle mActiveGeometry;
+	ShaderHandle mActiveShader;
 
 	HRESULT Init() override;
 	HRESULT CreateDevice() override;
@@ -30,9 +31,9 @@ private:
 
 	void ClearView() const override;
 	void SwapBuffers() const override;
-	void LoadGeometry(const Entity& pEntity) override;
-	bool LoadShaders(const Entity& pEntity) override;
-	void LoadTexture(const Entity& pEntity) override;
+	void LoadGeometry(const RenderMaterial& pMaterial) override;
+	bool LoadShaders(const RenderMaterial& pMaterial) override;
+	void LoadTexture(const RenderMaterial& pMaterial) override;
 
 	void SetViewProj() override;
 	void SetLights() override;
@@ -41,9 +42,6 @@ public:
 	explicit RenderSystem_GL(const HWND& pWindow, const int pMaxPointLights, const int pDirLights);
 	virtual ~RenderSystem_GL();
 
-
-	void AssignEntity(const Entity& pEntity) override;
-	void ReAssignEntity(const Entity& pEntity) override;
 	void Process() override;
 
 };
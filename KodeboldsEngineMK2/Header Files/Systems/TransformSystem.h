@@ -1,22 +1,42 @@
 #pragma once
-#include "ISystem.h"
+#include "IParallelSystem.h"
 #include "KodeboldsMath.h"
 #include "ECSManager.h"
 
-class TransformSystem : public ISystem
+class TransformSystem : public IParallelSystem
 {
 private:
+	//An entity with children or a parent, parents always come before their children
+	struct HierarchyNode
+	{
+		EntityHandle entity;
+		EntityHandle parent;
+		int parentNode;
+	};
+
 	std::shared_ptr<ECSManager> mEcsManager = ECSManager::Instance();
+	unsigned int mLastVersion;
+
+	//Hierarchy sorted by depth, with siblings next to each other, so transforms can be propagated from parent to child in a single pass
+	std::vector<HierarchyNode> mHierarchy;
+	std::vector<int> mHierarchyNodes;
+	std::vector<unsigned char> mDirtyNodes;
+	bool mHierarchyChanged;
+	int mOrphanCount;
+
+	void CalculateTransform(Transform& pTransform) const;
+	void CalculateDirections(Transform& pTransform) const;
+	void ExtractTransformations(Transform& pTransform) const;
 
-	void CalculateTransform(const unsigned short pEntity);
-	void CalculateDirections(const unsigned short pEntity);
-	void ExtractTransformations(const unsigned short pEntity);
+	int HierarchyNodeIndex(const EntityHandle pEntityID) const;
+	void BuildHierarchy();
+	void PropagateHierarchy();
 
 public:
 	TransformSystem();
 	virtual ~TransformSystem();
 
-	void AssignEntity(const Entity& pEntity) override;
-	void ReAssignEntity(const Entity& pEntity) override;
+	void OnEnter(const Entity& pEntity, const int pMaskIndex) override;
+	void OnExit(const Entity& pEntity, const int pMaskIndex) override;
 	void Process() override;
 };
\ No newline at end of file
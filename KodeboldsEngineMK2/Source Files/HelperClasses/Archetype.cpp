@@ -0,0 +1,248 @@
+#include "Archetype.h"
+
+/// <summary>
+/// Constructs an archetype for the given component mask
+/// Lays out one contiguous column per component type after the entity index column and calculates how many entities fit in a single chunk
+/// </summary>
+/// <param name="pComponentMask">Component mask shared by every entity stored in this archetype</param>
+/// <param name="pColumnTypes">Column types of the components in the mask, ordered by component mask</param>
+Archetype::Archetype(const int pComponentMask, const std::vector<const ComponentColumnType*>& pColumnTypes)
+	:mComponentMask(pComponentMask), mChunkCapacity(0), mEntityCount(0), mColumnTypes(pColumnTypes), mColumnLookup(32, -1)
+{
+	//Bytes required per entity without padding
+	size_t entitySize = sizeof(int);
+	for (const auto& columnType : mColumnTypes)
+	{
+		entitySize += columnType->size;
+	}
+
+	//Shrink capacity until every column, including alignment padding, fits within the chunk
+	mChunkCapacity = static_cast<int>(CHUNK_SIZE / entitySize);
+	while (mChunkCapacity > 0)
+	{
+		mColumns.clear();
+		size_t offset = sizeof(int) * mChunkCapacity;
+
+		for (const auto& columnType : mColumnTypes)
+		{
+			offset = (offset + columnType->alignment - 1) & ~(columnType->alignment - 1);
+			mColumns.push_back(Column{ columnType, offset });
+			offset += columnType->size * mChunkCapacity;
+		}
+
+		if (offset <= CHUNK_SIZE)
+		{
+			break;
+		}
+		mChunkCapacity--;
+	}
+
+	//Map the bit index of each component to its column
+	for (int i = 0; i < mColumns.size(); i++)
+	{
+		mColumnLookup[MaskIndex(mColumns[i].type->componentMask)] = i;
+	}
+}
+
+/// <summary>
+/// Destructor
+/// Destroys every component still stored in the archetype and frees the chunks
+/// </summary>
+Archetype::~Archetype()
+{
+	for (int row = 0; row < mEntityCount; row++)
+	{
+		for (const auto& column : mColumns)
+		{
+			column.type->destruct(Element(row, column));
+		}
+	}
+
+	for (auto& chunk : mChunks)
+	{
+		::operator delete(chunk);
+	}
+}
+
+/// <summary>
+/// Calculates the address of the component in the given column at the given row
+/// </summary>
+/// <param name="pRow">Row of the entity within the archetype</param>
+/// <param name="pColumn">Given column</param>
+/// <returns>Pointer to the component</returns>
+void* const Archetype::Element(const int pRow, const Column& pColumn) const
+{
+	unsigned char* const chunk = mChunks[pRow / mChunkCapacity];
+	return chunk + pColumn.offset + pColumn.type->size * (pRow % mChunkCapacity);
+}
+
+/// <summary>
+/// Get method for the component mask of the archetype
+/// </summary>
+/// <returns>Component mask of the archetype</returns>
+int Archetype::ComponentMask() const
+{
+	return mComponentMask;
+}
+
+/// <summary>
+/// Checks if the archetype contains every component in the given mask
+/// </summary>
+/// <param name="pComponentMask">Given component mask</param>
+/// <returns>Bool representing whether the archetype matches the mask</returns>
+bool Archetype::Matches(const int pComponentMask) const
+{
+	return (mComponentMask & pComponentMask) == pComponentMask;
+}
+
+/// <summary>
+/// Get method for the column types of the archetype
+/// </summary>
+/// <returns>Column types ordered by component mask</returns>
+const std::vector<const ComponentColumnType*>& Archetype::ColumnTypes() const
+{
+	return mColumnTypes;
+}
+
+/// <summary>
+/// Get method for the number of entities stored in the archetype
+/// </summary>
+/// <returns>Number of entities</returns>
+int Archetype::EntityCount() const
+{
+	return mEntityCount;
+}
+
+/// <summary>
+/// Get method for the number of allocated chunks
+/// </summary>
+/// <returns>Number of chunks</returns>
+int Archetype::ChunkCount() const
+{
+	return static_cast<int>(mChunks.size());
+}
+
+/// <summary>
+/// Get method for the number of entities that fit in a single chunk
+/// </summary>
+/// <returns>Chunk capacity</returns>
+int Archetype::ChunkCapacity() const
+{
+	return mChunkCapacity;
+}
+
+/// <summary>
+/// Returns the number of entities stored in the given chunk
+/// Every chunk apart from the last is always full
+/// </summary>
+/// <param name="pChunk">Index of the given chunk</param>
+/// <returns>Number of entities in the chunk</returns>
+int Archetype::ChunkEntityCount(const int pChunk) const
+{
+	if (pChunk < static_cast<int>(mChunks.size()) - 1)
+	{
+		return mChunkCapacity;
+	}
+	return mEntityCount - pChunk * mChunkCapacity;
+}
+
+/// <summary>
+/// Returns the entity index column of the given chunk
+/// </summary>
+/// <param name="pChunk">Index of the given chunk</param>
+/// <returns>Pointer to the first entity index in the chunk</returns>
+const int* const Archetype::ChunkEntities(const int pChunk) const
+{
+	return reinterpret_cast<const int*>(mChunks[pChunk]);
+}
+
+/// <summary>
+/// Returns the column of the given component in the given chunk
+/// </summary>
+/// <param name="pChunk">Index of the given chunk</param>
+/// <param name="pComponentMask">Component mask of the given component</param>
+/// <returns>Pointer to the first component in the column, nullptr if the archetype has no such column</returns>
+void* const Archetype::ChunkColumn(const int pChunk, const int pComponentMask) const
+{
+	const int column = mColumnLookup[MaskIndex(pComponentMask)];
+	if (column == -1)
+	{
+		return nullptr;
+	}
+	return mChunks[pChunk] + mColumns[column].offset;
+}
+
+/// <summary>
+/// Returns the given component of the entity stored at the given row
+/// </summary>
+/// <param name="pRow">Row of the entity within the archetype</param>
+/// <param name="pComponentMask">Component mask of the given component</param>
+/// <returns>Pointer to the component, nullptr if the archetype has no such column</returns>
+void* const Archetype::Component(const int pRow, const int pComponentMask) const
+{
+	const int column = mColumnLookup[MaskIndex(pComponentMask)];
+	if (column == -1)
+	{
+		return nullptr;
+	}
+	return Element(pRow, mColumns[column]);
+}
+
+/// <summary>
+/// Reserves a row at the end of the archetype for the given entity, allocating a new chunk if the last chunk is full
+/// The components of the new row are left unconstructed and must be constructed by the caller
+/// </summary>
+/// <param name="pEntityIndex">Index of the given entity</param>
+/// <returns>Row of the entity within the archetype</returns>
+int Archetype::AddEntity(const int pEntityIndex)
+{
+	if (mEntityCount == static_cast<int>(mChunks.size()) * mChunkCapacity)
+	{
+		mChunks.push_back(static_cast<unsigned char*>(::operator new(CHUNK_SIZE)));
+	}
+
+	const int row = mEntityCount++;
+	reinterpret_cast<int*>(mChunks[row / mChunkCapacity])[row % mChunkCapacity] = pEntityIndex;
+	return row;
+}
+
+/// <summary>
+/// Removes the entity at the given row, destroying its components and moving the last entity of the archetype into the row to keep the chunks dense
+/// Frees the last chunk once it becomes empty
+/// </summary>
+/// <param name="pRow">Row of the entity to remove</param>
+/// <returns>Index of the entity that was moved into the row, -1 if no entity was moved</returns>
+int Archetype::RemoveEntity(const int pRow)
+{
+	const int lastRow = mEntityCount - 1;
+	int movedEntity = -1;
+
+	for (const auto& column : mColumns)
+	{
+		column.type->destruct(Element(pRow, column));
+	}
+
+	//Fill the hole with the last entity
+	if (pRow != lastRow)
+	{
+		for (const auto& column : mColumns)
+		{
+			column.type->moveConstruct(Element(pRow, column), Element(lastRow, column));
+			column.type->destruct(Element(lastRow, column));
+		}
+
+		movedEntity = reinterpret_cast<int*>(mChunks[lastRow / mChunkCapacity])[lastRow % mChunkCapacity];
+		reinterpret_cast<int*>(mChunks[pRow / mChunkCapacity])[pRow % mChunkCapacity] = movedEntity;
+	}
+
+	mEntityCount--;
+
+	//Release the last chunk when it no longer holds any entities
+	if (mEntityCount == (static_cast<int>(mChunks.size()) - 1) * mChunkCapacity)
+	{
+		::operator delete(mChunks.back());
+		mChunks.pop_back();
+	}
+
+	return movedEntity;
+}
@@ -0,0 +1,105 @@
+#include "CollisionEventStream.h"
+
+/// <summary>
+/// Constructs an empty stream
+/// </summary>
+/// <param name="pCapacity">Initial number of events the stream can hold, rounded up to a power of two</param>
+CollisionEventStream::CollisionEventStream(const int pCapacity)
+	:mHead(0), mTail(0), mFrameStart(0)
+{
+	int capacity = 1;
+	while (capacity < pCapacity)
+	{
+		capacity <<= 1;
+	}
+	mEvents.resize(capacity);
+}
+
+/// <summary>
+/// Default destructor
+/// </summary>
+CollisionEventStream::~CollisionEventStream()
+{
+}
+
+/// <summary>
+/// Doubles the capacity of the stream, moving every stored event to its slot in the larger buffer
+/// The tail is kept where it was, the new slots are only filled by events pushed afterwards
+/// </summary>
+void CollisionEventStream::Grow()
+{
+	std::vector<CollisionEvent> events(mEvents.size() * 2);
+	for (unsigned long long sequence = mTail; sequence < mHead; sequence++)
+	{
+		events[sequence & (events.size() - 1)] = (*this)[sequence];
+	}
+	mEvents.swap(events);
+}
+
+/// <summary>
+/// Marks the start of a new frame of events
+/// Events pushed before this point may be overwritten by events pushed after it
+/// </summary>
+void CollisionEventStream::BeginFrame()
+{
+	mFrameStart = mHead;
+}
+
+/// <summary>
+/// Appends the given event to the stream, overwriting the oldest event once the buffer is full
+/// The buffer grows instead if the oldest event is from the current frame
+/// </summary>
+/// <param name="pEvent">Given event</param>
+void CollisionEventStream::Push(const CollisionEvent& pEvent)
+{
+	if (mHead - mTail == mEvents.size())
+	{
+		if (mTail < mFrameStart)
+		{
+			mTail++;
+		}
+		else
+		{
+			Grow();
+		}
+	}
+	mEvents[mHead & (mEvents.size() - 1)] = pEvent;
+	mHead++;
+}
+
+/// <summary>
+/// Get method for the sequence number the next pushed event will have
+/// </summary>
+/// <returns>Sequence number one past the newest event</returns>
+unsigned long long CollisionEventStream::Head() const
+{
+	return mHead;
+}
+
+/// <summary>
+/// Get method for the sequence number of the oldest event that hasn't been overwritten
+/// </summary>
+/// <returns>Sequence number of the oldest stored event</returns>
+unsigned long long CollisionEventStream::Tail() const
+{
+	return mTail;
+}
+
+/// <summary>
+/// Get method for the sequence number of the first event of the current frame
+/// </summary>
+/// <returns>Sequence number of the first event pushed since BeginFrame</returns>
+unsigned long long CollisionEventStream::FrameStart() const
+{
+	return mFrameStart;
+}
+
+/// <summary>
+/// Returns the event with the given sequence number
+/// </summary>
+/// <param name="pSequence">Sequence number between the tail and head of the stream</param>
+/// <returns>The event</returns>
+const CollisionEvent& CollisionEventStream::operator[](const unsigned long long pSequence) const
+{
+	return mEvents[pSequence & (mEvents.size() - 1)];
+}
@@ -0,0 +1,103 @@
+#include "CoreMask.h"
+
+/// <summary>
+/// Default constructor
+/// Creates an empty mask, letting the thread run on every core
+/// </summary>
+CoreMask::CoreMask()
+	:mWords()
+{
+}
+
+/// <summary>
+/// Constructor for the core mask class
+/// Creates a mask of the given cores without allocating, used for fixed affinities such as CoreMask{ 0 }
+/// </summary>
+/// <param name="pCores">Logical cores in the mask</param>
+CoreMask::CoreMask(std::initializer_list<int> pCores)
+	:mWords()
+{
+	for (const auto& core : pCores)
+	{
+		Set(core);
+	}
+}
+
+/// <summary>
+/// Constructor for the core mask class
+/// Creates a mask of the given cores, used for the affinity lists of the cpu topology
+/// </summary>
+/// <param name="pCores">Logical cores in the mask</param>
+CoreMask::CoreMask(const std::vector<int>& pCores)
+	:mWords()
+{
+	for (const auto& core : pCores)
+	{
+		Set(core);
+	}
+}
+
+/// <summary>
+/// Adds the given core to the mask, cores outside of the mask are ignored
+/// </summary>
+/// <param name="pCore">Logical core to add</param>
+void CoreMask::Set(const int pCore)
+{
+	if (!(pCore < 0) && pCore < MAX_CORES)
+	{
+		mWords[pCore / BITS_PER_WORD] |= static_cast<std::uint64_t>(1) << (pCore % BITS_PER_WORD);
+	}
+}
+
+/// <summary>
+/// Checks if the given core is in the mask
+/// </summary>
+/// <param name="pCore">Logical core to check</param>
+/// <returns>Bool representing whether the core is in the mask</returns>
+bool CoreMask::IsSet(const int pCore) const
+{
+	return !(pCore < 0) && pCore < MAX_CORES && (mWords[pCore / BITS_PER_WORD] & (static_cast<std::uint64_t>(1) << (pCore % BITS_PER_WORD))) != 0;
+}
+
+/// <summary>
+/// Checks if the mask has no cores, meaning the thread may run on every core
+/// </summary>
+/// <returns>Bool representing whether the mask is empty</returns>
+bool CoreMask::Empty() const
+{
+	for (int i = 0; i < WORD_COUNT; i++)
+	{
+		if (mWords[i] != 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// Equality operator
+/// </summary>
+/// <param name="pCoreMask">Mask to compare against</param>
+/// <returns>Bool representing whether both masks hold the same cores</returns>
+bool CoreMask::operator==(const CoreMask& pCoreMask) const
+{
+	for (int i = 0; i < WORD_COUNT; i++)
+	{
+		if (mWords[i] != pCoreMask.mWords[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// Inequality operator
+/// </summary>
+/// <param name="pCoreMask">Mask to compare against</param>
+/// <returns>Bool representing whether the masks hold different cores</returns>
+bool CoreMask::operator!=(const CoreMask& pCoreMask) const
+{
+	return !(*this == pCoreMask);
+}
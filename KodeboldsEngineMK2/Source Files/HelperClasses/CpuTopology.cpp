@@ -0,0 +1,246 @@
+#include "CpuTopology.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fstream>
+#include <map>
+#include <sched.h>
+#include <string>
+#include <unistd.h>
+#endif
+
+/// <summary>
+/// Constructor
+/// Queries the OS for the physical core of every logical core the process may run on, logical cores the OS doesn't report on are treated as physical cores of their own
+/// Offline cores and cores outside of the process affinity, such as those excluded by taskset or a container, are left out
+/// </summary>
+CpuTopology::CpuTopology()
+	:mLogicalCoreCount(0), mPhysicalCoreCount(0)
+{
+#ifdef _WIN32
+	DWORD_PTR processMask = 0;
+	DWORD_PTR systemMask = 0;
+	if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask) || processMask == 0)
+	{
+		processMask = 1;
+	}
+
+	//Logical cores the process can't run on stay at -2 so they are never counted
+	for (int core = 0; core < static_cast<int>(sizeof(DWORD_PTR) * 8); core++)
+	{
+		if (processMask & (static_cast<DWORD_PTR>(1) << core))
+		{
+			mPhysicalCores.resize(core + 1, -2);
+			mPhysicalCores[core] = -1;
+		}
+	}
+
+	DWORD length = 0;
+	GetLogicalProcessorInformation(nullptr, &length);
+	std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> processors(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+	if (!processors.empty() && GetLogicalProcessorInformation(processors.data(), &length))
+	{
+		for (const auto& processor : processors)
+		{
+			if (processor.Relationship == RelationProcessorCore)
+			{
+				//Every set bit of the mask is a logical core of this physical core, physical cores without any usable logical cores aren't counted
+				bool usable = false;
+				for (int core = 0; core < static_cast<int>(mPhysicalCores.size()); core++)
+				{
+					if (mPhysicalCores[core] == -1 && (processor.ProcessorMask & (static_cast<ULONG_PTR>(1) << core)))
+					{
+						mPhysicalCores[core] = mPhysicalCoreCount;
+						usable = true;
+					}
+				}
+				if (usable)
+				{
+					mPhysicalCoreCount++;
+				}
+			}
+		}
+	}
+#else
+	//Affinity of the process, read from the main thread so it isn't narrowed by a worker that has been pinned
+	cpu_set_t available;
+	CPU_ZERO(&available);
+	if (sched_getaffinity(getpid(), sizeof(available), &available) != 0)
+	{
+		CPU_ZERO(&available);
+		CPU_SET(0, &available);
+	}
+
+	//Logical cores the process can't run on stay at -2 so they are never counted
+	for (int core = 0; core < CPU_SETSIZE; core++)
+	{
+		if (CPU_ISSET(core, &available))
+		{
+			mPhysicalCores.resize(core + 1, -2);
+			mPhysicalCores[core] = -1;
+		}
+	}
+
+	//Physical cores are identified by their package and their core id within the package
+	std::map<std::pair<int, int>, int> physicalCores;
+	for (int core = 0; core < static_cast<int>(mPhysicalCores.size()); core++)
+	{
+		if (mPhysicalCores[core] != -1)
+		{
+			continue;
+		}
+
+		const std::string topology = "/sys/devices/system/cpu/cpu" + std::to_string(core) + "/topology/";
+		std::ifstream packageFile(topology + "physical_package_id");
+		std::ifstream coreFile(topology + "core_id");
+		int package = 0;
+		int coreId = 0;
+		if (packageFile >> package && coreFile >> coreId)
+		{
+			const auto physicalCore = physicalCores.insert(std::make_pair(std::make_pair(package, coreId), mPhysicalCoreCount));
+			if (physicalCore.second)
+			{
+				mPhysicalCoreCount++;
+			}
+			mPhysicalCores[core] = physicalCore.first->second;
+		}
+	}
+#endif
+
+	for (auto& physicalCore : mPhysicalCores)
+	{
+		if (physicalCore == -1)
+		{
+			physicalCore = mPhysicalCoreCount++;
+		}
+		if (physicalCore >= 0)
+		{
+			mLogicalCoreCount++;
+		}
+	}
+}
+
+/// <summary>
+/// Default destructor
+/// </summary>
+CpuTopology::~CpuTopology()
+{
+}
+
+/// <summary>
+/// Get method for the number of logical cores the process may run on
+/// Logical cores are numbered as the OS numbers them, so the highest logical core may be higher than the count when some cores are unavailable
+/// </summary>
+/// <returns>Number of logical cores</returns>
+int CpuTopology::LogicalCoreCount() const
+{
+	return mLogicalCoreCount;
+}
+
+/// <summary>
+/// Get method for the number of physical cores
+/// </summary>
+/// <returns>Number of physical cores</returns>
+int CpuTopology::PhysicalCoreCount() const
+{
+	return mPhysicalCoreCount;
+}
+
+/// <summary>
+/// Get method for the physical core the given logical core belongs to
+/// </summary>
+/// <param name="pLogicalCore">Given logical core</param>
+/// <returns>Index of the physical core, -1 if the logical core doesn't exist or the process can't run on it</returns>
+int CpuTopology::PhysicalCore(const int pLogicalCore) const
+{
+	if (pLogicalCore < 0 || pLogicalCore >= static_cast<int>(mPhysicalCores.size()) || mPhysicalCores[pLogicalCore] < 0)
+	{
+		return -1;
+	}
+	return mPhysicalCores[pLogicalCore];
+}
+
+/// <summary>
+/// Checks if the given logical core shares its physical core with a lower numbered logical core
+/// </summary>
+/// <param name="pLogicalCore">Given logical core</param>
+/// <returns>Bool representing whether the logical core is an SMT sibling rather than the first logical core of its physical core, false if the process can't run on the logical core</returns>
+bool CpuTopology::IsSMTSibling(const int pLogicalCore) const
+{
+	const int physicalCore = PhysicalCore(pLogicalCore);
+	if (physicalCore < 0)
+	{
+		return false;
+	}
+
+	for (int core = 0; core < pLogicalCore; core++)
+	{
+		if (mPhysicalCores[core] == physicalCore)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/// <summary>
+/// Get method for every logical core the process may run on, used as an affinity to let a thread run on any core
+/// </summary>
+/// <returns>Every usable logical core</returns>
+std::vector<int> CpuTopology::LogicalCores() const
+{
+	std::vector<int> cores;
+	for (int core = 0; core < static_cast<int>(mPhysicalCores.size()); core++)
+	{
+		if (mPhysicalCores[core] >= 0)
+		{
+			cores.push_back(core);
+		}
+	}
+	return cores;
+}
+
+/// <summary>
+/// Get method for the logical cores of the given physical core
+/// </summary>
+/// <param name="pPhysicalCore">Given physical core</param>
+/// <returns>Logical cores of the physical core</returns>
+std::vector<int> CpuTopology::LogicalCores(const int pPhysicalCore) const
+{
+	std::vector<int> cores;
+	for (int core = 0; core < static_cast<int>(mPhysicalCores.size()); core++)
+	{
+		if (pPhysicalCore >= 0 && mPhysicalCores[core] == pPhysicalCore)
+		{
+			cores.push_back(core);
+		}
+	}
+	return cores;
+}
+
+/// <summary>
+/// Get method for the first logical core of every physical core, used as an affinity that keeps threads off SMT siblings
+/// </summary>
+/// <returns>One logical core per physical core</returns>
+std::vector<int> CpuTopology::PrimaryCores() const
+{
+	std::vector<int> cores;
+	for (int core = 0; core < static_cast<int>(mPhysicalCores.size()); core++)
+	{
+		if (mPhysicalCores[core] >= 0 && !IsSMTSibling(core))
+		{
+			cores.push_back(core);
+		}
+	}
+	return cores;
+}
+
+/// <summary>
+/// If an instance of the cpu topology does not already exists, creates one and then provides a pointer to it
+/// </summary>
+/// <returns>Pointer to the cpu topology instance</returns>
+std::shared_ptr<CpuTopology> CpuTopology::Instance()
+{
+	static std::shared_ptr<CpuTopology> instance{ new CpuTopology() };
+	return instance;
+}
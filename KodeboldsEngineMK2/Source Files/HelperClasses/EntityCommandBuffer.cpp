@@ -0,0 +1,454 @@
+#include "EntityCommandBuffer.h"
+#include "ECSManager.h"
+
+/// <summary>
+/// Constructor for the entity command buffer
+/// </summary>
+/// <param name="pEcsManager">ECS manager that commands are played back on</param>
+EntityCommandBuffer::EntityCommandBuffer(ECSManager& pEcsManager)
+	:mEcsManager(pEcsManager), mBlockOffset(BLOCK_SIZE)
+{
+}
+
+/// <summary>
+/// Destructor
+/// Destroys any components that were recorded but never played back and frees all blocks
+/// </summary>
+EntityCommandBuffer::~EntityCommandBuffer()
+{
+	for (auto& command : mCommands)
+	{
+		if (command.destruct)
+		{
+			command.destruct(command.component);
+		}
+	}
+
+	for (auto& block : mBlocks)
+	{
+		::operator delete(block);
+	}
+	for (auto& block : mFreeBlocks)
+	{
+		::operator delete(block);
+	}
+}
+
+/// <summary>
+/// Reserves space for a component in the current block, starting a new block if the component doesn't fit
+/// Must be called while holding the buffer mutex
+/// </summary>
+/// <param name="pSize">Size of the component in bytes</param>
+/// <param name="pAlignment">Alignment of the component in bytes</param>
+/// <returns>Pointer to uninitialised memory for the component</returns>
+void* const EntityCommandBuffer::Allocate(const size_t pSize, const size_t pAlignment)
+{
+	size_t offset = (mBlockOffset + pAlignment - 1) & ~(pAlignment - 1);
+
+	if (mBlocks.empty() || offset + pSize > BLOCK_SIZE)
+	{
+		//Reuse a block from a previous playback if one is available
+		if (mFreeBlocks.empty())
+		{
+			mBlocks.push_back(static_cast<unsigned char*>(::operator new(BLOCK_SIZE)));
+		}
+		else
+		{
+			mBlocks.push_back(mFreeBlocks.back());
+			mFreeBlocks.pop_back();
+		}
+		offset = 0;
+	}
+
+	mBlockOffset = offset + pSize;
+	return mBlocks.back() + offset;
+}
+
+/// <summary>
+/// Records a command that carries no component
+/// </summary>
+/// <param name="pApply">Function that applies the command to the ECS manager</param>
+/// <param name="pEntityID">ID of the entity the command applies to</param>
+void EntityCommandBuffer::Record(const ApplyCommand pApply, const EntityHandle pEntityID)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mCommands.push_back(Command{ pApply, nullptr, pEntityID, nullptr });
+}
+
+/// <summary>
+/// Reserves a handle for a new entity and records its creation
+/// The handle can be used in further commands straight away, but the entity is not alive until the buffer is played back
+/// </summary>
+/// <returns>Handle of the new entity, null if max entities are already in use</returns>
+EntityHandle EntityCommandBuffer::CreateEntity()
+{
+	const EntityHandle entityID = mEcsManager.ReserveEntity();
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.PlaceEntity(pEntityID); }, entityID);
+	return entityID;
+}
+
+/// <summary>
+/// Records the destruction of the given entity
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity to destroy</param>
+void EntityCommandBuffer::DestroyEntity(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.DestroyEntity(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of an AI component to the entity with a given ID
+/// </summary>
+/// <param name="pAI">AI component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddAIComp(const AI& pAI, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddAIComp(*static_cast<const AI*>(pComponent), pEntityID); }, pAI, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of an Audio component to the entity with a given ID
+/// </summary>
+/// <param name="pAudio">Audio component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddAudioComp(const Audio& pAudio, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddAudioComp(*static_cast<const Audio*>(pComponent), pEntityID); }, pAudio, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a BoxCollider component to the entity with a given ID
+/// </summary>
+/// <param name="pBoxCollider">BoxCollider component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddBoxColliderComp(const BoxCollider& pBoxCollider, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddBoxColliderComp(*static_cast<const BoxCollider*>(pComponent), pEntityID); }, pBoxCollider, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a Camera component to the entity with a given ID
+/// </summary>
+/// <param name="pCamera">Camera component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddCameraComp(const Camera& pCamera, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddCameraComp(*static_cast<const Camera*>(pComponent), pEntityID); }, pCamera, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a Collision component to the entity with a given ID
+/// </summary>
+/// <param name="pCollision">Collision component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddCollisionComp(const Collision& pCollision, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddCollisionComp(*static_cast<const Collision*>(pComponent), pEntityID); }, pCollision, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a Colour component to the entity with a given ID
+/// </summary>
+/// <param name="pColour">Colour component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddColourComp(const Colour& pColour, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddColourComp(*static_cast<const Colour*>(pComponent), pEntityID); }, pColour, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a Geometry component to the entity with a given ID
+/// </summary>
+/// <param name="pGeometry">Geometry component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddGeometryComp(const Geometry& pGeometry, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddGeometryComp(*static_cast<const Geometry*>(pComponent), pEntityID); }, pGeometry, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a Gravity component to the entity with a given ID
+/// </summary>
+/// <param name="pGravity">Gravity component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddGravityComp(const Gravity& pGravity, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddGravityComp(*static_cast<const Gravity*>(pComponent), pEntityID); }, pGravity, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a PointLight component to the entity with a given ID
+/// </summary>
+/// <param name="pLight">PointLight component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddPointLightComp(const PointLight& pLight, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddPointLightComp(*static_cast<const PointLight*>(pComponent), pEntityID); }, pLight, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a DirectionalLight component to the entity with a given ID
+/// </summary>
+/// <param name="pLight">DirectionalLight component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddDirectionalLightComp(const DirectionalLight& pLight, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddDirectionalLightComp(*static_cast<const DirectionalLight*>(pComponent), pEntityID); }, pLight, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a Ray component to the entity with a given ID
+/// </summary>
+/// <param name="pRay">Ray component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddRayComp(const Ray& pRay, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddRayComp(*static_cast<const Ray*>(pComponent), pEntityID); }, pRay, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a Shader component to the entity with a given ID
+/// </summary>
+/// <param name="pShader">Shader component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddShaderComp(const Shader& pShader, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddShaderComp(*static_cast<const Shader*>(pComponent), pEntityID); }, pShader, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a SphereCollider component to the entity with a given ID
+/// </summary>
+/// <param name="pSphereCollider">SphereCollider component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddSphereColliderComp(const SphereCollider& pSphereCollider, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddSphereColliderComp(*static_cast<const SphereCollider*>(pComponent), pEntityID); }, pSphereCollider, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a Texture component to the entity with a given ID
+/// </summary>
+/// <param name="pTexture">Texture component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddTextureComp(const Texture& pTexture, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddTextureComp(*static_cast<const Texture*>(pComponent), pEntityID); }, pTexture, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a Transform component to the entity with a given ID
+/// </summary>
+/// <param name="pTransform">Transform component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddTransformComp(const Transform& pTransform, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddTransformComp(*static_cast<const Transform*>(pComponent), pEntityID); }, pTransform, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a Velocity component to the entity with a given ID
+/// </summary>
+/// <param name="pVelocity">Velocity component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddVelocityComp(const Velocity& pVelocity, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddVelocityComp(*static_cast<const Velocity*>(pComponent), pEntityID); }, pVelocity, pEntityID);
+}
+
+/// <summary>
+/// Records the addition of a Parent component to the entity with a given ID
+/// </summary>
+/// <param name="pParent">Parent component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::AddParentComp(const Parent& pParent, const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const pComponent) { pEcsManager.AddParentComp(*static_cast<const Parent*>(pComponent), pEntityID); }, pParent, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the AI component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveAIComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveAIComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the Audio component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveAudioComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveAudioComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the BoxCollider component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveBoxColliderComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveBoxColliderComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the Camera component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveCameraComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveCameraComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the Collision component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveCollisionComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveCollisionComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the Colour component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveColourComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveColourComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the Geometry component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveGeometryComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveGeometryComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the Gravity component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveGravityComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveGravityComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the PointLight component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemovePointLightComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemovePointLightComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the DirectionalLight component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveDirectionalLightComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveDirectionalLightComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the Ray component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveRayComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveRayComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the Shader component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveShaderComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveShaderComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the SphereCollider component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveSphereColliderComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveSphereColliderComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the Texture component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveTextureComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveTextureComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the Transform component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveTransformComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveTransformComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the Velocity component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveVelocityComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveVelocityComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Records the removal of the Parent component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void EntityCommandBuffer::RemoveParentComp(const EntityHandle pEntityID)
+{
+	Record([](ECSManager& pEcsManager, const EntityHandle pEntityID, const void* const) { pEcsManager.RemoveParentComp(pEntityID); }, pEntityID);
+}
+
+/// <summary>
+/// Applies every recorded command in the order it was recorded, then clears the buffer
+/// Commands recorded while playing back are kept for the next playback
+/// </summary>
+void EntityCommandBuffer::Playback()
+{
+	std::vector<Command> commands;
+	std::vector<unsigned char*> blocks;
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		commands.swap(mCommands);
+		blocks.swap(mBlocks);
+		mBlockOffset = BLOCK_SIZE;
+	}
+
+	for (auto& command : commands)
+	{
+		command.apply(mEcsManager, command.entityID, command.component);
+		if (command.destruct)
+		{
+			command.destruct(command.component);
+		}
+	}
+
+	//Keep the command vector and blocks so the next frame doesn't need to allocate
+	commands.clear();
+	std::lock_guard<std::mutex> lock(mMutex);
+	if (mCommands.empty())
+	{
+		mCommands.swap(commands);
+	}
+	mFreeBlocks.insert(mFreeBlocks.end(), blocks.begin(), blocks.end());
+}
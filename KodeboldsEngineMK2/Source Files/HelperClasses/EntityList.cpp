@@ -0,0 +1,128 @@
+#include "EntityList.h"
+
+/// <summary>
+/// Default constructor
+/// </summary>
+EntityList::EntityList()
+{
+}
+
+/// <summary>
+/// Default destructor
+/// </summary>
+EntityList::~EntityList()
+{
+}
+
+/// <summary>
+/// Adds the given entity to the end of the list, or updates its entry if it is already in the list
+/// </summary>
+/// <param name="pEntity">Given entity</param>
+/// <returns>Bool representing whether the entity was newly added</returns>
+bool EntityList::Add(const Entity& pEntity)
+{
+	const unsigned int index = pEntity.ID.Index();
+
+	//Grow the position map on demand so the list only pays for the indices it has seen
+	if (index >= mPositions.size())
+	{
+		mPositions.resize(index + 1, -1);
+	}
+
+	if (mPositions[index] != -1)
+	{
+		mEntities[mPositions[index]] = pEntity;
+		return false;
+	}
+
+	mPositions[index] = static_cast<int>(mEntities.size());
+	mEntities.push_back(pEntity);
+	return true;
+}
+
+/// <summary>
+/// Removes the given entity from the list by moving the last entity into its position
+/// </summary>
+/// <param name="pEntity">Handle of the given entity</param>
+/// <returns>Bool representing whether the entity was in the list</returns>
+bool EntityList::Remove(const EntityHandle pEntity)
+{
+	if (!Contains(pEntity))
+	{
+		return false;
+	}
+
+	const int position = mPositions[pEntity.Index()];
+	const Entity& last = mEntities.back();
+
+	mEntities[position] = last;
+	mPositions[last.ID.Index()] = position;
+	mPositions[pEntity.Index()] = -1;
+	mEntities.pop_back();
+	return true;
+}
+
+/// <summary>
+/// Removes every entity from the list
+/// </summary>
+void EntityList::Clear()
+{
+	mEntities.clear();
+	mPositions.clear();
+}
+
+/// <summary>
+/// Checks if the given entity is in the list
+/// </summary>
+/// <param name="pEntity">Handle of the given entity</param>
+/// <returns>Bool representing whether the entity is in the list</returns>
+bool EntityList::Contains(const EntityHandle pEntity) const
+{
+	return pEntity.Index() < mPositions.size() && mPositions[pEntity.Index()] != -1 && mEntities[mPositions[pEntity.Index()]].ID == pEntity;
+}
+
+/// <summary>
+/// Get method for the number of entities in the list
+/// </summary>
+/// <returns>Number of entities</returns>
+int EntityList::Size() const
+{
+	return static_cast<int>(mEntities.size());
+}
+
+/// <summary>
+/// Checks if the list contains no entities
+/// </summary>
+/// <returns>Bool representing whether the list is empty</returns>
+bool EntityList::Empty() const
+{
+	return mEntities.empty();
+}
+
+/// <summary>
+/// Returns the entity stored at the given position in the list
+/// </summary>
+/// <param name="pPosition">Given position</param>
+/// <returns>Entity at the position</returns>
+const Entity& EntityList::operator[](const int pPosition) const
+{
+	return mEntities[pPosition];
+}
+
+/// <summary>
+/// Returns an iterator to the first entity in the list
+/// </summary>
+/// <returns>Iterator to the first entity</returns>
+std::vector<Entity>::const_iterator EntityList::begin() const
+{
+	return mEntities.begin();
+}
+
+/// <summary>
+/// Returns an iterator past the last entity in the list
+/// </summary>
+/// <returns>Iterator past the last entity</returns>
+std::vector<Entity>::const_iterator EntityList::end() const
+{
+	return mEntities.end();
+}
@@ -0,0 +1,67 @@
+#include "FrameAllocator.h"
+
+/// <summary>
+/// Constructs an allocator with no blocks, the first block is allocated by the first allocation
+/// </summary>
+/// <param name="pBlockSize">Size in bytes of each block, larger allocations get a block of their own size</param>
+FrameAllocator::FrameAllocator(const size_t pBlockSize)
+	:mBlockSize(pBlockSize), mBlock(0), mOffset(0), mUsed(0)
+{
+}
+
+/// <summary>
+/// Default destructor
+/// </summary>
+FrameAllocator::~FrameAllocator()
+{
+}
+
+/// <summary>
+/// Allocates memory from the current block, moving on to the next block when the current one is full
+/// Blocks kept from earlier frames are reused before a new block is added
+/// </summary>
+/// <param name="pSize">Size of the allocation in bytes</param>
+/// <param name="pAlignment">Alignment of the allocation, must be a power of two</param>
+/// <returns>Pointer to the allocated memory, valid until the allocator is next reset</returns>
+void* FrameAllocator::Allocate(const size_t pSize, const size_t pAlignment)
+{
+	while (mBlock < static_cast<int>(mBlocks.size()))
+	{
+		std::vector<unsigned char>& block = mBlocks[mBlock];
+		const size_t address = reinterpret_cast<size_t>(block.data()) + mOffset;
+		const size_t padding = (pAlignment - (address & (pAlignment - 1))) & (pAlignment - 1);
+		if (mOffset + padding + pSize <= block.size())
+		{
+			mOffset += padding + pSize;
+			mUsed += padding + pSize;
+			return block.data() + mOffset - pSize;
+		}
+
+		mBlock++;
+		mOffset = 0;
+	}
+
+	//Every block is full, padding the new block by the alignment means the allocation always fits
+	mBlocks.emplace_back(pSize + pAlignment > mBlockSize ? pSize + pAlignment : mBlockSize);
+	return Allocate(pSize, pAlignment);
+}
+
+/// <summary>
+/// Frees every allocation at once by rewinding to the start of the first block
+/// The blocks are kept for the next frame
+/// </summary>
+void FrameAllocator::Reset()
+{
+	mBlock = 0;
+	mOffset = 0;
+	mUsed = 0;
+}
+
+/// <summary>
+/// Get method for the number of bytes allocated since the last reset, including alignment padding
+/// </summary>
+/// <returns>Number of bytes allocated</returns>
+size_t FrameAllocator::Used() const
+{
+	return mUsed;
+}
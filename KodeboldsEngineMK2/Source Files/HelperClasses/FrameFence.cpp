@@ -0,0 +1,54 @@
+#include "FrameFence.h"
+
+/// <summary>
+/// Constructs a fence that nothing has been signalled on
+/// </summary>
+FrameFence::FrameFence()
+	:mValue(0)
+{
+}
+
+/// <summary>
+/// Default destructor
+/// </summary>
+FrameFence::~FrameFence()
+{
+}
+
+/// <summary>
+/// Get method for the last value signalled on the fence
+/// </summary>
+/// <returns>Last signalled value</returns>
+unsigned long long FrameFence::Value() const
+{
+	return mValue.load(std::memory_order_acquire);
+}
+
+/// <summary>
+/// Sets the value of the fence and wakes every thread waiting on a value it has now reached
+/// Everything written before the signal is visible to a thread once its wait returns
+/// </summary>
+/// <param name="pValue">Given value, must not be less than the last signalled value</param>
+void FrameFence::Signal(const unsigned long long pValue)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mValue.store(pValue, std::memory_order_release);
+	}
+	mSignalled.notify_all();
+}
+
+/// <summary>
+/// Blocks the calling thread until the fence has been signalled with at least the given value
+/// </summary>
+/// <param name="pValue">Given value</param>
+void FrameFence::Wait(const unsigned long long pValue)
+{
+	if (Value() >= pValue)
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(mMutex);
+	mSignalled.wait(lock, [&] { return mValue.load(std::memory_order_acquire) >= pValue; });
+}
@@ -0,0 +1,112 @@
+#include "JobHandle.h"
+
+/// <summary>
+/// Constructs a handle to the given task, adding a reference to the task
+/// </summary>
+/// <param name="pTask">Given task</param>
+JobHandle::JobHandle(Task* const pTask)
+	:mTask(pTask)
+{
+	if (mTask)
+	{
+		mTask->AddReference();
+	}
+}
+
+/// <summary>
+/// Constructs an empty handle that doesn't refer to any task
+/// </summary>
+JobHandle::JobHandle()
+	:mTask(nullptr)
+{
+}
+
+/// <summary>
+/// Copy constructor, both handles refer to the same task
+/// </summary>
+/// <param name="pJobHandle">Handle to copy</param>
+JobHandle::JobHandle(const JobHandle& pJobHandle)
+	:JobHandle(pJobHandle.mTask)
+{
+}
+
+/// <summary>
+/// Move constructor, takes the reference of the given handle and leaves it empty
+/// </summary>
+/// <param name="pJobHandle">Handle to move from</param>
+JobHandle::JobHandle(JobHandle&& pJobHandle) noexcept
+	:mTask(pJobHandle.mTask)
+{
+	pJobHandle.mTask = nullptr;
+}
+
+/// <summary>
+/// Destructor
+/// Releases the reference to the task
+/// </summary>
+JobHandle::~JobHandle()
+{
+	Reset();
+}
+
+/// <summary>
+/// Copy assignment, releases the current task and refers to the task of the given handle
+/// </summary>
+/// <param name="pJobHandle">Handle to copy</param>
+/// <returns>This handle</returns>
+JobHandle& JobHandle::operator=(const JobHandle& pJobHandle)
+{
+	if (pJobHandle.mTask)
+	{
+		pJobHandle.mTask->AddReference();
+	}
+	Reset();
+	mTask = pJobHandle.mTask;
+	return *this;
+}
+
+/// <summary>
+/// Move assignment, releases the current task and takes the reference of the given handle
+/// </summary>
+/// <param name="pJobHandle">Handle to move from</param>
+/// <returns>This handle</returns>
+JobHandle& JobHandle::operator=(JobHandle&& pJobHandle) noexcept
+{
+	if (this != &pJobHandle)
+	{
+		Reset();
+		mTask = pJobHandle.mTask;
+		pJobHandle.mTask = nullptr;
+	}
+	return *this;
+}
+
+/// <summary>
+/// Checks if the handle refers to a task
+/// </summary>
+/// <returns>Bool representing whether the handle refers to a task</returns>
+bool JobHandle::Valid() const
+{
+	return mTask != nullptr;
+}
+
+/// <summary>
+/// Checks if the task has finished running, empty handles count as finished
+/// </summary>
+/// <returns>Bool representing whether the task has finished</returns>
+bool JobHandle::IsDone() const
+{
+	return !mTask || mTask->IsDone();
+}
+
+/// <summary>
+/// Releases the reference to the task, leaving the handle empty
+/// </summary>
+void JobHandle::Reset()
+{
+	if (mTask)
+	{
+		mTask->Release();
+		mTask = nullptr;
+	}
+}
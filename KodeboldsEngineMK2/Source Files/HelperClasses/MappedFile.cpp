@@ -0,0 +1,200 @@
+#include "MappedFile.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+/// <summary>
+/// Converts the given wide file name to a narrow one for the POSIX file functions
+/// Only file names made up of ASCII characters are supported
+/// </summary>
+/// <param name="pFilename">Given file name</param>
+/// <returns>Narrow file name</returns>
+static std::string NarrowFilename(const std::wstring& pFilename)
+{
+	return std::string(pFilename.begin(), pFilename.end());
+}
+#endif
+
+/// <summary>
+/// Constructs a closed file
+/// </summary>
+MappedFile::MappedFile()
+	:mData(nullptr), mSize(0)
+{
+}
+
+/// <summary>
+/// Destructor
+/// Unmaps the file if it is still open
+/// </summary>
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+/// <summary>
+/// Maps the whole of the given file into memory, closing any file that was already open
+/// The file and mapping handles are closed straight away as the view keeps the file mapped until it is unmapped
+/// </summary>
+/// <param name="pFilename">File name of the given file</param>
+/// <returns>Bool representing whether the file could be opened and mapped, empty files can't be mapped</returns>
+bool MappedFile::Open(const std::wstring& pFilename)
+{
+	Close();
+
+#ifdef _WIN32
+	const HANDLE file = CreateFileW(pFilename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+	{
+		return false;
+	}
+
+	const void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!view)
+	{
+		return false;
+	}
+
+	mData = static_cast<const unsigned char*>(view);
+	mSize = static_cast<size_t>(size.QuadPart);
+#else
+	const int file = open(NarrowFilename(pFilename).c_str(), O_RDONLY);
+	if (file == -1)
+	{
+		return false;
+	}
+
+	struct stat status;
+	if (fstat(file, &status) == -1 || status.st_size == 0)
+	{
+		close(file);
+		return false;
+	}
+
+	void* const view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (view == MAP_FAILED)
+	{
+		return false;
+	}
+
+	mData = static_cast<const unsigned char*>(view);
+	mSize = static_cast<size_t>(status.st_size);
+#endif
+
+	return true;
+}
+
+/// <summary>
+/// Unmaps the file, pointers into the mapped data are no longer valid afterwards
+/// </summary>
+void MappedFile::Close()
+{
+	if (!mData)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(mData);
+#else
+	munmap(const_cast<unsigned char*>(mData), mSize);
+#endif
+
+	mData = nullptr;
+	mSize = 0;
+}
+
+/// <summary>
+/// Get method for the mapped data
+/// </summary>
+/// <returns>Pointer to the first byte of the file, nullptr if no file is open</returns>
+const unsigned char* const MappedFile::Data() const
+{
+	return mData;
+}
+
+/// <summary>
+/// Get method for the size of the mapped file
+/// </summary>
+/// <returns>Size of the file in bytes</returns>
+size_t MappedFile::Size() const
+{
+	return mSize;
+}
+
+/// <summary>
+/// Writes the given bytes to the given file, replacing the file if it already exists
+/// </summary>
+/// <param name="pFilename">File name of the given file</param>
+/// <param name="pData">Bytes to write</param>
+/// <param name="pSize">Number of bytes to write</param>
+/// <returns>Bool representing whether every byte was written</returns>
+bool MappedFile::Write(const std::wstring& pFilename, const void* const pData, const size_t pSize)
+{
+	const char* bytes = static_cast<const char*>(pData);
+	size_t remaining = pSize;
+
+#ifdef _WIN32
+	const HANDLE file = CreateFileW(pFilename.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	//WriteFile takes a 32 bit size, so large buffers are written in blocks
+	while (remaining > 0)
+	{
+		const DWORD blockSize = remaining > 0x40000000 ? 0x40000000 : static_cast<DWORD>(remaining);
+		DWORD written = 0;
+		if (!WriteFile(file, bytes, blockSize, &written, nullptr) || written == 0)
+		{
+			break;
+		}
+		bytes += written;
+		remaining -= written;
+	}
+	CloseHandle(file);
+#else
+	const int file = open(NarrowFilename(pFilename).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (file == -1)
+	{
+		return false;
+	}
+
+	while (remaining > 0)
+	{
+		const ssize_t written = write(file, bytes, remaining);
+		if (written <= 0)
+		{
+			break;
+		}
+		bytes += written;
+		remaining -= static_cast<size_t>(written);
+	}
+	close(file);
+#endif
+
+	return remaining == 0;
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "Prefab.h"
+
+/// <summary>
+/// Constructs an empty prefab with a slot for every built in component
+/// </summary>
+Prefab::Prefab()
+	:mComponentMask(ComponentType::COMPONENT_NONE), mComponents(MaskIndex(ComponentType::CUSTOM_COMPONENT))
+{
+}
+
+/// <summary>
+/// Default destructor
+/// </summary>
+Prefab::~Prefab()
+{
+}
+
+/// <summary>
+/// Get method for the combined component mask of every component in the prefab
+/// </summary>
+/// <returns>Component mask of the prefab</returns>
+int Prefab::ComponentMask() const
+{
+	return mComponentMask;
+}
+
+/// <summary>
+/// Returns the template component of the given built in type
+/// </summary>
+/// <param name="pComponentMask">Component mask of the given component</param>
+/// <returns>Pointer to the component, nullptr if the prefab has no such component</returns>
+const void* const Prefab::Component(const int pComponentMask) const
+{
+	return mComponents[MaskIndex(pComponentMask)].get();
+}
@@ -0,0 +1,53 @@
+#include "ServiceThread.h"
+#include "ThreadManager.h"
+
+/// <summary>
+/// Constructor for the service thread class
+/// Starts a thread that runs the given task then exits, the thread sets itself to the affinity of the task and the given priority before running the task
+/// </summary>
+/// <param name="pThreadManager">Thread manager that readies the jobs depending on the task</param>
+/// <param name="pTask">Task to run on the thread</param>
+/// <param name="pPriority">Priority of the thread</param>
+ServiceThread::ServiceThread(ThreadManager* const pThreadManager, Task* const pTask, const THREAD_PRIORITY pPriority)
+	:mTask(pTask)
+{
+	//Hold a reference so the task can still be checked once it has run
+	mTask->AddReference();
+
+	mThread = std::thread([pThreadManager, pTask, pPriority]()
+	{
+		Thread::SetThreadName("Service");
+		Thread::SetThreadAffinity(pTask->ThreadAffinity());
+		Thread::SetThreadPriority(pPriority);
+		pThreadManager->RunTask(pTask);
+	});
+}
+
+/// <summary>
+/// Destructor
+/// Joins the thread if its task has finished, otherwise the thread is detached as it may be blocked indefinitely
+/// </summary>
+ServiceThread::~ServiceThread()
+{
+	if (mThread.joinable())
+	{
+		if (mTask->IsDone())
+		{
+			mThread.join();
+		}
+		else
+		{
+			mThread.detach();
+		}
+	}
+	mTask->Release();
+}
+
+/// <summary>
+/// Checks if the task of the service thread has finished running
+/// </summary>
+/// <returns>Bool representing whether the task has finished</returns>
+bool ServiceThread::IsDone() const
+{
+	return mTask->IsDone();
+}
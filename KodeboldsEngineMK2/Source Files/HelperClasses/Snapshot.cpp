@@ -0,0 +1,171 @@
+#include "Snapshot.h"
+
+/// <summary>
+/// Default constructor
+/// </summary>
+SnapshotWriter::SnapshotWriter()
+{
+}
+
+/// <summary>
+/// Default destructor
+/// </summary>
+SnapshotWriter::~SnapshotWriter()
+{
+}
+
+/// <summary>
+/// Get method for the written bytes
+/// </summary>
+/// <returns>Pointer to the first written byte</returns>
+const unsigned char* const SnapshotWriter::Data() const
+{
+	return mBuffer.data();
+}
+
+/// <summary>
+/// Get method for the number of written bytes
+/// </summary>
+/// <returns>Number of written bytes</returns>
+size_t SnapshotWriter::Size() const
+{
+	return mBuffer.size();
+}
+
+/// <summary>
+/// Appends the given bytes to the end of the buffer
+/// </summary>
+/// <param name="pData">Given bytes</param>
+/// <param name="pSize">Number of bytes</param>
+void SnapshotWriter::WriteBytes(const void* const pData, const size_t pSize)
+{
+	const unsigned char* const bytes = static_cast<const unsigned char*>(pData);
+	mBuffer.insert(mBuffer.end(), bytes, bytes + pSize);
+}
+
+/// <summary>
+/// Replaces previously written bytes, used to fill in section headers once the size of the section is known
+/// </summary>
+/// <param name="pOffset">Offset of the first byte to replace</param>
+/// <param name="pData">Given bytes</param>
+/// <param name="pSize">Number of bytes</param>
+void SnapshotWriter::Overwrite(const size_t pOffset, const void* const pData, const size_t pSize)
+{
+	memcpy(mBuffer.data() + pOffset, pData, pSize);
+}
+
+/// <summary>
+/// Writes the length of the given string followed by its characters
+/// </summary>
+/// <param name="pString">Given string</param>
+void SnapshotWriter::Transfer(std::wstring& pString)
+{
+	const unsigned int length = static_cast<unsigned int>(pString.size());
+	WriteBytes(&length, sizeof(length));
+	WriteBytes(pString.data(), length * sizeof(wchar_t));
+}
+
+/// <summary>
+/// Constructs a reader over the given block of memory
+/// </summary>
+/// <param name="pData">Pointer to the first byte</param>
+/// <param name="pSize">Number of bytes</param>
+SnapshotReader::SnapshotReader(const void* const pData, const size_t pSize)
+	:mData(static_cast<const unsigned char*>(pData)), mSize(pSize), mOffset(0), mFailed(false)
+{
+}
+
+/// <summary>
+/// Default destructor
+/// </summary>
+SnapshotReader::~SnapshotReader()
+{
+}
+
+/// <summary>
+/// Checks if a read has gone past the end of the data
+/// </summary>
+/// <returns>Bool representing whether any read has failed</returns>
+bool SnapshotReader::Failed() const
+{
+	return mFailed;
+}
+
+/// <summary>
+/// Get method for the number of bytes left to read
+/// </summary>
+/// <returns>Number of unread bytes</returns>
+size_t SnapshotReader::Remaining() const
+{
+	return mSize - mOffset;
+}
+
+/// <summary>
+/// Moves past the given number of bytes without copying them
+/// </summary>
+/// <param name="pSize">Number of bytes</param>
+/// <returns>Pointer to the first skipped byte, nullptr if there aren't enough bytes left</returns>
+const void* const SnapshotReader::Skip(const size_t pSize)
+{
+	if (mFailed || pSize > Remaining())
+	{
+		mFailed = true;
+		return nullptr;
+	}
+
+	const unsigned char* const bytes = mData + mOffset;
+	mOffset += pSize;
+	return bytes;
+}
+
+/// <summary>
+/// Copies the given number of bytes into the given destination
+/// </summary>
+/// <param name="pDestination">Memory to copy into</param>
+/// <param name="pSize">Number of bytes</param>
+/// <returns>Bool representing whether the bytes could be read</returns>
+bool SnapshotReader::ReadBytes(void* const pDestination, const size_t pSize)
+{
+	const void* const bytes = Skip(pSize);
+	if (mFailed)
+	{
+		return false;
+	}
+
+	if (pSize > 0)
+	{
+		memcpy(pDestination, bytes, pSize);
+	}
+	return true;
+}
+
+/// <summary>
+/// Splits the given number of bytes off into their own reader and moves past them
+/// A malformed section can then only fail its own reader
+/// </summary>
+/// <param name="pSize">Number of bytes in the section</param>
+/// <returns>Reader over the section, failed if there aren't enough bytes left</returns>
+SnapshotReader SnapshotReader::Section(const size_t pSize)
+{
+	const void* const bytes = Skip(pSize);
+	SnapshotReader section(bytes, bytes ? pSize : 0);
+	section.mFailed = bytes == nullptr;
+	return section;
+}
+
+/// <summary>
+/// Reads a length followed by that many characters into the given string
+/// </summary>
+/// <param name="pString">String to read into</param>
+void SnapshotReader::Transfer(std::wstring& pString)
+{
+	unsigned int length = 0;
+	if (ReadBytes(&length, sizeof(length)) && length <= Remaining() / sizeof(wchar_t))
+	{
+		pString.assign(reinterpret_cast<const wchar_t*>(Skip(length * sizeof(wchar_t))), length);
+	}
+	else
+	{
+		mFailed = true;
+	}
+}
\ No newline at end of file
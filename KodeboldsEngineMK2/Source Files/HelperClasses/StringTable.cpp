@@ -0,0 +1,88 @@
+#include "StringTable.h"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+//Strings are stored in a deque so references handed out by String stay valid as more strings are interned
+struct InternedStrings
+{
+	std::mutex mutex;
+	std::deque<std::wstring> strings;
+	std::unordered_map<std::wstring, unsigned int> ids;
+
+	InternedStrings()
+	{
+		strings.emplace_back();
+		ids.emplace(std::wstring(), 0);
+	}
+};
+
+/// <summary>
+/// Returns the table shared by every caller, created on first use so handles can be interned during static initialisation
+/// </summary>
+/// <returns>Shared table of strings</returns>
+static InternedStrings& Table()
+{
+	static InternedStrings table;
+	return table;
+}
+
+/// <summary>
+/// Returns the ID of the given string, adding the string to the table if it hasn't been interned before
+/// </summary>
+/// <param name="pString">Given string</param>
+/// <returns>ID of the string</returns>
+unsigned int StringTable::Intern(const std::wstring& pString)
+{
+	if (pString.empty())
+	{
+		return 0;
+	}
+
+	InternedStrings& table = Table();
+	std::lock_guard<std::mutex> lock(table.mutex);
+
+	const auto id = table.ids.find(pString);
+	if (id != table.ids.end())
+	{
+		return id->second;
+	}
+
+	const unsigned int newID = static_cast<unsigned int>(table.strings.size());
+	table.strings.push_back(pString);
+	table.ids.emplace(pString, newID);
+	return newID;
+}
+
+/// <summary>
+/// Returns the ID of the given null terminated string, adding the string to the table if it hasn't been interned before
+/// </summary>
+/// <param name="pString">Given string</param>
+/// <returns>ID of the string</returns>
+unsigned int StringTable::Intern(const wchar_t* const pString)
+{
+	return Intern(std::wstring(pString));
+}
+
+/// <summary>
+/// Looks up the string with the given ID
+/// </summary>
+/// <param name="pID">ID returned by Intern</param>
+/// <returns>The interned string, the empty string if the ID is unknown</returns>
+const std::wstring& StringTable::String(const unsigned int pID)
+{
+	InternedStrings& table = Table();
+	std::lock_guard<std::mutex> lock(table.mutex);
+	return pID < table.strings.size() ? table.strings[pID] : table.strings[0];
+}
+
+/// <summary>
+/// Get method for the number of interned strings
+/// </summary>
+/// <returns>Number of interned strings, including the empty string</returns>
+unsigned int StringTable::Count()
+{
+	InternedStrings& table = Table();
+	std::lock_guard<std::mutex> lock(table.mutex);
+	return static_cast<unsigned int>(table.strings.size());
+}
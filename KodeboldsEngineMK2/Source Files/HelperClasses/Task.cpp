@@ -1,30 +1,138 @@
 #include "Task.h"
 
+//Each thread caches up to TASK_CACHE_SIZE free task blocks, swapping TASK_BATCH_SIZE blocks at a time with the shared pool when its cache runs out or fills up
+//Blocks freed on one thread are often allocated on another, the render and wave tasks are added on the main thread but usually finish on a worker
+const int TASK_CACHE_SIZE = 256;
+const int TASK_BATCH_SIZE = 128;
+
+//Free blocks that aren't in any threads cache
+class TaskPool
+{
+private:
+	std::mutex mMutex;
+	std::vector<void*> mBlocks;
+
+public:
+	/// <summary>
+	/// Destructor
+	/// Returns every free block to the heap
+	/// </summary>
+	~TaskPool()
+	{
+		for (void* const block : mBlocks)
+		{
+			::operator delete(block);
+		}
+	}
+
+	/// <summary>
+	/// Moves up to a batch of free blocks into the given cache
+	/// </summary>
+	/// <param name="pCache">Cache of the calling thread</param>
+	void Take(std::vector<void*>& pCache)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		const int count = static_cast<int>(mBlocks.size()) < TASK_BATCH_SIZE ? static_cast<int>(mBlocks.size()) : TASK_BATCH_SIZE;
+		pCache.insert(pCache.end(), mBlocks.end() - count, mBlocks.end());
+		mBlocks.resize(mBlocks.size() - count);
+	}
+
+	/// <summary>
+	/// Moves a batch of free blocks out of the given cache
+	/// </summary>
+	/// <param name="pCache">Cache of the calling thread</param>
+	void Give(std::vector<void*>& pCache)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mBlocks.insert(mBlocks.end(), pCache.end() - TASK_BATCH_SIZE, pCache.end());
+		pCache.resize(pCache.size() - TASK_BATCH_SIZE);
+	}
+};
+TaskPool taskPool;
+
+//Free blocks cached by a thread, returned to the heap when the thread exits
+class TaskCache
+{
+public:
+	std::vector<void*> blocks;
+
+	/// <summary>
+	/// Constructor
+	/// Reserves the whole cache up front so freeing a task never allocates
+	/// </summary>
+	TaskCache()
+	{
+		blocks.reserve(TASK_CACHE_SIZE);
+	}
+
+	/// <summary>
+	/// Destructor
+	/// Returns every cached block to the heap
+	/// </summary>
+	~TaskCache()
+	{
+		for (void* const block : blocks)
+		{
+			::operator delete(block);
+		}
+	}
+};
+thread_local TaskCache taskCache;
+
+/// <summary>
+/// Allocates the memory for a task from the cache of the calling thread, refilling the cache from the shared pool and only falling back to the heap when both are empty
+/// </summary>
+/// <param name="pSize">Size of the task</param>
+/// <returns>Memory for the task</returns>
+void* Task::operator new(const std::size_t pSize)
+{
+	std::vector<void*>& cache = taskCache.blocks;
+	if (cache.empty())
+	{
+		taskPool.Take(cache);
+		if (cache.empty())
+		{
+			return ::operator new(pSize);
+		}
+	}
+
+	void* const block = cache.back();
+	cache.pop_back();
+	return block;
+}
+
 /// <summary>
-/// Constructs a Task class that encapsulates a std::function pointer, its parameters and the thread affinity for the task
+/// Returns the memory of a task to the cache of the calling thread, handing a batch to the shared pool when the cache is full
 /// </summary>
-/// <param name="pFunction">Function pointer to the given function</param>
-/// <param name="pParam1">The first parameter of the function</param>
-/// <param name="pParam2">The second parameter of the function</param>
-/// <param name="pThreadAffinity">Thread affinity of the task</param>
-Task::Task(std::function<void(void* param1, void* param2)> pFunction, void* pParam1, void* pParam2, const std::vector<int>& pThreadAffinity)
-	:mParam1(pParam1), mParam2(pParam2), mFunction(pFunction), mAffinity(pThreadAffinity), mIsDone(false)
+/// <param name="pMemory">Memory of the task</param>
+void Task::operator delete(void* const pMemory)
 {
+	std::vector<void*>& cache = taskCache.blocks;
+	if (static_cast<int>(cache.size()) == TASK_CACHE_SIZE)
+	{
+		taskPool.Give(cache);
+	}
+	cache.push_back(pMemory);
 }
 
 /// <summary>
-/// Default destructor
+/// Destructor
+/// Destroys the stored function
 /// </summary>
 Task::~Task()
 {
+	mDestroy(&mStorage);
 }
 
 /// <summary>
-/// Run method of the task, runs the contained std::function pointer and sets isDone to true when complete
+/// Run method of the task, runs the stored function and sets isDone to true when complete
+/// No continuations can be added once the task is done, so the continuations can be read without locking afterwards
 /// </summary>
 void Task::Run()
 {
-	mFunction(mParam1, mParam2);
+	mInvoke(&mStorage, mParam1, mParam2);
+
+	std::lock_guard<std::mutex> lock(mContinuationsMutex);
 	mIsDone = true;
 }
 
@@ -32,7 +140,7 @@ void Task::Run()
 /// Get method for the tasks thread affinity
 /// </summary>
 /// <returns>The thread affinity of the task</returns>
-const std::vector<int>& Task::ThreadAffinity()
+const CoreMask& Task::ThreadAffinity()
 {
 	return mAffinity;
 }
@@ -47,9 +155,81 @@ bool Task::IsDone()
 }
 
 /// <summary>
-/// Cleans up the task from memory
+/// Adds a reference to the task, keeping it alive until the reference is released
+/// </summary>
+void Task::AddReference()
+{
+	mReferences.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Releases a reference to the task, deleting the task once the last reference has been released
+/// </summary>
+void Task::Release()
+{
+	if (mReferences.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		delete this;
+	}
+}
+
+/// <summary>
+/// Adds a dependency the task must wait on before it can run
+/// </summary>
+void Task::AddDependency()
+{
+	mDependencies.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Finishes one of the dependencies of the task
+/// </summary>
+/// <returns>Bool representing whether that was the last dependency, meaning the task is ready to run</returns>
+bool Task::DependencyFinished()
+{
+	return mDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1;
+}
+
+/// <summary>
+/// Adds a task to be readied when this task finishes
+/// </summary>
+/// <param name="pTask">Task that depends on this task</param>
+/// <returns>Bool representing whether the continuation was added, false if this task has already finished</returns>
+bool Task::AddContinuation(Task* const pTask)
+{
+	std::lock_guard<std::mutex> lock(mContinuationsMutex);
+	if (mIsDone)
+	{
+		return false;
+	}
+
+	if (mContinuationCount < INLINE_CONTINUATIONS)
+	{
+		mContinuations[mContinuationCount] = pTask;
+	}
+	else
+	{
+		mMoreContinuations.push_back(pTask);
+	}
+	mContinuationCount++;
+	return true;
+}
+
+/// <summary>
+/// Get method for the number of tasks that depend on this task, only valid once the task is done
+/// </summary>
+/// <returns>Number of tasks that depend on this task</returns>
+int Task::ContinuationCount() const
+{
+	return mContinuationCount;
+}
+
+/// <summary>
+/// Get method for a task that depends on this task, only valid once the task is done
 /// </summary>
-void Task::CleanUpTask()
+/// <param name="pIndex">Index of the continuation</param>
+/// <returns>Task that depends on this task</returns>
+Task* Task::Continuation(const int pIndex) const
 {
-	delete this;
+	return pIndex < INLINE_CONTINUATIONS ? mContinuations[pIndex] : mMoreContinuations[pIndex - INLINE_CONTINUATIONS];
 }
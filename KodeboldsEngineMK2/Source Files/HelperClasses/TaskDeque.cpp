@@ -0,0 +1,129 @@
+#include "TaskDeque.h"
+
+/// <summary>
+/// Constructs an empty deque
+/// </summary>
+/// <param name="pCapacity">Initial number of tasks the deque can hold, rounded up to a power of two</param>
+TaskDeque::TaskDeque(const int pCapacity)
+	:mTop(0), mBottom(0)
+{
+	long long capacity = 1;
+	while (capacity < pCapacity)
+	{
+		capacity <<= 1;
+	}
+	mBuffers.push_back(std::make_unique<Buffer>(capacity));
+	mBuffer.store(mBuffers.back().get(), std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Default destructor
+/// </summary>
+TaskDeque::~TaskDeque()
+{
+}
+
+/// <summary>
+/// Copies the tasks of the given buffer into a buffer of twice the size and publishes it
+/// </summary>
+/// <param name="pBuffer">Current buffer</param>
+/// <param name="pBottom">Bottom index of the deque</param>
+/// <param name="pTop">Top index of the deque</param>
+/// <returns>The new buffer</returns>
+TaskDeque::Buffer* TaskDeque::Grow(Buffer* const pBuffer, const long long pBottom, const long long pTop)
+{
+	mBuffers.push_back(std::make_unique<Buffer>(pBuffer->capacity * 2));
+	Buffer* const buffer = mBuffers.back().get();
+	for (long long i = pTop; i < pBottom; i++)
+	{
+		buffer->Put(i, pBuffer->Get(i));
+	}
+	mBuffer.store(buffer, std::memory_order_release);
+	return buffer;
+}
+
+/// <summary>
+/// Pushes the given task onto the bottom of the deque
+/// Must only be called by the owner of the deque
+/// </summary>
+/// <param name="pTask">Given task</param>
+void TaskDeque::Push(Task* const pTask)
+{
+	const long long bottom = mBottom.load(std::memory_order_relaxed);
+	const long long top = mTop.load(std::memory_order_acquire);
+	Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+	if (bottom - top > buffer->capacity - 1)
+	{
+		buffer = Grow(buffer, bottom, top);
+	}
+	buffer->Put(bottom, pTask);
+
+	//Release so the task is visible before thieves can see the new bottom
+	mBottom.store(bottom + 1, std::memory_order_release);
+}
+
+/// <summary>
+/// Takes the newest task from the bottom of the deque
+/// Must only be called by the owner of the deque
+/// </summary>
+/// <returns>The task, nullptr if the deque is empty or a thief took the last task</returns>
+Task* TaskDeque::Pop()
+{
+	const long long bottom = mBottom.load(std::memory_order_relaxed) - 1;
+	Buffer* const buffer = mBuffer.load(std::memory_order_relaxed);
+	mBottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	long long top = mTop.load(std::memory_order_relaxed);
+
+	if (top > bottom)
+	{
+		//Empty, restore the bottom
+		mBottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Task* task = buffer->Get(bottom);
+	if (top == bottom)
+	{
+		//Last task, race thieves for it
+		if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			task = nullptr;
+		}
+		mBottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+	return task;
+}
+
+/// <summary>
+/// Takes the oldest task from the top of the deque
+/// Can be called by any thread
+/// </summary>
+/// <returns>The task, nullptr if the deque is empty or another thread took the task first</returns>
+Task* TaskDeque::Steal()
+{
+	long long top = mTop.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const long long bottom = mBottom.load(std::memory_order_acquire);
+
+	if (top >= bottom)
+	{
+		return nullptr;
+	}
+
+	Task* const task = mBuffer.load(std::memory_order_acquire)->Get(top);
+	if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+	{
+		return nullptr;
+	}
+	return task;
+}
+
+/// <summary>
+/// Checks if the deque holds no tasks, the result may be out of date as soon as it is returned if other threads are using the deque
+/// </summary>
+/// <returns>Bool representing whether the deque is empty</returns>
+bool TaskDeque::Empty() const
+{
+	return mTop.load(std::memory_order_acquire) >= mBottom.load(std::memory_order_acquire);
+}
@@ -1,22 +1,43 @@
 #include "Thread.h"
+#include "ThreadManager.h"
+#include "CpuTopology.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+//Nice values used for the priorities either side of normal, nice values run from -20 for the highest priority to 19 for the lowest
+const int LINUX_BELOW_NORMAL_NICENESS = 5;
+const int LINUX_ABOVE_NORMAL_NICENESS = -5;
+#endif
+
+//Worker running on this thread, nullptr on threads that aren't workers
+thread_local Thread* currentThread = nullptr;
 
 /// <summary>
 /// The main function for the thread
-/// Calls the run function of the thread class
+/// Names the thread after the worker then calls the run function of the thread class
 /// </summary>
 auto threadMain = [](Thread* pThread)
 {
+	currentThread = pThread;
+	Thread::SetThreadName("Worker " + std::to_string(pThread->Index()));
 	pThread->Run();
 };
 
 /// <summary>
 /// Constructor for the thread class
-/// Calls the start method upon construction, creating a new thread
+/// The thread isn't started until Start is called, so the thread manager can create every worker before any of them start stealing
 /// </summary>
-Thread::Thread()
-	:mTask(nullptr), mNeedsTask(true)
+/// <param name="pThreadManager">Thread manager the worker takes tasks from</param>
+/// <param name="pIndex">Index of the worker in the thread manager</param>
+Thread::Thread(ThreadManager* const pThreadManager, const int pIndex)
+	:mThreadManager(pThreadManager), mIndex(pIndex), mHomeAffinityChanged(false)
 {
-	Start();
 }
 
 /// <summary>
@@ -34,64 +55,217 @@ void Thread::Start()
 	mThread = std::thread(threadMain, this);
 }
 
-/// <summary>
-/// Sets the task of the thread to a given task
-/// </summary>
-/// <param name="pTask">The given task to assign to the thread</param>
-void Thread::SetTask(Task* pTask)
-{
-	mTask = pTask;
-	mNeedsTask = false;
-}
-
 /// <summary>
 /// The run method of the thread that contains all the logic executed on the thread
+/// Waits for the next task from the thread manager, which finds work in this workers deque, the shared queue or the deques of other workers
 /// </summary>
 void Thread::Run()
 {
 	while (true)
 	{
-		if (mTask)
+		Task* const task = mThreadManager->WaitForTask(mIndex);
+
+		//Picks up home cores set by another thread since the last task
+		if (mHomeAffinityChanged.exchange(false))
 		{
-			//Sets thread affinity to the affinity specified in the task, runs the task and then sets thread to requiring new task
-			SetThreadAffinity(mTask->ThreadAffinity());
-			mTask->Run();
-			mTask = nullptr;
-			mNeedsTask = true;
+			std::lock_guard<std::mutex> lock(mAffinityMutex);
+			mHomeAffinity = mNewHomeAffinity;
 		}
 
-		//Sleep to prevent thread taking 100% cpu with a busy while
-		Sleep(1);
+		//Runs the task on the cores specified in the task, or on the home cores of the worker if the task doesn't specify any
+		UpdateAffinity(task->ThreadAffinity().Empty() ? mHomeAffinity : task->ThreadAffinity());
+		mThreadManager->RunTask(task);
 	}
 }
 
 /// <summary>
-/// Get method for the Threads need task status
+/// Pushes the given task onto this workers deque
+/// Must only be called from this worker
+/// </summary>
+/// <param name="pTask">The given task</param>
+void Thread::PushTask(Task* const pTask)
+{
+	mTasks.Push(pTask);
+}
+
+/// <summary>
+/// Takes the newest task from this workers deque
+/// Must only be called from this worker
+/// </summary>
+/// <returns>The task, nullptr if the deque is empty</returns>
+Task* Thread::PopTask()
+{
+	return mTasks.Pop();
+}
+
+/// <summary>
+/// Takes the oldest task from this workers deque, called by other threads looking for work
 /// </summary>
-/// <returns>A bool determining whether the thread needs a task or not</returns>
-bool Thread::NeedsTask()
+/// <returns>The task, nullptr if there was nothing to steal</returns>
+Task* Thread::StealTask()
 {
-	return mNeedsTask;;
+	return mTasks.Steal();
 }
 
 /// <summary>
-/// Sets the thread affinity to the given core
+/// Checks if this workers deque holds any tasks
 /// </summary>
-/// <param name="pCore">Core to set the threads affinity to</param>
-void Thread::SetThreadAffinity(const std::vector<int>& pCores)
+/// <returns>Bool representing whether the deque has tasks</returns>
+bool Thread::HasTasks() const
 {
-	if (pCores.size() != 0)
+	return !mTasks.Empty();
+}
+
+/// <summary>
+/// Get method for the index of the worker in the thread manager
+/// </summary>
+/// <returns>Index of the worker</returns>
+int Thread::Index() const
+{
+	return mIndex;
+}
+
+/// <summary>
+/// Sets the cores the worker runs on when its task doesn't specify any, the worker moves to them before its next task
+/// </summary>
+/// <param name="pCores">Cores to run the worker on, empty for every core</param>
+void Thread::SetHomeAffinity(const CoreMask& pCores)
+{
+	std::lock_guard<std::mutex> lock(mAffinityMutex);
+	mNewHomeAffinity = pCores;
+	mHomeAffinityChanged = true;
+}
+
+/// <summary>
+/// Get method for the worker running on the calling thread
+/// </summary>
+/// <returns>The worker, nullptr if the calling thread isn't a worker</returns>
+Thread* Thread::Current()
+{
+	return currentThread;
+}
+
+/// <summary>
+/// Moves the worker to the given cores if it isn't already on them
+/// The current cores are only updated once the move succeeds, so a failed move is tried again before the next task
+/// Must only be called from this worker
+/// </summary>
+/// <param name="pCores">Cores to run the worker on, empty for every core</param>
+void Thread::UpdateAffinity(const CoreMask& pCores)
+{
+	if (pCores != mAffinity && SetThreadAffinity(pCores))
 	{
-		const auto handle = mThread.native_handle();
-		DWORD_PTR mask = 0;
+		mAffinity = pCores;
+	}
+}
 
-		for (const auto& core : pCores)
+/// <summary>
+/// Sets the affinity of the calling thread to the given cores
+/// </summary>
+/// <param name="pCores">Cores to set the threads affinity to, empty for every core</param>
+/// <returns>Bool representing whether the affinity was set</returns>
+bool Thread::SetThreadAffinity(const CoreMask& pCores)
+{
+	const CoreMask cores = pCores.Empty() ? CoreMask(CpuTopology::Instance()->LogicalCores()) : pCores;
+
+#ifdef _WIN32
+	DWORD_PTR mask = 0;
+	for (int core = 0; core < static_cast<int>(sizeof(DWORD_PTR) * 8); core++)
+	{
+		if (cores.IsSet(core))
+		{
+			mask |= (static_cast<DWORD_PTR>(1) << core);
+		}
+	}
+	return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (int core = 0; core < CoreMask::MAX_CORES && core < CPU_SETSIZE; core++)
+	{
+		if (cores.IsSet(core))
 		{
-			if (!(core < 0))
-			{
-				mask += (1i64 << core);
-			}
+			CPU_SET(core, &set);
 		}
-		SetThreadAffinityMask(handle, mask);
 	}
+	return CPU_COUNT(&set) > 0 && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif
+}
+
+/// <summary>
+/// Sets the priority of the calling thread
+/// On Linux the lowest priority uses the idle scheduling policy and the highest uses the real time FIFO policy, the priorities in between set the nice value of the thread
+/// Raising a thread above normal needs CAP_SYS_NICE or a raised nice or real time limit on Linux, without them the call is expected to fail and the thread keeps its current priority
+/// </summary>
+/// <param name="pPriority">Priority to set the thread to</param>
+/// <returns>Bool representing whether the priority was set</returns>
+bool Thread::SetThreadPriority(const THREAD_PRIORITY pPriority)
+{
+#ifdef _WIN32
+	int priority = THREAD_PRIORITY_NORMAL;
+	switch (pPriority)
+	{
+	case THREAD_PRIORITY::LOWEST:
+		priority = THREAD_PRIORITY_LOWEST;
+		break;
+	case THREAD_PRIORITY::BELOW_NORMAL:
+		priority = THREAD_PRIORITY_BELOW_NORMAL;
+		break;
+	case THREAD_PRIORITY::ABOVE_NORMAL:
+		priority = THREAD_PRIORITY_ABOVE_NORMAL;
+		break;
+	case THREAD_PRIORITY::HIGHEST:
+		priority = THREAD_PRIORITY_HIGHEST;
+		break;
+	default:
+		break;
+	}
+	return ::SetThreadPriority(GetCurrentThread(), priority) != 0;
+#else
+	int policy = SCHED_OTHER;
+	int niceness = 0;
+	switch (pPriority)
+	{
+	case THREAD_PRIORITY::LOWEST:
+		policy = SCHED_IDLE;
+		break;
+	case THREAD_PRIORITY::BELOW_NORMAL:
+		niceness = LINUX_BELOW_NORMAL_NICENESS;
+		break;
+	case THREAD_PRIORITY::ABOVE_NORMAL:
+		niceness = LINUX_ABOVE_NORMAL_NICENESS;
+		break;
+	case THREAD_PRIORITY::HIGHEST:
+		policy = SCHED_FIFO;
+		break;
+	default:
+		break;
+	}
+
+	sched_param parameters;
+	parameters.sched_priority = policy == SCHED_FIFO ? sched_get_priority_min(policy) : 0;
+	if (pthread_setschedparam(pthread_self(), policy, &parameters) != 0)
+	{
+		return false;
+	}
+
+	//Nice values belong to each thread on Linux, so the thread is identified by its thread id rather than the process id
+	return setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), niceness) == 0;
+#endif
+}
+
+/// <summary>
+/// Sets the name of the calling thread shown in debuggers and profilers
+/// On Linux names are cut to 15 characters
+/// </summary>
+/// <param name="pName">Name of the thread</param>
+/// <returns>Bool representing whether the name was set</returns>
+bool Thread::SetThreadName(const std::string& pName)
+{
+#ifdef _WIN32
+	const std::wstring name(pName.begin(), pName.end());
+	return SUCCEEDED(SetThreadDescription(GetCurrentThread(), name.c_str()));
+#else
+	return pthread_setname_np(pthread_self(), pName.substr(0, 15).c_str()) == 0;
+#endif
 }
@@ -51,14 +51,6 @@ Matrix4::Matrix4(
 {
 }
 
-/// <summary>
-/// Default destructor for Matrix4
-/// </summary>
-Matrix4::~Matrix4()
-{
-}
-
-
 /// <summary>
 /// Multiplies this matrix with a given matrix
 /// </summary>
@@ -22,13 +22,6 @@ Vector4::Vector4(const float x, const float y, const float z, const float w)
 {
 }
 
-/// <summary>
-/// Default destructor for Vector4
-/// </summary>
-Vector4::~Vector4()
-{
-}
-
 /// <summary>
 /// Calculates and returns the magnitude of the vector
 /// </summary>
@@ -22,13 +22,6 @@ Vector2::Vector2(const float x, const float y)
 {
 }
 
-/// <summary>
-/// Default destructor for Vector4
-/// </summary>
-Vector2::~Vector2()
-{
-}
-
 /// <summary>
 /// Calculates and returns the magnitude of the vector
 /// </summary>
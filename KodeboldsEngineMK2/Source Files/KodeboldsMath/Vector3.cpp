@@ -21,13 +21,6 @@ Vector3::Vector3(const float x, const float y, const float z)
 {
 }
 
-/// <summary>
-/// Default destructor for Vector4
-/// </summary>
-Vector3::~Vector3()
-{
-}
-
 /// <summary>
 /// Calculates and returns the magnitude of the vector
 /// </summary>
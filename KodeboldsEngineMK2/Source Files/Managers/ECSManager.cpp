@@ -1,69 +1,945 @@
 #include "ECSManager.h"
+#include "MappedFile.h"
 #include "RenderSystem_DX.h"
 
 using namespace std;
 
+//Mask of every built in component, custom components occupy the bits above
+const int BUILT_IN_COMPONENTS = ComponentType::CUSTOM_COMPONENT - 1;
+
+//Number of entities a defragmentation step visits between checks of the time budget
+const int DEFRAGMENT_BATCH = 256;
+
+//Command buffer of the update system running on this thread, nullptr outside of update systems
+thread_local EntityCommandBuffer* activeCommandBuffer = nullptr;
+
+/// <summary>
+/// Looks up the entity referenced by the given handle
+/// The handle is only valid if the entity stored at its index still carries the same handle, so stale handles are detected in constant time
+/// </summary>
+/// <param name="pEntityID">Given handle of the entity</param>
+/// <returns>Pointer to the entity, nullptr if the handle refers to a destroyed entity</returns>
+Entity* const ECSManager::LiveEntity(const EntityHandle pEntityID)
+{
+	if (pEntityID.Index() < mEntities.size() && mEntities[pEntityID.Index()].ID == pEntityID)
+	{
+		return &mEntities[pEntityID.Index()];
+	}
+	return nullptr;
+}
+
+/// <summary>
+/// Reserves a handle for a new entity, reusing the index of a destroyed entity if one is available
+/// Reused indices carry the next generation so handles to the destroyed entity remain invalid
+/// Safe to call from any thread, the entity isn't alive until it is placed
+/// Component pools only map max entities indices, so no new index is handed out once they are all in use
+/// </summary>
+/// <returns>Reserved handle, null if every index up to max entities is in use</returns>
+EntityHandle ECSManager::ReserveEntity()
+{
+	std::lock_guard<std::mutex> lock(mEntityIDMutex);
+	if (!mFreeEntityIDs.empty())
+	{
+		const EntityHandle entityID = mFreeEntityIDs.back();
+		mFreeEntityIDs.pop_back();
+		return entityID;
+	}
+	if (mEntityID >= MAX_ENTITIES)
+	{
+		return EntityHandle();
+	}
+	return EntityHandle(mEntityID++, 0);
+}
+
+/// <summary>
+/// Makes the entity with the given reserved handle alive, enabled and outside of any pool
+/// Indices can be reserved out of order by command buffers, so the entity list is grown with empty slots as needed
+/// </summary>
+/// <param name="pEntityID">Reserved handle of the entity, null handles from a full entity list are ignored</param>
+void ECSManager::PlaceEntity(const EntityHandle pEntityID)
+{
+	if (pEntityID.IsNull())
+	{
+		return;
+	}
+
+	if (pEntityID.Index() >= mEntities.size())
+	{
+		mEntities.resize(pEntityID.Index() + 1, Entity{ EntityHandle(), ComponentType::COMPONENT_NONE });
+		mEnabledEntities.resize(mEntities.size(), 1);
+		mEntityPoolIndices.resize(mEntities.size(), -1);
+	}
+	mEntities[pEntityID.Index()] = Entity{ pEntityID, ComponentType::COMPONENT_NONE };
+	mEnabledEntities[pEntityID.Index()] = 1;
+	mEntityPoolIndices[pEntityID.Index()] = -1;
+}
+
+/// <summary>
+/// Instantiates the given number of disabled entities into the pool with the given index
+/// </summary>
+/// <param name="pPoolIndex">Index of the given pool</param>
+/// <param name="pCount">Number of entities to add to the pool</param>
+void ECSManager::GrowEntityPool(const int pPoolIndex, const int pCount)
+{
+	const std::vector<EntityHandle> entities = Instantiate(mEntityPools[pPoolIndex].prefab, pCount);
+
+	EntityPool& pool = mEntityPools[pPoolIndex];
+	for (const EntityHandle entityID : entities)
+	{
+		mEnabledEntities[entityID.Index()] = 0;
+		mEntityPoolIndices[entityID.Index()] = pPoolIndex;
+		pool.inactive.push_back(entityID);
+	}
+	pool.size += static_cast<int>(entities.size());
+}
+
+/// <summary>
+/// Rebuilds the inactive list and size of every pool from the pool index and enabled bit of each entity
+/// Used after a snapshot is loaded, pooled entities whose pool no longer exists are kept as ordinary entities
+/// </summary>
+void ECSManager::RefillEntityPools()
+{
+	for (auto& pool : mEntityPools)
+	{
+		pool.inactive.clear();
+		pool.size = 0;
+	}
+
+	for (const Entity& entity : mEntities)
+	{
+		if (entity.ID.IsNull())
+		{
+			continue;
+		}
+
+		int& poolIndex = mEntityPoolIndices[entity.ID.Index()];
+		if (poolIndex >= static_cast<int>(mEntityPools.size()))
+		{
+			poolIndex = -1;
+		}
+		if (poolIndex != -1)
+		{
+			mEntityPools[poolIndex].size++;
+			if (!mEnabledEntities[entity.ID.Index()])
+			{
+				mEntityPools[poolIndex].inactive.push_back(entity.ID);
+			}
+		}
+	}
+}
+
+/// <summary>
+/// Records that systems need to be notified of the given entities mask change once command playback has finished
+/// Only the mask the entity had before its first change is kept, so each entity is only notified once per playback no matter how many of its components changed
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+/// <param name="pOldMask">Component mask of the entity before the change</param>
+void ECSManager::DeferNotification(const EntityHandle pEntityID, const ComponentMask& pOldMask)
+{
+	const unsigned int index = pEntityID.Index();
+	if (index >= mPendingNotificationPositions.size())
+	{
+		mPendingNotificationPositions.resize(index + 1, -1);
+	}
+
+	if (mPendingNotificationPositions[index] == -1)
+	{
+		mPendingNotificationPositions[index] = static_cast<int>(mPendingNotifications.size());
+		mPendingNotifications.emplace_back(pEntityID, pOldMask);
+	}
+}
+
+/// <summary>
+/// Plays back the command buffers, then notifies systems once for every entity that changed
+/// Systems are notified of the difference between the mask each entity had before playback and its final mask
+/// </summary>
+void ECSManager::PlaybackCommands()
+{
+	//Commands recorded outside of systems are played back first, followed by each systems commands in the order the systems were added
+	mDeferNotifications = true;
+	mCommandBuffer.Playback();
+	for (auto& commandBuffer : mSystemCommandBuffers)
+	{
+		commandBuffer->Playback();
+	}
+	mDeferNotifications = false;
+
+	for (const auto& notification : mPendingNotifications)
+	{
+		//Destroyed entities are notified with an empty mask so systems release them
+		const Entity* const entity = LiveEntity(notification.first);
+		NotifySystems(notification.first, notification.second, entity ? entity->componentMask : ComponentMask());
+		mPendingNotificationPositions[notification.first.Index()] = -1;
+	}
+	mPendingNotifications.clear();
+}
+
+/// <summary>
+/// Registers a signature for each mask of the given system and indexes it by every component bit in the mask
+/// </summary>
+/// <param name="pSystem">Given system</param>
+void ECSManager::RegisterSignatures(ISystem* const pSystem)
+{
+	const std::vector<ComponentMask>& masks = pSystem->Masks();
+	for (int i = 0; i < masks.size(); i++)
+	{
+		const int signatureIndex = static_cast<int>(mSystemSignatures.size());
+		mSystemSignatures.push_back(SystemSignature{ pSystem, masks[i], i });
+		mSignatureStamps.push_back(0);
+
+		masks[i].ForEachBit([&](const int pBitIndex) { mSignaturesByComponent[pBitIndex].push_back(signatureIndex); });
+	}
+}
+
+/// <summary>
+/// Notifies systems of a change to the given entities component mask
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+/// <param name="pOldMask">Component mask of the entity before the change</param>
+/// <param name="pNewMask">Component mask of the entity after the change</param>
+void ECSManager::NotifySystems(const EntityHandle pEntityID, const ComponentMask& pOldMask, const ComponentMask& pNewMask)
+{
+	NotifySystems(&pEntityID, 1, pOldMask, pNewMask);
+}
+
+/// <summary>
+/// Notifies systems of the same component mask change to a batch of entities
+/// Only signatures containing a changed component are visited, and a system is only called when the entities start or stop matching one of its masks
+/// Signatures are resolved once for the whole batch, then each affected system is called for every entity in turn
+/// Deferred until the end of command playback if commands are being played back
+/// </summary>
+/// <param name="pEntityIDs">IDs of the given entities</param>
+/// <param name="pCount">Number of given entities</param>
+/// <param name="pOldMask">Component mask of the entities before the change</param>
+/// <param name="pNewMask">Component mask of the entities after the change</param>
+void ECSManager::NotifySystems(const EntityHandle* const pEntityIDs, const int pCount, const ComponentMask& pOldMask, const ComponentMask& pNewMask)
+{
+	if (mDeferNotifications)
+	{
+		for (int i = 0; i < pCount; i++)
+		{
+			DeferNotification(pEntityIDs[i], pOldMask);
+		}
+		return;
+	}
+
+	const ComponentMask changedMask = pOldMask ^ pNewMask;
+	if (changedMask.IsEmpty())
+	{
+		return;
+	}
+
+	for (int i = 0; i < pCount; i++)
+	{
+		UpdateViews(Entity{ pEntityIDs[i], pNewMask }, pOldMask);
+	}
+
+	//Signatures containing several changed components are only visited once per notification
+	mNotificationStamp++;
+	changedMask.ForEachBit([&](const int pBitIndex)
+	{
+		for (const int signatureIndex : mSignaturesByComponent[pBitIndex])
+		{
+			if (mSignatureStamps[signatureIndex] == mNotificationStamp)
+			{
+				continue;
+			}
+			mSignatureStamps[signatureIndex] = mNotificationStamp;
+
+			const SystemSignature& signature = mSystemSignatures[signatureIndex];
+			const bool matched = pOldMask.Contains(signature.componentMask);
+			const bool matches = pNewMask.Contains(signature.componentMask);
+			if (matches && !matched)
+			{
+				for (int i = 0; i < pCount; i++)
+				{
+					signature.system->OnEnter(Entity{ pEntityIDs[i], pNewMask }, signature.maskIndex);
+				}
+			}
+			else if (matched && !matches)
+			{
+				for (int i = 0; i < pCount; i++)
+				{
+					signature.system->OnExit(Entity{ pEntityIDs[i], pNewMask }, signature.maskIndex);
+				}
+			}
+		}
+	});
+}
+
+/// <summary>
+/// Adds the given entity to every view whose component mask it now matches and removes it from every view it no longer matches
+/// </summary>
+/// <param name="pEntity">Entity whose component mask has changed</param>
+/// <param name="pOldMask">Component mask of the entity before the change</param>
+void ECSManager::UpdateViews(const Entity& pEntity, const ComponentMask& pOldMask)
+{
+	for (auto& view : mViews)
+	{
+		const bool matched = pOldMask.Contains(view.first);
+		const bool matches = pEntity.componentMask.Contains(view.first);
+		if (matches && !matched)
+		{
+			view.second.Add(pEntity);
+		}
+		else if (matched && !matches)
+		{
+			view.second.Remove(pEntity.ID);
+		}
+	}
+}
+
+/// <summary>
+/// Returns the packed list of entities matching the given component mask
+/// The list is built from the live entities the first time the mask is queried
+/// </summary>
+/// <param name="pComponentMask">Given component mask</param>
+/// <returns>Packed list of matching entities</returns>
+EntityList& ECSManager::ViewEntities(const ComponentMask& pComponentMask)
+{
+	std::lock_guard<std::mutex> lock(mViewsMutex);
+
+	const auto view = mViews.find(pComponentMask);
+	if (view != mViews.end())
+	{
+		return view->second;
+	}
+
+	EntityList& entities = mViews[pComponentMask];
+	for (const Entity& entity : mEntities)
+	{
+		if (!entity.ID.IsNull() && entity.componentMask.Contains(pComponentMask))
+		{
+			entities.Add(entity);
+		}
+	}
+	return entities;
+}
+
+/// <summary>
+/// Resizes the entity component maps of every built in and custom component pool to the max entities value
+/// </summary>
+void ECSManager::ResizeEntityMaps()
+{
+	mAIs.entityMap.resize(MAX_ENTITIES);
+	mAudios.entityMap.resize(MAX_ENTITIES);
+	mBoxColliders.entityMap.resize(MAX_ENTITIES);
+	mCameras.entityMap.resize(MAX_ENTITIES);
+	mCollisions.entityMap.resize(MAX_ENTITIES);
+	mColours.entityMap.resize(MAX_ENTITIES);
+	mGeometries.entityMap.resize(MAX_ENTITIES);
+	mGravities.entityMap.resize(MAX_ENTITIES);
+	mPointLights.entityMap.resize(MAX_ENTITIES);
+	mDirectionalLights.entityMap.resize(MAX_ENTITIES);
+	mRays.entityMap.resize(MAX_ENTITIES);
+	mShaders.entityMap.resize(MAX_ENTITIES);
+	mSphereColliders.entityMap.resize(MAX_ENTITIES);
+	mTextures.entityMap.resize(MAX_ENTITIES);
+	mTransforms.entityMap.resize(MAX_ENTITIES);
+	mVelocities.entityMap.resize(MAX_ENTITIES);
+	mParents.entityMap.resize(MAX_ENTITIES);
+
+	mArchetypeLocations.resize(MAX_ENTITIES, ArchetypeLocation{ nullptr, -1 });
+
+	for (auto& versions : mComponentVersions)
+	{
+		versions.resize(MAX_ENTITIES, 0);
+	}
+
+	for (auto& customPool : mCustomComponentPools)
+	{
+		if (customPool)
+		{
+			customPool->Resize(MAX_ENTITIES);
+		}
+	}
+}
+
+/// <summary>
+/// Finds the archetype that stores entities with the given built in component mask, creating it if it doesn't exist yet
+/// </summary>
+/// <param name="pComponentMask">Given built in component mask</param>
+/// <returns>Pointer to the archetype, nullptr if the mask contains no built in components</returns>
+Archetype* const ECSManager::FindArchetype(const int pComponentMask)
+{
+	if (pComponentMask == ComponentType::COMPONENT_NONE)
+	{
+		return nullptr;
+	}
+
+	const auto archetype = mArchetypeLookup.find(pComponentMask);
+	if (archetype != mArchetypeLookup.end())
+	{
+		return archetype->second;
+	}
+
+	//Gather column types for each component in the mask, ordered by component mask
+	vector<const ComponentColumnType*> columnTypes;
+	for (const auto& columnType : mColumnTypes)
+	{
+		if (columnType.componentMask != ComponentType::COMPONENT_NONE && (pComponentMask & columnType.componentMask) == columnType.componentMask)
+		{
+			columnTypes.push_back(&columnType);
+		}
+	}
+
+	Archetype* const newArchetype = new Archetype(pComponentMask, columnTypes);
+	mArchetypes.push_back(newArchetype);
+	mArchetypeLookup[pComponentMask] = newArchetype;
+	return newArchetype;
+}
+
+/// <summary>
+/// Moves the given entity into the archetype matching the given component mask
+/// Components shared by both archetypes are moved across, the added component (if any) is copied into the new archetype and components that are no longer in the mask are destroyed
+/// </summary>
+/// <param name="pEntityIndex">Index of the given entity</param>
+/// <param name="pComponentMask">New component mask of the entity</param>
+/// <param name="pAddedComponent">Component being added to the entity, nullptr if a component is being removed</param>
+/// <param name="pAddedMask">Component mask of the added component</param>
+void ECSManager::MoveToArchetype(const int pEntityIndex, const int pComponentMask, const void* const pAddedComponent, const int pAddedMask)
+{
+	ArchetypeLocation& location = mArchetypeLocations[pEntityIndex];
+	Archetype* const source = location.archetype;
+	const int sourceRow = location.row;
+
+	//Custom components are not stored in archetypes
+	Archetype* const destination = FindArchetype(pComponentMask & BUILT_IN_COMPONENTS);
+	int destinationRow = -1;
+
+	if (destination)
+	{
+		destinationRow = destination->AddEntity(pEntityIndex);
+
+		for (const auto& columnType : destination->ColumnTypes())
+		{
+			void* const component = destination->Component(destinationRow, columnType->componentMask);
+			if (columnType->componentMask == pAddedMask)
+			{
+				columnType->copyConstruct(component, pAddedComponent);
+			}
+			else
+			{
+				columnType->moveConstruct(component, source->Component(sourceRow, columnType->componentMask));
+			}
+		}
+	}
+
+	if (source)
+	{
+		//Removing the entity moves the last entity of the source archetype into the vacated row
+		const int movedEntity = source->RemoveEntity(sourceRow);
+		if (movedEntity != -1)
+		{
+			mArchetypeLocations[movedEntity].row = sourceRow;
+		}
+	}
+
+	location = ArchetypeLocation{ destination, destinationRow };
+}
+
+/// <summary>
+/// Adds the given component to the given entity, then notifies systems of the change
+/// If the entity already owns a component of this type it is overwritten
+/// </summary>
+/// <param name="pPool">Pool that stores components of type T</param>
+/// <param name="pComponent">Component to add</param>
+/// <param name="pComponentMask">Component mask of type T</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+template <class T>
+void ECSManager::AddComponent(ComponentPool<T>& pPool, const T& pComponent, const int pComponentMask, const EntityHandle pEntityID)
+{
+	//Ignore stale handles to destroyed entities
+	Entity* const entity = LiveEntity(pEntityID);
+	if (!entity)
+	{
+		return;
+	}
+	const int index = pEntityID.Index();
+	const ComponentMask oldMask = entity->componentMask;
+
+	if (entity->componentMask.Contains(pComponentMask))
+	{
+		//Overwrite existing component
+		*Component(pPool, pComponentMask, pEntityID) = pComponent;
+	}
+	else if (mStorageMode == StorageMode::ARCHETYPE)
+	{
+		//Move entity into the archetype containing the new component
+		MoveToArchetype(index, entity->componentMask.BuiltIn() | pComponentMask, &pComponent, pComponentMask);
+	}
+	else
+	{
+		//Store in a free slot or at the back of the pool
+		pPool.Place(index, pComponent);
+	}
+
+	//Adjust mask, record the change then notify systems
+	entity->componentMask |= pComponentMask;
+	StampVersions(index, pComponentMask);
+	NotifySystems(pEntityID, oldMask, entity->componentMask);
+}
+
+/// <summary>
+/// Removes the component of type T from the given entity, then notifies systems of the change
+/// </summary>
+/// <param name="pPool">Pool that stores components of type T</param>
+/// <param name="pComponentMask">Component mask of type T</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+template <class T>
+void ECSManager::RemoveComponent(ComponentPool<T>& pPool, const int pComponentMask, const EntityHandle pEntityID)
+{
+	Entity* const entity = LiveEntity(pEntityID);
+
+	//Checks if entity is alive and actually owns a component of this type
+	if (entity && entity->componentMask.Contains(pComponentMask))
+	{
+		const ComponentMask oldMask = entity->componentMask;
+		if (mStorageMode == StorageMode::ARCHETYPE)
+		{
+			//Move entity into the archetype without this component
+			MoveToArchetype(pEntityID.Index(), entity->componentMask.BuiltIn() & ~pComponentMask, nullptr, ComponentType::COMPONENT_NONE);
+		}
+		else
+		{
+			//Add slot in component array to free list
+			pPool.Free(pEntityID.Index());
+		}
+
+		//Update mask and notify systems
+		entity->componentMask = entity->componentMask.Without(pComponentMask);
+		NotifySystems(pEntityID, oldMask, entity->componentMask);
+	}
+}
+
+/// <summary>
+/// Returns the slot of the given entities component of type T to the pools free list without notifying systems
+/// Only used by the sparse storage mode
+/// </summary>
+/// <param name="pPool">Pool that stores components of type T</param>
+/// <param name="pComponentMask">Component mask of type T</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+template <class T>
+void ECSManager::ReleaseComponent(ComponentPool<T>& pPool, const int pComponentMask, const EntityHandle pEntityID)
+{
+	if (mEntities[pEntityID.Index()].componentMask.Contains(pComponentMask))
+	{
+		pPool.Free(pEntityID.Index());
+	}
+}
+
+/// <summary>
+/// Copies the prefabs component of type T onto every given entity, filling free slots of the pool before appending the rest in a single pass
+/// Only used by the sparse storage mode
+/// </summary>
+/// <param name="pPool">Pool that stores components of type T</param>
+/// <param name="pComponentMask">Component mask of type T</param>
+/// <param name="pPrefab">Given prefab</param>
+/// <param name="pEntityIDs">IDs of the instantiated entities</param>
+template <class T>
+void ECSManager::InstantiateComponents(ComponentPool<T>& pPool, const int pComponentMask, const Prefab& pPrefab, const std::vector<EntityHandle>& pEntityIDs)
+{
+	const T* const component = static_cast<const T*>(pPrefab.Component(pComponentMask));
+	if (!component)
+	{
+		return;
+	}
+
+	const int appended = static_cast<int>(pEntityIDs.size()) - static_cast<int>(pPool.freeList.size());
+	if (appended > 0)
+	{
+		pPool.components.reserve(pPool.components.size() + appended);
+		pPool.owners.reserve(pPool.owners.size() + appended);
+	}
+
+	for (const EntityHandle entityID : pEntityIDs)
+	{
+		pPool.Place(entityID.Index(), *component);
+	}
+}
+
+/// <summary>
+/// Continues defragmenting the pool with the given index over the given number of entities
+/// Built in pools are indexed by the bit index of their component, custom pools follow in custom component type order and unused indices have nothing to defragment
+/// </summary>
+/// <param name="pPoolIndex">Index of the given pool</param>
+/// <param name="pEntityCount">Number of entities to visit</param>
+/// <returns>Bool representing whether the pool still needs defragmenting</returns>
+bool ECSManager::DefragmentPool(const int pPoolIndex, const int pEntityCount)
+{
+	switch (ComponentMask::Bit(pPoolIndex).BuiltIn())
+	{
+	case ComponentType::COMPONENT_AI: return mAIs.Defragment(mEntities, ComponentType::COMPONENT_AI, pEntityCount);
+	case ComponentType::COMPONENT_AUDIO: return mAudios.Defragment(mEntities, ComponentType::COMPONENT_AUDIO, pEntityCount);
+	case ComponentType::COMPONENT_BOXCOLLIDER: return mBoxColliders.Defragment(mEntities, ComponentType::COMPONENT_BOXCOLLIDER, pEntityCount);
+	case ComponentType::COMPONENT_CAMERA: return mCameras.Defragment(mEntities, ComponentType::COMPONENT_CAMERA, pEntityCount);
+	case ComponentType::COMPONENT_COLLISION: return mCollisions.Defragment(mEntities, ComponentType::COMPONENT_COLLISION, pEntityCount);
+	case ComponentType::COMPONENT_COLOUR: return mColours.Defragment(mEntities, ComponentType::COMPONENT_COLOUR, pEntityCount);
+	case ComponentType::COMPONENT_GEOMETRY: return mGeometries.Defragment(mEntities, ComponentType::COMPONENT_GEOMETRY, pEntityCount);
+	case ComponentType::COMPONENT_GRAVITY: return mGravities.Defragment(mEntities, ComponentType::COMPONENT_GRAVITY, pEntityCount);
+	case ComponentType::COMPONENT_POINTLIGHT: return mPointLights.Defragment(mEntities, ComponentType::COMPONENT_POINTLIGHT, pEntityCount);
+	case ComponentType::COMPONENT_DIRECTIONALLIGHT: return mDirectionalLights.Defragment(mEntities, ComponentType::COMPONENT_DIRECTIONALLIGHT, pEntityCount);
+	case ComponentType::COMPONENT_RAY: return mRays.Defragment(mEntities, ComponentType::COMPONENT_RAY, pEntityCount);
+	case ComponentType::COMPONENT_SHADER: return mShaders.Defragment(mEntities, ComponentType::COMPONENT_SHADER, pEntityCount);
+	case ComponentType::COMPONENT_SPHERECOLLIDER: return mSphereColliders.Defragment(mEntities, ComponentType::COMPONENT_SPHERECOLLIDER, pEntityCount);
+	case ComponentType::COMPONENT_TEXTURE: return mTextures.Defragment(mEntities, ComponentType::COMPONENT_TEXTURE, pEntityCount);
+	case ComponentType::COMPONENT_TRANSFORM: return mTransforms.Defragment(mEntities, ComponentType::COMPONENT_TRANSFORM, pEntityCount);
+	case ComponentType::COMPONENT_VELOCITY: return mVelocities.Defragment(mEntities, ComponentType::COMPONENT_VELOCITY, pEntityCount);
+	case ComponentType::COMPONENT_PARENT: return mParents.Defragment(mEntities, ComponentType::COMPONENT_PARENT, pEntityCount);
+	default:
+	{
+		const int typeIndex = pPoolIndex - ComponentMask::CUSTOM_BIT;
+		if (typeIndex >= 0 && typeIndex < static_cast<int>(mCustomComponentPools.size()) && mCustomComponentPools[typeIndex])
+		{
+			return mCustomComponentPools[typeIndex]->Defragment(mEntities, pEntityCount);
+		}
+		return false;
+	}
+	}
+}
+
+/// <summary>
+/// Returns a modifiable handle to the component of type T associated with the given entity and records a change to it at the current version
+/// </summary>
+/// <param name="pPool">Pool that stores components of type T</param>
+/// <param name="pComponentMask">Component mask of type T</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+/// <returns>Modifiable handle to the component, nullptr if the entity doesn't own one or the handle is stale</returns>
+template <class T>
+T* const ECSManager::ModifiableComponent(ComponentPool<T>& pPool, const int pComponentMask, const EntityHandle pEntityID)
+{
+	T* const component = Component(pPool, pComponentMask, pEntityID);
+	if (component)
+	{
+		mComponentVersions[MaskIndex(pComponentMask)][pEntityID.Index()] = mVersion;
+	}
+	return component;
+}
+
+/// <summary>
+/// Records a change at the current version to every built in component in the given mask for the given entity
+/// </summary>
+/// <param name="pEntityIndex">Index of the given entity</param>
+/// <param name="pComponentMask">Mask of the changed components, custom components are ignored</param>
+void ECSManager::StampVersions(const int pEntityIndex, const int pComponentMask)
+{
+	int changedMask = pComponentMask & BUILT_IN_COMPONENTS;
+	while (changedMask)
+	{
+		mComponentVersions[MaskIndex(changedMask)][pEntityIndex] = mVersion;
+		changedMask &= changedMask - 1;
+	}
+}
+
+/// <summary>
+/// Writes a section holding the component of type T of every entity that owns one in entity index order
+/// </summary>
+/// <param name="pWriter">Given writer</param>
+/// <param name="pPool">Pool that stores components of type T</param>
+/// <param name="pComponentMask">Component mask of type T</param>
+template <class T>
+void ECSManager::SaveComponents(SnapshotWriter& pWriter, ComponentPool<T>& pPool, const int pComponentMask)
+{
+	SnapshotSection section{ MaskIndex(pComponentMask), sizeof(T), 0, 0 };
+	const size_t sectionOffset = pWriter.Size();
+	pWriter.WriteBytes(&section, sizeof(section));
+
+	for (const Entity& entity : mEntities)
+	{
+		if (entity.componentMask.Contains(pComponentMask))
+		{
+			TransferComponent(pWriter, *Component(pPool, pComponentMask, entity.ID));
+			section.componentCount++;
+		}
+	}
+
+	//The size of the section is only known once every component has been written
+	section.byteCount = static_cast<unsigned int>(pWriter.Size() - sectionOffset - sizeof(section));
+	pWriter.Overwrite(sectionOffset, &section, sizeof(section));
+}
+
+/// <summary>
+/// Reads a section of components of type T and gives each one to the entity that owns it
+/// In sparse mode the section is copied into the pool in one go when T doesn't own memory, in archetype mode each component is constructed in its reserved row
+/// </summary>
+/// <param name="pReader">Reader over the section data</param>
+/// <param name="pPool">Pool that stores components of type T</param>
+/// <param name="pComponentMask">Component mask of type T</param>
+/// <param name="pCount">Number of components in the section</param>
+template <class T>
+void ECSManager::LoadComponents(SnapshotReader& pReader, ComponentPool<T>& pPool, const int pComponentMask, const int pCount)
+{
+	if (mStorageMode == StorageMode::ARCHETYPE)
+	{
+		for (const Entity& entity : mEntities)
+		{
+			if (entity.componentMask.Contains(pComponentMask))
+			{
+				const ArchetypeLocation& location = mArchetypeLocations[entity.ID.Index()];
+				T* const component = new (location.archetype->Component(location.row, pComponentMask)) T();
+				TransferComponent(pReader, *component);
+			}
+		}
+	}
+	else
+	{
+		pPool.components.resize(pCount);
+		ReadComponents(pReader, pPool.components.data(), pCount);
+
+		//Components were written in entity index order, so the nth owner owns the nth component
+		pPool.MapInOrder(mEntities, pComponentMask);
+	}
+}
+
+/// <summary>
+/// Checks the given snapshot can be loaded before the current world is replaced
+/// The entity table must fit within the max entities value and every component owned by an entity must have a section with a component for every owner
+/// Sections of components that own memory are only bounds checked as they are read
+/// </summary>
+/// <param name="pData">Snapshot data</param>
+/// <param name="pSize">Size of the snapshot data in bytes</param>
+/// <returns>Bool representing whether the snapshot is valid</returns>
+bool ECSManager::ValidateSnapshot(const unsigned char* const pData, const size_t pSize) const
+{
+	SnapshotReader reader(pData, pSize);
+
+	SnapshotHeader header;
+	if (!reader.ReadBytes(&header, sizeof(header))
+		|| memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0
+		|| header.version != SNAPSHOT_VERSION
+		|| header.nextEntityID < 0
+		|| header.nextEntityID > MAX_ENTITIES
+		|| header.entityCount > static_cast<unsigned int>(header.nextEntityID)
+		|| header.freeEntityCount > header.entityCount)
+	{
+		return false;
+	}
+
+	//Count the owners of each component so the sections can be checked against the entity table
+	std::vector<unsigned int> owners(ComponentMask::BITS, 0);
+	ComponentMask ownedMask;
+	for (unsigned int i = 0; i < header.entityCount; i++)
+	{
+		Entity entity;
+		if (!reader.ReadBytes(&entity, sizeof(entity)))
+		{
+			return false;
+		}
+
+		//Empty slots left by destroyed entities can't own components
+		if (entity.ID.IsNull())
+		{
+			if (!entity.componentMask.IsEmpty())
+			{
+				return false;
+			}
+			continue;
+		}
+		if (entity.ID.Index() != i)
+		{
+			return false;
+		}
+
+		ownedMask |= entity.componentMask;
+		entity.componentMask.ForEachBit([&](const int pBitIndex) { owners[pBitIndex]++; });
+	}
+
+	for (unsigned int i = 0; i < header.freeEntityCount; i++)
+	{
+		EntityHandle entityID;
+		if (!reader.ReadBytes(&entityID, sizeof(entityID)) || entityID.Index() >= header.entityCount)
+		{
+			return false;
+		}
+	}
+
+	//Enabled bits and pool indices, pools are matched by index when the snapshot is loaded
+	if (!reader.Skip(header.entityCount * sizeof(unsigned char)))
+	{
+		return false;
+	}
+	for (unsigned int i = 0; i < header.entityCount; i++)
+	{
+		int poolIndex;
+		if (!reader.ReadBytes(&poolIndex, sizeof(poolIndex)) || poolIndex < -1)
+		{
+			return false;
+		}
+	}
+
+	ComponentMask sectionMask;
+	for (unsigned int i = 0; i < header.sectionCount; i++)
+	{
+		SnapshotSection section;
+		if (!reader.ReadBytes(&section, sizeof(section)))
+		{
+			return false;
+		}
+
+		//Each section must hold a single component type that hasn't already been loaded
+		if (section.componentIndex < 0 || section.componentIndex >= ComponentMask::BITS
+			|| sectionMask.Intersects(ComponentMask::Bit(section.componentIndex)) || section.componentCount != owners[section.componentIndex])
+		{
+			return false;
+		}
+		const ComponentMask componentMask = ComponentMask::Bit(section.componentIndex);
+
+		//Built in components must match the size of their column and custom components must match a created pool
+		if (section.componentIndex < ComponentMask::CUSTOM_BIT)
+		{
+			const ComponentColumnType& columnType = mColumnTypes[section.componentIndex];
+			if (columnType.componentMask != componentMask.BuiltIn() || columnType.componentMask == ComponentType::COMPONENT_NONE || columnType.size != section.componentSize)
+			{
+				return false;
+			}
+		}
+		else
+		{
+			const auto customPool = std::find_if(mCustomComponentPools.begin(), mCustomComponentPools.end(),
+				[&](const std::unique_ptr<ICustomComponentPool>& pPool) { return pPool && pPool->componentMask == componentMask; });
+			if (customPool == mCustomComponentPools.end() || !(*customPool)->CanSnapshot() || (*customPool)->ComponentSize() != section.componentSize
+				|| static_cast<size_t>(section.byteCount) != static_cast<size_t>(section.componentCount) * section.componentSize)
+			{
+				return false;
+			}
+		}
+
+		if (!reader.Skip(section.byteCount))
+		{
+			return false;
+		}
+		sectionMask |= componentMask;
+	}
+
+	return ownedMask.Without(sectionMask).IsEmpty();
+}
+
 /// <summary>
-/// Assigns given entity to all appropriate systems upon addition of new component
+/// Removes every component and free slot from the built in and custom component pools
+/// Only called once every entity has been destroyed
 /// </summary>
-/// <param name="pEntity">The given entity to assign to systems</param>
-void ECSManager::AssignEntity(const Entity& pEntity)
+void ECSManager::ClearComponents()
 {
-	mRenderSystem->AssignEntity(pEntity);
-
-	for (auto& system : mUpdateSystems)
-	{
-		system->AssignEntity(pEntity);
+	const auto clear = [](auto& pPool)
+	{
+		pPool.Clear();
+	};
+
+	clear(mAIs);
+	clear(mAudios);
+	clear(mBoxColliders);
+	clear(mCameras);
+	clear(mCollisions);
+	clear(mColours);
+	clear(mGeometries);
+	clear(mGravities);
+	clear(mPointLights);
+	clear(mDirectionalLights);
+	clear(mRays);
+	clear(mShaders);
+	clear(mSphereColliders);
+	clear(mTextures);
+	clear(mTransforms);
+	clear(mVelocities);
+	clear(mParents);
+
+	for (auto& customPool : mCustomComponentPools)
+	{
+		if (customPool)
+		{
+			customPool->Clear();
+		}
 	}
 }
 
 /// <summary>
-/// Re-assigns given entity to all appropriate systems upon removal of component
+/// Reads the given section into the pool or archetype rows of its component type
 /// </summary>
-/// <param name="pEntity">Entity to re-assign</param>
-void ECSManager::ReAssignEntity(const Entity& pEntity)
+/// <param name="pReader">Reader over the section data</param>
+/// <param name="pSection">Header of the given section</param>
+void ECSManager::LoadSection(SnapshotReader& pReader, const SnapshotSection& pSection)
 {
-	mRenderSystem->ReAssignEntity(pEntity);
-
-	for (auto& system : mUpdateSystems)
-	{
-		system->ReAssignEntity(pEntity);
+	const int count = static_cast<int>(pSection.componentCount);
+	const ComponentMask componentMask = ComponentMask::Bit(pSection.componentIndex);
+	switch (componentMask.BuiltIn())
+	{
+	case ComponentType::COMPONENT_AI: LoadComponents(pReader, mAIs, ComponentType::COMPONENT_AI, count); break;
+	case ComponentType::COMPONENT_AUDIO: LoadComponents(pReader, mAudios, ComponentType::COMPONENT_AUDIO, count); break;
+	case ComponentType::COMPONENT_BOXCOLLIDER: LoadComponents(pReader, mBoxColliders, ComponentType::COMPONENT_BOXCOLLIDER, count); break;
+	case ComponentType::COMPONENT_CAMERA: LoadComponents(pReader, mCameras, ComponentType::COMPONENT_CAMERA, count); break;
+	case ComponentType::COMPONENT_COLLISION: LoadComponents(pReader, mCollisions, ComponentType::COMPONENT_COLLISION, count); break;
+	case ComponentType::COMPONENT_COLOUR: LoadComponents(pReader, mColours, ComponentType::COMPONENT_COLOUR, count); break;
+	case ComponentType::COMPONENT_GEOMETRY: LoadComponents(pReader, mGeometries, ComponentType::COMPONENT_GEOMETRY, count); break;
+	case ComponentType::COMPONENT_GRAVITY: LoadComponents(pReader, mGravities, ComponentType::COMPONENT_GRAVITY, count); break;
+	case ComponentType::COMPONENT_POINTLIGHT: LoadComponents(pReader, mPointLights, ComponentType::COMPONENT_POINTLIGHT, count); break;
+	case ComponentType::COMPONENT_DIRECTIONALLIGHT: LoadComponents(pReader, mDirectionalLights, ComponentType::COMPONENT_DIRECTIONALLIGHT, count); break;
+	case ComponentType::COMPONENT_RAY: LoadComponents(pReader, mRays, ComponentType::COMPONENT_RAY, count); break;
+	case ComponentType::COMPONENT_SHADER: LoadComponents(pReader, mShaders, ComponentType::COMPONENT_SHADER, count); break;
+	case ComponentType::COMPONENT_SPHERECOLLIDER: LoadComponents(pReader, mSphereColliders, ComponentType::COMPONENT_SPHERECOLLIDER, count); break;
+	case ComponentType::COMPONENT_TEXTURE: LoadComponents(pReader, mTextures, ComponentType::COMPONENT_TEXTURE, count); break;
+	case ComponentType::COMPONENT_TRANSFORM: LoadComponents(pReader, mTransforms, ComponentType::COMPONENT_TRANSFORM, count); break;
+	case ComponentType::COMPONENT_VELOCITY: LoadComponents(pReader, mVelocities, ComponentType::COMPONENT_VELOCITY, count); break;
+	case ComponentType::COMPONENT_PARENT: LoadComponents(pReader, mParents, ComponentType::COMPONENT_PARENT, count); break;
+	default:
+		for (auto& customPool : mCustomComponentPools)
+		{
+			if (customPool && customPool->componentMask == componentMask)
+			{
+				customPool->Load(pReader, mEntities, count);
+			}
+		}
+		break;
 	}
 }
 
 /// <summary>
 /// Constructor for ECS Manager
 /// Resizes entity and component vectors upon construction to max entities to avoid performance overhead of resizing
+/// Registers the column type of each built in component for archetype storage
 /// </summary>
 ECSManager::ECSManager()
-	:mEntityID(0), MAX_ENTITIES(65000)
+	:mEntityID(0), MAX_ENTITIES(65000), mStorageMode(StorageMode::SPARSE), mCommandBuffer(*this), mDeferNotifications(false),
+	mSignaturesByComponent(ComponentMask::BITS), mNotificationStamp(0), mComponentVersions(MaskIndex(ComponentType::CUSTOM_COMPONENT)), mVersion(1),
+	mFramesInFlight(2), mFramesExtracted(0), mRendering(false), mRenderingFrequency(0), mDefragmentBudget(0.25f), mDefragmentPool(0)
 {
 	mEntities.reserve(MAX_ENTITIES);
+	mEnabledEntities.reserve(MAX_ENTITIES);
+	mEntityPoolIndices.reserve(MAX_ENTITIES);
 
 	//Resize entity component map vectors
-	mAIEntityMap.resize(MAX_ENTITIES);
-	mAudioEntityMap.resize(MAX_ENTITIES);
-	mBoxColliderEntityMap.resize(MAX_ENTITIES);
-	mCameraEntityMap.resize(MAX_ENTITIES);
-	mCollisionEntityMap.resize(MAX_ENTITIES);
-	mColourEntityMap.resize(MAX_ENTITIES);
-	mGeometryEntityMap.resize(MAX_ENTITIES);
-	mGravityEntityMap.resize(MAX_ENTITIES);
-	mPointLightEntityMap.resize(MAX_ENTITIES);
-	mDirectionalLightEntityMap.resize(MAX_ENTITIES);
-	mRayEntityMap.resize(MAX_ENTITIES);
-	mShaderEntityMap.resize(MAX_ENTITIES);
-	mSphereColliderEntityMap.resize(MAX_ENTITIES);
-	mTextureEntityMap.resize(MAX_ENTITIES);
-	mTransformEntityMap.resize(MAX_ENTITIES);
-	mVelocityEntityMap.resize(MAX_ENTITIES);
-}
-
-/// <summary>
-/// Default destructor
+	ResizeEntityMaps();
+
+	//Column types indexed by the bit index of each component
+	mColumnTypes.resize(MaskIndex(ComponentType::CUSTOM_COMPONENT), ComponentColumnType{});
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_AI)] = ColumnType<AI>(ComponentType::COMPONENT_AI);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_AUDIO)] = ColumnType<Audio>(ComponentType::COMPONENT_AUDIO);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_BOXCOLLIDER)] = ColumnType<BoxCollider>(ComponentType::COMPONENT_BOXCOLLIDER);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_CAMERA)] = ColumnType<Camera>(ComponentType::COMPONENT_CAMERA);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_COLOUR)] = ColumnType<Colour>(ComponentType::COMPONENT_COLOUR);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_GEOMETRY)] = ColumnType<Geometry>(ComponentType::COMPONENT_GEOMETRY);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_GRAVITY)] = ColumnType<Gravity>(ComponentType::COMPONENT_GRAVITY);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_POINTLIGHT)] = ColumnType<PointLight>(ComponentType::COMPONENT_POINTLIGHT);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_DIRECTIONALLIGHT)] = ColumnType<DirectionalLight>(ComponentType::COMPONENT_DIRECTIONALLIGHT);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_RAY)] = ColumnType<Ray>(ComponentType::COMPONENT_RAY);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_SHADER)] = ColumnType<Shader>(ComponentType::COMPONENT_SHADER);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_SPHERECOLLIDER)] = ColumnType<SphereCollider>(ComponentType::COMPONENT_SPHERECOLLIDER);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_TEXTURE)] = ColumnType<Texture>(ComponentType::COMPONENT_TEXTURE);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_TRANSFORM)] = ColumnType<Transform>(ComponentType::COMPONENT_TRANSFORM);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_VELOCITY)] = ColumnType<Velocity>(ComponentType::COMPONENT_VELOCITY);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_COLLISION)] = ColumnType<Collision>(ComponentType::COMPONENT_COLLISION);
+	mColumnTypes[MaskIndex(ComponentType::COMPONENT_PARENT)] = ColumnType<Parent>(ComponentType::COMPONENT_PARENT);
+}
+
+/// <summary>
+/// Destructor
+/// Deletes all archetypes created by the archetype storage mode
 /// </summary>
 ECSManager::~ECSManager()
 {
+	for (auto& archetype : mArchetypes)
+	{
+		delete archetype;
+	}
 }
 
 /// <summary>
@@ -86,13 +962,91 @@ int ECSManager::RenderingFrequency() const
 	return mRenderingFrequency;
 }
 
+/// <summary>
+/// Sets how many frames can be in flight at once, counting the frame being simulated and every extracted frame the renderer hasn't finished
+/// One frame in flight simulates and renders each frame in turn, more frames let the simulation run ahead of the renderer at the cost of a frame of latency each
+/// Waits for the renderer to finish every extracted frame before the ring of frame contexts is resized
+/// </summary>
+/// <param name="pFramesInFlight">Given number of frames, clamped between one and three</param>
+void ECSManager::SetFramesInFlight(const int pFramesInFlight)
+{
+	FlushFrames();
+	mFramesInFlight = pFramesInFlight < 1 ? 1 : pFramesInFlight > MAX_FRAMES_IN_FLIGHT ? MAX_FRAMES_IN_FLIGHT : pFramesInFlight;
+}
+
+/// <summary>
+/// Get method for the number of frames that can be in flight at once
+/// </summary>
+/// <returns>Number of frames in flight</returns>
+int ECSManager::FramesInFlight() const
+{
+	return mFramesInFlight;
+}
+
+/// <summary>
+/// Blocks the calling thread until the renderer has finished every frame extracted so far
+/// </summary>
+void ECSManager::FlushFrames()
+{
+	mRenderFence.Wait(mFramesExtracted);
+}
+
+/// <summary>
+/// Get method for the scratch memory of the frame being simulated
+/// Allocations stay valid until the renderer has finished the frame, so they can be referenced from its render frame
+/// The allocator isn't thread safe, so systems that run at the same time must not share it
+/// </summary>
+/// <returns>Allocator of the current frame context</returns>
+FrameAllocator& ECSManager::CurrentFrameAllocator()
+{
+	return mFrameContexts[mFramesExtracted % mFramesInFlight].allocator;
+}
+
+/// <summary>
+/// Sets the storage mode used for built in components
+/// Sparse mode stores each component type in its own pool, archetype mode stores entities that share a component mask together in fixed size chunks
+/// Must be set before any entities are created
+/// </summary>
+/// <param name="pStorageMode">Given storage mode</param>
+void ECSManager::SetStorageMode(const StorageMode pStorageMode)
+{
+	if (mEntities.empty())
+	{
+		mStorageMode = pStorageMode;
+	}
+}
+
+/// <summary>
+/// Get method for the storage mode used for built in components
+/// </summary>
+/// <returns>Storage mode</returns>
+StorageMode ECSManager::Storage() const
+{
+	return mStorageMode;
+}
+
+/// <summary>
+/// Get method for the archetypes created by the archetype storage mode
+/// Systems can iterate the chunks of each matching archetype instead of looking up components per entity
+/// </summary>
+/// <returns>All archetypes in creation order</returns>
+const std::vector<Archetype*>& ECSManager::Archetypes() const
+{
+	return mArchetypes;
+}
+
 /// <summary>
 /// Sets the maximum entity count for the ECS
+/// Clamped to the number of indices that can be stored in an entity handle
 /// </summary>
 /// <param name="pEntityCount">Maximum entity count</param>
 void ECSManager::SetMaxEntities(const int pEntityCount)
 {
-	MAX_ENTITIES = pEntityCount;
+	MAX_ENTITIES = pEntityCount < static_cast<int>(EntityHandle::INDEX_MASK) ? pEntityCount : static_cast<int>(EntityHandle::INDEX_MASK);
+	mEntities.reserve(MAX_ENTITIES);
+	mEnabledEntities.reserve(MAX_ENTITIES);
+	mEntityPoolIndices.reserve(MAX_ENTITIES);
+	ResizeEntityMaps();
 }
 
 /// <summary>
@@ -105,215 +1059,734 @@ int ECSManager::MaxEntities() const
 }
 
 /// <summary>
-/// Creates an entity with the given name
+/// Creates a new entity, reusing the index of a destroyed entity if one is available
 /// </summary>
-int ECSManager::CreateEntity()
+/// <returns>Handle of the new entity, null if max entities are already alive</returns>
+EntityHandle ECSManager::CreateEntity()
 {
-	unsigned short entityID = 0;
-	if (!mFreeEntityIDs.empty())
+	const EntityHandle entityID = ReserveEntity();
+	PlaceEntity(entityID);
+	return entityID;
+}
+
+/// <summary>
+/// Creates the given number of entities that each own a copy of every component in the given prefab
+/// Handles are reserved under a single lock, components are written straight into their final pool or archetype and systems are notified once for the whole batch
+/// The initialise function is called for each entity before systems are notified so per entity values, such as transforms, can be set first
+/// </summary>
+/// <param name="pPrefab">Prefab to instantiate</param>
+/// <param name="pCount">Number of entities to create</param>
+/// <param name="pInitialise">Function called with the handle and batch index of each new entity, can be empty</param>
+/// <returns>Handles of the new entities, fewer than the given count if max entities would be exceeded</returns>
+std::vector<EntityHandle> ECSManager::Instantiate(const Prefab& pPrefab, const int pCount, const std::function<void(const EntityHandle, const int)>& pInitialise)
+{
+	std::vector<EntityHandle> entities;
+	entities.reserve(pCount);
+
+	//Reserve every handle under a single lock, reusing the indices of destroyed entities first
 	{
-		entityID = mFreeEntityIDs.back();
-		mFreeEntityIDs.pop_back();
-		mEntities[entityID] = Entity{ entityID, ComponentType::COMPONENT_NONE };
+		std::lock_guard<std::mutex> lock(mEntityIDMutex);
+		while (static_cast<int>(entities.size()) < pCount && !mFreeEntityIDs.empty())
+		{
+			entities.push_back(mFreeEntityIDs.back());
+			mFreeEntityIDs.pop_back();
+		}
+		while (static_cast<int>(entities.size()) < pCount && mEntityID < MAX_ENTITIES)
+		{
+			entities.push_back(EntityHandle(mEntityID++, 0));
+		}
+	}
+
+	const int componentMask = pPrefab.ComponentMask();
+	for (const EntityHandle entityID : entities)
+	{
+		PlaceEntity(entityID);
+		mEntities[entityID.Index()].componentMask = componentMask;
+	}
+
+	if (mStorageMode == StorageMode::ARCHETYPE)
+	{
+		//Every instance shares the same archetype, so it is only looked up once
+		Archetype* const archetype = FindArchetype(componentMask);
+		if (archetype)
+		{
+			for (const EntityHandle entityID : entities)
+			{
+				const int row = archetype->AddEntity(entityID.Index());
+				for (const auto& columnType : archetype->ColumnTypes())
+				{
+					columnType->copyConstruct(archetype->Component(row, columnType->componentMask), pPrefab.Component(columnType->componentMask));
+				}
+				mArchetypeLocations[entityID.Index()] = ArchetypeLocation{ archetype, row };
+			}
+		}
 	}
 	else
 	{
-		mEntities.emplace_back(Entity{ mEntityID, ComponentType::COMPONENT_NONE });
-		entityID = mEntityID;
-		mEntityID++;
+		InstantiateComponents(mAIs, ComponentType::COMPONENT_AI, pPrefab, entities);
+		InstantiateComponents(mAudios, ComponentType::COMPONENT_AUDIO, pPrefab, entities);
+		InstantiateComponents(mBoxColliders, ComponentType::COMPONENT_BOXCOLLIDER, pPrefab, entities);
+		InstantiateComponents(mCameras, ComponentType::COMPONENT_CAMERA, pPrefab, entities);
+		InstantiateComponents(mCollisions, ComponentType::COMPONENT_COLLISION, pPrefab, entities);
+		InstantiateComponents(mColours, ComponentType::COMPONENT_COLOUR, pPrefab, entities);
+		InstantiateComponents(mGeometries, ComponentType::COMPONENT_GEOMETRY, pPrefab, entities);
+		InstantiateComponents(mGravities, ComponentType::COMPONENT_GRAVITY, pPrefab, entities);
+		InstantiateComponents(mPointLights, ComponentType::COMPONENT_POINTLIGHT, pPrefab, entities);
+		InstantiateComponents(mDirectionalLights, ComponentType::COMPONENT_DIRECTIONALLIGHT, pPrefab, entities);
+		InstantiateComponents(mRays, ComponentType::COMPONENT_RAY, pPrefab, entities);
+		InstantiateComponents(mShaders, ComponentType::COMPONENT_SHADER, pPrefab, entities);
+		InstantiateComponents(mSphereColliders, ComponentType::COMPONENT_SPHERECOLLIDER, pPrefab, entities);
+		InstantiateComponents(mTextures, ComponentType::COMPONENT_TEXTURE, pPrefab, entities);
+		InstantiateComponents(mTransforms, ComponentType::COMPONENT_TRANSFORM, pPrefab, entities);
+		InstantiateComponents(mVelocities, ComponentType::COMPONENT_VELOCITY, pPrefab, entities);
+		InstantiateComponents(mParents, ComponentType::COMPONENT_PARENT, pPrefab, entities);
 	}
-	return entityID;
+
+	for (const EntityHandle entityID : entities)
+	{
+		StampVersions(entityID.Index(), componentMask);
+	}
+
+	const int count = static_cast<int>(entities.size());
+	if (pInitialise)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			pInitialise(entities[i], i);
+		}
+	}
+
+	NotifySystems(entities.data(), count, ComponentType::COMPONENT_NONE, componentMask);
+	return entities;
 }
 
 /// <summary>
-/// Destroys an entity with the given name and all components owned by it
+/// Destroys the given entity and all components owned by it
+/// Destroying a stale handle has no effect
 /// </summary>
 /// <param name="pEntityID">Given id of the entity to delete</param>
-void ECSManager::DestroyEntity(const int pEntityID)
+void ECSManager::DestroyEntity(const EntityHandle pEntityID)
 {
 	//Find entity with matching ID
-	Entity* entity = &mEntities[pEntityID];
+	Entity* const entity = LiveEntity(pEntityID);
+	if (!entity)
+	{
+		return;
+	}
+	const int index = pEntityID.Index();
+
+	//Releases all built in components owned by this entity
+	if (mStorageMode == StorageMode::ARCHETYPE)
+	{
+		//Removes entity from its archetype in a single move
+		MoveToArchetype(index, ComponentType::COMPONENT_NONE, nullptr, ComponentType::COMPONENT_NONE);
+	}
+	else
+	{
+		ReleaseComponent(mAIs, ComponentType::COMPONENT_AI, pEntityID);
+		ReleaseComponent(mAudios, ComponentType::COMPONENT_AUDIO, pEntityID);
+		ReleaseComponent(mBoxColliders, ComponentType::COMPONENT_BOXCOLLIDER, pEntityID);
+		ReleaseComponent(mCameras, ComponentType::COMPONENT_CAMERA, pEntityID);
+		ReleaseComponent(mCollisions, ComponentType::COMPONENT_COLLISION, pEntityID);
+		ReleaseComponent(mColours, ComponentType::COMPONENT_COLOUR, pEntityID);
+		ReleaseComponent(mGeometries, ComponentType::COMPONENT_GEOMETRY, pEntityID);
+		ReleaseComponent(mGravities, ComponentType::COMPONENT_GRAVITY, pEntityID);
+		ReleaseComponent(mPointLights, ComponentType::COMPONENT_POINTLIGHT, pEntityID);
+		ReleaseComponent(mDirectionalLights, ComponentType::COMPONENT_DIRECTIONALLIGHT, pEntityID);
+		ReleaseComponent(mRays, ComponentType::COMPONENT_RAY, pEntityID);
+		ReleaseComponent(mShaders, ComponentType::COMPONENT_SHADER, pEntityID);
+		ReleaseComponent(mSphereColliders, ComponentType::COMPONENT_SPHERECOLLIDER, pEntityID);
+		ReleaseComponent(mTextures, ComponentType::COMPONENT_TEXTURE, pEntityID);
+		ReleaseComponent(mTransforms, ComponentType::COMPONENT_TRANSFORM, pEntityID);
+		ReleaseComponent(mVelocities, ComponentType::COMPONENT_VELOCITY, pEntityID);
+		ReleaseComponent(mParents, ComponentType::COMPONENT_PARENT, pEntityID);
+	}
+
+	//Releases all custom components owned by this entity
+	for (const auto& customPool : mCustomComponentPools)
+	{
+		if (customPool && entity->componentMask.Contains(customPool->componentMask))
+		{
+			customPool->Release(index);
+		}
+	}
 
-	//Removes all components owned by this entity
-	//AI Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_AI) == ComponentType::COMPONENT_AI)
+	//Destroyed pooled entities leave their pool, a stale handle left in the inactive list is skipped when it is next acquired
+	if (mEntityPoolIndices[index] != -1)
 	{
-		RemoveAIComp(pEntityID);
+		mEntityPools[mEntityPoolIndices[index]].size--;
+		mEntityPoolIndices[index] = -1;
 	}
-	//Audio Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_AUDIO) == ComponentType::COMPONENT_AUDIO)
+
+	//Clear mask and notify systems once for all components
+	const ComponentMask oldMask = entity->componentMask;
+	entity->componentMask = ComponentType::COMPONENT_NONE;
+	NotifySystems(pEntityID, oldMask, ComponentType::COMPONENT_NONE);
+
+	//Invalidates the entity and frees its index for reuse with the next generation
+	mEntities[index] = Entity{ EntityHandle(), ComponentType::COMPONENT_NONE };
+	std::lock_guard<std::mutex> lock(mEntityIDMutex);
+	mFreeEntityIDs.push_back(EntityHandle(index, pEntityID.Generation() + 1));
+}
+
+/// <summary>
+/// Destroys every live entity
+/// </summary>
+void ECSManager::DestroyEntities()
+{
+	for (int i = 0; i < mEntities.size(); i++)
 	{
-		RemoveAudioComp(pEntityID);
+		if (!mEntities[i].ID.IsNull())
+		{
+			DestroyEntity(mEntities[i].ID);
+		}
 	}
-	//BoxCollider Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_BOXCOLLIDER) == ComponentType::COMPONENT_BOXCOLLIDER)
+}
+
+/// <summary>
+/// Checks if the given handle still refers to a live entity
+/// </summary>
+/// <param name="pEntityID">Given handle of the entity</param>
+/// <returns>Bool representing whether the entity is alive</returns>
+bool ECSManager::IsAlive(const EntityHandle pEntityID) const
+{
+	return pEntityID.Index() < mEntities.size() && mEntities[pEntityID.Index()].ID == pEntityID;
+}
+
+/// <summary>
+/// Returns the handle of the live entity stored at the given index
+/// Used where only the index of an entity is known, such as entity IDs sent over the network
+/// </summary>
+/// <param name="pEntityIndex">Given index of the entity</param>
+/// <returns>Handle of the entity, null handle if no live entity is stored at the index</returns>
+EntityHandle ECSManager::Handle(const int pEntityIndex) const
+{
+	if (pEntityIndex >= 0 && pEntityIndex < static_cast<int>(mEntities.size()))
 	{
-		RemoveBoxColliderComp(pEntityID);
+		return mEntities[pEntityIndex].ID;
 	}
-	//Camera Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_CAMERA) == ComponentType::COMPONENT_CAMERA)
+	return EntityHandle();
+}
+
+/// <summary>
+/// Get method for the command buffer
+/// Structural changes recorded in the buffer are applied once all update systems have been processed
+/// </summary>
+/// <returns>Modifiable handle to the command buffer</returns>
+EntityCommandBuffer& ECSManager::CommandBuffer()
+{
+	return activeCommandBuffer ? *activeCommandBuffer : mCommandBuffer;
+}
+
+/// <summary>
+/// Enables or disables the given entity without changing its components or the systems it belongs to
+/// Disabled entities are skipped by views and by systems that iterate their own entity lists, so toggling an entity costs a single write
+/// Enabling an entity records a change to each of its built in components, so change filtered systems catch up with anything written while it was disabled
+/// Must not be called while systems that read the enabled bit are running on other threads
+/// </summary>
+/// <param name="pEntityID">ID of the given entity</param>
+/// <param name="pEnabled">Bool representing whether the entity should be enabled</param>
+void ECSManager::SetEnabled(const EntityHandle pEntityID, const bool pEnabled)
+{
+	const Entity* const entity = LiveEntity(pEntityID);
+	if (!entity || mEnabledEntities[pEntityID.Index()] == static_cast<unsigned char>(pEnabled))
 	{
-		RemoveCameraComp(pEntityID);
+		return;
 	}
-	//Collision Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_COLLISION) == ComponentType::COMPONENT_COLLISION)
+
+	mEnabledEntities[pEntityID.Index()] = pEnabled;
+	if (pEnabled)
 	{
-		RemoveCollisionComp(pEntityID);
+		StampVersions(pEntityID.Index(), entity->componentMask.BuiltIn());
 	}
-	//Colour Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_COLOUR) == ComponentType::COMPONENT_COLOUR)
+}
+
+/// <summary>
+/// Checks if the given entity is alive and enabled
+/// </summary>
+/// <param name="pEntityID">ID of the given entity</param>
+/// <returns>Bool representing whether the entity is enabled, false for stale handles</returns>
+bool ECSManager::IsEnabled(const EntityHandle pEntityID) const
+{
+	return IsAlive(pEntityID) && mEnabledEntities[pEntityID.Index()];
+}
+
+/// <summary>
+/// Creates a pool of disabled entities that each own a copy of every component in the given prefab
+/// Pooled entities are enabled by AcquireEntity and disabled by ReleaseEntity instead of being created and destroyed, so short lived entities such as projectiles cause no structural changes
+/// </summary>
+/// <param name="pPrefab">Prefab the pooled entities are instantiated from</param>
+/// <param name="pCapacity">Number of entities to instantiate up front, the pool doubles in size whenever it runs out</param>
+/// <returns>Index of the new pool</returns>
+int ECSManager::CreateEntityPool(const Prefab& pPrefab, const int pCapacity)
+{
+	const int poolIndex = static_cast<int>(mEntityPools.size());
+	mEntityPools.push_back(EntityPool{ pPrefab, std::vector<EntityHandle>(), 0 });
+	if (pCapacity > 0)
 	{
-		RemoveColourComp(pEntityID);
+		GrowEntityPool(poolIndex, pCapacity);
 	}
-	//Geometry Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_GEOMETRY) == ComponentType::COMPONENT_GEOMETRY)
+	return poolIndex;
+}
+
+/// <summary>
+/// Enables an inactive entity from the pool with the given index, growing the pool if every entity is in use
+/// The entity keeps the component values it had when it was released, so callers set the values that differ between uses
+/// </summary>
+/// <param name="pPoolIndex">Index of the given pool</param>
+/// <returns>Handle of the enabled entity, null handle if the pool doesn't exist or can't grow past max entities</returns>
+EntityHandle ECSManager::AcquireEntity(const int pPoolIndex)
+{
+	if (pPoolIndex < 0 || pPoolIndex >= static_cast<int>(mEntityPools.size()))
 	{
-		RemoveGeometryComp(pEntityID);
+		return EntityHandle();
 	}
-	//Gravity Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_GRAVITY) == ComponentType::COMPONENT_GRAVITY)
+
+	EntityPool& pool = mEntityPools[pPoolIndex];
+	for (;;)
 	{
-		RemoveGravityComp(pEntityID);
+		if (pool.inactive.empty())
+		{
+			GrowEntityPool(pPoolIndex, pool.size > 0 ? pool.size : 1);
+			if (pool.inactive.empty())
+			{
+				return EntityHandle();
+			}
+		}
+
+		//Pooled entities can still be destroyed, their stale handles are dropped from the pool here
+		const EntityHandle entityID = pool.inactive.back();
+		pool.inactive.pop_back();
+		if (IsAlive(entityID))
+		{
+			SetEnabled(entityID, true);
+			return entityID;
+		}
 	}
-	//Point Light Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_POINTLIGHT) == ComponentType::COMPONENT_POINTLIGHT)
+}
+
+/// <summary>
+/// Disables the given pooled entity and returns it to its pool
+/// </summary>
+/// <param name="pEntityID">ID of the given entity</param>
+/// <returns>Bool representing whether the entity was released, false if it isn't pooled or has already been released</returns>
+bool ECSManager::ReleaseEntity(const EntityHandle pEntityID)
+{
+	if (!IsEnabled(pEntityID) || mEntityPoolIndices[pEntityID.Index()] == -1)
 	{
-		RemovePointLightComp(pEntityID);
+		return false;
 	}
-	//Directional Light Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_DIRECTIONALLIGHT) == ComponentType::COMPONENT_DIRECTIONALLIGHT)
+
+	SetEnabled(pEntityID, false);
+	mEntityPools[mEntityPoolIndices[pEntityID.Index()]].inactive.push_back(pEntityID);
+	return true;
+}
+
+/// <summary>
+/// Adds the given system to the update system vector and registers its masks for notification
+/// </summary>
+/// <param name="pSystem">Pointer to the given system</param>
+void ECSManager::AddUpdateSystem(shared_ptr<ISystem> pSystem)
+{
+	mUpdateSystems.push_back(pSystem);
+	mSystemCommandBuffers.push_back(std::make_unique<EntityCommandBuffer>(*this));
+	RegisterSignatures(pSystem.get());
+	ScheduleSystem(static_cast<int>(mUpdateSystems.size()) - 1);
+}
+
+/// <summary>
+/// Places the given update system in the first wave after every earlier system it conflicts with
+/// Two systems conflict if either writes a component the other reads or writes, so conflicting systems always run in the order they were added
+/// </summary>
+/// <param name="pSystemIndex">Index of the given system in the update systems</param>
+void ECSManager::ScheduleSystem(const int pSystemIndex)
+{
+	const ISystem& system = *mUpdateSystems[pSystemIndex];
+	const ComponentMask accessMask = system.ReadMask() | system.WriteMask();
+
+	int wave = 0;
+	for (int i = 0; i < static_cast<int>(mSystemWaves.size()); i++)
 	{
-		RemoveDirectionalLightComp(pEntityID);
+		for (const int other : mSystemWaves[i])
+		{
+			const ISystem& otherSystem = *mUpdateSystems[other];
+			if (system.WriteMask().Intersects(otherSystem.ReadMask() | otherSystem.WriteMask()) || otherSystem.WriteMask().Intersects(accessMask))
+			{
+				wave = i + 1;
+				break;
+			}
+		}
 	}
-	//Ray Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_RAY) == ComponentType::COMPONENT_RAY)
+
+	if (wave == static_cast<int>(mSystemWaves.size()))
 	{
-		RemoveRayComp(pEntityID);
+		mSystemWaves.emplace_back();
 	}
-	//Shader Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_SHADER) == ComponentType::COMPONENT_SHADER)
+	mSystemWaves[wave].push_back(pSystemIndex);
+}
+
+/// <summary>
+/// Runs the process method of the given update system, recording its structural changes into the systems own command buffer
+/// </summary>
+/// <param name="pSystemIndex">Index of the given system in the update systems</param>
+void ECSManager::RunSystem(const int pSystemIndex)
+{
+	activeCommandBuffer = mSystemCommandBuffers[pSystemIndex].get();
+	mUpdateSystems[pSystemIndex]->Process();
+	activeCommandBuffer = nullptr;
+}
+
+/// <summary>
+/// Adds the given system to the render system vector and registers its masks for notification
+/// </summary>
+/// <param name="pSystem">Pointer to the given system</param>
+void ECSManager::AddRenderSystem(shared_ptr<ISystem> pSystem)
+{
+	if (!mRenderSystem)
 	{
-		RemoveShaderComp(pEntityID);
+		mRenderSystem = pSystem;
+		RegisterSignatures(pSystem.get());
 	}
-	//SphereCollider Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_SPHERECOLLIDER) == ComponentType::COMPONENT_SPHERECOLLIDER)
+}
+
+/// <summary>
+/// Steps the update systems the given number of times, then extracts the frame for the render thread to draw while the next frame is simulated
+/// Component pools are defragmented within the defragment budget once the steps have run
+/// </summary>
+/// <param name="pSteps">Number of simulation steps to run, zero only renders the frame</param>
+void ECSManager::ProcessSystems(const int pSteps)
+{
+	BeginFrame();
+	mFrameContexts[mFramesExtracted % mFramesInFlight].steps = pSteps;
+
+	for (int step = 0; step < pSteps; step++)
 	{
-		RemoveSphereColliderComp(pEntityID);
+		//The renderer blends from the state before the last step, so frames that catch up over several steps are still interpolated
+		if (step == pSteps - 1 && mRenderSystem)
+		{
+			mRenderSystem->BeforeFinalStep();
+		}
+		StepSystems();
 	}
-	//Texture Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_TEXTURE) == ComponentType::COMPONENT_TEXTURE)
+
+	//Compact component pools while no systems are running, the render thread only reads its extracted frame
+	Defragment(mDefragmentBudget);
+
+	//Nothing to render until a render system has been added
+	if (!mRenderSystem)
 	{
-		RemoveTextureComp(pEntityID);
+		return;
 	}
-	//Transform Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_TRANSFORM) == ComponentType::COMPONENT_TRANSFORM)
+
+	SubmitFrame();
+}
+
+/// <summary>
+/// Calls the process method for all update systems, then applies the structural changes they recorded
+/// Update systems run in waves, the systems of a wave don't conflict so all but the first are handed to the worker threads while the first runs on this thread
+/// Every wave is joined before the next starts, so results don't depend on how the systems of a wave were scheduled
+/// </summary>
+void ECSManager::StepSystems()
+{
+	//Run update systems, each wave at its own version so a system sees the changes made by every system after it
+	for (const auto& wave : mSystemWaves)
 	{
-		RemoveTransformComp(pEntityID);
+		mVersion++;
+
+		for (int i = 1; i < static_cast<int>(wave.size()); i++)
+		{
+			mWaveJobs.push_back(mThreadManager->AddJob(std::bind(&ECSManager::RunSystem, this, wave[i]), nullptr, nullptr));
+		}
+
+		RunSystem(wave.front());
+
+		//Wait for the rest of the wave, helping with its jobs if the workers haven't got to them
+		for (const JobHandle& job : mWaveJobs)
+		{
+			mThreadManager->Wait(job);
+		}
+		mWaveJobs.clear();
 	}
-	//Velocity Comp
-	if ((entity->componentMask & ComponentType::COMPONENT_VELOCITY) == ComponentType::COMPONENT_VELOCITY)
+
+	//Changes made by the command buffer and outside of systems are recorded at a version newer than every system
+	mVersion++;
+
+	//Apply structural changes recorded by the update systems
+	PlaybackCommands();
+}
+
+/// <summary>
+/// Sets the time spent defragmenting component pools at the end of every ProcessSystems call
+/// </summary>
+/// <param name="pMilliseconds">Time budget in milliseconds, zero disables defragmentation</param>
+void ECSManager::SetDefragmentBudget(const float pMilliseconds)
+{
+	mDefragmentBudget = pMilliseconds;
+}
+
+/// <summary>
+/// Moves components in the sparse pools into dense ranges ordered by entity index until every pool is compact or the time budget runs out
+/// Each pool is worked through in batches of entities and the pass picks up where it stopped on the next call, so fragmentation from component churn is removed a little each frame
+/// Archetype chunks are kept dense as entities are removed, so only custom component pools need defragmenting in archetype mode
+/// Pointers to components are invalidated, and no systems may be running while pools are defragmented
+/// </summary>
+/// <param name="pMilliseconds">Time budget in milliseconds</param>
+void ECSManager::Defragment(const float pMilliseconds)
+{
+	if (pMilliseconds <= 0)
 	{
-		RemoveVelocityComp(pEntityID);
+		return;
 	}
 
-	//Remove custom components
-	for (int i = 0; i < mCustomComponentTypes.size(); i++)
+	const auto deadline = std::chrono::high_resolution_clock::now() + std::chrono::nanoseconds(static_cast<long long>(pMilliseconds * 1000000));
+	const int poolCount = ComponentMask::CUSTOM_BIT + static_cast<int>(mCustomComponentPools.size());
+
+	//Visit every pool at most once, starting with the pool the last call stopped on
+	for (int i = 0; i < poolCount; i++)
 	{
-		//If entity contains a component of this type
-		if ((entity->componentMask & mCustomComponentMasks[i]) == mCustomComponentMasks[i])
+		const int poolIndex = (mDefragmentPool + i) % poolCount;
+		while (DefragmentPool(poolIndex, DEFRAGMENT_BATCH))
 		{
-			//Retrieve vector that contains this component type and vector that contains this componenet types entity component map
-			std::vector<unsigned short>* componentEntityMapVector = mCustomComponentEntityMaps[i];
-			std::vector<ComponentType*>* componentVector = static_cast<std::vector<ComponentType*>*>(mCustomComponentVectors[i]);
+			if (std::chrono::high_resolution_clock::now() >= deadline)
+			{
+				mDefragmentPool = poolIndex;
+				return;
+			}
+		}
+	}
+}
+
+/// <summary>
+/// Waits for the frame context the current frame will be extracted into, then resets its allocator
+/// A context is only reused once the renderer has finished the frame that last used it, so the simulation never runs more than the frames in flight ahead of the renderer
+/// </summary>
+void ECSManager::BeginFrame()
+{
+	const unsigned long long frame = mFramesExtracted;
+	if (frame >= static_cast<unsigned long long>(mFramesInFlight))
+	{
+		mRenderFence.Wait(frame - mFramesInFlight + 1);
+	}
 
-			//Replace removed component with back element
-			(*componentVector)[(*componentEntityMapVector)[pEntityID]] = componentVector->back();
+	FrameContext& context = mFrameContexts[frame % mFramesInFlight];
+	context.allocator.Reset();
+	context.frameIndex = frame;
+}
 
-			//Set new index of component in the entity component map		
-			(*componentEntityMapVector)[componentVector->size() - 1] = (*componentEntityMapVector)[pEntityID];
+/// <summary>
+/// Copies everything the render system draws into the current frame context and hands the frame to the render thread, starting the render task if it isn't already running
+/// The render thread only reads extracted frames, so update systems can write components while it draws without any locking
+/// </summary>
+void ECSManager::SubmitFrame()
+{
+	mRenderSystem->Extract(mFrameContexts[mFramesExtracted % mFramesInFlight]);
 
-			//Pop back element
-			componentVector->pop_back();
+	//Changes made after extraction are recorded at a newer version than the render system has seen
+	mVersion++;
 
-			//Adjust entities mask to no longer contain mask of removed component
-			entity->componentMask = entity->componentMask &= ~mCustomComponentMasks[i]; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-			ReAssignEntity(*entity);
+	{
+		std::lock_guard<std::mutex> lock(mRenderMutex);
+		mFramesExtracted++;
+		if (mRendering)
+		{
+			return;
 		}
+		mRendering = true;
 	}
 
-	//Finds the entity with the matching ID and removes it from the entities vector
-	mEntities[pEntityID] = Entity{};
-	mFreeEntityIDs.push_back(pEntityID);
+	//Replacing the handle releases the previous render task, which has finished drawing
+	mRenderTask = mThreadManager->AddTask(std::bind(&ECSManager::RenderFrames, this), nullptr, nullptr, CoreMask{ 0 });
 }
 
-void ECSManager::DestroyEntities()
+/// <summary>
+/// Runs on the render thread, drawing every extracted frame in order and signalling the render fence as each one finishes
+/// Returns once it has caught up with the main thread, the next extracted frame starts a new render task
+/// </summary>
+void ECSManager::RenderFrames()
 {
-	for (int i = 0; i < mEntities.size(); i++)
+	while (true)
 	{
-		DestroyEntity(mEntities[i].ID);
+		const unsigned long long frame = mRenderFence.Value();
+		{
+			std::lock_guard<std::mutex> lock(mRenderMutex);
+			if (frame == mFramesExtracted)
+			{
+				mRendering = false;
+				return;
+			}
+		}
+
+		const auto renderStart = std::chrono::high_resolution_clock::now();
+		mRenderSystem->ProcessFrame(mFrameContexts[frame % mFramesInFlight]);
+		const std::chrono::nanoseconds renderTime = std::chrono::high_resolution_clock::now() - renderStart;
+
+		//Convert timings to milliseconds for frequency calculations
+		const float renderTimeMilliseconds = static_cast<float>(renderTime.count() / pow(10, 6));
+
+		//Calculate the actual rendering frequency
+		mRenderingFrequency = static_cast<int>(1000 / renderTimeMilliseconds);
+
+		mRenderFence.Signal(frame + 1);
 	}
 }
 
 /// <summary>
-/// Adds the given system to the update system vector
+/// Get method for the current change version
+/// Systems store this after processing and pass it to a views change filter on their next run to only visit components changed since
 /// </summary>
-/// <param name="pSystem">Pointer to the given system</param>
-void ECSManager::AddUpdateSystem(shared_ptr<ISystem> pSystem)
+/// <returns>Current change version</returns>
+unsigned int ECSManager::Version() const
 {
-	mUpdateSystems.push_back(pSystem);
+	return mVersion;
 }
 
 /// <summary>
-/// Adds the given system to the render system vector
+/// Writes every entity, the free entity IDs, the enabled bit and pool index of each entity and every built in and custom component to the given file
+/// Components that don't own memory are written byte for byte, so a snapshot can only be loaded by a build with the same component layouts
 /// </summary>
-/// <param name="pSystem">Pointer to the given system</param>
-void ECSManager::AddRenderSystem(shared_ptr<ISystem> pSystem)
+/// <param name="pFilename">File name of the snapshot</param>
+/// <returns>Bool representing whether the snapshot was written, fails if a custom component type isn't trivially copyable</returns>
+bool ECSManager::SaveSnapshot(const std::wstring& pFilename)
 {
-	if (!mRenderSystem)
+	//Custom components are written byte for byte as their layout isn't known
+	int customSections = 0;
+	for (const auto& customPool : mCustomComponentPools)
 	{
-		mRenderSystem = pSystem;
+		if (customPool)
+		{
+			if (!customPool->CanSnapshot())
+			{
+				return false;
+			}
+			customSections++;
+		}
+	}
+
+	SnapshotHeader header;
+	memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	header.version = SNAPSHOT_VERSION;
+	header.entityCount = static_cast<unsigned int>(mEntities.size());
+	header.freeEntityCount = static_cast<unsigned int>(mFreeEntityIDs.size());
+	header.sectionCount = static_cast<unsigned int>(MaskIndex(ComponentType::CUSTOM_COMPONENT) - MaskIndex(ComponentType::COMPONENT_AI) + customSections);
+	header.nextEntityID = mEntityID;
+
+	SnapshotWriter writer;
+	writer.WriteBytes(&header, sizeof(header));
+	writer.WriteBytes(mEntities.data(), mEntities.size() * sizeof(Entity));
+	writer.WriteBytes(mFreeEntityIDs.data(), mFreeEntityIDs.size() * sizeof(EntityHandle));
+	writer.WriteBytes(mEnabledEntities.data(), mEntities.size() * sizeof(unsigned char));
+	writer.WriteBytes(mEntityPoolIndices.data(), mEntities.size() * sizeof(int));
+
+	SaveComponents(writer, mAIs, ComponentType::COMPONENT_AI);
+	SaveComponents(writer, mAudios, ComponentType::COMPONENT_AUDIO);
+	SaveComponents(writer, mBoxColliders, ComponentType::COMPONENT_BOXCOLLIDER);
+	SaveComponents(writer, mCameras, ComponentType::COMPONENT_CAMERA);
+	SaveComponents(writer, mCollisions, ComponentType::COMPONENT_COLLISION);
+	SaveComponents(writer, mColours, ComponentType::COMPONENT_COLOUR);
+	SaveComponents(writer, mGeometries, ComponentType::COMPONENT_GEOMETRY);
+	SaveComponents(writer, mGravities, ComponentType::COMPONENT_GRAVITY);
+	SaveComponents(writer, mPointLights, ComponentType::COMPONENT_POINTLIGHT);
+	SaveComponents(writer, mDirectionalLights, ComponentType::COMPONENT_DIRECTIONALLIGHT);
+	SaveComponents(writer, mRays, ComponentType::COMPONENT_RAY);
+	SaveComponents(writer, mShaders, ComponentType::COMPONENT_SHADER);
+	SaveComponents(writer, mSphereColliders, ComponentType::COMPONENT_SPHERECOLLIDER);
+	SaveComponents(writer, mTextures, ComponentType::COMPONENT_TEXTURE);
+	SaveComponents(writer, mTransforms, ComponentType::COMPONENT_TRANSFORM);
+	SaveComponents(writer, mVelocities, ComponentType::COMPONENT_VELOCITY);
+	SaveComponents(writer, mParents, ComponentType::COMPONENT_PARENT);
+
+	for (const auto& customPool : mCustomComponentPools)
+	{
+		if (customPool)
+		{
+			customPool->Save(writer, mEntities);
+		}
 	}
+
+	return MappedFile::Write(pFilename, writer.Data(), writer.Size());
 }
 
 /// <summary>
-/// Calls the process method for all systems in the ECS
+/// Replaces every entity with the contents of the given snapshot
+/// The file is memory mapped and validated before the current entities are destroyed, then the entity table and component sections are copied straight into place
+/// Systems are notified once for each run of loaded entities that share a component mask
+/// Custom component types in the snapshot must have been created first, and no systems may be running while the snapshot is loaded
+/// Entity pools are matched by index, so pools created in the same order before loading are refilled with their loaded entities
 /// </summary>
-void ECSManager::ProcessSystems()
+/// <param name="pFilename">File name of the snapshot</param>
+/// <returns>Bool representing whether the snapshot was loaded, the current entities are kept if the file is missing or invalid</returns>
+bool ECSManager::LoadSnapshot(const std::wstring& pFilename)
 {
-	//Run update systems
-	for (auto& system : mUpdateSystems)
+	MappedFile file;
+	if (!file.Open(pFilename) || !ValidateSnapshot(file.Data(), file.Size()))
 	{
-		system->Process();
+		return false;
 	}
 
-	//If render task has already been assigned
-	if (mRenderTask)
-	{
-		//Check if render task has been completed
-		if (mRenderTask->IsDone())
-		{
-			//Calculate time taken
-			mRenderFinish = std::chrono::high_resolution_clock::now();
-			mRenderTime = mRenderFinish - mRenderStart;
+	DestroyEntities();
+	ClearComponents();
 
-			//Convert timings to milliseconds for frequency calculations
-			const float renderTimeMilliseconds = static_cast<float>(mRenderTime.count() / pow(10, 6));
+	SnapshotReader reader(file.Data(), file.Size());
+	SnapshotHeader header;
+	reader.ReadBytes(&header, sizeof(header));
 
-			//Calculate the actual rendering frequency
-			mRenderingFrequency = static_cast<int>(1000 / renderTimeMilliseconds);
+	mEntities.resize(header.entityCount);
+	reader.ReadBytes(static_cast<void*>(mEntities.data()), header.entityCount * sizeof(Entity));
+	mFreeEntityIDs.resize(header.freeEntityCount);
+	reader.ReadBytes(static_cast<void*>(mFreeEntityIDs.data()), header.freeEntityCount * sizeof(EntityHandle));
+	mEnabledEntities.resize(header.entityCount);
+	reader.ReadBytes(mEnabledEntities.data(), header.entityCount * sizeof(unsigned char));
+	mEntityPoolIndices.resize(header.entityCount);
+	reader.ReadBytes(mEntityPoolIndices.data(), header.entityCount * sizeof(int));
+	mEntityID = header.nextEntityID;
+	RefillEntityPools();
 
-			//Cleanup then create new task and set start time
-			mRenderTask->CleanUpTask();
-			mRenderTask = mThreadManager->AddTask(std::bind(&ISystem::Process, mRenderSystem), nullptr, nullptr, std::vector<int>{0});
-			mRenderStart = std::chrono::high_resolution_clock::now();
+	//Archetype rows are reserved up front so each section can construct its components in place
+	if (mStorageMode == StorageMode::ARCHETYPE)
+	{
+		for (const Entity& entity : mEntities)
+		{
+			Archetype* const archetype = FindArchetype(entity.componentMask.BuiltIn());
+			if (archetype)
+			{
+				mArchetypeLocations[entity.ID.Index()] = ArchetypeLocation{ archetype, archetype->AddEntity(entity.ID.Index()) };
+			}
 		}
 	}
-	else
+
+	//A malformed section only leaves its own components default constructed
+	bool loaded = true;
+	for (unsigned int i = 0; i < header.sectionCount; i++)
+	{
+		SnapshotSection section;
+		reader.ReadBytes(&section, sizeof(section));
+		SnapshotReader sectionReader = reader.Section(section.byteCount);
+		LoadSection(sectionReader, section);
+		loaded = loaded && !sectionReader.Failed() && sectionReader.Remaining() == 0;
+	}
+
+	//Entities created by the same prefab or scene code tend to be consecutive, so most runs cover many entities
+	std::vector<EntityHandle> batch;
+	ComponentMask batchMask;
+	for (const Entity& entity : mEntities)
 	{
-		//Create render task and set start time
-		mRenderTask = mThreadManager->AddTask(std::bind(&ISystem::Process, mRenderSystem), nullptr, nullptr, std::vector<int>{0});
-		mRenderStart = std::chrono::high_resolution_clock::now();
+		if (entity.ID.IsNull())
+		{
+			continue;
+		}
+
+		StampVersions(entity.ID.Index(), entity.componentMask.BuiltIn());
+		if (entity.componentMask != batchMask)
+		{
+			NotifySystems(batch.data(), static_cast<int>(batch.size()), ComponentType::COMPONENT_NONE, batchMask);
+			batch.clear();
+			batchMask = entity.componentMask;
+		}
+		batch.push_back(entity.ID);
 	}
+	NotifySystems(batch.data(), static_cast<int>(batch.size()), ComponentType::COMPONENT_NONE, batchMask);
+
+	return loaded;
 }
 
 /// <summary>
@@ -321,27 +1794,9 @@ void ECSManager::ProcessSystems()
 /// </summary>
 /// <param name="pAI">AI component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddAIComp(const AI& pAI, const int pEntityID)
+void ECSManager::AddAIComp(const AI& pAI, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mAIFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mAIs.push_back(pAI);
-		mAIEntityMap[pEntityID] = static_cast<unsigned short>(mAIs.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mAIs[mAIFreeList.back()] = pAI;
-		mAIEntityMap[pEntityID] = static_cast<unsigned short>(mAIFreeList.back());
-		mAIFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_AI;
-	AssignEntity(*entity);
+	AddComponent(mAIs, pAI, ComponentType::COMPONENT_AI, pEntityID);
 }
 
 /// <summary>
@@ -349,27 +1804,9 @@ void ECSManager::AddAIComp(const AI& pAI, const int pEntityID)
 /// </summary>
 /// <param name="pAudio">Audio component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddAudioComp(const Audio & pAudio, const int pEntityID)
+void ECSManager::AddAudioComp(const Audio & pAudio, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mAudioFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mAudios.push_back(pAudio);
-		mAudioEntityMap[pEntityID] = static_cast<unsigned short>(mAudios.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mAudios[mAudioFreeList.back()] = pAudio;
-		mAudioEntityMap[pEntityID] = static_cast<unsigned short>(mAudioFreeList.back());
-		mAudioFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_AUDIO;
-	AssignEntity(*entity);
+	AddComponent(mAudios, pAudio, ComponentType::COMPONENT_AUDIO, pEntityID);
 }
 
 /// <summary>
@@ -377,27 +1814,9 @@ void ECSManager::AddAudioComp(const Audio & pAudio, const int pEntityID)
 /// </summary>
 /// <param name="pBoxCollider">Box Collider component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddBoxColliderComp(const BoxCollider & pBoxCollider, const int pEntityID)
+void ECSManager::AddBoxColliderComp(const BoxCollider & pBoxCollider, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mBoxColliderFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mBoxColliders.push_back(pBoxCollider);
-		mBoxColliderEntityMap[pEntityID] = static_cast<unsigned short>(mBoxColliders.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mBoxColliders[mBoxColliderFreeList.back()] = pBoxCollider;
-		mBoxColliderEntityMap[pEntityID] = static_cast<unsigned short>(mBoxColliderFreeList.back());
-		mBoxColliderFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_BOXCOLLIDER;
-	AssignEntity(*entity);
+	AddComponent(mBoxColliders, pBoxCollider, ComponentType::COMPONENT_BOXCOLLIDER, pEntityID);
 }
 
 /// <summary>
@@ -405,27 +1824,9 @@ void ECSManager::AddBoxColliderComp(const BoxCollider & pBoxCollider, const int
 /// </summary>
 /// <param name="pCamera">Camera component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddCameraComp(const Camera & pCamera, const int pEntityID)
+void ECSManager::AddCameraComp(const Camera & pCamera, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mCameraFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mCameras.push_back(pCamera);
-		mCameraEntityMap[pEntityID] = static_cast<unsigned short>(mCameras.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mCameras[mCameraFreeList.back()] = pCamera;
-		mCameraEntityMap[pEntityID] = static_cast<unsigned short>(mCameraFreeList.back());
-		mCameraFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_CAMERA;
-	AssignEntity(*entity);
+	AddComponent(mCameras, pCamera, ComponentType::COMPONENT_CAMERA, pEntityID);
 }
 
 /// <summary>
@@ -433,27 +1834,9 @@ void ECSManager::AddCameraComp(const Camera & pCamera, const int pEntityID)
 /// </summary>
 /// <param name="pCollision">Collision component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddCollisionComp(const Collision & pCollision, const int pEntityID)
+void ECSManager::AddCollisionComp(const Collision & pCollision, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mCollisionFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mCollisions.push_back(pCollision);
-		mCollisionEntityMap[pEntityID] = static_cast<unsigned short>(mCollisions.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mCollisions[mCollisionFreeList.back()] = pCollision;
-		mCollisionEntityMap[pEntityID] = static_cast<unsigned short>(mCollisionFreeList.back());
-		mCollisionFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_COLLISION;
-	AssignEntity(*entity);
+	AddComponent(mCollisions, pCollision, ComponentType::COMPONENT_COLLISION, pEntityID);
 }
 
 /// <summary>
@@ -461,27 +1844,9 @@ void ECSManager::AddCollisionComp(const Collision & pCollision, const int pEntit
 /// </summary>
 /// <param name="pColour">Colour component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddColourComp(const Colour & pColour, const int pEntityID)
+void ECSManager::AddColourComp(const Colour & pColour, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mColourFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mColours.push_back(pColour);
-		mColourEntityMap[pEntityID] = static_cast<unsigned short>(mColours.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mColours[mColourFreeList.back()] = pColour;
-		mColourEntityMap[pEntityID] = static_cast<unsigned short>(mColourFreeList.back());
-		mColourFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_COLOUR;
-	AssignEntity(*entity);
+	AddComponent(mColours, pColour, ComponentType::COMPONENT_COLOUR, pEntityID);
 }
 
 /// <summary>
@@ -489,27 +1854,9 @@ void ECSManager::AddColourComp(const Colour & pColour, const int pEntityID)
 /// </summary>
 /// <param name="pGeometry">Geometry component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddGeometryComp(const Geometry & pGeometry, const int pEntityID)
+void ECSManager::AddGeometryComp(const Geometry & pGeometry, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mGeometryFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mGeometries.push_back(pGeometry);
-		mGeometryEntityMap[pEntityID] = static_cast<unsigned short>(mGeometries.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mGeometries[mGeometryFreeList.back()] = pGeometry;
-		mGeometryEntityMap[pEntityID] = static_cast<unsigned short>(mGeometryFreeList.back());
-		mGeometryFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_GEOMETRY;
-	AssignEntity(*entity);
+	AddComponent(mGeometries, pGeometry, ComponentType::COMPONENT_GEOMETRY, pEntityID);
 }
 
 /// <summary>
@@ -517,27 +1864,9 @@ void ECSManager::AddGeometryComp(const Geometry & pGeometry, const int pEntityID
 /// </summary>
 /// <param name="pGravity">Gravity component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddGravityComp(const Gravity & pGravity, const int pEntityID)
+void ECSManager::AddGravityComp(const Gravity & pGravity, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mGravityFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mGravities.push_back(pGravity);
-		mGravityEntityMap[pEntityID] = static_cast<unsigned short>(mGravities.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mGravities[mGravityFreeList.back()] = pGravity;
-		mGravityEntityMap[pEntityID] = static_cast<unsigned short>(mGravityFreeList.back());
-		mGravityFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_GRAVITY;
-	AssignEntity(*entity);
+	AddComponent(mGravities, pGravity, ComponentType::COMPONENT_GRAVITY, pEntityID);
 }
 
 /// <summary>
@@ -545,27 +1874,9 @@ void ECSManager::AddGravityComp(const Gravity & pGravity, const int pEntityID)
 /// </summary>
 /// <param name="pLight">Light component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddPointLightComp(const PointLight & pLight, const int pEntityID)
+void ECSManager::AddPointLightComp(const PointLight & pLight, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mPointLightFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mPointLights.push_back(pLight);
-		mPointLightEntityMap[pEntityID] = static_cast<unsigned short>(mPointLights.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mPointLights[mPointLightFreeList.back()] = pLight;
-		mPointLightEntityMap[pEntityID] = static_cast<unsigned short>(mPointLightFreeList.back());
-		mPointLightFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_POINTLIGHT;
-	AssignEntity(*entity);
+	AddComponent(mPointLights, pLight, ComponentType::COMPONENT_POINTLIGHT, pEntityID);
 }
 
 /// <summary>
@@ -573,27 +1884,9 @@ void ECSManager::AddPointLightComp(const PointLight & pLight, const int pEntityI
 /// </summary>
 /// <param name="pLight">Light component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddDirectionalLightComp(const DirectionalLight & pLight, const int pEntityID)
+void ECSManager::AddDirectionalLightComp(const DirectionalLight & pLight, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mDirectionalLightFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mDirectionalLights.push_back(pLight);
-		mDirectionalLightEntityMap[pEntityID] = static_cast<unsigned short>(mDirectionalLights.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mDirectionalLights[mDirectionalLightFreeList.back()] = pLight;
-		mDirectionalLightEntityMap[pEntityID] = static_cast<unsigned short>(mDirectionalLightFreeList.back());
-		mDirectionalLightFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_DIRECTIONALLIGHT;
-	AssignEntity(*entity);
+	AddComponent(mDirectionalLights, pLight, ComponentType::COMPONENT_DIRECTIONALLIGHT, pEntityID);
 }
 
 /// <summary>
@@ -601,27 +1894,9 @@ void ECSManager::AddDirectionalLightComp(const DirectionalLight & pLight, const
 /// </summary>
 /// <param name="pRay">Ray component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddRayComp(const Ray & pRay, const int pEntityID)
+void ECSManager::AddRayComp(const Ray & pRay, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mRayFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mRays.push_back(pRay);
-		mRayEntityMap[pEntityID] = static_cast<unsigned short>(mRays.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mRays[mRayFreeList.back()] = pRay;
-		mRayEntityMap[pEntityID] = static_cast<unsigned short>(mRayFreeList.back());
-		mRayFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_RAY;
-	AssignEntity(*entity);
+	AddComponent(mRays, pRay, ComponentType::COMPONENT_RAY, pEntityID);
 }
 
 /// <summary>
@@ -629,27 +1904,9 @@ void ECSManager::AddRayComp(const Ray & pRay, const int pEntityID)
 /// </summary>
 /// <param name="pShader">Shader component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddShaderComp(const Shader & pShader, const int pEntityID)
+void ECSManager::AddShaderComp(const Shader & pShader, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mShaderFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mShaders.push_back(pShader);
-		mShaderEntityMap[pEntityID] = static_cast<unsigned short>(mShaders.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mShaders[mShaderFreeList.back()] = pShader;
-		mShaderEntityMap[pEntityID] = static_cast<unsigned short>(mShaderFreeList.back());
-		mShaderFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_SHADER;
-	AssignEntity(*entity);
+	AddComponent(mShaders, pShader, ComponentType::COMPONENT_SHADER, pEntityID);
 }
 
 /// <summary>
@@ -657,27 +1914,9 @@ void ECSManager::AddShaderComp(const Shader & pShader, const int pEntityID)
 /// </summary>
 /// <param name="pSphereCollider">Sphere Collider component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddSphereColliderComp(const SphereCollider & pSphereCollider, const int pEntityID)
+void ECSManager::AddSphereColliderComp(const SphereCollider & pSphereCollider, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mSphereColliderFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mSphereColliders.push_back(pSphereCollider);
-		mSphereColliderEntityMap[pEntityID] = static_cast<unsigned short>(mSphereColliders.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mSphereColliders[mSphereColliderFreeList.back()] = pSphereCollider;
-		mSphereColliderEntityMap[pEntityID] = static_cast<unsigned short>(mSphereColliderFreeList.back());
-		mSphereColliderFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_SPHERECOLLIDER;
-	AssignEntity(*entity);
+	AddComponent(mSphereColliders, pSphereCollider, ComponentType::COMPONENT_SPHERECOLLIDER, pEntityID);
 }
 
 /// <summary>
@@ -685,27 +1924,9 @@ void ECSManager::AddSphereColliderComp(const SphereCollider & pSphereCollider, c
 /// </summary>
 /// <param name="pTexture">Texture component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddTextureComp(const Texture & pTexture, const int pEntityID)
+void ECSManager::AddTextureComp(const Texture & pTexture, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mTextureFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mTextures.push_back(pTexture);
-		mTextureEntityMap[pEntityID] = static_cast<unsigned short>(mTextures.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mTextures[mTextureFreeList.back()] = pTexture;
-		mTextureEntityMap[pEntityID] = static_cast<unsigned short>(mTextureFreeList.back());
-		mTextureFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_TEXTURE;
-	AssignEntity(*entity);
+	AddComponent(mTextures, pTexture, ComponentType::COMPONENT_TEXTURE, pEntityID);
 }
 
 /// <summary>
@@ -713,27 +1934,9 @@ void ECSManager::AddTextureComp(const Texture & pTexture, const int pEntityID)
 /// </summary>
 /// <param name="pTransform">Transform component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddTransformComp(const Transform & pTransform, const int pEntityID)
+void ECSManager::AddTransformComp(const Transform & pTransform, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mTransformFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mTransforms.push_back(pTransform);
-		mTransformEntityMap[pEntityID] = static_cast<unsigned short>(mTransforms.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mTransforms[mTransformFreeList.back()] = pTransform;
-		mTransformEntityMap[pEntityID] = static_cast<unsigned short>(mTransformFreeList.back());
-		mTransformFreeList.pop_back();
-	}
-
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_TRANSFORM;
-	AssignEntity(*entity);
+	AddComponent(mTransforms, pTransform, ComponentType::COMPONENT_TRANSFORM, pEntityID);
 }
 
 /// <summary>
@@ -741,87 +1944,46 @@ void ECSManager::AddTransformComp(const Transform & pTransform, const int pEntit
 /// </summary>
 /// <param name="pVelocity">Velocity component to add</param>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::AddVelocityComp(const Velocity & pVelocity, const int pEntityID)
+void ECSManager::AddVelocityComp(const Velocity & pVelocity, const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	if (mVelocityFreeList.empty())
-	{
-		//Push onto back if no free slots and map to back
-		mVelocities.push_back(pVelocity);
-		mVelocityEntityMap[pEntityID] = static_cast<unsigned short>(mVelocities.size() - 1);
-	}
-	else
-	{
-		//Insert into free slot and map to free slot
-		mVelocities[mVelocityFreeList.back()] = pVelocity;
-		mVelocityEntityMap[pEntityID] = static_cast<unsigned short>(mVelocityFreeList.back());
-		mVelocityFreeList.pop_back();
-	}
+	AddComponent(mVelocities, pVelocity, ComponentType::COMPONENT_VELOCITY, pEntityID);
+}
 
-	//Adjust mask then assign entity
-	entity->componentMask |= ComponentType::COMPONENT_VELOCITY;
-	AssignEntity(*entity);
+/// <summary>
+/// Adds a Parent component to the entity with a given ID
+/// </summary>
+/// <param name="pParent">Parent component to add</param>
+/// <param name="pEntityID">Given ID of the entity</param>
+void ECSManager::AddParentComp(const Parent & pParent, const EntityHandle pEntityID)
+{
+	AddComponent(mParents, pParent, ComponentType::COMPONENT_PARENT, pEntityID);
 }
 
 /// <summary>
 /// Removes an AI component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveAIComp(const int pEntityID)
+void ECSManager::RemoveAIComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_AI) == ComponentType::COMPONENT_AI)
-	{
-		//Add slot in ai array to free list
-		mAIFreeList.push_back(mAIEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_AI; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mAIs, ComponentType::COMPONENT_AI, pEntityID);
 }
 
 /// <summary>
 /// Removes an Audio component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveAudioComp(const int pEntityID)
+void ECSManager::RemoveAudioComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_AUDIO) == ComponentType::COMPONENT_AUDIO)
-	{
-		//Add slot in audio array to free list
-		mAudioFreeList.push_back(mAudioEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_AUDIO; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mAudios, ComponentType::COMPONENT_AUDIO, pEntityID);
 }
 
 /// <summary>
 /// Removes a BoxCollider component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveBoxColliderComp(const int pEntityID)
+void ECSManager::RemoveBoxColliderComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_BOXCOLLIDER) == ComponentType::COMPONENT_BOXCOLLIDER)
-	{
-		//Add slot in box collider array to free list
-		mBoxColliderFreeList.push_back(mBoxColliderEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_BOXCOLLIDER; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mBoxColliders, ComponentType::COMPONENT_BOXCOLLIDER, pEntityID);
 }
 
 
@@ -829,60 +1991,27 @@ void ECSManager::RemoveBoxColliderComp(const int pEntityID)
 /// Removes a Camera component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveCameraComp(const int pEntityID)
+void ECSManager::RemoveCameraComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_CAMERA) == ComponentType::COMPONENT_CAMERA)
-	{
-		//Add slot in camera array to free list
-		mCameraFreeList.push_back(mCameraEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_CAMERA; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mCameras, ComponentType::COMPONENT_CAMERA, pEntityID);
 }
 
 /// <summary>
 /// Removes a Collision component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveCollisionComp(const int pEntityID)
+void ECSManager::RemoveCollisionComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_COLLISION) == ComponentType::COMPONENT_COLLISION)
-	{
-		//Add slot in collision array to free list
-		mCollisionFreeList.push_back(mCollisionEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_COLLISION; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mCollisions, ComponentType::COMPONENT_COLLISION, pEntityID);
 }
 
 /// <summary>
 /// Removes a Colour component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveColourComp(const int pEntityID)
+void ECSManager::RemoveColourComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_COLOUR) == ComponentType::COMPONENT_COLOUR)
-	{
-		//Add slot in colour array to free list
-		mColourFreeList.push_back(mColourEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_COLOUR; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mColours, ComponentType::COMPONENT_COLOUR, pEntityID);
 }
 
 
@@ -890,40 +2019,18 @@ void ECSManager::RemoveColourComp(const int pEntityID)
 /// Removes a Geometry component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveGeometryComp(const int pEntityID)
+void ECSManager::RemoveGeometryComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_GEOMETRY) == ComponentType::COMPONENT_GEOMETRY)
-	{
-		//Add slot in geometry array to free list
-		mGeometryFreeList.push_back(mGeometryEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_GEOMETRY; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mGeometries, ComponentType::COMPONENT_GEOMETRY, pEntityID);
 }
 
 /// <summary>
 /// Removes a Gravity component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveGravityComp(const int pEntityID)
+void ECSManager::RemoveGravityComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_GRAVITY) == ComponentType::COMPONENT_GRAVITY)
-	{
-		//Add slot in gravity array to free list
-		mGravityFreeList.push_back(mGravityEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_GRAVITY; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mGravities, ComponentType::COMPONENT_GRAVITY, pEntityID);
 }
 
 
@@ -931,56 +2038,23 @@ void ECSManager::RemoveGravityComp(const int pEntityID)
 /// Removes a Light component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemovePointLightComp(const int pEntityID)
+void ECSManager::RemovePointLightComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_POINTLIGHT) == ComponentType::COMPONENT_POINTLIGHT)
-	{
-		//Add slot in light array to free list
-		mPointLightFreeList.push_back(mPointLightEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_POINTLIGHT; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mPointLights, ComponentType::COMPONENT_POINTLIGHT, pEntityID);
 }
 
-void ECSManager::RemoveDirectionalLightComp(const int pEntityID)
+void ECSManager::RemoveDirectionalLightComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_DIRECTIONALLIGHT) == ComponentType::COMPONENT_DIRECTIONALLIGHT)
-	{
-		//Add slot in light array to free list
-		mDirectionalLightFreeList.push_back(mDirectionalLightEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_DIRECTIONALLIGHT; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mDirectionalLights, ComponentType::COMPONENT_DIRECTIONALLIGHT, pEntityID);
 }
 
 /// <summary>
 /// Removes a Ray component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveRayComp(const int pEntityID)
+void ECSManager::RemoveRayComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_RAY) == ComponentType::COMPONENT_RAY)
-	{
-		//Add slot in ray array to free list
-		mRayFreeList.push_back(mRayEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_RAY; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mRays, ComponentType::COMPONENT_RAY, pEntityID);
 }
 
 
@@ -988,60 +2062,27 @@ void ECSManager::RemoveRayComp(const int pEntityID)
 /// Removes a Shader component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveShaderComp(const int pEntityID)
+void ECSManager::RemoveShaderComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_SHADER) == ComponentType::COMPONENT_SHADER)
-	{
-		//Add slot in shader array to free list
-		mShaderFreeList.push_back(mShaderEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_SHADER; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mShaders, ComponentType::COMPONENT_SHADER, pEntityID);
 }
 
 /// <summary>
 /// Removes a Sphere Collider component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveSphereColliderComp(const int pEntityID)
+void ECSManager::RemoveSphereColliderComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_SPHERECOLLIDER) == ComponentType::COMPONENT_SPHERECOLLIDER)
-	{
-		//Add slot in sphere collider array to free list
-		mSphereColliderFreeList.push_back(mSphereColliderEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_SPHERECOLLIDER; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mSphereColliders, ComponentType::COMPONENT_SPHERECOLLIDER, pEntityID);
 }
 
 /// <summary>
 /// Removes a Texture component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveTextureComp(const int pEntityID)
+void ECSManager::RemoveTextureComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_TEXTURE) == ComponentType::COMPONENT_TEXTURE)
-	{
-		//Add slot in texture array to free list
-		mTextureFreeList.push_back(mTextureEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_TEXTURE; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mTextures, ComponentType::COMPONENT_TEXTURE, pEntityID);
 }
 
 
@@ -1049,40 +2090,27 @@ void ECSManager::RemoveTextureComp(const int pEntityID)
 /// Removes a Transform component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveTransformComp(const int pEntityID)
+void ECSManager::RemoveTransformComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_TRANSFORM) == ComponentType::COMPONENT_TRANSFORM)
-	{
-		//Add slot in transform array to free list
-		mTransformFreeList.push_back(mTransformEntityMap[pEntityID]);
-
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_TRANSFORM; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+	RemoveComponent(mTransforms, ComponentType::COMPONENT_TRANSFORM, pEntityID);
 }
 
 /// <summary>
 /// Removes a Velocity component from the entity with a given ID
 /// </summary>
 /// <param name="pEntityID">Given ID of the entity</param>
-void ECSManager::RemoveVelocityComp(const int pEntityID)
+void ECSManager::RemoveVelocityComp(const EntityHandle pEntityID)
 {
-	Entity* entity = &mEntities[pEntityID];
-
-	//Checks if entity actually owns a component of this type
-	if ((entity->componentMask & ComponentType::COMPONENT_VELOCITY) == ComponentType::COMPONENT_VELOCITY)
-	{
-		//Add slot in velocity array to free list
-		mVelocityFreeList.push_back(mVelocityEntityMap[pEntityID]);
+	RemoveComponent(mVelocities, ComponentType::COMPONENT_VELOCITY, pEntityID);
+}
 
-		//Update mask and reassign entity
-		entity->componentMask = entity->componentMask &= ~ComponentType::COMPONENT_VELOCITY; //Performs a bitwise & between the entities mask and the bitwise complement of the components mask
-		ReAssignEntity(*entity);
-	}
+/// <summary>
+/// Removes a Parent component from the entity with a given ID
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void ECSManager::RemoveParentComp(const EntityHandle pEntityID)
+{
+	RemoveComponent(mParents, ComponentType::COMPONENT_PARENT, pEntityID);
 }
 
 /// <summary>
@@ -1090,14 +2118,9 @@ void ECSManager::RemoveVelocityComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to AI component</returns>
-AI* const ECSManager::AIComp(const int pEntityID)
+AI* const ECSManager::AIComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_AI) == ComponentType::COMPONENT_AI)
-	{
-		return &mAIs[mAIEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mAIs, ComponentType::COMPONENT_AI, pEntityID);
 }
 
 /// <summary>
@@ -1105,14 +2128,9 @@ AI* const ECSManager::AIComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to Audio component</returns>
-Audio* const ECSManager::AudioComp(const int pEntityID)
+Audio* const ECSManager::AudioComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_AUDIO) == ComponentType::COMPONENT_AUDIO)
-	{
-		return &mAudios[mAudioEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mAudios, ComponentType::COMPONENT_AUDIO, pEntityID);
 }
 
 /// <summary>
@@ -1120,14 +2138,9 @@ Audio* const ECSManager::AudioComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to BoxCollider component</returns>
-BoxCollider* const ECSManager::BoxColliderComp(const int pEntityID)
+BoxCollider* const ECSManager::BoxColliderComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_BOXCOLLIDER) == ComponentType::COMPONENT_BOXCOLLIDER)
-	{
-		return &mBoxColliders[mBoxColliderEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mBoxColliders, ComponentType::COMPONENT_BOXCOLLIDER, pEntityID);
 }
 
 /// <summary>
@@ -1135,14 +2148,9 @@ BoxCollider* const ECSManager::BoxColliderComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to Camera component</returns>
-Camera* const ECSManager::CameraComp(const int pEntityID)
+Camera* const ECSManager::CameraComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_CAMERA) == ComponentType::COMPONENT_CAMERA)
-	{
-		return &mCameras[mCameraEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mCameras, ComponentType::COMPONENT_CAMERA, pEntityID);
 }
 
 /// <summary>
@@ -1150,14 +2158,9 @@ Camera* const ECSManager::CameraComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to Collision component</returns>
-Collision* const ECSManager::CollisionComp(const int pEntityID)
+Collision* const ECSManager::CollisionComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_COLLISION) == ComponentType::COMPONENT_COLLISION)
-	{
-		return &mCollisions[mCollisionEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mCollisions, ComponentType::COMPONENT_COLLISION, pEntityID);
 }
 
 /// <summary>
@@ -1165,14 +2168,9 @@ Collision* const ECSManager::CollisionComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to Colour component</returns>
-Colour* const ECSManager::ColourComp(const int pEntityID)
+Colour* const ECSManager::ColourComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_COLOUR) == ComponentType::COMPONENT_COLOUR)
-	{
-		return &mColours[mColourEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mColours, ComponentType::COMPONENT_COLOUR, pEntityID);
 }
 
 /// <summary>
@@ -1180,14 +2178,9 @@ Colour* const ECSManager::ColourComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to Geometry component</returns>
-Geometry* const ECSManager::GeometryComp(const int pEntityID)
+Geometry* const ECSManager::GeometryComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_GEOMETRY) == ComponentType::COMPONENT_GEOMETRY)
-	{
-		return &mGeometries[mGeometryEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mGeometries, ComponentType::COMPONENT_GEOMETRY, pEntityID);
 }
 
 /// <summary>
@@ -1195,14 +2188,9 @@ Geometry* const ECSManager::GeometryComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to Geometry component</returns>
-Gravity* const ECSManager::GravityComp(const int pEntityID)
+Gravity* const ECSManager::GravityComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_GRAVITY) == ComponentType::COMPONENT_GRAVITY)
-	{
-		return &mGravities[mGravityEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mGravities, ComponentType::COMPONENT_GRAVITY, pEntityID);
 }
 
 /// <summary>
@@ -1210,24 +2198,14 @@ Gravity* const ECSManager::GravityComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to AI component</returns>
-PointLight* const ECSManager::PointLightComp(const int pEntityID)
+PointLight* const ECSManager::PointLightComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_POINTLIGHT) == ComponentType::COMPONENT_POINTLIGHT)
-	{
-		return &mPointLights[mPointLightEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mPointLights, ComponentType::COMPONENT_POINTLIGHT, pEntityID);
 }
 
-DirectionalLight* const ECSManager::DirectionalLightComp(const int pEntityID)
+DirectionalLight* const ECSManager::DirectionalLightComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_DIRECTIONALLIGHT) == ComponentType::COMPONENT_DIRECTIONALLIGHT)
-	{
-		return &mDirectionalLights[mDirectionalLightEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mDirectionalLights, ComponentType::COMPONENT_DIRECTIONALLIGHT, pEntityID);
 }
 
 /// <summary>
@@ -1235,14 +2213,9 @@ DirectionalLight* const ECSManager::DirectionalLightComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to Ray component</returns>
-Ray* const ECSManager::RayComp(const int pEntityID)
+Ray* const ECSManager::RayComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_RAY) == ComponentType::COMPONENT_RAY)
-	{
-		return &mRays[mRayEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mRays, ComponentType::COMPONENT_RAY, pEntityID);
 }
 
 /// <summary>
@@ -1250,14 +2223,9 @@ Ray* const ECSManager::RayComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to Shader component</returns>
-Shader* const ECSManager::ShaderComp(const int pEntityID)
+Shader* const ECSManager::ShaderComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_SHADER) == ComponentType::COMPONENT_SHADER)
-	{
-		return &mShaders[mShaderEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mShaders, ComponentType::COMPONENT_SHADER, pEntityID);
 }
 
 /// <summary>
@@ -1265,14 +2233,9 @@ Shader* const ECSManager::ShaderComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to Sphere Collider component</returns>
-SphereCollider* const ECSManager::SphereColliderComp(const int pEntityID)
+SphereCollider* const ECSManager::SphereColliderComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_SPHERECOLLIDER) == ComponentType::COMPONENT_SPHERECOLLIDER)
-	{
-		return &mSphereColliders[mSphereColliderEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mSphereColliders, ComponentType::COMPONENT_SPHERECOLLIDER, pEntityID);
 }
 
 /// <summary>
@@ -1280,14 +2243,9 @@ SphereCollider* const ECSManager::SphereColliderComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to Texture component</returns>
-Texture* const ECSManager::TextureComp(const int pEntityID)
+Texture* const ECSManager::TextureComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_TEXTURE) == ComponentType::COMPONENT_TEXTURE)
-	{
-		return &mTextures[mTextureEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mTextures, ComponentType::COMPONENT_TEXTURE, pEntityID);
 }
 
 /// <summary>
@@ -1295,14 +2253,9 @@ Texture* const ECSManager::TextureComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to Transform component</returns>
-Transform* const ECSManager::TransformComp(const int pEntityID)
+Transform* const ECSManager::TransformComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_TRANSFORM) == ComponentType::COMPONENT_TRANSFORM)
-	{
-		return &mTransforms[mTransformEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mTransforms, ComponentType::COMPONENT_TRANSFORM, pEntityID);
 }
 
 /// <summary>
@@ -1310,12 +2263,17 @@ Transform* const ECSManager::TransformComp(const int pEntityID)
 /// </summary>
 /// <param name="pEntityID">Given entity ID</param>
 /// <returns>Modifiable handle to Velocity component</returns>
-Velocity* const ECSManager::VelocityComp(const int pEntityID)
+Velocity* const ECSManager::VelocityComp(const EntityHandle pEntityID)
 {
-	//Checks if entity actually owns a component of this type
-	if ((mEntities[pEntityID].componentMask & ComponentType::COMPONENT_VELOCITY) == ComponentType::COMPONENT_VELOCITY)
-	{
-		return &mVelocities[mVelocityEntityMap[pEntityID]];
-	}
-	return nullptr;
+	return ModifiableComponent(mVelocities, ComponentType::COMPONENT_VELOCITY, pEntityID);
+}
+
+/// <summary>
+/// Returns a modifiable handle to the Parent component associated with the given entity ID
+/// </summary>
+/// <param name="pEntityID">Given entity ID</param>
+/// <returns>Modifiable handle to Parent component</returns>
+Parent* const ECSManager::ParentComp(const EntityHandle pEntityID)
+{
+	return ModifiableComponent(mParents, ComponentType::COMPONENT_PARENT, pEntityID);
 }
@@ -190,9 +190,9 @@ void NetworkManager::FindPeers()
 			}
 			else
 			{
-				//If connect command was sent successfully, add the peer listener to a thread to handle communication with this peer
+				//If connect command was sent successfully, add the peer listener to a service thread to handle communication with this peer
 				mPeers.push_back(peerSocket);
-				mThreadManager->AddTask(std::bind(&NetworkManager::ListenToPeer, this, std::placeholders::_1), &mPeers[mPeerCount], nullptr, std::vector<int>{2, 3, 4, 5, 6, 7});
+				mThreadManager->StartService(std::bind(&NetworkManager::ListenToPeer, this, std::placeholders::_1), &mPeers[mPeerCount], nullptr, CoreMask());
 				mPeerCount++;
 			}
 		}
@@ -239,7 +239,7 @@ void NetworkManager::Listen()
 
 			//Add peer socket to thread
 			mPeers.push_back(peerSocket);
-			mThreadManager->AddTask(std::bind(&NetworkManager::ListenToPeer, this, std::placeholders::_1), &mPeers[mPeerCount], nullptr, std::vector<int>{2, 3, 4, 5, 6, 7});
+			mThreadManager->StartService(std::bind(&NetworkManager::ListenToPeer, this, std::placeholders::_1), &mPeers[mPeerCount], nullptr, CoreMask());
 			mPeerCount++;
 		}
 	}
@@ -302,9 +302,9 @@ void NetworkManager::InitWinSock(const int pPort)
 				//Listen on socket
 				listen(mListenSocket, 5);
 
-				//Add listener and sender to threads
-				mThreadManager->AddTask(std::bind(&NetworkManager::Listen, this), nullptr, nullptr, std::vector<int>{2, 3, 4, 5, 6, 7});
-				mThreadManager->AddTask(std::bind(&NetworkManager::SendMessages, this), nullptr, nullptr, std::vector<int>{2, 3, 4, 5, 6, 7});
+				//Run the listener and sender on service threads, the sender polls its queue constantly so it runs below normal priority
+				mThreadManager->StartService(std::bind(&NetworkManager::Listen, this), nullptr, nullptr, CoreMask());
+				mThreadManager->StartService(std::bind(&NetworkManager::SendMessages, this), nullptr, nullptr, CoreMask(), THREAD_PRIORITY::BELOW_NORMAL);
 				break;
 			}
 		}
@@ -316,9 +316,9 @@ void NetworkManager::InitWinSock(const int pPort)
 	}
 	else
 	{
-		//Add listener and sender to threads
-		mThreadManager->AddTask(std::bind(&NetworkManager::Listen, this), nullptr, nullptr, std::vector<int>{2, 3, 4, 5, 6, 7});
-		mThreadManager->AddTask(std::bind(&NetworkManager::SendMessages, this), nullptr, nullptr, std::vector<int>{2, 3, 4, 5, 6, 7});
+		//Run the listener and sender on service threads, the sender polls its queue constantly so it runs below normal priority
+		mThreadManager->StartService(std::bind(&NetworkManager::Listen, this), nullptr, nullptr, CoreMask());
+		mThreadManager->StartService(std::bind(&NetworkManager::SendMessages, this), nullptr, nullptr, CoreMask(), THREAD_PRIORITY::BELOW_NORMAL);
 	}
 }
 
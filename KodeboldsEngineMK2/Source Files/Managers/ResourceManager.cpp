@@ -22,18 +22,21 @@ ResourceManager::~ResourceManager()
 /// If texture is already loaded, retrieves the already created texture object
 /// </summary>
 /// <param name="pRenderer">The render system used for creation of texture object</param>
-/// <param name="pFilename">Filename of the texture</param>
-/// <returns>Handle to the texture object associated with the file name</returns>
-const TextureObject* const ResourceManager::LoadTexture(const RenderSystem* const pRenderer, const std::wstring& pFilename)
+/// <param name="pTexture">Resource handle of the texture</param>
+/// <returns>Handle to the texture object associated with the file name, nullptr if the handle is empty or the texture can't be created</returns>
+const TextureObject* const ResourceManager::LoadTexture(const RenderSystem* const pRenderer, const TextureHandle pTexture)
 {
 	auto hr{ S_OK };
-	//find and return from map
-	for (const auto& pair : mTextures)
+	//Empty handles name no texture
+	if (pTexture.IsNull())
 	{
-		if (pair.first == pFilename)
-		{
-			return pair.second;
-		}
+		return nullptr;
+	}
+	//find and return from the slot of the handle
+	TextureObject*& texture = Slot(mTextures, pTexture.id);
+	if (texture)
+	{
+		return texture;
 	}
 	//else create a new texture
 
@@ -42,17 +45,16 @@ const TextureObject* const ResourceManager::LoadTexture(const RenderSystem* cons
 #elif OPENGL
 	TextureObject* newTexture = new TextureObject_GL();
 #endif
-	hr = newTexture->Create(pRenderer, pFilename);
+	hr = newTexture->Create(pRenderer, pTexture.Filename());
 
 	if (FAILED(hr))
 	{
 		return nullptr;
 	}
 
-	//add it to the map
-	mTextures.emplace_back(make_pair(pFilename, newTexture));
-	//return the last thing in the dictionary (the newly created texture)
-	return mTextures.back().second;
+	//store it in the slot of the handle
+	texture = newTexture;
+	return texture;
 }
 
 /// <summary>
@@ -60,18 +62,16 @@ const TextureObject* const ResourceManager::LoadTexture(const RenderSystem* cons
 /// If geometry is already loaded, retrieves the already created geometry object
 /// </summary>
 /// <param name="pRenderer">The render system used for the creation of the geometry object</param>
-/// <param name="pFilename">Filename of the geometry</param>
+/// <param name="pGeometry">Resource handle of the geometry</param>
 /// <returns>Handle to the VBO associated with the file name</returns>
-VBO* const ResourceManager::LoadGeometry(const RenderSystem* const pRenderer, const std::wstring& pFilename)
+VBO* const ResourceManager::LoadGeometry(const RenderSystem* const pRenderer, const GeometryHandle pGeometry)
 {
 	auto hr{ S_OK };
-	//find and return from map
-	for (const auto& pair : mGeometries)
+	//find and return from the slot of the handle
+	VBO*& geometry = Slot(mGeometries, pGeometry.id);
+	if (geometry)
 	{
-		if (pair.first == pFilename)
-		{
-			return pair.second;
-		}
+		return geometry;
 	}
 	//else create a new geometry
 #ifdef  DIRECTX
@@ -79,15 +79,14 @@ VBO* const ResourceManager::LoadGeometry(const RenderSystem* const pRenderer, co
 #elif OPENGL
 	VBO* newGeometry = new VBO_GL();
 #endif
-	hr = newGeometry->Create(pRenderer, pFilename);
+	hr = newGeometry->Create(pRenderer, pGeometry.Filename());
 	if (FAILED(hr))
 	{
 		return nullptr;
 	}
-	//add it to the map
-	mGeometries.emplace_back(make_pair(pFilename, newGeometry));
-	//return the last thing in the dictionary (the newly created geometry)
-	return mGeometries.back().second;
+	//store it in the slot of the handle
+	geometry = newGeometry;
+	return geometry;
 }
 
 /// <summary>
@@ -95,18 +94,16 @@ VBO* const ResourceManager::LoadGeometry(const RenderSystem* const pRenderer, co
 /// If shader is already loaded, retrieves the already created shader object
 /// </summary>
 /// <param name="pRenderer">The render system used for the creation of the shader object</param>
-/// <param name="pFilename">Filename of the shader</param>
+/// <param name="pShader">Resource handle of the shader</param>
 /// <returns>Handle to the shader object associated with the file name</returns>
-const ShaderObject* const ResourceManager::LoadShader(const RenderSystem* const pRenderer, const std::wstring& pFilename)
+const ShaderObject* const ResourceManager::LoadShader(const RenderSystem* const pRenderer, const ShaderHandle pShader)
 {
 	auto hr{ S_OK };
-	//find and return from map
-	for (const auto& pair : mShaders)
+	//find and return from the slot of the handle
+	ShaderObject*& shader = Slot(mShaders, pShader.id);
+	if (shader)
 	{
-		if (pair.first == pFilename)
-		{
-			return pair.second;
-		}
+		return shader;
 	}
 	//else create a new shader
 #ifdef  DIRECTX
@@ -114,20 +111,19 @@ const ShaderObject* const ResourceManager::LoadShader(const RenderSystem* const
 #elif OPENGL
 	ShaderObject* newShader = new ShaderObject_GL();
 #endif
-	hr = newShader->CreateVertex(pRenderer, pFilename, "VS", "vs_5_0");
+	hr = newShader->CreateVertex(pRenderer, pShader.Filename(), "VS", "vs_5_0");
 	if (FAILED(hr))
 	{
 		return nullptr;
 	}
-	hr = newShader->CreatePixel(pRenderer, pFilename, "PS", "ps_5_0");
+	hr = newShader->CreatePixel(pRenderer, pShader.Filename(), "PS", "ps_5_0");
 	if (FAILED(hr))
 	{
 		return nullptr;
 	}
-	//add it to the map
-	mShaders.emplace_back(make_pair(pFilename, newShader));
-	//return the last thing in the dictionary (the newly created shader)
-	return mShaders.back().second;
+	//store it in the slot of the handle
+	shader = newShader;
+	return shader;
 }
 
 /// <summary>
@@ -135,17 +131,15 @@ const ShaderObject* const ResourceManager::LoadShader(const RenderSystem* const
 /// If sound is already loaded, retrieves the already created sound object
 /// </summary>
 /// <param name="pAudioSystem">The audio system used for the creation of the sound object</param>
-/// <param name="pFileName">Filename of the sound</param>
+/// <param name="pAudio">Resource handle of the sound</param>
 /// <returns>Handle to the sound object associated with the file name</returns>
-const Sound* const ResourceManager::LoadAudio(const AudioSystem* const pAudioSystem, std::wstring& pFileName)
+const Sound* const ResourceManager::LoadAudio(const AudioSystem* const pAudioSystem, const AudioHandle pAudio)
 {
-	//Find and return from map
-	for (const auto& pair : mSounds)
+	//Find and return from the slot of the handle
+	Sound*& sound = Slot(mSounds, pAudio.id);
+	if (sound)
 	{
-		if (pair.first == pFileName) 
-		{
-			return pair.second;
-		}
+		return sound;
 	}
 	//Else create a new sound
 #ifdef DIRECTX
@@ -153,13 +147,11 @@ const Sound* const ResourceManager::LoadAudio(const AudioSystem* const pAudioSys
 #elif
 	Sound* newSound = new Sound_GL();
 #endif
-	newSound->Create(pAudioSystem, pFileName);
-
-	//Add it to map
-	mSounds.emplace_back(make_pair(pFileName, newSound));
+	newSound->Create(pAudioSystem, pAudio.Filename());
 
-	//Return the newly added sound at the back of the map
-	return mSounds.back().second;
+	//Store it in the slot of the handle
+	sound = newSound;
+	return sound;
 }
 
 /// <summary>
@@ -3,8 +3,8 @@
 /// <summary>
 /// Updates the input and ecsManager every frame
 /// Updates the scene every frame
-/// Assigns the threads tasks every frame
 /// Calculates all the timing of the scene
+/// In fixed step mode the systems are stepped once for every whole tick of elapsed time, up to the maximum number of catch up steps
 /// </summary>
 void SceneManager::Update()
 {
@@ -13,8 +13,35 @@ void SceneManager::Update()
 
 	if (mDeltaTimeSet)
 	{
-		mEcsManager->ProcessSystems();
-		mThreadManager->ProcessTasks();
+		if (mFixedStep)
+		{
+			mAccumulator += mDeltaTime;
+
+			int steps = 0;
+			while (mAccumulator >= mTickLength && steps < mMaxCatchUpSteps)
+			{
+				mAccumulator -= mTickLength;
+				steps++;
+			}
+
+			//Time that couldn't be caught up on is dropped, so under load the simulation slows down instead of falling further behind every frame
+			if (mAccumulator >= mTickLength)
+			{
+				mAccumulator = mAccumulator % mTickLength;
+			}
+
+			//The frame is drawn part way between the last two steps by the time left over in the accumulator
+			mInterpolationAlpha = static_cast<double>(mAccumulator.count()) / mTickLength.count();
+
+			//Update systems step by the tick, the scene and input are still updated once per frame by the frame time
+			mStepping = true;
+			mEcsManager->ProcessSystems(steps);
+			mStepping = false;
+		}
+		else
+		{
+			mEcsManager->ProcessSystems();
+		}
 
 		mInputManager->Update();
 		mScene->Update();
@@ -27,7 +54,7 @@ void SceneManager::Update()
 	{
 		mLast50Frames[i] = mLast50Frames[i + 1];
 	}
-	mLast50Frames[mLast50Frames.size() - 1] = DeltaTime();
+	mLast50Frames[mLast50Frames.size() - 1] = mDeltaTime.count() / pow(10, 9);
 
 	for (auto i = 0; i < mLast50Frames.size(); i++)
 	{
@@ -43,10 +70,16 @@ void SceneManager::Update()
 
 /// <summary>
 /// Calculates delta time
+/// In fixed step mode this is the length of a tick while the update systems are stepping, so they step by the same time however long the frame took
+/// Everywhere else, including the scenes update, it is the time the last frame took
 /// </summary>
 /// <returns>Delta time of the scene</returns>
 const double SceneManager::DeltaTime() const
 {
+	if (mFixedStep && mStepping)
+	{
+		return mTickLength.count() / pow(10, 9);
+	}
 	return mDeltaTime.count() / pow(10, 9); // (or 1e+9)
 
 }
@@ -70,6 +103,63 @@ const int& SceneManager::Fps() const
 	return mFps;
 }
 
+/// <summary>
+/// Switches between stepping the systems once per frame by the frame time and stepping them by a fixed tick
+/// The accumulator is emptied so switching never runs a burst of catch up steps
+/// </summary>
+/// <param name="pFixedStep">Whether the systems are stepped by a fixed tick</param>
+void SceneManager::SetFixedStep(const bool pFixedStep)
+{
+	mFixedStep = pFixedStep;
+	mAccumulator = std::chrono::nanoseconds(0);
+	mInterpolationAlpha = 1;
+}
+
+/// <summary>
+/// Sets the number of fixed steps simulated per second
+/// </summary>
+/// <param name="pTicksPerSecond">Given tick rate, at least one tick per second</param>
+void SceneManager::SetTickRate(const int pTicksPerSecond)
+{
+	mTickLength = std::chrono::nanoseconds(1000000000 / (pTicksPerSecond < 1 ? 1 : pTicksPerSecond));
+}
+
+/// <summary>
+/// Sets the most fixed steps a single frame can run to catch up with elapsed time
+/// </summary>
+/// <param name="pMaxCatchUpSteps">Given number of steps, at least one</param>
+void SceneManager::SetMaxCatchUpSteps(const int pMaxCatchUpSteps)
+{
+	mMaxCatchUpSteps = pMaxCatchUpSteps < 1 ? 1 : pMaxCatchUpSteps;
+}
+
+/// <summary>
+/// Get method for whether the systems are stepped by a fixed tick
+/// </summary>
+/// <returns>Whether fixed step mode is on</returns>
+const bool SceneManager::FixedStep() const
+{
+	return mFixedStep;
+}
+
+/// <summary>
+/// Get method for the number of fixed steps simulated per second
+/// </summary>
+/// <returns>Tick rate</returns>
+const int SceneManager::TickRate() const
+{
+	return static_cast<int>(1000000000 / mTickLength.count());
+}
+
+/// <summary>
+/// Get method for how far between the last two fixed steps the current frame is, used by the renderer to blend the previous and current transforms
+/// </summary>
+/// <returns>Interpolation alpha between zero and one, always one outside of fixed step mode</returns>
+const double SceneManager::InterpolationAlpha() const
+{
+	return mInterpolationAlpha;
+}
+
 /// <summary>
 /// Sets the window width and height inside the scene manager
 /// </summary>
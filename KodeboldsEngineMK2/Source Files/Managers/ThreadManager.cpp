@@ -1,16 +1,25 @@
 #include "ThreadManager.h"
 
+//Number of times an idle worker searches for tasks before going to sleep
+const int SPIN_COUNT = 64;
+
 /// <summary>
 /// Constructor
-/// Creates number of threads equal to double the available hardware cores
+/// Creates number of threads equal to double the available hardware cores, every worker is created before any are started so they can steal from each other
 /// </summary>
 ThreadManager::ThreadManager()
+	:mSharedJobCount(0), mSharedTaskCount(0), mSleepingThreads(0), mWakeSignals(0)
 {
-	const int maxThreads = static_cast<int>(std::thread::hardware_concurrency() * 2);
+	const int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+	const int maxThreads = hardwareThreads > 0 ? hardwareThreads * 2 : 2;
 
 	for (int i = 0; i < maxThreads; i++)
 	{
-		mThreads.push_back(new Thread());
+		mThreads.push_back(new Thread(this, i));
+	}
+	for (auto& thread : mThreads)
+	{
+		thread->Start();
 	}
 }
 
@@ -24,42 +33,413 @@ ThreadManager::~ThreadManager()
 	{
 		delete thread;
 	}
+	for (auto& serviceThread : mServiceThreads)
+	{
+		delete serviceThread;
+	}
+}
+
+/// <summary>
+/// Queues a newly created task on the shared task queue and wakes a sleeping worker to pick it up
+/// </summary>
+/// <param name="pTask">Newly created task</param>
+/// <returns>A handle to the task</returns>
+JobHandle ThreadManager::QueueTask(Task* const pTask)
+{
+	JobHandle handle(pTask);
+	pTask->DependencyFinished();
+
+	{
+		std::lock_guard<std::mutex> lock(mSharedMutex);
+		mSharedTasks.push_back(pTask);
+		mSharedTaskCount++;
+	}
+
+	WakeThread();
+	return handle;
+}
+
+/// <summary>
+/// Makes a newly created job depend on the given jobs, scheduling it straight away if they have all finished
+/// </summary>
+/// <param name="pJob">Newly created job</param>
+/// <param name="pDependencies">Jobs that must finish before the job runs, empty handles are ignored</param>
+/// <returns>A handle to the job</returns>
+JobHandle ThreadManager::QueueJob(Task* const pJob, const std::vector<JobHandle>& pDependencies)
+{
+	JobHandle handle(pJob);
+
+	//The dependency is counted before the continuation is added, as the dependency may finish as soon as it has been added
+	for (const JobHandle& dependency : pDependencies)
+	{
+		if (dependency.mTask)
+		{
+			pJob->AddDependency();
+			if (!dependency.mTask->AddContinuation(pJob))
+			{
+				pJob->DependencyFinished();
+			}
+		}
+	}
+
+	//Finish the dependency the job was created with, scheduling it now if every other dependency has already finished
+	if (pJob->DependencyFinished())
+	{
+		Schedule(pJob);
+	}
+	return handle;
+}
+
+/// <summary>
+/// Starts a service thread for a newly created task, cleaning up the service threads whose tasks have finished
+/// </summary>
+/// <param name="pTask">Newly created task</param>
+/// <param name="pPriority">Priority of the service thread</param>
+/// <returns>A handle to the task</returns>
+JobHandle ThreadManager::QueueService(Task* const pTask, const THREAD_PRIORITY pPriority)
+{
+	JobHandle handle(pTask);
+	pTask->DependencyFinished();
+
+	std::lock_guard<std::mutex> lock(mServiceMutex);
+	for (int i = static_cast<int>(mServiceThreads.size()) - 1; i >= 0; i--)
+	{
+		if (mServiceThreads[i]->IsDone())
+		{
+			delete mServiceThreads[i];
+			mServiceThreads.erase(mServiceThreads.begin() + i);
+		}
+	}
+	mServiceThreads.push_back(new ServiceThread(this, pTask, pPriority));
+	return handle;
+}
+
+/// <summary>
+/// Queues a job that is ready to run
+/// Jobs readied on a worker go onto its own deque where other workers can steal them, jobs readied on any other thread go onto the shared queue
+/// </summary>
+/// <param name="pTask">Job that is ready to run</param>
+void ThreadManager::Schedule(Task* const pTask)
+{
+	Thread* const worker = CurrentWorker();
+	if (worker)
+	{
+		worker->PushTask(pTask);
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock(mSharedMutex);
+		mSharedJobs.push_back(pTask);
+		mSharedJobCount++;
+	}
+
+	WakeThread();
 }
 
 /// <summary>
-/// Adds a new task to the task queue
+/// Runs the given task on the calling thread, readies the jobs that depend on it, then releases the thread managers reference to it
 /// </summary>
-/// <param name="pFunction">std::function containing function pointer to a function that holds the task</param>
-/// <param name="pParam1">First parameter of the function</param>
-/// <param name="pParam2">Second parameter of the function</param>
-/// <param name="pThreadAffinity">Thread affinity to set the task to</param>
-/// <returns>A handle to the created task so tha the tasks completion and be monitored and the memory can be cleaned up upon completion</returns>
-Task* const  ThreadManager::AddTask(std::function<void(void* param1, void* param2)> pFunction, void* pParam1, void* pParam2, const std::vector<int>& pThreadAffinity)
+/// <param name="pTask">Task to run</param>
+void ThreadManager::RunTask(Task* const pTask)
 {
-	Task* task = new Task(pFunction, pParam1, pParam2, pThreadAffinity);
+	pTask->Run();
+	const int continuationCount = pTask->ContinuationCount();
+	for (int i = 0; i < continuationCount; i++)
+	{
+		Task* const continuation = pTask->Continuation(i);
+		if (continuation->DependencyFinished())
+		{
+			Schedule(continuation);
+		}
+	}
+	pTask->Release();
+}
 
-	mTasks.push(task);
+/// <summary>
+/// Blocks until the given job has finished, running other jobs on the calling thread in the meantime
+/// Only jobs are run while waiting, never tasks, as a task may block the waiting thread indefinitely
+/// </summary>
+/// <param name="pJob">Job to wait on</param>
+void ThreadManager::Wait(const JobHandle& pJob)
+{
+	Thread* const worker = CurrentWorker();
+	while (!pJob.IsDone())
+	{
+		Task* const job = FindJob(worker);
+		if (job)
+		{
+			RunTask(job);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
 
+/// <summary>
+/// Splits the given range into ranges of the grain size and calls the given function on each of them across the workers, returning once every range has been processed
+/// Ranges are claimed one at a time by the calling thread and by helper jobs, so the work is shared out however busy each worker is
+/// Helpers only capture a pointer to the shared state, so they fit inside their tasks and no handles to them are kept
+/// </summary>
+/// <param name="pBegin">First index of the range</param>
+/// <param name="pEnd">Index past the last index of the range</param>
+/// <param name="pGrainSize">Number of indices processed together by a single call of the function</param>
+/// <param name="pFunction">Function taking the context and the first index and the index past the last index of a range, called from several threads at once</param>
+/// <param name="pContext">Context passed to the function</param>
+void ThreadManager::ParallelRanges(const int pBegin, const int pEnd, const int pGrainSize, void(*pFunction)(void* pContext, const int pRangeBegin, const int pRangeEnd), void* const pContext)
+{
+	const int grainSize = pGrainSize > 0 ? pGrainSize : 1;
+	const int rangeCount = pEnd > pBegin ? (pEnd - pBegin + grainSize - 1) / grainSize : 0;
+	if (rangeCount == 0)
+	{
+		return;
+	}
+	if (rangeCount == 1)
+	{
+		pFunction(pContext, pBegin, pEnd);
+		return;
+	}
+
+	std::atomic<int> nextRange(0);
+	std::atomic<int> finishedHelpers(0);
+	const auto processRanges = [&]()
+	{
+		int range = nextRange++;
+		while (range < rangeCount)
+		{
+			const int rangeBegin = pBegin + range * grainSize;
+			pFunction(pContext, rangeBegin, pEnd - rangeBegin > grainSize ? rangeBegin + grainSize : pEnd);
+			range = nextRange++;
+		}
+	};
+
+	//The calling thread takes ranges as well, so one fewer helper is needed than there are ranges
+	const int helperCount = rangeCount - 1 < ThreadCount() ? rangeCount - 1 : ThreadCount();
+	for (int i = 0; i < helperCount; i++)
+	{
+		AddJob([&processRanges, &finishedHelpers](void*, void*)
+		{
+			processRanges();
+			finishedHelpers++;
+		}, nullptr, nullptr);
+	}
+
+	processRanges();
+
+	//Helpers that start after the ranges run out finish straight away, the calling thread runs other jobs until they have
+	Thread* const worker = CurrentWorker();
+	while (finishedHelpers.load() < helperCount)
+	{
+		Task* const job = FindJob(worker);
+		if (job)
+		{
+			RunTask(job);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+/// <summary>
+/// Get method for the worker of this thread manager running on the calling thread
+/// </summary>
+/// <returns>The worker, nullptr if the calling thread isn't one of the workers</returns>
+Thread* ThreadManager::CurrentWorker() const
+{
+	Thread* const worker = Thread::Current();
+	if (worker && worker->Index() < static_cast<int>(mThreads.size()) && mThreads[worker->Index()] == worker)
+	{
+		return worker;
+	}
+	return nullptr;
+}
+
+/// <summary>
+/// Wakes one sleeping worker, if any are sleeping
+/// Pairs with the search a worker makes after announcing it is going to sleep, so either the worker finds the new task or it is woken for it
+/// </summary>
+void ThreadManager::WakeThread()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (mSleepingThreads.load() > 0)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mSleepMutex);
+			if (mWakeSignals < mSleepingThreads.load())
+			{
+				mWakeSignals++;
+			}
+		}
+		mTaskAvailable.notify_one();
+	}
+}
+
+/// <summary>
+/// Takes the oldest task from the given shared queue
+/// </summary>
+/// <param name="pQueue">Shared queue to take from</param>
+/// <param name="pCount">Number of tasks in the queue, checked before locking so empty queues are skipped cheaply</param>
+/// <returns>The task, nullptr if the queue was empty</returns>
+Task* ThreadManager::TakeShared(std::deque<Task*>& pQueue, std::atomic<int>& pCount)
+{
+	if (pCount.load() > 0)
+	{
+		std::lock_guard<std::mutex> lock(mSharedMutex);
+		if (!pQueue.empty())
+		{
+			Task* const task = pQueue.front();
+			pQueue.pop_front();
+			pCount--;
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+/// <summary>
+/// Steals a job from the deques of the workers, starting from the worker after the thief so thieves spread out over the other workers
+/// </summary>
+/// <param name="pThief">Worker stealing the job, nullptr if the thief isn't a worker</param>
+/// <returns>The job, nullptr if there was nothing to steal</returns>
+Task* ThreadManager::StealJob(Thread* const pThief)
+{
+	const int threadCount = static_cast<int>(mThreads.size());
+	const int first = pThief ? pThief->Index() + 1 : 0;
+	for (int i = 0; i < threadCount; i++)
+	{
+		Thread* const victim = mThreads[(first + i) % threadCount];
+		if (victim != pThief && victim->HasTasks())
+		{
+			Task* const job = victim->StealTask();
+			if (job)
+			{
+				return job;
+			}
+		}
+	}
+	return nullptr;
+}
+
+/// <summary>
+/// Looks for a job for a thread waiting on another job in the deque of its worker, then the shared job queue, then the deques of the other workers
+/// </summary>
+/// <param name="pWorker">Worker running on the waiting thread, nullptr if the thread isn't a worker</param>
+/// <returns>The job, nullptr if no job was found</returns>
+Task* ThreadManager::FindJob(Thread* const pWorker)
+{
+	Task* job = pWorker ? pWorker->PopTask() : nullptr;
+	if (!job)
+	{
+		job = TakeShared(mSharedJobs, mSharedJobCount);
+	}
+	if (!job)
+	{
+		job = StealJob(pWorker);
+	}
+	return job;
+}
+
+/// <summary>
+/// Looks for a task for the given worker in its own deque, then the shared job and task queues, then the deques of the other workers
+/// </summary>
+/// <param name="pThreadIndex">Index of the worker looking for a task</param>
+/// <returns>The task, nullptr if no task was found</returns>
+Task* ThreadManager::FindTask(const int pThreadIndex)
+{
+	Task* task = mThreads[pThreadIndex]->PopTask();
+	if (!task)
+	{
+		task = TakeShared(mSharedJobs, mSharedJobCount);
+	}
+	if (!task)
+	{
+		task = TakeShared(mSharedTasks, mSharedTaskCount);
+	}
+	if (!task)
+	{
+		task = StealJob(mThreads[pThreadIndex]);
+	}
 	return task;
 }
 
 /// <summary>
-/// Assigns tasks from the queue to any threads that need tasks if there any tasks to be done
+/// Returns the next task for the given worker, blocking until one is available
+/// The worker searches for tasks a number of times before sleeping, so tasks added in quick succession are picked up without waking a thread
 /// </summary>
-void ThreadManager::ProcessTasks()
+/// <param name="pThreadIndex">Index of the worker</param>
+/// <returns>The task for the worker to run</returns>
+Task* ThreadManager::WaitForTask(const int pThreadIndex)
 {
-	for (auto thread : mThreads)
+	while (true)
 	{
-		if (!mTasks.empty())
+		for (int i = 0; i < SPIN_COUNT; i++)
 		{
-			//If thread needs tasks, set threads task to front of task queue, then pop task off queue
-			if (thread->NeedsTask())
+			Task* const task = FindTask(pThreadIndex);
+			if (task)
 			{
-				thread->SetTask(mTasks.front());
-				mTasks.pop();
+				return task;
 			}
+			std::this_thread::yield();
+		}
+
+		//Announce the worker is going to sleep, then search once more to catch tasks added before the announcement was seen
+		std::unique_lock<std::mutex> lock(mSleepMutex);
+		mSleepingThreads++;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		Task* const task = FindTask(pThreadIndex);
+		if (task)
+		{
+			mSleepingThreads--;
+			return task;
+		}
+
+		mTaskAvailable.wait(lock, [this] { return mWakeSignals > 0; });
+		mWakeSignals--;
+		mSleepingThreads--;
+	}
+}
+
+/// <summary>
+/// Get method for the number of worker threads
+/// </summary>
+/// <returns>Number of worker threads</returns>
+int ThreadManager::ThreadCount() const
+{
+	return static_cast<int>(mThreads.size());
+}
+
+/// <summary>
+/// Pins each worker to one of the given cores, going round the cores in order when there are more workers than cores
+/// Workers move to their core before their next task, tasks that specify their own affinity still run on the cores they ask for
+/// </summary>
+/// <param name="pCores">Cores to pin the workers to, such as CpuTopology::PrimaryCores, empty to let the workers run on every core</param>
+void ThreadManager::PinWorkers(const std::vector<int>& pCores)
+{
+	for (int i = 0; i < static_cast<int>(mThreads.size()); i++)
+	{
+		mThreads[i]->SetHomeAffinity(pCores.empty() ? CoreMask() : CoreMask{ pCores[i % pCores.size()] });
+	}
+}
+
+/// <summary>
+/// Get method for the number of service threads that are still running their task
+/// </summary>
+/// <returns>Number of running service threads</returns>
+int ThreadManager::ServiceThreadCount()
+{
+	std::lock_guard<std::mutex> lock(mServiceMutex);
+	int count = 0;
+	for (const auto& serviceThread : mServiceThreads)
+	{
+		if (!serviceThread->IsDone())
+		{
+			count++;
 		}
 	}
+	return count;
 }
 
 /// <summary>
@@ -2,10 +2,10 @@
 
 /// <summary>
 /// Constructor
-/// Initialises entity vector to max entities size
 /// </summary>
 /// <param name="pMask">Mask for the system</param>
-AudioSystem::AudioSystem(const std::vector<int>& pMasks) : ISystem(pMasks)
+/// <param name="pReadMask">Components the system reads</param>
+/// <param name="pWriteMask">Components the system writes</param>
+AudioSystem::AudioSystem(const std::vector<ComponentMask>& pMasks, const ComponentMask& pReadMask, const ComponentMask& pWriteMask) : ISystem(pMasks, pReadMask, pWriteMask)
 {
-	mEntities = std::vector<Entity>(mEcsManager->MaxEntities(), Entity{ -1, ComponentType::COMPONENT_NONE });
 }
\ No newline at end of file
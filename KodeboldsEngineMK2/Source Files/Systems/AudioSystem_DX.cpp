@@ -1,6 +1,6 @@
 #include "AudioSystem_DX.h"
 
-AudioSystem_DX::AudioSystem_DX() : AudioSystem(std::vector<int>{ComponentType::COMPONENT_AUDIO})
+AudioSystem_DX::AudioSystem_DX() : AudioSystem(std::vector<ComponentMask>{ComponentType::COMPONENT_AUDIO}, ComponentType::COMPONENT_AUDIO, ComponentType::COMPONENT_AUDIO)
 {
 	eflags = DirectX::AUDIO_ENGINE_FLAGS::AudioEngine_Default;
 	mAudioEngine = std::make_unique<DirectX::AudioEngine>(eflags);
@@ -11,51 +11,34 @@ AudioSystem_DX::~AudioSystem_DX()
 }
 
 /// <summary>
-/// Assigns entity to system if the entities mask matches the system mask
+/// Adds the entity to the system when it starts matching the audio mask
 /// </summary>
-/// <param name="pEntity">Entity to be assigned</param>
-void AudioSystem_DX::AssignEntity(const Entity& pEntity)
+/// <param name="pEntity">Entity that entered the system</param>
+/// <param name="pMaskIndex">Index of the mask the entity now matches</param>
+void AudioSystem_DX::OnEnter(const Entity& pEntity, const int pMaskIndex)
 {
-	//Checks if entity mask matches the audio mask
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0])
-	{
-		//Update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
-	}
+	mEntities.Add(pEntity);
 }
 
 /// <summary>
-/// Re-assigns entity to system when component is removed from entity
-/// </summary>
-/// <param name="pEntity">Entity to re-assign</param>
-/// <summary>
-/// 
+/// Removes the entity from the system when it stops matching the audio mask
 /// </summary>
-/// <param name="pEntity"></param>
-void AudioSystem_DX::ReAssignEntity(const Entity& pEntity)
+/// <param name="pEntity">Entity that exited the system</param>
+/// <param name="pMaskIndex">Index of the mask the entity no longer matches</param>
+void AudioSystem_DX::OnExit(const Entity& pEntity, const int pMaskIndex)
 {
-	//Checks if entity mask matches the audio mask
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0])
-	{
-		//If the entity matches audio mask then update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
-	}
-	else
-	{
-		//If the mask doesn't match then set ID to -1
-		mEntities[pEntity.ID].ID = -1;
-	}
+	mEntities.Remove(pEntity.ID);
 }
 
 /// <summary>
 /// Systems process function, core logic of system
-/// Plays all the audio clips in the world
+/// Plays all the audio clips of enabled entities in the world
 /// </summary>
 void AudioSystem_DX::Process()
 {
 	for (const Entity& entity : mEntities) 
 	{
-		if (entity.ID != -1 && mEcsManager->AudioComp(entity.ID))
+		if (mEcsManager->IsEnabled(entity.ID) && mEcsManager->AudioComp(entity.ID))
 		{
 			// if the sound is active
 			if (mEcsManager->AudioComp(entity.ID)->active)
@@ -1,6 +1,6 @@
 #include "AudioSystem_GL.h"
 
-AudioSystem_GL::AudioSystem_GL() : AudioSystem(std::vector<int>{ComponentType::COMPONENT_AUDIO})
+AudioSystem_GL::AudioSystem_GL() : AudioSystem(std::vector<ComponentMask>{ComponentType::COMPONENT_AUDIO}, ComponentType::COMPONENT_AUDIO, ComponentType::COMPONENT_AUDIO)
 {
 }
 
@@ -8,11 +8,11 @@ AudioSystem_GL::~AudioSystem_GL()
 {
 }
 
-void AudioSystem_GL::AssignEntity(const Entity & pEntity)
+void AudioSystem_GL::OnEnter(const Entity & pEntity, const int pMaskIndex)
 {
 }
 
-void AudioSystem_GL::ReAssignEntity(const Entity & pEntity)
+void AudioSystem_GL::OnExit(const Entity & pEntity, const int pMaskIndex)
 {
 }
 
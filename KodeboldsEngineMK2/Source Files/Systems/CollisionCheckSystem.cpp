@@ -4,20 +4,22 @@ using namespace KodeboldsMath;
 
 /// <summary>
 /// Constructor
-/// Initialises entity vector and entity node map to max entities size
+/// Initialises entity node map to max entities size
 /// Sets component mask that system is interested in
+/// Collision checks only read colliders and transforms, contacts are reported through the systems event stream
 /// Sets min/max octant size to given size
 /// Constructs oct tree
 /// </summary>
 /// <param name="pMaxOctantSize">Given max size of octants</param>
 /// <param name="pMinOctantSize">Given min size of octants</param>
 CollisionCheckSystem::CollisionCheckSystem(const int pMaxOctantSize, const int pMinOctantSize)
-	: ISystem(std::vector<int>{ComponentType::COMPONENT_BOXCOLLIDER | ComponentType::COMPONENT_TRANSFORM,
+	: ISystem(std::vector<ComponentMask>{ComponentType::COMPONENT_BOXCOLLIDER | ComponentType::COMPONENT_TRANSFORM,
 		ComponentType::COMPONENT_SPHERECOLLIDER | ComponentType::COMPONENT_TRANSFORM,
-		ComponentType::COMPONENT_RAY, ComponentType::COMPONENT_TRANSFORM}),
-	MAX_OCTANT_SIZE(pMaxOctantSize), MIN_OCTANT_SIZE(pMinOctantSize)
+		ComponentType::COMPONENT_RAY},
+		ComponentType::COMPONENT_BOXCOLLIDER | ComponentType::COMPONENT_SPHERECOLLIDER | ComponentType::COMPONENT_RAY | ComponentType::COMPONENT_TRANSFORM,
+		ComponentType::COMPONENT_NONE),
+	MAX_OCTANT_SIZE(pMaxOctantSize), MIN_OCTANT_SIZE(pMinOctantSize), mLastVersion(0)
 {
-	mEntities = std::vector<Entity>(mEcsManager->MaxEntities(), Entity{ -1, ComponentType::COMPONENT_NONE });
 	mEntityNodeMap = std::vector<OctTreeNode*>(mEcsManager->MaxEntities(), nullptr);
 	ConstructTree();
 }
@@ -30,90 +32,146 @@ CollisionCheckSystem::~CollisionCheckSystem()
 }
 
 /// <summary>
-/// Assigns entity to system if the entities mask matches the system mask
+/// Queues the entity for insertion into the tree when it starts matching any of the collider masks
 /// </summary>
-/// <param name="pEntity">Entity to be assigned</param>
-void CollisionCheckSystem::AssignEntity(const Entity & pEntity)
+/// <param name="pEntity">Entity that entered the system</param>
+/// <param name="pMaskIndex">Index of the collider mask the entity now matches</param>
+void CollisionCheckSystem::OnEnter(const Entity & pEntity, const int pMaskIndex)
 {
-	//Checks if entity mask contains any colliders
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0] || (pEntity.componentMask & mMasks[1]) == mMasks[1] || (pEntity.componentMask & mMasks[2]) == mMasks[2])
+	//Add entity to insertion queue if it is new to the system
+	if (mEntities.Add(pEntity))
 	{
-		//Add entity to insertion queue
-		if (mEntities[pEntity.ID].ID == -1)
-		{
-			mEntitiesToInsert.push(static_cast<unsigned short>(pEntity.ID));
-			mEntities[pEntity.ID] = pEntity;
-		}
+		mEntitiesToInsert.push(pEntity.ID);
 	}
 }
 
 /// <summary>
-/// Re-assigns entity to system when component is removed from entity
+/// Queues the entity for removal from the tree once it no longer matches any of the collider masks
 /// </summary>
-/// <param name="pEntity">Entity to re-assign</param>
-void CollisionCheckSystem::ReAssignEntity(const Entity & pEntity)
+/// <param name="pEntity">Entity that exited the system</param>
+/// <param name="pMaskIndex">Index of the collider mask the entity no longer matches</param>
+void CollisionCheckSystem::OnExit(const Entity & pEntity, const int pMaskIndex)
 {
 	//Checks if entity mask no longer contains any colliders
-	if (!((pEntity.componentMask & mMasks[0]) == mMasks[0] || (pEntity.componentMask & mMasks[1]) == mMasks[1] || (pEntity.componentMask & mMasks[2]) == mMasks[2])
-		&& mEntities[pEntity.ID].ID != -1)
+	for (const ComponentMask& mask : mMasks)
 	{
-		//Add entity to removal queue
-		mEntitiesToRemove.push(static_cast<unsigned short>(pEntity.ID));
-		mEntities[pEntity.ID].ID = -1;
+		if (pEntity.componentMask.Contains(mask))
+		{
+			return;
+		}
+	}
+
+	//Add entity to removal queue
+	if (mEntities.Remove(pEntity.ID))
+	{
+		mEntitiesToRemove.push(pEntity.ID);
 	}
 }
 
 /// <summary>
 /// Systems process function, core logic of system
 /// Updates the tree with any insertions or removals from the tree
-/// Calculates all the collision checks for each node of tree
+/// Calculates all the collision checks for each node of tree and records the contacts found in the collision event stream
 /// </summary>
 void CollisionCheckSystem::Process()
 {
-	//Loop through all entities in the system
-	for (const auto& entity : mEntities)
+	//Only entities whose transform changed since the last run can have left the region of their node
+	mEcsManager->View<Transform>().Changed<Transform>(mLastVersion).ForEach([this](const EntityHandle pEntity, const Transform& pTransform)
 	{
-		//If the system has been assigned this entity, the entity has a velocity component and the entity is already in the tree
-		if (entity.ID != -1 && mEcsManager->VelocityComp(entity.ID) && mEntityNodeMap[entity.ID])
-		{
-			//If the entity has a velocity greater than 0
-			if (mEcsManager->VelocityComp(entity.ID)->velocity.Magnitude() > 0)
-			{
-				//If the entity has a box collider
-				if (mEcsManager->BoxColliderComp(entity.ID))
-				{
-					//If the entity is no longer within it's enclosed region, remove it and re-insert it into the tree
-					if (!BoxInsideRegion(mEntityNodeMap[entity.ID], entity.ID))
-					{
-						mEntitiesToRemove.push(static_cast<unsigned short>(entity.ID));
-						mEntitiesToInsert.push(static_cast<unsigned short>(entity.ID));
-					}
-				}
-
-				//If the entity has a sphere collider
-				if (mEcsManager->SphereColliderComp(entity.ID))
-				{
-					//If the entity is no longer within it's enclosed region, remove it and re-insert it into the tree
-					if (!SphereInsideRegion(mEntityNodeMap[entity.ID], entity.ID))
-					{
-						mEntitiesToRemove.push(static_cast<unsigned short>(entity.ID));
-						mEntitiesToInsert.push(static_cast<unsigned short>(entity.ID));
-					}
-				}
-			}
-		}
+		RequeueMovedEntity(pEntity, pTransform, mEcsManager->Read<BoxCollider>(pEntity), mEcsManager->Read<SphereCollider>(pEntity));
+	});
+	mLastVersion = mEcsManager->Version();
+
+	UpdateTree();
+
+	//Contacts found last frame are kept to classify this frames contacts
+	mEvents.BeginFrame();
+	mPreviousContacts.swap(mContacts);
+	mContacts.clear();
+
+	HandleCollisions(mOctTree, std::vector<EntityHandle>{});
+	EndContacts();
+}
+
+/// <summary>
+/// Get method for the stream of collision events
+/// Each frame appends a begin or stay event for every touching pair and an end event for every pair that stopped touching
+/// </summary>
+/// <returns>Collision event stream</returns>
+const CollisionEventStream& CollisionCheckSystem::Events() const
+{
+	return mEvents;
+}
 
-		//If the system has been assigned this entity and it has a collision component
-		if (entity.ID != -1 && mEcsManager->CollisionComp(entity.ID))
+/// <summary>
+/// Records a contact between the two given entities, classifying it as beginning or staying based on the contacts of the previous frame
+/// </summary>
+/// <param name="pEntityA">Given entity A</param>
+/// <param name="pCollisionMaskA">Collision mask of entity A</param>
+/// <param name="pEntityB">Given entity B</param>
+/// <param name="pCollisionMaskB">Collision mask of entity B</param>
+void CollisionCheckSystem::AddContact(const EntityHandle pEntityA, const int pCollisionMaskA, const EntityHandle pEntityB, const int pCollisionMaskB)
+{
+	//Pairs are keyed by both handles with the smaller first so the order the tree visits them in doesn't matter
+	const unsigned long long key = pEntityA < pEntityB
+		? (static_cast<unsigned long long>(pEntityA.value) << 32) | pEntityB.value
+		: (static_cast<unsigned long long>(pEntityB.value) << 32) | pEntityA.value;
+
+	const CollisionEvent::Phase phase = mPreviousContacts.count(key) ? CollisionEvent::STAY : CollisionEvent::BEGIN;
+	const CollisionEvent contact{ pEntityA, pEntityB, pCollisionMaskA, pCollisionMaskB, phase };
+
+	if (mContacts.emplace(key, contact).second)
+	{
+		mEvents.Push(contact);
+	}
+}
+
+/// <summary>
+/// Records an end event for every pair that touched last frame but not this frame
+/// The entities of an ended contact may have been destroyed since
+/// </summary>
+void CollisionCheckSystem::EndContacts()
+{
+	for (const auto& previousContact : mPreviousContacts)
+	{
+		if (!mContacts.count(previousContact.first))
 		{
-			//Remove collision component from previous frame
-			mEcsManager->RemoveCollisionComp(entity.ID);
+			CollisionEvent contact = previousContact.second;
+			contact.phase = CollisionEvent::END;
+			mEvents.Push(contact);
 		}
 	}
+}
 
-	UpdateTree();
+/// <summary>
+/// Re-queues the given moved entity for insertion if its collider is no longer enclosed by the region of its node
+/// </summary>
+/// <param name="pEntity">Given entity</param>
+/// <param name="pTransform">Transform of the entity</param>
+/// <param name="pBox">Box collider of the entity, nullptr if the entity has none</param>
+/// <param name="pSphere">Sphere collider of the entity, nullptr if the entity has none</param>
+void CollisionCheckSystem::RequeueMovedEntity(const EntityHandle pEntity, const Transform& pTransform, const BoxCollider* const pBox, const SphereCollider* const pSphere)
+{
+	//If the entity is already in the tree
+	OctTreeNode* const node = mEntityNodeMap[pEntity.Index()];
+	if (!node)
+	{
+		return;
+	}
+
+	//If the entity has a box collider and is no longer within it's enclosed region, remove it and re-insert it into the tree
+	if (pBox && !BoxInsideRegion(node, pBox))
+	{
+		mEntitiesToRemove.push(pEntity);
+		mEntitiesToInsert.push(pEntity);
+	}
 
-	HandleCollisions(mOctTree, std::vector<unsigned short>{});
+	//If the entity has a sphere collider and is no longer within it's enclosed region, remove it and re-insert it into the tree
+	if (pSphere && !SphereInsideRegion(node, pTransform.translation, pSphere))
+	{
+		mEntitiesToRemove.push(pEntity);
+		mEntitiesToInsert.push(pEntity);
+	}
 }
 
 /// <summary>
@@ -201,15 +259,17 @@ void CollisionCheckSystem::UpdateTree()
 	//Process the removal queue until it's empty
 	while (!mEntitiesToRemove.empty())
 	{
+		const unsigned int index = mEntitiesToRemove.front().Index();
+
 		//Get the node of the entity to remove from the entity node map, then remove the entity from that nodes entity list
-		if (mEntityNodeMap[mEntitiesToRemove.front()])
+		if (mEntityNodeMap[index])
 		{
-			std::vector<unsigned short>* nodeEntities = &mEntityNodeMap[mEntitiesToRemove.front()]->entities;
+			std::vector<EntityHandle>* nodeEntities = &mEntityNodeMap[index]->entities;
 			nodeEntities->erase(remove(nodeEntities->begin(), nodeEntities->end(), mEntitiesToRemove.front()), nodeEntities->end());
 		}
 
 		//Set entities node to null
-		mEntityNodeMap[mEntitiesToRemove.front()] = nullptr;
+		mEntityNodeMap[index] = nullptr;
 
 		mEntitiesToRemove.pop();
 	}
@@ -217,8 +277,12 @@ void CollisionCheckSystem::UpdateTree()
 	//Process the insertion queue until it's empty
 	while (!mEntitiesToInsert.empty())
 	{
-		//Begin insertion of entity into oct tree
-		Insert(mOctTree, mEntitiesToInsert.front());
+		//Skip entities that were destroyed or left the system after being queued
+		if (mEntities.Contains(mEntitiesToInsert.front()))
+		{
+			//Begin insertion of entity into oct tree
+			Insert(mOctTree, mEntitiesToInsert.front());
+		}
 		mEntitiesToInsert.pop();
 	}
 }
@@ -228,7 +292,7 @@ void CollisionCheckSystem::UpdateTree()
 /// </summary>
 /// <param name="pNode">Given node to insert entity into</param>
 /// <param name="pEntity">Given entity to insert</param>
-void CollisionCheckSystem::Insert(OctTreeNode * const pNode, const unsigned short pEntity)
+void CollisionCheckSystem::Insert(OctTreeNode * const pNode, const EntityHandle pEntity)
 {
 	//Loop through children and see if any children enclose the entities collider
 	for (auto& child : pNode->children)
@@ -237,13 +301,13 @@ void CollisionCheckSystem::Insert(OctTreeNode * const pNode, const unsigned shor
 		if (child)
 		{
 			//If the entity has a box collider and the collider is enclosed within the region, begin looping on the childs children to see if any of those enclose the collider
-			if (mEcsManager->BoxColliderComp(pEntity) && BoxInsideRegion(child, pEntity))
+			if (mEcsManager->Read<BoxCollider>(pEntity) && BoxInsideRegion(child, mEcsManager->Read<BoxCollider>(pEntity)))
 			{
 				Insert(child, pEntity);
 				return;
 			}
 			//If the entity has a sphere collider and the collider is enclosed within the region, begin looping on the childs children to see if any of those enclose the collider
-			if (mEcsManager->SphereColliderComp(pEntity) && SphereInsideRegion(child, pEntity))
+			if (mEcsManager->Read<SphereCollider>(pEntity) && SphereInsideRegion(child, mEcsManager->Read<Transform>(pEntity)->translation, mEcsManager->Read<SphereCollider>(pEntity)))
 			{
 				Insert(child, pEntity);
 				return;
@@ -253,39 +317,44 @@ void CollisionCheckSystem::Insert(OctTreeNode * const pNode, const unsigned shor
 
 	//Add entity to node
 	pNode->entities.push_back(pEntity);
-	mEntityNodeMap[pEntity] = pNode;
+	mEntityNodeMap[pEntity.Index()] = pNode;
 	return;
 }
 
 /// <summary>
 /// Calculates collisions for the given node, then recursively calls itself on the children of the given node
+/// Disabled entities stay in the tree but never collide
 /// </summary>
 /// <param name="pNode">Given node to calculate collisions for</param>
-/// <param name="pParentEntities">The entities contained within all of the parent nodes in this branch</param>
-void CollisionCheckSystem::HandleCollisions(OctTreeNode * const pNode, std::vector<unsigned short> pParentEntities)
+/// <param name="pParentEntities">The enabled entities contained within all of the parent nodes in this branch</param>
+void CollisionCheckSystem::HandleCollisions(OctTreeNode * const pNode, std::vector<EntityHandle> pParentEntities)
 {
+	//Only the enabled entities of this node are checked, they are added to the parent entities list for the children of this node
+	const size_t parentCount = pParentEntities.size();
+	for (const auto& entity : pNode->entities)
+	{
+		if (mEcsManager->IsEnabled(entity))
+		{
+			pParentEntities.push_back(entity);
+		}
+	}
+
 	//Loop through entities in this node
-	for (int i = 0; i < pNode->entities.size(); i++)
+	for (size_t i = parentCount; i < pParentEntities.size(); i++)
 	{
 		//Check for collisions with other entities in this node
-		for (int j = i + 1; j < pNode->entities.size(); j++)
+		for (size_t j = i + 1; j < pParentEntities.size(); j++)
 		{
-			CollisionBetweenEntities(pNode->entities[i], pNode->entities[j]);
+			CollisionBetweenEntities(pParentEntities[i], pParentEntities[j]);
 		}
 
 		//Check for collision with entities in the parent nodes
-		for (const auto& parentEntity : pParentEntities)
+		for (size_t j = 0; j < parentCount; j++)
 		{
-			CollisionBetweenEntities(pNode->entities[i], parentEntity);
+			CollisionBetweenEntities(pParentEntities[i], pParentEntities[j]);
 		}
 	}
 
-	//Add this nodes entities to the parent entities list
-	for (const auto& entity : pNode->entities)
-	{
-		pParentEntities.push_back(entity);
-	}
-
 	//Loop through children of node
 	for (auto& child : pNode->children)
 	{
@@ -300,87 +369,75 @@ void CollisionCheckSystem::HandleCollisions(OctTreeNode * const pNode, std::vect
 }
 
 /// <summary>
-/// Checks for a collision between two given entities and adds a collision component if a collision is found
+/// Checks for a collision between two given entities and records a contact if a collision is found
 /// </summary>
 /// <param name="pEntityA">Given entity A</param>
 /// <param name="pEntityB">Given entity B</param>
-void CollisionCheckSystem::CollisionBetweenEntities(const unsigned short pEntityA, const unsigned short pEntityB)
+void CollisionCheckSystem::CollisionBetweenEntities(const EntityHandle pEntityA, const EntityHandle pEntityB)
 {
 	//If entity A has box collider
-	if (mEcsManager->BoxColliderComp(pEntityA))
+	if (mEcsManager->Read<BoxCollider>(pEntityA))
 	{
 		//If entity B has box collider
-		if (mEcsManager->BoxColliderComp(pEntityB))
+		if (mEcsManager->Read<BoxCollider>(pEntityB))
 		{
 			//If A's ignored collision mask contains B's collision mask then return as this collision will be ignored
-			if ((mEcsManager->BoxColliderComp(pEntityA)->ignoreCollisionMask & mEcsManager->BoxColliderComp(pEntityB)->collisionMask)
-				== mEcsManager->BoxColliderComp(pEntityB)->collisionMask)
+			if ((mEcsManager->Read<BoxCollider>(pEntityA)->ignoreCollisionMask & mEcsManager->Read<BoxCollider>(pEntityB)->collisionMask)
+				== mEcsManager->Read<BoxCollider>(pEntityB)->collisionMask)
 			{
 				return;
 			}
 
 			//If the entities have collided
-			if (BoxBox(mEcsManager->BoxColliderComp(pEntityA), mEcsManager->BoxColliderComp(pEntityB)))
+			if (BoxBox(mEcsManager->Read<BoxCollider>(pEntityA), mEcsManager->Read<BoxCollider>(pEntityB)))
 			{
-				//Add collision component to entities
-				if (!mEcsManager->CollisionComp(pEntityA))
-					mEcsManager->AddCollisionComp(Collision{ pEntityB, mEcsManager->BoxColliderComp(pEntityB)->collisionMask }, pEntityA);
-
-				if (!mEcsManager->CollisionComp(pEntityB))
-					mEcsManager->AddCollisionComp(Collision{ pEntityA, mEcsManager->BoxColliderComp(pEntityA)->collisionMask }, pEntityB);
+				//Record the contact between the entities
+				AddContact(pEntityA, mEcsManager->Read<BoxCollider>(pEntityA)->collisionMask, pEntityB, mEcsManager->Read<BoxCollider>(pEntityB)->collisionMask);
 				return;
 			}
 
 		}
 
 		//If entity j has sphere collider
-		if (mEcsManager->SphereColliderComp(pEntityB))
+		if (mEcsManager->Read<SphereCollider>(pEntityB))
 		{
 			//If i's ignored collision mask contains j's collision mask then return as this collision will be ignored
-			if ((mEcsManager->BoxColliderComp(pEntityA)->ignoreCollisionMask & mEcsManager->SphereColliderComp(pEntityB)->collisionMask)
-				== mEcsManager->SphereColliderComp(pEntityB)->collisionMask)
+			if ((mEcsManager->Read<BoxCollider>(pEntityA)->ignoreCollisionMask & mEcsManager->Read<SphereCollider>(pEntityB)->collisionMask)
+				== mEcsManager->Read<SphereCollider>(pEntityB)->collisionMask)
 			{
 				return;
 			}
 
 			//If the entities have collided
-			if (BoxSphere(mEcsManager->BoxColliderComp(pEntityA), mEcsManager->TransformComp(pEntityB)->translation.XYZ(),
-				mEcsManager->SphereColliderComp(pEntityB)))
+			if (BoxSphere(mEcsManager->Read<BoxCollider>(pEntityA), mEcsManager->Read<Transform>(pEntityB)->translation.XYZ(),
+				mEcsManager->Read<SphereCollider>(pEntityB)))
 			{
-				//Add collision component to entities
-				if (!mEcsManager->CollisionComp(pEntityA))
-					mEcsManager->AddCollisionComp(Collision{ pEntityB, mEcsManager->SphereColliderComp(pEntityB)->collisionMask }, pEntityA);
-
-				if (!mEcsManager->CollisionComp(pEntityB))
-					mEcsManager->AddCollisionComp(Collision{ pEntityA, mEcsManager->BoxColliderComp(pEntityA)->collisionMask }, pEntityB);
+				//Record the contact between the entities
+				AddContact(pEntityA, mEcsManager->Read<BoxCollider>(pEntityA)->collisionMask, pEntityB, mEcsManager->Read<SphereCollider>(pEntityB)->collisionMask);
 				return;
 			}
 		}
 	}
 
 	//If entity i has sphere collider
-	if (mEcsManager->SphereColliderComp(pEntityA))
+	if (mEcsManager->Read<SphereCollider>(pEntityA))
 	{
 		//If entity j has sphere collider
-		if (mEcsManager->SphereColliderComp(pEntityB))
+		if (mEcsManager->Read<SphereCollider>(pEntityB))
 		{
 			//If i's ignored collision mask contains j's collision mask then return as this collision will be ignored
-			if ((mEcsManager->SphereColliderComp(pEntityA)->ignoreCollisionMask & mEcsManager->SphereColliderComp(pEntityB)->collisionMask)
-				== mEcsManager->SphereColliderComp(pEntityB)->collisionMask)
+			if ((mEcsManager->Read<SphereCollider>(pEntityA)->ignoreCollisionMask & mEcsManager->Read<SphereCollider>(pEntityB)->collisionMask)
+				== mEcsManager->Read<SphereCollider>(pEntityB)->collisionMask)
 			{
 				return;
 			}
 
 			//If the entities have collided
-			if (SphereSphere(mEcsManager->TransformComp(pEntityA)->translation.XYZ(), mEcsManager->SphereColliderComp(pEntityA),
-				mEcsManager->TransformComp(pEntityB)->translation.XYZ(), mEcsManager->SphereColliderComp(pEntityB)))
+			if (SphereSphere(mEcsManager->Read<Transform>(pEntityA)->translation.XYZ(), mEcsManager->Read<SphereCollider>(pEntityA),
+				mEcsManager->Read<Transform>(pEntityB)->translation.XYZ(), mEcsManager->Read<SphereCollider>(pEntityB)))
 			{
-				//Add collision component to entities
-				if (!mEcsManager->CollisionComp(pEntityA))
-					mEcsManager->AddCollisionComp(Collision{ pEntityB, mEcsManager->SphereColliderComp(pEntityB)->collisionMask }, pEntityA);
-
-				if (!mEcsManager->CollisionComp(pEntityB))
-					mEcsManager->AddCollisionComp(Collision{ pEntityA, mEcsManager->SphereColliderComp(pEntityA)->collisionMask }, pEntityB);
+				//Record the contact between the entities
+				AddContact(pEntityA, mEcsManager->Read<SphereCollider>(pEntityA)->collisionMask, pEntityB, mEcsManager->Read<SphereCollider>(pEntityB)->collisionMask);
 				return;
 			}
 		}
@@ -394,7 +451,7 @@ void CollisionCheckSystem::CollisionBetweenEntities(const unsigned short pEntity
 /// </summary>
 bool CollisionCheckSystem::RaySphere()
 {
-	return E_NOTIMPL;
+	return false;
 }
 
 /// <summary>
@@ -443,26 +500,26 @@ bool CollisionCheckSystem::BoxBox(const BoxCollider* const pBoxA, const BoxColli
 /// </summary>
 bool CollisionCheckSystem::RayBox()
 {
-	return E_NOTIMPL;
+	return false;
 }
 
 /// <summary>
 /// Calculates whether or not an AABB is completely enclosed by a given region
 /// </summary>
 /// <param name="pNode">Node containing the given region</param>
-/// <param name="pEntity">Entity that owns the given AABB</param>
+/// <param name="pBox">Given AABB</param>
 /// <returns>bool representing whether it is enclosed or not</returns>
-bool CollisionCheckSystem::BoxInsideRegion(OctTreeNode * const pNode, const unsigned short pEntity) const
+bool CollisionCheckSystem::BoxInsideRegion(OctTreeNode * const pNode, const BoxCollider* const pBox) const
 {
 	return (//If the min bounds of the box are greater than the min bounds of the region
-		mEcsManager->BoxColliderComp(pEntity)->minBounds.X > pNode->minBounds.X &&
-		mEcsManager->BoxColliderComp(pEntity)->minBounds.Y > pNode->minBounds.Y &&
-		mEcsManager->BoxColliderComp(pEntity)->minBounds.Z > pNode->minBounds.Z &&
+		pBox->minBounds.X > pNode->minBounds.X &&
+		pBox->minBounds.Y > pNode->minBounds.Y &&
+		pBox->minBounds.Z > pNode->minBounds.Z &&
 
 		//If the max bounds of the box are smaller than the max bounds of the region
-		mEcsManager->BoxColliderComp(pEntity)->maxBounds.X < pNode->maxBounds.X &&
-		mEcsManager->BoxColliderComp(pEntity)->maxBounds.Y < pNode->maxBounds.Y &&
-		mEcsManager->BoxColliderComp(pEntity)->maxBounds.Z < pNode->maxBounds.Z
+		pBox->maxBounds.X < pNode->maxBounds.X &&
+		pBox->maxBounds.Y < pNode->maxBounds.Y &&
+		pBox->maxBounds.Z < pNode->maxBounds.Z
 		);
 }
 
@@ -470,18 +527,19 @@ bool CollisionCheckSystem::BoxInsideRegion(OctTreeNode * const pNode, const unsi
 /// Calculates whether or not a sphere is completely enclosed by a given region
 /// </summary>
 /// <param name="pNode">Node containing the given region</param>
-/// <param name="pEntity">Entity that owns the given sphere collider</param>
+/// <param name="pSpherePos">Position of the sphere</param>
+/// <param name="pSphere">Given sphere collider</param>
 /// <returns>bool representing whether it is enclosed or not</returns>
-bool CollisionCheckSystem::SphereInsideRegion(OctTreeNode * const pNode, const unsigned short pEntity) const
+bool CollisionCheckSystem::SphereInsideRegion(OctTreeNode * const pNode, const Vector4& pSpherePos, const SphereCollider* const pSphere) const
 {
 	return (//If the min bounds of the sphere are greater than the min bounds of the region
-		mEcsManager->TransformComp(pEntity)->translation.X - mEcsManager->SphereColliderComp(pEntity)->radius > pNode->minBounds.X &&
-		mEcsManager->TransformComp(pEntity)->translation.Y - mEcsManager->SphereColliderComp(pEntity)->radius > pNode->minBounds.Y &&
-		mEcsManager->TransformComp(pEntity)->translation.Z - mEcsManager->SphereColliderComp(pEntity)->radius > pNode->minBounds.Z &&
+		pSpherePos.X - pSphere->radius > pNode->minBounds.X &&
+		pSpherePos.Y - pSphere->radius > pNode->minBounds.Y &&
+		pSpherePos.Z - pSphere->radius > pNode->minBounds.Z &&
 
 		//If the max bounds of the sphere are smaller than the max bounds of the region
-		mEcsManager->TransformComp(pEntity)->translation.X + mEcsManager->SphereColliderComp(pEntity)->radius < pNode->maxBounds.X &&
-		mEcsManager->TransformComp(pEntity)->translation.Y + mEcsManager->SphereColliderComp(pEntity)->radius < pNode->maxBounds.Y &&
-		mEcsManager->TransformComp(pEntity)->translation.Z + mEcsManager->SphereColliderComp(pEntity)->radius < pNode->maxBounds.Z
+		pSpherePos.X + pSphere->radius < pNode->maxBounds.X &&
+		pSpherePos.Y + pSphere->radius < pNode->maxBounds.Y &&
+		pSpherePos.Z + pSphere->radius < pNode->maxBounds.Z
 		);
-}
+}
\ No newline at end of file
@@ -2,12 +2,13 @@
 
 /// <summary>
 /// Constructor
-/// Initialises entity vector to max entities size
+/// Reads gravity and writes the transform, velocity and box collider of moving entities
 /// </summary>
 MovementSystem::MovementSystem() 
-	: ISystem(std::vector<int>{ComponentType::COMPONENT_TRANSFORM | ComponentType::COMPONENT_VELOCITY})
+	: IParallelSystem(std::vector<ComponentMask>{ComponentType::COMPONENT_TRANSFORM | ComponentType::COMPONENT_VELOCITY},
+		ComponentType::COMPONENT_TRANSFORM | ComponentType::COMPONENT_VELOCITY | ComponentType::COMPONENT_BOXCOLLIDER | ComponentType::COMPONENT_GRAVITY,
+		ComponentType::COMPONENT_TRANSFORM | ComponentType::COMPONENT_VELOCITY | ComponentType::COMPONENT_BOXCOLLIDER)
 {
-	mEntities = std::vector<Entity>(mEcsManager->MaxEntities(), Entity{ -1, ComponentType::COMPONENT_NONE });
 }
 
 /// <summary>
@@ -18,36 +19,138 @@ MovementSystem::~MovementSystem()
 }
 
 /// <summary>
-/// Assigns entity to system if the entities mask matches the system mask
+/// Adds the entity to the system when it starts matching the movement mask
 /// </summary>
-/// <param name="pEntity">Entity to be assigned</param>
-void MovementSystem::AssignEntity(const Entity & pEntity)
+/// <param name="pEntity">Entity that entered the system</param>
+/// <param name="pMaskIndex">Index of the mask the entity now matches</param>
+void MovementSystem::OnEnter(const Entity & pEntity, const int pMaskIndex)
 {
-	//Checks if entity mask matches the movement mask
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0])
+	mEntities.Add(pEntity);
+}
+
+/// <summary>
+/// Removes the entity from the system when it stops matching the movement mask
+/// </summary>
+/// <param name="pEntity">Entity that exited the system</param>
+/// <param name="pMaskIndex">Index of the mask the entity no longer matches</param>
+void MovementSystem::OnExit(const Entity & pEntity, const int pMaskIndex)
+{
+	mEntities.Remove(pEntity.ID);
+}
+
+/// <summary>
+/// Calculates the velocity of a single entity by applying its acceleration as well as acceleration of gravity
+/// Applies velocity to the entities transform
+/// </summary>
+/// <param name="pTransform">Transform of the entity</param>
+/// <param name="pVelocity">Velocity of the entity</param>
+/// <param name="pGravity">Whether the entity is affected by gravity</param>
+/// <param name="pDeltaTime">Delta time of the frame</param>
+/// <returns>Displacement applied to the entity this frame</returns>
+KodeboldsMath::Vector3 MovementSystem::Move(Transform& pTransform, Velocity& pVelocity, const bool pGravity, const float pDeltaTime) const
+{
+	if (pGravity)
+	{
+		//Modify velocity by gravity acceleration
+		pVelocity.velocity.Y += mGravityAccel * pDeltaTime;
+	}
+
+	//Modify velocity by acceleration
+	pVelocity.velocity += pVelocity.acceleration * pDeltaTime;
+
+	//Clamp velocity magnitude to max speed of entity
+	if (pVelocity.velocity.Magnitude() > pVelocity.maxSpeed)
 	{
-		//Update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
+		pVelocity.velocity.Clamp(pVelocity.maxSpeed);
 	}
+
+	//Stationary entities are left untouched so they aren't reported as changed
+	KodeboldsMath::Vector4 displacement = pVelocity.velocity * pDeltaTime;
+	if (!(displacement.XYZ().Magnitude() > 0))
+	{
+		return KodeboldsMath::Vector3();
+	}
+
+	//Modify translation and transform by velocity
+	pTransform.translation += displacement;
+	pTransform.transform *= KodeboldsMath::TranslationMatrix(displacement);
+	return displacement.XYZ();
 }
 
 /// <summary>
-/// Re-assigns entity to system when component is removed from entity
+/// Moves the bounds of the given box collider by the given displacement
 /// </summary>
-/// <param name="pEntity">Entity to re-assign</param>
-void MovementSystem::ReAssignEntity(const Entity & pEntity)
+/// <param name="pBoxCollider">Box collider of the entity</param>
+/// <param name="pDisplacement">Displacement applied to the entity this frame</param>
+void MovementSystem::MoveBounds(BoxCollider& pBoxCollider, const KodeboldsMath::Vector3& pDisplacement) const
 {
-	//Checks if entity mask matches the movement mask
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0])
+	pBoxCollider.minBounds += pDisplacement;
+	pBoxCollider.maxBounds += pDisplacement;
+}
+
+/// <summary>
+/// Moves every entity in a single chunk of an archetype matching the movement mask
+/// Walks the transform, velocity and box collider columns of the chunk directly, marking the transforms and box colliders of entities that moved as changed
+/// </summary>
+/// <param name="pArchetype">Archetype that owns the chunk</param>
+/// <param name="pChunk">Index of the chunk in the archetype</param>
+/// <param name="pDeltaTime">Delta time of the frame</param>
+void MovementSystem::ProcessChunk(const Archetype& pArchetype, const int pChunk, const float pDeltaTime) const
+{
+	const bool gravity = pArchetype.Matches(ComponentType::COMPONENT_GRAVITY);
+
+	const int* const entities = pArchetype.ChunkEntities(pChunk);
+	Transform* const transforms = pArchetype.ChunkColumn<Transform>(pChunk, ComponentType::COMPONENT_TRANSFORM);
+	Velocity* const velocities = pArchetype.ChunkColumn<Velocity>(pChunk, ComponentType::COMPONENT_VELOCITY);
+	BoxCollider* const boxColliders = pArchetype.ChunkColumn<BoxCollider>(pChunk, ComponentType::COMPONENT_BOXCOLLIDER);
+	const int entityCount = pArchetype.ChunkEntityCount(pChunk);
+
+	for (int i = 0; i < entityCount; i++)
 	{
-		//If the entity matches movement mask then update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
+		const KodeboldsMath::Vector3 displacement = Move(transforms[i], velocities[i], gravity, pDeltaTime);
+		if (!(displacement.Magnitude() > 0))
+		{
+			continue;
+		}
+
+		const EntityHandle entity = mEcsManager->Handle(entities[i]);
+		mEcsManager->MarkChanged<Transform>(entity);
+		if (boxColliders)
+		{
+			MoveBounds(boxColliders[i], displacement);
+			mEcsManager->MarkChanged<BoxCollider>(entity);
+		}
 	}
-	else
+}
+
+/// <summary>
+/// Moves every entity stored in the archetypes matching the movement mask
+/// The chunks of every matching archetype are split across the workers
+/// </summary>
+/// <param name="pDeltaTime">Delta time of the frame</param>
+void MovementSystem::ProcessChunks(const float pDeltaTime)
+{
+	mChunks.clear();
+	for (const auto& archetype : mEcsManager->Archetypes())
 	{
-		//If the mask doesn't match then set ID to -1
-		mEntities[pEntity.ID].ID = -1;
+		if (!archetype->Matches(mMasks[0].BuiltIn()))
+		{
+			continue;
+		}
+
+		for (int chunk = 0; chunk < archetype->ChunkCount(); chunk++)
+		{
+			mChunks.emplace_back(archetype, chunk);
+		}
 	}
+
+	mThreadManager->ParallelFor(0, static_cast<int>(mChunks.size()), mChunkGrainSize, [this, pDeltaTime](const int pBegin, const int pEnd)
+	{
+		for (int i = pBegin; i < pEnd; i++)
+		{
+			ProcessChunk(*mChunks[i].first, mChunks[i].second, pDeltaTime);
+		}
+	});
 }
 
 /// <summary>
@@ -57,36 +160,31 @@ void MovementSystem::ReAssignEntity(const Entity & pEntity)
 /// </summary>
 void MovementSystem::Process()
 {
-	for (const Entity& entity : mEntities)
+	const float deltaTime = static_cast<float>(mSceneManager->DeltaTime());
+
+	if (mEcsManager->Storage() == StorageMode::ARCHETYPE)
 	{
-		if (entity.ID != -1)
+		ProcessChunks(deltaTime);
+		return;
+	}
+
+	//Each entity only writes to its own components, so the entities are split across the workers
+	ParallelForEach(mEcsManager->View<Transform, Velocity>(), [this, deltaTime](const EntityHandle pEntity, Transform& pTransform, Velocity& pVelocity)
+	{
+		//Check if entity has gravity component
+		const bool gravity = mEcsManager->Read<Gravity>(pEntity) != nullptr;
+
+		const KodeboldsMath::Vector3 displacement = Move(pTransform, pVelocity, gravity, deltaTime);
+		if (!(displacement.Magnitude() > 0))
 		{
-			//Check if entity has gravity component
-			if ((entity.componentMask & ComponentType::COMPONENT_GRAVITY) == ComponentType::COMPONENT_GRAVITY)
-			{
-				//Modify velocity by gravity acceleration
-				mEcsManager->VelocityComp(entity.ID)->velocity.Y += mGravityAccel * static_cast<float>(mSceneManager->DeltaTime());
-			}
-
-			//Modify velocity by acceleration
-			mEcsManager->VelocityComp(entity.ID)->velocity += mEcsManager->VelocityComp(entity.ID)->acceleration * static_cast<float>(mSceneManager->DeltaTime());
-
-			//Clamp velocity magnitude to max speed of entity
-			if (mEcsManager->VelocityComp(entity.ID)->velocity.Magnitude() > mEcsManager->VelocityComp(entity.ID)->maxSpeed)
-			{
-				mEcsManager->VelocityComp(entity.ID)->velocity.Clamp(mEcsManager->VelocityComp(entity.ID)->maxSpeed);
-			}
-
-			//Modify translation and transform by velocity
-			mEcsManager->TransformComp(entity.ID)->translation += mEcsManager->VelocityComp(entity.ID)->velocity * static_cast<float>(mSceneManager->DeltaTime());
-			mEcsManager->TransformComp(entity.ID)->transform *= KodeboldsMath::TranslationMatrix(mEcsManager->VelocityComp(entity.ID)->velocity * static_cast<float>(mSceneManager->DeltaTime()));
-
-			//Modify the entities box collider bounds
-			if (mEcsManager->BoxColliderComp(entity.ID))
-			{
-				mEcsManager->BoxColliderComp(entity.ID)->minBounds += (mEcsManager->VelocityComp(entity.ID)->velocity * static_cast<float>(mSceneManager->DeltaTime())).XYZ();
-				mEcsManager->BoxColliderComp(entity.ID)->maxBounds += (mEcsManager->VelocityComp(entity.ID)->velocity * static_cast<float>(mSceneManager->DeltaTime())).XYZ();
-			}
+			return;
 		}
-	}
+
+		//Modifiable access records the change to the box collider
+		mEcsManager->MarkChanged<Transform>(pEntity);
+		if (BoxCollider* const boxCollider = mEcsManager->BoxColliderComp(pEntity))
+		{
+			MoveBounds(*boxCollider, displacement);
+		}
+	});
 }
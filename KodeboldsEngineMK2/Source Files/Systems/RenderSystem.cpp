@@ -2,12 +2,355 @@
 
 /// <summary>
 /// Constructor
-/// Initialises entity vector to max entities size
 /// </summary>
 /// <param name="pMasks">Masks for the system</param>
 /// <param name="pMaxPointLights">The maximum number of point lights for the renderer</param>
 /// <param name="pMaxDirLights">The maximum number of directional lights for the renderer</param>
-RenderSystem::RenderSystem(const std::vector<int>& pMasks, const int pMaxPointLights, const int pMaxDirLights) : ISystem(pMasks),  mMaxPointLights(pMaxPointLights), mMaxDirLights(pMaxDirLights)
+RenderSystem::RenderSystem(const std::vector<ComponentMask>& pMasks, const int pMaxPointLights, const int pMaxDirLights) : ISystem(pMasks),  mMaxPointLights(pMaxPointLights), mMaxDirLights(pMaxDirLights),
+	mFrame(nullptr), mLastVersion(0)
 {
-	mEntities = std::vector<Entity>(mEcsManager->MaxEntities(), Entity{ -1, ComponentType::COMPONENT_NONE });
-}
\ No newline at end of file
+}
+
+/// <summary>
+/// Adds the entity to the renderable, point light, directional light or camera list when it starts matching the corresponding mask
+/// </summary>
+/// <param name="pEntity">Entity that entered the system</param>
+/// <param name="pMaskIndex">Index of the mask the entity now matches</param>
+void RenderSystem::OnEnter(const Entity& pEntity, const int pMaskIndex)
+{
+	//The entity index may have been used by an entity with a different material and transform
+	if (pEntity.ID.Index() < mHasPreviousTransforms.size())
+	{
+		mHasPreviousTransforms[pEntity.ID.Index()] = false;
+	}
+
+	if (pMaskIndex == 0)
+	{
+		mEntities.Add(pEntity);
+
+		if (pEntity.ID.Index() < mEntityMaterials.size())
+		{
+			mEntityMaterials[pEntity.ID.Index()] = -1;
+		}
+	}
+	else if (pMaskIndex == 1)
+	{
+		mPointLights.push_back(pEntity);
+	}
+	else if (pMaskIndex == 2)
+	{
+		mDirectionalLights.push_back(pEntity);
+	}
+	else
+	{
+		mCameras.push_back(pEntity);
+	}
+}
+
+/// <summary>
+/// Removes the entity from the renderable, point light, directional light or camera list when it stops matching the corresponding mask
+/// </summary>
+/// <param name="pEntity">Entity that exited the system</param>
+/// <param name="pMaskIndex">Index of the mask the entity no longer matches</param>
+void RenderSystem::OnExit(const Entity& pEntity, const int pMaskIndex)
+{
+	const auto matchesID = [&](const Entity & pEntity2) {return pEntity2.ID == pEntity.ID; };
+
+	if (pMaskIndex == 0)
+	{
+		mEntities.Remove(pEntity.ID);
+	}
+	else if (pMaskIndex == 1)
+	{
+		mPointLights.erase(remove_if(mPointLights.begin(), mPointLights.end(), matchesID), mPointLights.end());
+	}
+	else if (pMaskIndex == 2)
+	{
+		mDirectionalLights.erase(remove_if(mDirectionalLights.begin(), mDirectionalLights.end(), matchesID), mDirectionalLights.end());
+	}
+	else
+	{
+		mCameras.erase(remove_if(mCameras.begin(), mCameras.end(), matchesID), mCameras.end());
+	}
+}
+
+/// <summary>
+/// Forgets the material key of every entity whose geometry, shader or texture has changed since the last extraction
+/// </summary>
+void RenderSystem::InvalidateMaterials()
+{
+	const auto invalidate = [this](const EntityHandle pEntityID)
+	{
+		if (pEntityID.Index() < mEntityMaterials.size())
+		{
+			mEntityMaterials[pEntityID.Index()] = -1;
+		}
+	};
+
+	mEcsManager->View<Geometry>().Changed<Geometry>(mLastVersion).ForEach([&](const EntityHandle pEntityID, Geometry&) { invalidate(pEntityID); });
+	mEcsManager->View<Shader>().Changed<Shader>(mLastVersion).ForEach([&](const EntityHandle pEntityID, Shader&) { invalidate(pEntityID); });
+	mEcsManager->View<Texture>().Changed<Texture>(mLastVersion).ForEach([&](const EntityHandle pEntityID, Texture&) { invalidate(pEntityID); });
+}
+
+/// <summary>
+/// Finds the material key of the given renderable entity, adding a new material if no existing material matches its geometry, shader and texture
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+/// <returns>Index of the entities material in the material list</returns>
+int RenderSystem::MaterialKey(const EntityHandle pEntityID)
+{
+	const unsigned int index = pEntityID.Index();
+	if (index >= mEntityMaterials.size())
+	{
+		mEntityMaterials.resize(index + 1, -1);
+	}
+
+	//Removing a texture isn't recorded as a change, so the cached key is also checked against whether the entity still has one
+	const Texture* const texture = mEcsManager->Read<Texture>(pEntityID);
+	int& key = mEntityMaterials[index];
+	if (key != -1 && mMaterials[key].hasTexture == (texture != nullptr))
+	{
+		return key;
+	}
+
+	const Geometry* const geometry = mEcsManager->Read<Geometry>(pEntityID);
+	const Shader* const shader = mEcsManager->Read<Shader>(pEntityID);
+
+	//Materials rarely change, so a linear search over the few unique materials is cheaper than hashing them, and resource names compare as interned handles
+	for (int i = 0; i < static_cast<int>(mMaterials.size()); ++i)
+	{
+		const RenderMaterial& material = mMaterials[i];
+		if (material.geometry.filename == geometry->filename
+			&& material.shader.filename == shader->filename
+			&& material.shader.blendState == shader->blendState
+			&& material.shader.cullState == shader->cullState
+			&& material.shader.depthState == shader->depthState
+			&& material.shader.renderTargets == shader->renderTargets
+			&& material.shader.renderToScreen == shader->renderToScreen
+			&& material.hasTexture == (texture != nullptr)
+			&& (!texture || (material.texture.diffuse == texture->diffuse && material.texture.normal == texture->normal && material.texture.height == texture->height)))
+		{
+			key = i;
+			return key;
+		}
+	}
+
+	mMaterials.push_back(RenderMaterial{ *geometry, *shader, texture ? *texture : Texture{}, texture != nullptr });
+	key = static_cast<int>(mMaterials.size()) - 1;
+	return key;
+}
+
+/// <summary>
+/// Records the transform of the given entity as the state the next extracted frame blends from
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+void RenderSystem::RecordPreviousTransform(const EntityHandle pEntityID)
+{
+	const unsigned int index = pEntityID.Index();
+	if (index >= mHasPreviousTransforms.size())
+	{
+		mPreviousTransforms.resize(index + 1);
+		mHasPreviousTransforms.resize(index + 1, false);
+	}
+	mPreviousTransforms[index] = *mEcsManager->Read<Transform>(pEntityID);
+	mHasPreviousTransforms[index] = true;
+}
+
+/// <summary>
+/// Finds the transform the given entity had before the last simulation step
+/// </summary>
+/// <param name="pEntityID">Given ID of the entity</param>
+/// <param name="pTransform">Current transform of the entity</param>
+/// <returns>Recorded transform, or the current transform if the entity entered the system after the last record</returns>
+const Transform& RenderSystem::PreviousTransform(const EntityHandle pEntityID, const Transform& pTransform) const
+{
+	const unsigned int index = pEntityID.Index();
+	if (index < mHasPreviousTransforms.size() && mHasPreviousTransforms[index])
+	{
+		return mPreviousTransforms[index];
+	}
+	return pTransform;
+}
+
+/// <summary>
+/// Records the transform of every renderable entity, camera and light before the last simulation step of the frame runs
+/// Extract pairs these with the transforms after the step, so the frame is blended between the last two steps however many steps the frame ran
+/// </summary>
+void RenderSystem::BeforeFinalStep()
+{
+	for (const Entity& entity : mEntities)
+	{
+		RecordPreviousTransform(entity.ID);
+	}
+	for (const Entity& camera : mCameras)
+	{
+		RecordPreviousTransform(camera.ID);
+	}
+	for (const Entity& light : mPointLights)
+	{
+		RecordPreviousTransform(light.ID);
+	}
+	for (const Entity& light : mDirectionalLights)
+	{
+		RecordPreviousTransform(light.ID);
+	}
+}
+
+/// <summary>
+/// Copies the world matrix, colour and material key of every renderable entity, as well as the cameras and lights, into the render frame of the given context
+/// Only called on the main thread once the renderer has finished with the context, so the render thread never reads components that update systems are writing
+/// </summary>
+/// <param name="pFrame">Context of the frame being extracted</param>
+void RenderSystem::Extract(FrameContext& pFrame)
+{
+	RenderFrame& frame = pFrame.renderFrame;
+
+	InvalidateMaterials();
+
+	//Enabled renderable entities, in the order they entered the system
+	//The items are allocated from the frame allocator with room for every renderable entity, as the allocator was reset when the context was reused
+	frame.items.data = pFrame.allocator.Allocate<RenderItem>(mEntities.Size());
+	frame.items.count = 0;
+	for (const Entity& entity : mEntities)
+	{
+		if (!mEcsManager->IsEnabled(entity.ID))
+		{
+			continue;
+		}
+
+		const int material = MaterialKey(entity.ID);
+		const Colour* const colour = mEcsManager->Read<Colour>(entity.ID);
+		const Transform* const transform = mEcsManager->Read<Transform>(entity.ID);
+
+		frame.items[frame.items.count++] = RenderItem{ transform->transform, PreviousTransform(entity.ID, *transform).transform, colour ? colour->mColour : KodeboldsMath::Vector4(0, 0, 0, 0), material };
+	}
+
+	//Materials are only ever appended, so the frame only needs the ones added since it was last extracted
+	frame.materials.insert(frame.materials.end(), mMaterials.begin() + frame.materials.size(), mMaterials.end());
+
+	//Cameras and lights are assigned in place so their vectors keep their capacity between frames
+	//Disabled cameras and lights are skipped, so each vector is trimmed to the number assigned once it has been filled
+	int count = 0;
+	frame.cameras.resize(mCameras.size());
+	for (const Entity& camera : mCameras)
+	{
+		if (!mEcsManager->IsEnabled(camera.ID))
+		{
+			continue;
+		}
+
+		const Transform* const transform = mEcsManager->Read<Transform>(camera.ID);
+		const Transform& previous = PreviousTransform(camera.ID, *transform);
+		frame.cameras[count].translation = transform->translation;
+		frame.cameras[count].forward = transform->forward;
+		frame.cameras[count].up = transform->up;
+		frame.cameras[count].previousTranslation = previous.translation;
+		frame.cameras[count].previousForward = previous.forward;
+		frame.cameras[count].previousUp = previous.up;
+		frame.cameras[count].camera = *mEcsManager->Read<Camera>(camera.ID);
+		count++;
+	}
+	frame.cameras.resize(count);
+
+	count = 0;
+	frame.pointLights.resize(static_cast<int>(mPointLights.size()) > mMaxPointLights ? mMaxPointLights : mPointLights.size());
+	for (int i = 0; i < static_cast<int>(mPointLights.size()) && count < static_cast<int>(frame.pointLights.size()); ++i)
+	{
+		if (!mEcsManager->IsEnabled(mPointLights[i].ID))
+		{
+			continue;
+		}
+
+		const Transform* const transform = mEcsManager->Read<Transform>(mPointLights[i].ID);
+		frame.pointLights[count].translation = transform->translation;
+		frame.pointLights[count].previousTranslation = PreviousTransform(mPointLights[i].ID, *transform).translation;
+		frame.pointLights[count].light = *mEcsManager->Read<PointLight>(mPointLights[i].ID);
+		count++;
+	}
+	frame.pointLights.resize(count);
+
+	count = 0;
+	frame.directionalLights.resize(static_cast<int>(mDirectionalLights.size()) > mMaxDirLights ? mMaxDirLights : mDirectionalLights.size());
+	for (int i = 0; i < static_cast<int>(mDirectionalLights.size()) && count < static_cast<int>(frame.directionalLights.size()); ++i)
+	{
+		if (!mEcsManager->IsEnabled(mDirectionalLights[i].ID))
+		{
+			continue;
+		}
+
+		const Transform* const transform = mEcsManager->Read<Transform>(mDirectionalLights[i].ID);
+		const Transform& previous = PreviousTransform(mDirectionalLights[i].ID, *transform);
+		frame.directionalLights[count].translation = transform->translation;
+		frame.directionalLights[count].forward = transform->forward;
+		frame.directionalLights[count].up = transform->up;
+		frame.directionalLights[count].previousTranslation = previous.translation;
+		frame.directionalLights[count].previousForward = previous.forward;
+		frame.directionalLights[count].previousUp = previous.up;
+		frame.directionalLights[count].light = *mEcsManager->Read<DirectionalLight>(mDirectionalLights[i].ID);
+		frame.directionalLights[count].camera = *mEcsManager->Read<Camera>(mDirectionalLights[i].ID);
+		count++;
+	}
+	frame.directionalLights.resize(count);
+
+	frame.time = mSceneManager->Time();
+	frame.interpolationAlpha = static_cast<float>(mSceneManager->InterpolationAlpha());
+
+	mLastVersion = mEcsManager->Version();
+}
+
+/// <summary>
+/// Draws the render frame of the given context
+/// </summary>
+/// <param name="pFrame">Context of the frame being drawn</param>
+void RenderSystem::ProcessFrame(const FrameContext& pFrame)
+{
+	mFrame = &pFrame.renderFrame;
+	Process();
+}
+
+/// <summary>
+/// Get method for the frame the render thread draws
+/// </summary>
+/// <returns>Render frame of the context being drawn</returns>
+const RenderFrame& RenderSystem::Frame() const
+{
+	return *mFrame;
+}
+
+/// <summary>
+/// Blends the world matrix of the given item from the previous simulation step to the current step by the interpolation alpha of the frame being drawn
+/// Blending the elements is exact for translation and close enough for the small rotations made in a single step
+/// </summary>
+/// <param name="pItem">Given render item</param>
+/// <returns>World matrix to draw the item with</returns>
+KodeboldsMath::Matrix4 RenderSystem::InterpolatedWorld(const RenderItem& pItem) const
+{
+	const float alpha = Frame().interpolationAlpha;
+	if (alpha >= 1)
+	{
+		return pItem.world;
+	}
+
+	KodeboldsMath::Matrix4 world;
+	for (int i = 0; i < 16; i++)
+	{
+		world.mElements[i] = pItem.previousWorld.mElements[i] + (pItem.world.mElements[i] - pItem.previousWorld.mElements[i]) * alpha;
+	}
+	return world;
+}
+
+/// <summary>
+/// Blends the given vector from the previous simulation step to the current step by the interpolation alpha of the frame being drawn, used for camera and light positions and directions
+/// </summary>
+/// <param name="pPrevious">Value at the previous step</param>
+/// <param name="pCurrent">Value at the current step</param>
+/// <returns>Value to draw with</returns>
+KodeboldsMath::Vector4 RenderSystem::Interpolate(const KodeboldsMath::Vector4& pPrevious, const KodeboldsMath::Vector4& pCurrent) const
+{
+	const float alpha = Frame().interpolationAlpha;
+	if (alpha >= 1)
+	{
+		return pCurrent;
+	}
+	return pPrevious + (pCurrent - pPrevious) * alpha;
+}
@@ -10,13 +10,13 @@ using namespace DirectX;
 /// <param name="pWindow">A handle to the win32 window</param>
 /// <param name="pMaxLights">The maximum number of lights in the render system</param>
 RenderSystem_DX::RenderSystem_DX(const HWND& pWindow, const int pMaxPointLights, const int pMaxDirLights, const int pRenderTextures)
-	: RenderSystem(std::vector<int>{ ComponentType::COMPONENT_TRANSFORM | ComponentType::COMPONENT_GEOMETRY | ComponentType::COMPONENT_SHADER,
+	: RenderSystem(std::vector<ComponentMask>{ ComponentType::COMPONENT_TRANSFORM | ComponentType::COMPONENT_GEOMETRY | ComponentType::COMPONENT_SHADER,
 		ComponentType::COMPONENT_POINTLIGHT,
 		ComponentType::COMPONENT_DIRECTIONALLIGHT,
 		ComponentType::COMPONENT_CAMERA },
 		pMaxPointLights,
 		pMaxDirLights),
-	mWindow(pWindow), mActiveCamera(nullptr), mActiveGeometry(L""), mActiveShader(L""), mRenderTextureCount(pRenderTextures), mActiveRenderTarget(-1)
+	mWindow(pWindow), mActiveCamera(nullptr), mDepthShader(L"depthShader.fx"), mRenderTextureCount(pRenderTextures), mActiveRenderTarget(-1)
 {
 	if (FAILED(Init()))
 	{
@@ -577,162 +577,18 @@ void RenderSystem_DX::Cleanup()
 	mGUIManager->Cleanup();
 }
 
-/// <summary>
-/// Assigns entity to system if the entities mask matches the system mask
-/// </summary>
-/// <param name="pEntity">Entity to be assigned</param>
-void RenderSystem_DX::AssignEntity(const Entity& pEntity)
-{
-	//Checks if entity mask matches the renderable mask
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0])
-	{
-		//Update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
-	}
-
-	//Checks if entity mask matches the point light mask
-	if ((pEntity.componentMask & mMasks[1]) == mMasks[1])
-	{
-		//If the entity has a light component then find it in the lights
-		const auto entity = find_if(mPointLights.begin(), mPointLights.end(), [&](const Entity & pEntity2) {return pEntity2.ID == pEntity.ID; });
-		if (entity == mPointLights.end())
-		{
-			//If not found then add it
-			mPointLights.push_back(pEntity);
-		}
-		else
-		{
-			//If already in the list, then update mask
-			entity->componentMask = pEntity.componentMask;
-		}
-	}
-
-	//Checks if entity mask matches the directional light mask
-	if ((pEntity.componentMask & mMasks[2]) == mMasks[2])
-	{
-		//If the entity has a light component then find it in the lights
-		const auto entity = find_if(mDirectionalLights.begin(), mDirectionalLights.end(), [&](const Entity & pEntity2) {return pEntity2.ID == pEntity.ID; });
-		if (entity == mDirectionalLights.end())
-		{
-			//If not found then add it
-			mDirectionalLights.push_back(pEntity);
-		}
-		else
-		{
-			//If already in the list, then update mask
-			entity->componentMask = pEntity.componentMask;
-		}
-	}
-
-	//If the entity is marked as a camera set it to the active camera
-	if ((pEntity.componentMask & mMasks[3]) == mMasks[3])
-	{
-		//If the entity has a light component then find it in the lights
-		const auto entity = find_if(mCameras.begin(), mCameras.end(), [&](const Entity & pEntity2) {return pEntity2.ID == pEntity.ID; });
-		if (entity == mCameras.end())
-		{
-			//If not found then add it
-			mCameras.push_back(pEntity);
-		}
-		else
-		{
-			//If already in the list, then update mask
-			entity->componentMask = pEntity.componentMask;
-		}
-	}
-}
-
-/// <summary>
-/// Re-assigns entity to system when component is removed from entity
-/// </summary>
-/// <param name="pEntity">Entity to re-assign</param>
-void RenderSystem_DX::ReAssignEntity(const Entity& pEntity)
-{
-	//Checks if entity mask matches the renderable mask
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0])
-	{
-		//If the entity matches renderable mask then update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
-	}
-	else
-	{
-		//If the mask doesn't match then set ID to -1
-		mEntities[pEntity.ID].ID = -1;
-	}
-
-	//Checks if entity mask matches the point light mask
-	if ((pEntity.componentMask & mMasks[1]) == mMasks[1])
-	{
-		//If the entity has a light component then find it in the lights
-		const auto entity = find_if(mPointLights.begin(), mPointLights.end(), [&](const Entity & pEntity2) {return pEntity2.ID == pEntity.ID; });
-		if (entity == mPointLights.end())
-		{
-			//If not found then add it
-			mPointLights.push_back(pEntity);
-		}
-		else
-		{
-			//If already in the list, then update mask
-			entity->componentMask = pEntity.componentMask;
-		}
-	}
-	else
-	{
-		//If the mask doesn't match then remove it (if it wasn't in the list then the remove acts as a search to confirm it is not there)
-		mPointLights.erase(remove_if(mPointLights.begin(), mPointLights.end(), [&](const Entity & pEntity2) {return pEntity2.ID == pEntity.ID; }), mPointLights.end());
-	}
-
-	//Checks if entity mask matches the directional light mask
-	if ((pEntity.componentMask & mMasks[2]) == mMasks[2])
-	{
-		//If the entity has a light component then find it in the lights
-		const auto entity = find_if(mDirectionalLights.begin(), mDirectionalLights.end(), [&](const Entity & pEntity2) {return pEntity2.ID == pEntity.ID; });
-		if (entity == mDirectionalLights.end())
-		{
-			//If not found then add it
-			mDirectionalLights.push_back(pEntity);
-		}
-		else
-		{
-			//If already in the list, then update mask
-			entity->componentMask = pEntity.componentMask;
-		}
-	}
-	else
-	{
-		//If the mask doesn't match then remove it (if it wasn't in the list then the remove acts as a search to confirm it is not there)
-		mDirectionalLights.erase(remove_if(mDirectionalLights.begin(), mDirectionalLights.end(), [&](const Entity & pEntity2) {return pEntity2.ID == pEntity.ID; }), mDirectionalLights.end());
-	}
-
-	//Checks if entity mask matches the camera mask
-	if ((pEntity.componentMask & mMasks[3]) == mMasks[3])
-	{
-		//If the entity has a light component then find it in the lights
-		const auto entity = find_if(mCameras.begin(), mCameras.end(), [&](const Entity & pEntity2) {return pEntity2.ID == pEntity.ID; });
-		if (entity == mCameras.end())
-		{
-			//If not found then add it
-			mCameras.push_back(pEntity);
-		}
-		else
-		{
-			//If already in the list, then update mask
-			entity->componentMask = pEntity.componentMask;
-		}
-	}
-	else
-	{
-		//If the mask doesn't match then remove it (if it wasn't in the list then the remove acts as a search to confirm it is not there)
-		mCameras.erase(remove_if(mCameras.begin(), mCameras.end(), [&](const Entity & pEntity2) {return pEntity2.ID == pEntity.ID; }), mCameras.end());
-	}
-}
-
 /// <summary>
 /// Systems process function, core logic of system
 /// Renders every renderable entity, as well as updating all lighting and camera data
+/// Only reads the most recently extracted render frame, never the components themselves
 /// </summary>
 void RenderSystem_DX::Process()
 {
+	const RenderFrame& frame = Frame();
+
+	//The previous frames camera belongs to another frame context
+	mActiveCamera = nullptr;
+
 	//Clear render targets and depth view
 	ClearView();
 
@@ -750,7 +606,7 @@ void RenderSystem_DX::Process()
 		mContext->ClearRenderTargetView(mTextureRenderTargetViews[i].Get(), DirectX::Colors::White);
 		//Render to texture
 		mContext->OMSetRenderTargets(1, mTextureRenderTargetViews[i].GetAddressOf(), mDepthStencilView.Get());
-		Render();
+		Render(frame);
 		//Clear depth between renders
 		mContext->ClearDepthStencilView(mDepthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
 	}
@@ -759,7 +615,7 @@ void RenderSystem_DX::Process()
 
 	//Render to window
 	mContext->OMSetRenderTargets(1, mRenderTargetView.GetAddressOf(), mDepthStencilView.Get());
-	Render();
+	Render(frame);
 
 	RenderGUI();
 	mGUIManager->Update();
@@ -786,27 +642,27 @@ void RenderSystem_DX::SwapBuffers() const
 }
 
 /// <summary>
-/// Loads the geometry for the given entity into a VBO object
+/// Loads the geometry of the given material into a VBO object
 /// </summary>
-/// <param name="pEntity">Entity to load geometry for</param>
-void RenderSystem_DX::LoadGeometry(const Entity& pEntity)
+/// <param name="pMaterial">Material to load geometry for</param>
+void RenderSystem_DX::LoadGeometry(const RenderMaterial& pMaterial)
 {
-	//If geometry of entity is not already in the buffers, load entities geometry
-	if (mEcsManager->GeometryComp(pEntity.ID)->filename != mActiveGeometry)
+	//If geometry of material is not already in the buffers, load materials geometry
+	if (pMaterial.geometry.filename != mActiveGeometry)
 	{
-		mGeometry = mResourceManager->LoadGeometry(this, mEcsManager->GeometryComp(pEntity.ID)->filename);
+		mGeometry = mResourceManager->LoadGeometry(this, pMaterial.geometry.filename);
 		mGeometry->Load(this);
-		mActiveGeometry = mEcsManager->GeometryComp(pEntity.ID)->filename;
+		mActiveGeometry = pMaterial.geometry.filename;
 	}
 }
 
 /// <summary>
-/// Loads the shader for the given entity into a shader object
+/// Loads the shader of the given material into a shader object
 /// </summary>
-/// <param name="pEntity">Entity to load shader for</param>
-bool RenderSystem_DX::LoadShaders(const Entity& pEntity)
+/// <param name="pMaterial">Material to load shader for</param>
+bool RenderSystem_DX::LoadShaders(const RenderMaterial& pMaterial)
 {
-	const Shader* s = mEcsManager->ShaderComp(pEntity.ID);
+	const Shader* s = &pMaterial.shader;
 	if (mActiveRenderTarget == -1)
 	{
 		if (!s->renderToScreen)
@@ -820,13 +676,13 @@ bool RenderSystem_DX::LoadShaders(const Entity& pEntity)
 	}
 	if (mActiveRenderTarget == 0)
 	{
-		const auto shader = mResourceManager->LoadShader(this, L"depthShader.fx");
+		const auto shader = mResourceManager->LoadShader(this, mDepthShader);
 		shader->Load(this);
-		mActiveShader = L"depthShader.fx";
+		mActiveShader = mDepthShader;
 	}
 	else
 	{
-		//If shader of entity is not already in the buffers, load entities shader
+		//If shader of material is not already in the buffers, load materials shader
 		if (s->filename != mActiveShader)
 		{
 			const auto shader = mResourceManager->LoadShader(this, s->filename);
@@ -895,29 +751,29 @@ bool RenderSystem_DX::LoadShaders(const Entity& pEntity)
 }
 
 /// <summary>
-/// Loads the texture for the given entity into a texture object
+/// Loads the textures of the given material into texture objects
 /// </summary>
-/// <param name="pEntity">Entity to load texture for</param>
-void RenderSystem_DX::LoadTexture(const Entity& pEntity)
+/// <param name="pMaterial">Material to load textures for</param>
+void RenderSystem_DX::LoadTexture(const RenderMaterial& pMaterial)
 {
-	if (mEcsManager->TextureComp(pEntity.ID))
+	if (pMaterial.hasTexture)
 	{
 		//Loads diffuse texture from texture component
-		auto texture = mResourceManager->LoadTexture(this, mEcsManager->TextureComp(pEntity.ID)->diffuse);
+		auto texture = mResourceManager->LoadTexture(this, pMaterial.texture.diffuse);
 		if (texture)
 		{
 			texture->Load(this, 0);
 		}
 
 		//Loads normal map texture from texture component
-		texture = mResourceManager->LoadTexture(this, mEcsManager->TextureComp(pEntity.ID)->normal);
+		texture = mResourceManager->LoadTexture(this, pMaterial.texture.normal);
 		if (texture)
 		{
 			texture->Load(this, 1);
 		}
 
 		//Loads height map texture from texture component
-		texture = mResourceManager->LoadTexture(this, mEcsManager->TextureComp(pEntity.ID)->height);
+		texture = mResourceManager->LoadTexture(this, pMaterial.texture.height);
 		if (texture)
 		{
 			texture->Load(this, 2);
@@ -937,13 +793,15 @@ void RenderSystem_DX::LoadTexture(const Entity& pEntity)
 /// </summary>
 void RenderSystem_DX::SetViewProj()
 {
-	//Calculates the view matrix and sets it in the constant buffer
-	const XMFLOAT4 position(reinterpret_cast<float*>(&(mEcsManager->TransformComp(mActiveCamera->ID)->translation)));
+	//Calculates the view matrix from the camera blended between the last two steps and sets it in the constant buffer
+	const KodeboldsMath::Vector4 translation = Interpolate(mActiveCamera->previousTranslation, mActiveCamera->translation);
+	const KodeboldsMath::Vector4 upV = Interpolate(mActiveCamera->previousUp, mActiveCamera->up);
+	const XMFLOAT4 position(reinterpret_cast<const float*>(&translation));
 	mCB.mCameraPosition = position;
 
-	KodeboldsMath::Vector4 lookAtV = mEcsManager->TransformComp(mActiveCamera->ID)->translation + mEcsManager->TransformComp(mActiveCamera->ID)->forward;
+	KodeboldsMath::Vector4 lookAtV = translation + Interpolate(mActiveCamera->previousForward, mActiveCamera->forward);
 	const XMFLOAT4 lookAt(reinterpret_cast<float*>(&(lookAtV)));
-	const XMFLOAT4 up(reinterpret_cast<float*>(&(mEcsManager->TransformComp(mActiveCamera->ID)->up)));
+	const XMFLOAT4 up(reinterpret_cast<const float*>(&upV));
 
 	const XMVECTOR posVec = XMLoadFloat4(&position);
 	const XMVECTOR lookAtVec = XMLoadFloat4(&lookAt);
@@ -952,38 +810,36 @@ void RenderSystem_DX::SetViewProj()
 	XMStoreFloat4x4(&mCB.mView, XMMatrixTranspose(XMMatrixLookAtLH(posVec, lookAtVec, upVec)));
 
 	//Calculates the projection matrix and sets it in the constant buffer
-	const float fov = XMConvertToRadians(mEcsManager->CameraComp(mActiveCamera->ID)->FOV);
+	const float fov = XMConvertToRadians(mActiveCamera->camera.FOV);
 	const float aspectRatio = static_cast<float>(mWidth) / static_cast<float>(mHeight);
-	const float nearClip = mEcsManager->CameraComp(mActiveCamera->ID)->nearPlane;
-	const float farClip = mEcsManager->CameraComp(mActiveCamera->ID)->farPlane;
+	const float nearClip = mActiveCamera->camera.nearPlane;
+	const float farClip = mActiveCamera->camera.farPlane;
 
 	XMStoreFloat4x4(&mCB.mProj, XMMatrixTranspose(XMMatrixPerspectiveFovLH(fov, aspectRatio, nearClip, farClip)));
 }
 
 /// <summary>
 /// Sets the light position and colour in the constant buffer
+/// The render frame only holds as many lights as the renderer supports
 /// </summary>
 void RenderSystem_DX::SetLights()
 {
-	if (mDirectionalLights.size() > mMaxDirLights)
-	{
-		mLightCB.numDirLights = mMaxDirLights;
-	}
-	else
-	{
-		mLightCB.numDirLights = mDirectionalLights.size();
-	}
+	const RenderFrame& frame = Frame();
+
+	mLightCB.numDirLights = frame.directionalLights.size();
 
 	for (int i = 0; i < mLightCB.numDirLights; ++i)
 	{
-		const auto dlComp = mEcsManager->DirectionalLightComp(mDirectionalLights[i].ID);
+		const RenderDirectionalLight& dirLight = frame.directionalLights[i];
 
-		//Calculates the view matrix and sets it in the constant buffer
-		const XMFLOAT4 position(reinterpret_cast<float*>(&(mEcsManager->TransformComp(mDirectionalLights[i].ID)->translation)));
+		//Calculates the view matrix from the light blended between the last two steps and sets it in the constant buffer
+		const KodeboldsMath::Vector4 translation = Interpolate(dirLight.previousTranslation, dirLight.translation);
+		const KodeboldsMath::Vector4 upV = Interpolate(dirLight.previousUp, dirLight.up);
+		const XMFLOAT4 position(reinterpret_cast<const float*>(&translation));
 
-		KodeboldsMath::Vector4 lookAtV = mEcsManager->TransformComp(mDirectionalLights[i].ID)->translation + mEcsManager->TransformComp(mDirectionalLights[i].ID)->forward;
+		KodeboldsMath::Vector4 lookAtV = translation + Interpolate(dirLight.previousForward, dirLight.forward);
 		const XMFLOAT4 lookAt(reinterpret_cast<float*>(&(lookAtV)));
-		const XMFLOAT4 up(reinterpret_cast<float*>(&(mEcsManager->TransformComp(mDirectionalLights[i].ID)->up)));
+		const XMFLOAT4 up(reinterpret_cast<const float*>(&upV));
 
 		const XMVECTOR posVec = XMLoadFloat4(&position);
 		const XMVECTOR lookAtVec = XMLoadFloat4(&lookAt);
@@ -993,45 +849,37 @@ void RenderSystem_DX::SetLights()
 		XMStoreFloat4x4(&view, XMMatrixTranspose(XMMatrixLookAtLH(posVec, lookAtVec, upVec)));
 
 		//Calculates the projection matrix and sets it in the constant buffer
-		const float fov = XMConvertToRadians(mEcsManager->CameraComp(mDirectionalLights[i].ID)->FOV);
+		const float fov = XMConvertToRadians(dirLight.camera.FOV);
 		const float aspectRatio = static_cast<float>(mWidth) / static_cast<float>(mHeight);
-		const float nearClip = mEcsManager->CameraComp(mDirectionalLights[i].ID)->nearPlane;
-		const float farClip = mEcsManager->CameraComp(mDirectionalLights[i].ID)->farPlane;
+		const float nearClip = dirLight.camera.nearPlane;
+		const float farClip = dirLight.camera.farPlane;
 
 		XMFLOAT4X4 proj;
 		XMStoreFloat4x4(&proj, XMMatrixTranspose(XMMatrixPerspectiveFovLH(fov, aspectRatio, nearClip, farClip)));
 
 		const DirectionalLightCB dl{
-			XMFLOAT3(reinterpret_cast<float*>(&dlComp->mDirection)),
+			XMFLOAT3(reinterpret_cast<const float*>(&dirLight.light.mDirection)),
 			1.0f,
-			XMFLOAT4(reinterpret_cast<float*>(&dlComp->mColour)),
+			XMFLOAT4(reinterpret_cast<const float*>(&dirLight.light.mColour)),
 			view,
 			proj
 		};
 		mLightCB.dirLights[i] = dl;
 	}
 
-	if (mPointLights.size() > mMaxPointLights)
-	{
-		mLightCB.numPointLights = mMaxPointLights;
-	}
-	else
-	{
-		mLightCB.numPointLights = mPointLights.size();
-	}
+	mLightCB.numPointLights = frame.pointLights.size();
 
 	for (int i = 0; i < mLightCB.numPointLights; ++i)
 	{
-		if (const auto plComp = mEcsManager->PointLightComp(mPointLights[i].ID))
-		{
-			const PointLightCB pl{
-	XMFLOAT4(reinterpret_cast<float*>(&(mEcsManager->TransformComp(mPointLights[i].ID)->translation))),
-	XMFLOAT4(reinterpret_cast<float*>(&plComp->mColour)),
-	plComp->mRange,
+		const RenderPointLight& pointLight = frame.pointLights[i];
+		const KodeboldsMath::Vector4 translation = Interpolate(pointLight.previousTranslation, pointLight.translation);
+		const PointLightCB pl{
+	XMFLOAT4(reinterpret_cast<const float*>(&translation)),
+	XMFLOAT4(reinterpret_cast<const float*>(&pointLight.light.mColour)),
+	pointLight.light.mRange,
 	XMFLOAT3(0,0,0)
-			};
-			mLightCB.pointLights[i] = pl;
-		}
+		};
+		mLightCB.pointLights[i] = pl;
 	}
 }
 
@@ -1040,17 +888,16 @@ void RenderSystem_DX::SetLights()
 /// </summary>
 void RenderSystem_DX::SetCamera()
 {
-	for (const auto& camera : mCameras)
+	for (const RenderCamera& camera : Frame().cameras)
 	{
-		const auto cameraComp = mEcsManager->CameraComp(camera.ID);
-		if (mActiveRenderTarget == -1 && cameraComp->active)
+		if (mActiveRenderTarget == -1 && camera.camera.active)
 		{
 			mActiveCamera = &camera;
 		}
 		else
 		{
-			auto it = std::find(cameraComp->activeTargets.begin(), cameraComp->activeTargets.end(), mActiveRenderTarget);
-			if (it != cameraComp->activeTargets.end())
+			auto it = std::find(camera.camera.activeTargets.begin(), camera.camera.activeTargets.end(), mActiveRenderTarget);
+			if (it != camera.camera.activeTargets.end())
 			{
 				mActiveCamera = &camera;
 			}
@@ -1065,41 +912,33 @@ void RenderSystem_DX::SetCamera()
 /// <summary>
 /// Renders the scene
 /// </summary>
-void RenderSystem_DX::Render()
+/// <param name="pFrame">Render frame to draw</param>
+void RenderSystem_DX::Render(const RenderFrame& pFrame)
 {
 	SetCamera();
-	//Load everything necessary and draw each entity
-	for (const Entity& entity : mEntities)
-	{
-		if (entity.ID != -1)
-		{
-			if (!LoadShaders(entity))
-				continue;
-			LoadGeometry(entity);
-			LoadTexture(entity);
-
-			//Set world matrix
-			mCB.mWorld = XMFLOAT4X4(reinterpret_cast<float*>(&(mEcsManager->TransformComp(entity.ID)->transform)));
-
-			//Set time
-			mCB.time = static_cast<float>(mSceneManager->Time());
-
-			//Set colour if there is a colour component attached
-			if ((entity.componentMask & ComponentType::COMPONENT_COLOUR) == ComponentType::COMPONENT_COLOUR)
-			{
-				mCB.mColour = XMFLOAT4(reinterpret_cast<float*>(&(mEcsManager->ColourComp(entity.ID)->mColour)));
-			}
-			else
-			{
-				mCB.mColour = XMFLOAT4(0, 0, 0, 0);
-			}
 
-			//Update constant buffer
-			mContext->UpdateSubresource(mConstantBuffer.Get(), 0, nullptr, &mCB, 0, 0);
-			mContext->UpdateSubresource(mLightingBuffer.Get(), 0, nullptr, &mLightCB, 0, 0);
+	//Set time
+	mCB.time = static_cast<float>(pFrame.time);
 
-			mGeometry->Draw(this);
-		}
+	//Load everything necessary and draw each item
+	for (const RenderItem& item : pFrame.items)
+	{
+		const RenderMaterial& material = pFrame.materials[item.material];
+		if (!LoadShaders(material))
+			continue;
+		LoadGeometry(material);
+		LoadTexture(material);
+
+		//Set world matrix and colour, items without a colour component are extracted with a zero colour
+		const KodeboldsMath::Matrix4 world = InterpolatedWorld(item);
+		mCB.mWorld = XMFLOAT4X4(reinterpret_cast<const float*>(&world));
+		mCB.mColour = XMFLOAT4(reinterpret_cast<const float*>(&(item.colour)));
+
+		//Update constant buffer
+		mContext->UpdateSubresource(mConstantBuffer.Get(), 0, nullptr, &mCB, 0, 0);
+		mContext->UpdateSubresource(mLightingBuffer.Get(), 0, nullptr, &mLightCB, 0, 0);
+
+		mGeometry->Draw(this);
 	}
 }
 
@@ -16,7 +16,7 @@
 /// <param name="pWindow">A handle to the win32 window</param>
 /// <param name="pMaxLights">the maximum number of lights in this renderer</param>
 RenderSystem_GL::RenderSystem_GL(const HWND& pWindow, const int pMaxPointLights, const int pMaxDirLights) 
- : RenderSystem(std::vector<int>{ ComponentType::COMPONENT_TRANSFORM | ComponentType::COMPONENT_GEOMETRY | ComponentType::COMPONENT_SHADER,
+ : RenderSystem(std::vector<ComponentMask>{ ComponentType::COMPONENT_TRANSFORM | ComponentType::COMPONENT_GEOMETRY | ComponentType::COMPONENT_SHADER,
 	ComponentType::COMPONENT_POINTLIGHT,
 	ComponentType::COMPONENT_DIRECTIONALLIGHT,
 	ComponentType::COMPONENT_CAMERA },
@@ -191,135 +191,63 @@ void RenderSystem_GL::Cleanup()
 }
 
 /// <summary>
-/// Assigns entity to system if the entities mask matches the system mask
+/// Systems process function, core logic of system
+/// Renders every renderable entity, as well as updating all lighting and camera data
 /// </summary>
-/// <param name="pEntity">Entity to be assigned</param>
-void RenderSystem_GL::AssignEntity(const Entity & pEntity)
+void RenderSystem_GL::Process()
 {
-	//Checks if entity mask matches the renderable mask
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0])
-	{
-		//Update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
-	}
+	const RenderFrame& frame = Frame();
 
-	//Checks if entity mask matches the light mask
-	if ((pEntity.componentMask & ComponentType::COMPONENT_POINTLIGHT) == ComponentType::COMPONENT_POINTLIGHT)
+	ClearView();
+
+	//TODO: Implement multiple cameras
+	mActiveCamera = nullptr;
+	for (const RenderCamera& camera : frame.cameras)
 	{
-		//If the entity has a light component then find it in the lights
-		const auto entity = find_if(mLights.begin(), mLights.end(), [&](const Entity& entity) {return entity.ID == pEntity.ID; });
-		if (entity == mLights.end())
+		if (camera.camera.active)
 		{
-			//If not found then add it
-			mLights.push_back(pEntity);
-		}
-		else
-		{
-			//If already in the list, then update mask
-			entity->componentMask = pEntity.componentMask;
+			mActiveCamera = &camera;
 		}
 	}
 
-	//If the entity is marked as a camera set it to the active camera
-	//TODO: Implement multiple cameras
-	if ((pEntity.componentMask & ComponentType::COMPONENT_CAMERA) == ComponentType::COMPONENT_CAMERA)
+	if (mActiveCamera)
 	{
-		mActiveCamera = &pEntity;
-
-		//if already in the list, then update mask
-		//mActiveCamera->componentMask = pEntity.componentMask;
+		SetViewProj();
 	}
-}
-
-/// <summary>
-/// Re-assigns entity to system when component is removed from entity
-/// </summary>
-/// <param name="pEntity">Entity to re-assign</param>
-void RenderSystem_GL::ReAssignEntity(const Entity & pEntity)
-{
-	//Checks if entity mask matches the renderable mask
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0])
+	if (frame.pointLights.size() > 0)
 	{
-		//If the entity matches renderable mask then update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
+		SetLights();
 	}
-	else
+	for (const RenderItem& item : frame.items)
 	{
-		//If the mask doesn't match then set ID to -1
-		mEntities[pEntity.ID].ID = -1;
-	}
+		const RenderMaterial& material = frame.materials[item.material];
 
-	//Checks if entity mask matches the light mask
-	if ((pEntity.componentMask & ComponentType::COMPONENT_POINTLIGHT) == ComponentType::COMPONENT_POINTLIGHT)
-	{
-		//If the entity has a light component then find it in the lights
-		const auto entity = find_if(mLights.begin(), mLights.end(), [&](const Entity& entity) {return entity.ID == pEntity.ID; });
-		if (entity == mLights.end())
+		//If geometry of material is not already in the buffers, load materials geometry
+		if (material.geometry.filename != mActiveGeometry)
 		{
-			//If not found then add it
-			mLights.push_back(pEntity);
+			LoadGeometry(material);
+			mGeometry->Load(this);
+			mActiveGeometry = material.geometry.filename;
 		}
-		else
+		//LoadTexture(material);
+		//If shader of material is not already in the buffers, load materials shader
+		if (material.shader.filename != mActiveShader)
 		{
-			//If already in the list, then update mask
-			entity->componentMask = pEntity.componentMask;
+			LoadShaders(material);
+			mActiveShader = material.shader.filename;
 		}
-	}
-	else
-	{
-		//If the mask doesn't match then remove it (if it wasn't in the list then the remove acts as a search to confirm it is not there)
-		mLights.erase(remove_if(mLights.begin(), mLights.end(), [&](const Entity& entity) {return entity.ID == pEntity.ID; }), mLights.end());
-	}
 
-	//TODO: Implement multiple cameras
-}
+		//Update constant buffer with world matrix and object colour
+		mWorld = InterpolatedWorld(item);
+		//mCB.mWorld = XMFLOAT4X4(reinterpret_cast<const float*>(&mWorld));
+		//mCB.colour = XMFLOAT4(reinterpret_cast<const float*>(&(item.colour)));
+		//mContext->UpdateSubresource(mConstantBuffer.Get(), 0, nullptr, &mCB, 0, 0);
 
-/// <summary>
-/// Systems process function, core logic of system
-/// Renders every renderable entity, as well as updating all lighting and camera data
-/// </summary>
-void RenderSystem_GL::Process()
-{
-	ClearView();
+		//mContext->OMSetBlendState()
+		//mContext->OMSetDepthStencilState(NULL, 1);
+		//mContext->RSSetState(mDefaultRasterizerState.Get());
 
-	if (mActiveCamera)
-	{
-		SetViewProj();
-	}
-	if (mLights.size() > 0)
-	{
-		SetLights();
-	}
-	for (const Entity& entity : mEntities)
-	{
-		if (entity.ID != -1)
-		{
-			//If geometry of entity is not already in the buffers, load entities geometry
-			if (mEcsManager->GeometryComp(entity.ID)->filename != mActiveGeometry)
-			{
-				LoadGeometry(entity);
-				mGeometry->Load(this);
-				mActiveGeometry = mEcsManager->GeometryComp(entity.ID)->filename;
-			}
-			//LoadTexture(entity);
-			//If shader of entity is not already in the buffers, load entities shader
-			if (mEcsManager->ShaderComp(entity.ID)->filename != mActiveShader)
-			{
-				LoadShaders(entity);
-				mActiveShader = mEcsManager->ShaderComp(entity.ID)->filename;
-			}
-
-			//Update constant buffer with world matrix and object colour
-			//mCB.mWorld = XMFLOAT4X4(reinterpret_cast<float*>(&(mEcsManager->TransformComp(entity.ID)->transform)));
-			//mCB.colour = XMFLOAT4(reinterpret_cast<float*>(&(mEcsManager->ColourComp(entity.ID)->colour)));
-			//mContext->UpdateSubresource(mConstantBuffer.Get(), 0, nullptr, &mCB, 0, 0);
-
-			//mContext->OMSetBlendState()
-			//mContext->OMSetDepthStencilState(NULL, 1);
-			//mContext->RSSetState(mDefaultRasterizerState.Get());
-
-			mGeometry->Draw(this);
-		}
+		mGeometry->Draw(this);
 	}
 
 	mGUIManager->Draw();
@@ -1,8 +1,8 @@
 #include "TransformSystem.h"
 
-void TransformSystem::CalculateTransform(const unsigned short pEntity)
+void TransformSystem::CalculateTransform(Transform& pTransform) const
 {
-	Transform* t = mEcsManager->TransformComp(pEntity);
+	Transform* t = &pTransform;
 	const auto scale = KodeboldsMath::ScaleMatrix(t->scale);
 	const auto translation = KodeboldsMath::TranslationMatrix(t->translation);
 	const auto rotation = KodeboldsMath::RotationMatrixX(t->rotation.X)
@@ -12,79 +12,221 @@ void TransformSystem::CalculateTransform(const unsigned short pEntity)
 	t->transform = translation * rotation * scale;
 }
 
-void TransformSystem::CalculateDirections(const unsigned short pEntity)
+void TransformSystem::CalculateDirections(Transform& pTransform) const
 {
-	Transform* t = mEcsManager->TransformComp(pEntity);
+	Transform* t = &pTransform;
 	t->forward = KodeboldsMath::Vector4(t->transform._13, t->transform._23, t->transform._33, 1.0f).Normalise();
 	t->up = KodeboldsMath::Vector4(t->transform._12, t->transform._22, t->transform._32, 1.0f).Normalise();
 	t->right = KodeboldsMath::Vector4(t->transform._11, t->transform._21, t->transform._31, 1.0f).Normalise();
 }
 
-void TransformSystem::ExtractTransformations(const unsigned short pEntity)
+void TransformSystem::ExtractTransformations(Transform& pTransform) const
 {
-	Transform* t = mEcsManager->TransformComp(pEntity);
+	Transform* t = &pTransform;
 	t->translation = KodeboldsMath::Vector4(t->transform._14, t->transform._24, t->transform._34, 1.0f);
 }
 
-TransformSystem::TransformSystem() 
-	: ISystem(std::vector<int>{ ComponentType::COMPONENT_TRANSFORM })
+int TransformSystem::HierarchyNodeIndex(const EntityHandle pEntityID) const
 {
-	mEntities = std::vector<Entity>(mEcsManager->MaxEntities(), Entity{ -1, ComponentType::COMPONENT_NONE });
+	if (pEntityID.Index() < mHierarchyNodes.size())
+	{
+		const int node = mHierarchyNodes[pEntityID.Index()];
+		if (node != -1 && mHierarchy[node].entity == pEntityID)
+		{
+			return node;
+		}
+	}
+	return -1;
 }
 
-TransformSystem::~TransformSystem()
+void TransformSystem::BuildHierarchy()
 {
-}
+	mHierarchy.clear();
+	std::fill(mHierarchyNodes.begin(), mHierarchyNodes.end(), -1);
+	mOrphanCount = 0;
 
-void TransformSystem::AssignEntity(const Entity & pEntity)
-{
-	//Checks if entity mask matches the transform mask
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0])
+	const auto addNode = [this](const EntityHandle pEntityID, const EntityHandle pParentID, const int pParentNode)
+	{
+		if (pEntityID.Index() >= mHierarchyNodes.size())
+		{
+			mHierarchyNodes.resize(pEntityID.Index() + 1, -1);
+		}
+		mHierarchyNodes[pEntityID.Index()] = static_cast<int>(mHierarchy.size());
+		mHierarchy.push_back(HierarchyNode{ pEntityID, pParentID, pParentNode });
+	};
+
+	//Find the depth of every child by walking up its parents
+	//Children whose parents are missing a transform, have been destroyed or loop back round to the child are left where they are
+	auto view = mEcsManager->View<Transform, Parent>();
+	const int maxDepth = view.Size();
+	std::vector<std::pair<int, HierarchyNode>> children;
+	view.ForEach([&](const EntityHandle pEntityID, Transform&, Parent& pParent)
+	{
+		int depth = 0;
+		const Parent* parent = &pParent;
+		while (parent && depth <= maxDepth)
+		{
+			if (!mEcsManager->Read<Transform>(parent->parent))
+			{
+				depth = maxDepth + 1;
+				break;
+			}
+			depth++;
+			parent = mEcsManager->Read<Parent>(parent->parent);
+		}
+
+		if (depth > maxDepth)
+		{
+			mOrphanCount++;
+			return;
+		}
+		children.emplace_back(depth, HierarchyNode{ pEntityID, pParent.parent, -1 });
+	});
+
+	std::sort(children.begin(), children.end(), [](const std::pair<int, HierarchyNode>& pA, const std::pair<int, HierarchyNode>& pB) { return pA.first < pB.first; });
+
+	//Roots are the parents of the first level that don't have parents of their own
+	for (const auto& child : children)
 	{
-		//Calculate transform
-		if (mEntities[pEntity.ID].ID == -1)
+		if (child.first != 1)
 		{
-			CalculateTransform(pEntity.ID);
-			CalculateDirections(pEntity.ID);
-			ExtractTransformations(pEntity.ID);
+			break;
 		}
+		if (HierarchyNodeIndex(child.second.parent) == -1)
+		{
+			addNode(child.second.parent, EntityHandle(), -1);
+		}
+	}
 
-		//Update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
+	//Each level is added once the level above it is in place, sorted by parent so siblings end up next to each other
+	auto level = children.begin();
+	while (level != children.end())
+	{
+		const auto levelEnd = std::find_if(level, children.end(), [&](const std::pair<int, HierarchyNode>& pChild) { return pChild.first != level->first; });
+		for (auto child = level; child != levelEnd; ++child)
+		{
+			child->second.parentNode = HierarchyNodeIndex(child->second.parent);
+		}
+		std::sort(level, levelEnd, [](const std::pair<int, HierarchyNode>& pA, const std::pair<int, HierarchyNode>& pB) { return pA.second.parentNode < pB.second.parentNode; });
+		for (auto child = level; child != levelEnd; ++child)
+		{
+			addNode(child->second.entity, child->second.parent, child->second.parentNode);
+		}
+		level = levelEnd;
 	}
+
+	//Every child needs its transform recalculating against its new parent
+	mDirtyNodes.assign(mHierarchy.size(), 1);
 }
 
-void TransformSystem::ReAssignEntity(const Entity & pEntity)
+void TransformSystem::PropagateHierarchy()
 {
-	//Checks if entity mask matches the transform mask
-	if ((pEntity.componentMask & mMasks[0]) == mMasks[0])
+	//Parents always come first, so a dirty parent has already been updated and flagged by the time its children are reached
+	for (int i = 0; i < static_cast<int>(mHierarchy.size()); i++)
 	{
-		//Calculate transform
-		if (mEntities[pEntity.ID].ID == -1)
+		const HierarchyNode& node = mHierarchy[i];
+		if (node.parentNode == -1 || !(mDirtyNodes[i] || mDirtyNodes[node.parentNode]))
 		{
-			CalculateTransform(pEntity.ID);
-			CalculateDirections(pEntity.ID);
-			ExtractTransformations(pEntity.ID);
+			continue;
 		}
+		mDirtyNodes[i] = 1;
+
+		Transform* const transform = mEcsManager->TransformComp(node.entity);
+		transform->transform = mEcsManager->Read<Transform>(node.parent)->transform * mEcsManager->Read<Parent>(node.entity)->localTransform;
+		CalculateDirections(*transform);
+		ExtractTransformations(*transform);
+	}
+	std::fill(mDirtyNodes.begin(), mDirtyNodes.end(), 0);
+}
 
-		//If the entity matches transform mask then update entry in systems entity list
-		mEntities[pEntity.ID] = pEntity;
+TransformSystem::TransformSystem() 
+	: IParallelSystem(std::vector<ComponentMask>{ ComponentType::COMPONENT_TRANSFORM, ComponentType::COMPONENT_TRANSFORM | ComponentType::COMPONENT_PARENT },
+		ComponentType::COMPONENT_TRANSFORM | ComponentType::COMPONENT_PARENT, ComponentType::COMPONENT_TRANSFORM),
+	mLastVersion(0), mHierarchyChanged(false), mOrphanCount(0)
+{
+}
+
+TransformSystem::~TransformSystem()
+{
+}
+
+void TransformSystem::OnEnter(const Entity & pEntity, const int pMaskIndex)
+{
+	//Entities that gain or lose a parent change the shape of the hierarchy
+	if (pMaskIndex == 1)
+	{
+		mHierarchyChanged = true;
+		return;
+	}
+
+	//Calculate transform
+	Transform* const transform = mEcsManager->TransformComp(pEntity.ID);
+	CalculateTransform(*transform);
+	CalculateDirections(*transform);
+	ExtractTransformations(*transform);
+
+	mEntities.Add(pEntity);
+
+	//The new entity may be the missing parent of an orphaned child
+	if (mOrphanCount > 0)
+	{
+		mHierarchyChanged = true;
+	}
+}
+
+void TransformSystem::OnExit(const Entity & pEntity, const int pMaskIndex)
+{
+	if (pMaskIndex == 1)
+	{
+		mHierarchyChanged = true;
+		return;
 	}
-	else
+
+	mEntities.Remove(pEntity.ID);
+
+	//Children of a removed parent are orphaned
+	if (HierarchyNodeIndex(pEntity.ID) != -1)
 	{
-		//If the mask doesn't match then set ID to -1
-		mEntities[pEntity.ID].ID = -1;
+		mHierarchyChanged = true;
 	}
 }
 
 void TransformSystem::Process()
 {
-	for (const Entity& entity : mEntities)
+	//Changing a childs parent changes the shape of the hierarchy, changing only its local transform just moves the child
+	mEcsManager->View<Transform, Parent>().Changed<Parent>(mLastVersion).ForEach([this](const EntityHandle pEntityID, Transform&, Parent& pParent)
 	{
-		if (entity.ID != -1)
+		const int node = HierarchyNodeIndex(pEntityID);
+		if (node == -1 || mHierarchy[node].parent != pParent.parent)
+		{
+			mHierarchyChanged = true;
+		}
+		else
 		{
-			CalculateDirections(entity.ID);
-			ExtractTransformations(entity.ID);
+			mDirtyNodes[node] = 1;
 		}
+	});
+
+	if (mHierarchyChanged)
+	{
+		BuildHierarchy();
+		mHierarchyChanged = false;
 	}
+
+	//Only transforms changed since the last run need their directions and translation updating, each entity only flags its own node so they are split across the workers
+	ParallelForEach(mEcsManager->View<Transform>().Changed<Transform>(mLastVersion), [this](const EntityHandle pEntityID, Transform& pTransform)
+	{
+		CalculateDirections(pTransform);
+		ExtractTransformations(pTransform);
+
+		const int node = HierarchyNodeIndex(pEntityID);
+		if (node != -1)
+		{
+			mDirtyNodes[node] = 1;
+		}
+	});
+
+	//Children of changed entities are moved with them, children that were moved directly are put back relative to their parent
+	PropagateHierarchy();
+	mLastVersion = mEcsManager->Version();
 }